@@ -36,5 +36,5 @@ bool CAreaAttributes::IsSkyEnabled() const
 
 CModel* CAreaAttributes::SkyModel() const
 {
-    return mOverrideSky.IsValid() ? gpResourceStore->LoadResource<CModel>(mOverrideSky.Get()) : nullptr;
+    return mOverrideSky.IsValid() ? ActiveResourceStore()->LoadResource<CModel>(mOverrideSky.Get()) : nullptr;
 }
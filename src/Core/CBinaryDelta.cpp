@@ -0,0 +1,143 @@
+#include "CBinaryDelta.h"
+#include <algorithm>
+#include <cstring>
+
+// Unchanged gaps shorter than a range record are cheaper to store as part of the surrounding ranges
+static constexpr uint32 kMinRangeGap = 16;
+
+CBinaryDelta CBinaryDelta::Create(const std::vector<char>& rkOld, const std::vector<char>& rkNew)
+{
+    CBinaryDelta Delta;
+    Delta.mOldSize = rkOld.size();
+    Delta.mNewSize = rkNew.size();
+
+    const uint32 MinSize = std::min(Delta.mOldSize, Delta.mNewSize);
+    uint32 Prefix = 0;
+    uint32 Suffix = 0;
+
+    while (Prefix < MinSize && rkOld[Prefix] == rkNew[Prefix])
+        Prefix++;
+
+    while (Suffix < MinSize - Prefix && rkOld[Delta.mOldSize - Suffix - 1] == rkNew[Delta.mNewSize - Suffix - 1])
+        Suffix++;
+
+    auto AddRange = [&](uint32 Offset, uint32 OldSize, uint32 NewSize)
+    {
+        // The new bytes start at the same place as the old ones; ranges only shift after a size change
+        SRange Range{Offset, OldSize, NewSize, static_cast<uint32>(Delta.mBytes.size())};
+        Delta.mBytes.insert(Delta.mBytes.end(), rkOld.begin() + Offset, rkOld.begin() + Offset + OldSize);
+        Delta.mBytes.insert(Delta.mBytes.end(), rkNew.begin() + Offset, rkNew.begin() + Offset + NewSize);
+        Delta.mRanges.push_back(Range);
+    };
+
+    if (Delta.mOldSize != Delta.mNewSize)
+    {
+        // Sizes differ, so everything between the common prefix and suffix is treated as one replaced block
+        AddRange(Prefix, Delta.mOldSize - Suffix - Prefix, Delta.mNewSize - Suffix - Prefix);
+    }
+    else
+    {
+        // Same size; store each run of changed bytes separately, joining runs that are close together
+        const uint32 End = Delta.mOldSize - Suffix;
+        uint32 Pos = Prefix;
+
+        while (Pos < End)
+        {
+            const uint32 RunStart = Pos;
+            uint32 RunEnd = Pos + 1;
+
+            for (Pos = RunEnd; Pos < End && Pos - RunEnd < kMinRangeGap; Pos++)
+            {
+                if (rkOld[Pos] != rkNew[Pos])
+                    RunEnd = Pos + 1;
+            }
+
+            AddRange(RunStart, RunEnd - RunStart, RunEnd - RunStart);
+
+            while (Pos < End && rkOld[Pos] == rkNew[Pos])
+                Pos++;
+        }
+    }
+
+    Delta.mBytes.shrink_to_fit();
+    Delta.mRanges.shrink_to_fit();
+    return Delta;
+}
+
+void CBinaryDelta::Clear()
+{
+    mRanges.clear();
+    mRanges.shrink_to_fit();
+    mBytes.clear();
+    mBytes.shrink_to_fit();
+    mOldSize = 0;
+    mNewSize = 0;
+}
+
+size_t CBinaryDelta::MemoryUsage() const
+{
+    return sizeof(CBinaryDelta) + mRanges.capacity() * sizeof(SRange) + mBytes.capacity();
+}
+
+bool CBinaryDelta::Matches(const std::vector<char>& rkData, bool Old) const
+{
+    if (rkData.size() != (Old ? mOldSize : mNewSize))
+        return false;
+
+    // Bytes outside the ranges are the same in both buffers, so only the ranges need to be compared
+    int64 Shift = 0;
+
+    for (const SRange& rkRange : mRanges)
+    {
+        const uint32 Offset = static_cast<uint32>(rkRange.Offset + (Old ? 0 : Shift));
+        const uint32 Size = (Old ? rkRange.OldSize : rkRange.NewSize);
+        const char* pkBytes = mBytes.data() + rkRange.DataOffset + (Old ? 0 : rkRange.OldSize);
+
+        if (Offset + Size > rkData.size() || memcmp(rkData.data() + Offset, pkBytes, Size) != 0)
+            return false;
+
+        Shift += static_cast<int64>(rkRange.NewSize) - static_cast<int64>(rkRange.OldSize);
+    }
+
+    return true;
+}
+
+bool CBinaryDelta::Apply(std::vector<char>& rData, bool Forward) const
+{
+    // Make sure the data is actually the version this delta starts from before touching it
+    if (!Matches(rData, Forward))
+        return false;
+
+    if (mOldSize == mNewSize && std::all_of(mRanges.begin(), mRanges.end(), [](const SRange& rkRange) { return rkRange.OldSize == rkRange.NewSize; }))
+    {
+        // Nothing moves, so the changed bytes can be swapped in place
+        for (const SRange& rkRange : mRanges)
+        {
+            const char* pkToBytes = mBytes.data() + rkRange.DataOffset + (Forward ? rkRange.OldSize : 0);
+            memcpy(rData.data() + rkRange.Offset, pkToBytes, rkRange.OldSize);
+        }
+        return true;
+    }
+
+    std::vector<char> Result;
+    Result.reserve(Forward ? mNewSize : mOldSize);
+    uint32 ReadPos = 0;
+    int64 Shift = 0;
+
+    for (const SRange& rkRange : mRanges)
+    {
+        const uint32 FromOffset = static_cast<uint32>(rkRange.Offset + (Forward ? 0 : Shift));
+        const uint32 FromSize = (Forward ? rkRange.OldSize : rkRange.NewSize);
+        const uint32 ToSize = (Forward ? rkRange.NewSize : rkRange.OldSize);
+        const char* pkToBytes = mBytes.data() + rkRange.DataOffset + (Forward ? rkRange.OldSize : 0);
+
+        Result.insert(Result.end(), rData.begin() + ReadPos, rData.begin() + FromOffset);
+        Result.insert(Result.end(), pkToBytes, pkToBytes + ToSize);
+        ReadPos = FromOffset + FromSize;
+        Shift += static_cast<int64>(rkRange.NewSize) - static_cast<int64>(rkRange.OldSize);
+    }
+
+    Result.insert(Result.end(), rData.begin() + ReadPos, rData.end());
+    rData = std::move(Result);
+    return true;
+}
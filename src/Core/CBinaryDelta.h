@@ -0,0 +1,62 @@
+#ifndef CBINARYDELTA_H
+#define CBINARYDELTA_H
+
+#include <Common/BasicTypes.h>
+#include <vector>
+
+/**
+ * Difference between two versions of a binary buffer, stored as the byte ranges that changed.
+ * Each range keeps both its old and new bytes, so the delta can be applied in either direction:
+ * forwards to turn the old buffer into the new one, or backwards to turn the new one into the old one.
+ * Used by undo commands to avoid keeping two full copies of an object's serialized state.
+ */
+class CBinaryDelta
+{
+    struct SRange
+    {
+        /** Offset of the range in the old buffer */
+        uint32 Offset;
+        uint32 OldSize;
+        uint32 NewSize;
+        /** Offset of the range's old bytes in mBytes; the new bytes follow them */
+        uint32 DataOffset;
+    };
+
+    std::vector<SRange> mRanges;
+    std::vector<char> mBytes;
+    uint32 mOldSize = 0;
+    uint32 mNewSize = 0;
+
+public:
+    CBinaryDelta() = default;
+
+    /** Build the delta that turns rkOld into rkNew */
+    static CBinaryDelta Create(const std::vector<char>& rkOld, const std::vector<char>& rkNew);
+
+    /** Turn the old buffer into the new one. Returns false if rData isn't the old buffer. */
+    bool ApplyForward(std::vector<char>& rData) const   { return Apply(rData, true); }
+
+    /** Turn the new buffer into the old one. Returns false if rData isn't the new buffer. */
+    bool ApplyBackward(std::vector<char>& rData) const  { return Apply(rData, false); }
+
+    /** Check whether rData is the old or new buffer that the delta was built from */
+    bool MatchesOld(const std::vector<char>& rkData) const  { return Matches(rkData, true); }
+    bool MatchesNew(const std::vector<char>& rkData) const  { return Matches(rkData, false); }
+
+    /** Drop all stored ranges */
+    void Clear();
+
+    bool IsEmpty() const            { return mRanges.empty(); }
+    uint32 NumRanges() const        { return mRanges.size(); }
+    uint32 OldSize() const          { return mOldSize; }
+    uint32 NewSize() const          { return mNewSize; }
+
+    /** Approximate heap and object memory held by the delta */
+    size_t MemoryUsage() const;
+
+private:
+    bool Matches(const std::vector<char>& rkData, bool Old) const;
+    bool Apply(std::vector<char>& rData, bool Forward) const;
+};
+
+#endif // CBINARYDELTA_H
@@ -0,0 +1,122 @@
+#include "CJobPool.h"
+#include "CTrace.h"
+#include <algorithm>
+#include <atomic>
+
+CJobPool::CJobPool(uint32 NumWorkers)
+{
+    if (NumWorkers == 0)
+    {
+        const uint32 HardwareThreads = std::thread::hardware_concurrency();
+        NumWorkers = std::max<uint32>(HardwareThreads, 2) - 1;
+    }
+
+    mWorkers.reserve(NumWorkers);
+
+    for (uint32 iWorker = 0; iWorker < NumWorkers; iWorker++)
+        mWorkers.emplace_back(&CJobPool::WorkerMain, this);
+}
+
+CJobPool::~CJobPool()
+{
+    {
+        std::lock_guard Lock(mMutex);
+        mShuttingDown = true;
+    }
+    mJobAvailable.notify_all();
+
+    for (std::thread& rWorker : mWorkers)
+        rWorker.join();
+}
+
+void CJobPool::ParallelFor(size_t Count, size_t MinChunkSize, const std::function<void(size_t Begin, size_t End)>& Func)
+{
+    if (Count == 0)
+        return;
+
+    // Aim for a few chunks per thread so uneven work still balances out
+    const size_t NumThreads = mWorkers.size() + 1;
+    const size_t ChunkSize = std::max<size_t>(std::max<size_t>(MinChunkSize, 1), (Count + NumThreads * 4 - 1) / (NumThreads * 4));
+    const size_t NumChunks = (Count + ChunkSize - 1) / ChunkSize;
+
+    if (NumChunks <= 1 || mWorkers.empty())
+    {
+        Func(0, Count);
+        return;
+    }
+
+    // Shared so helper jobs that only get scheduled after we return don't touch a dead stack frame
+    struct SSharedState
+    {
+        std::atomic<size_t> NextChunk{0};
+        std::atomic<size_t> ChunksDone{0};
+        std::mutex DoneMutex;
+        std::condition_variable DoneCondition;
+    };
+    auto pState = std::make_shared<SSharedState>();
+
+    // Func is only invoked for chunks claimed before all chunks are done, which can't outlive this call
+    const auto* pkFunc = &Func;
+    auto RunChunks = [pState, pkFunc, Count, ChunkSize, NumChunks]()
+    {
+        for (size_t Chunk = pState->NextChunk++; Chunk < NumChunks; Chunk = pState->NextChunk++)
+        {
+            const size_t Begin = Chunk * ChunkSize;
+            (*pkFunc)(Begin, std::min(Begin + ChunkSize, Count));
+
+            if (++pState->ChunksDone == NumChunks)
+            {
+                std::lock_guard Lock(pState->DoneMutex);
+                pState->DoneCondition.notify_all();
+            }
+        }
+    };
+
+    const size_t NumHelpers = std::min(mWorkers.size(), NumChunks - 1);
+
+    for (size_t iHelper = 0; iHelper < NumHelpers; iHelper++)
+        Enqueue(RunChunks);
+
+    RunChunks();
+
+    std::unique_lock Lock(pState->DoneMutex);
+    pState->DoneCondition.wait(Lock, [&pState, NumChunks]() { return pState->ChunksDone == NumChunks; });
+}
+
+CJobPool& CJobPool::Global()
+{
+    static CJobPool sPool;
+    return sPool;
+}
+
+void CJobPool::Enqueue(std::function<void()>&& Job)
+{
+    {
+        std::lock_guard Lock(mMutex);
+        mJobs.push_back(std::move(Job));
+    }
+    mJobAvailable.notify_one();
+}
+
+void CJobPool::WorkerMain()
+{
+    NTrace::SetThreadName("Job worker");
+
+    while (true)
+    {
+        std::function<void()> Job;
+
+        {
+            std::unique_lock Lock(mMutex);
+            mJobAvailable.wait(Lock, [this]() { return mShuttingDown || !mJobs.empty(); });
+
+            if (mShuttingDown && mJobs.empty())
+                return;
+
+            Job = std::move(mJobs.front());
+            mJobs.pop_front();
+        }
+
+        Job();
+    }
+}
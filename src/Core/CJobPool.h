@@ -0,0 +1,64 @@
+#ifndef CJOBPOOL_H
+#define CJOBPOOL_H
+
+#include <Common/BasicTypes.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed-size pool of worker threads for running CPU-side work in parallel.
+ * Jobs must not touch OpenGL state; anything that needs the GL context has
+ * to be done on the main thread after the parallel work is finished.
+ */
+class CJobPool
+{
+    std::vector<std::thread> mWorkers;
+    std::deque<std::function<void()>> mJobs;
+    std::mutex mMutex;
+    std::condition_variable mJobAvailable;
+    bool mShuttingDown = false;
+
+public:
+    /** NumWorkers of 0 picks one worker per hardware thread, minus one for the calling thread */
+    explicit CJobPool(uint32 NumWorkers = 0);
+    ~CJobPool();
+
+    CJobPool(const CJobPool&) = delete;
+    CJobPool& operator=(const CJobPool&) = delete;
+
+    /** Queue a job to run on a worker thread */
+    template<typename FuncType>
+    auto Submit(FuncType&& Func) -> std::future<std::invoke_result_t<std::decay_t<FuncType>>>
+    {
+        using ResultType = std::invoke_result_t<std::decay_t<FuncType>>;
+        auto pTask = std::make_shared<std::packaged_task<ResultType()>>(std::forward<FuncType>(Func));
+        std::future<ResultType> Future = pTask->get_future();
+        Enqueue([pTask]() { (*pTask)(); });
+        return Future;
+    }
+
+    /**
+     * Run Func(Begin, End) over the range [0, Count) split into chunks of at least MinChunkSize
+     * elements, and block until every chunk is done. The calling thread helps run chunks, so
+     * this is safe to call from inside another job. Small ranges run inline on the caller.
+     */
+    void ParallelFor(size_t Count, size_t MinChunkSize, const std::function<void(size_t Begin, size_t End)>& Func);
+
+    uint32 NumWorkers() const { return static_cast<uint32>(mWorkers.size()); }
+
+    /** Shared pool used by the editor */
+    static CJobPool& Global();
+
+private:
+    void Enqueue(std::function<void()>&& Job);
+    void WorkerMain();
+};
+
+#endif // CJOBPOOL_H
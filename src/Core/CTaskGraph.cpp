@@ -0,0 +1,184 @@
+#include "CTaskGraph.h"
+#include "CJobPool.h"
+#include "IProgressNotifier.h"
+#include <Common/CTimer.h>
+#include <Common/Log.h>
+#include <Common/Macros.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+
+CTaskGraph::TaskID CTaskGraph::AddTask(TString Name, std::function<bool()> Func, std::vector<TaskID> Dependencies)
+{
+    const TaskID ID = static_cast<TaskID>(mTasks.size());
+
+    for (const TaskID Dependency : Dependencies)
+        ASSERT(Dependency < ID);
+
+    STask& rTask = mTasks.emplace_back();
+    rTask.Name = std::move(Name);
+    rTask.Func = std::move(Func);
+    rTask.Dependencies = std::move(Dependencies);
+    return ID;
+}
+
+bool CTaskGraph::Run(CJobPool& rPool, IProgressNotifier *pProgress)
+{
+    enum class EState
+    {
+        Waiting,
+        Running,
+        Done
+    };
+
+    std::vector<EState> States(mTasks.size(), EState::Waiting);
+    std::mutex Mutex;
+    std::condition_variable TaskFinished;
+    std::vector<TaskID> Finished;
+
+    const double RunStartTime = CTimer::GlobalTime();
+    size_t NumDone = 0;
+    bool AllSucceeded = true;
+
+    for (STask& rTask : mTasks)
+    {
+        rTask.Ran = false;
+        rTask.Succeeded = false;
+    }
+
+    while (NumDone < mTasks.size())
+    {
+        // Start or skip every task whose dependencies are done. Skipping one can unblock
+        // others, so keep going until nothing changes.
+        bool Changed = true;
+
+        while (Changed)
+        {
+            Changed = false;
+
+            for (TaskID ID = 0; ID < mTasks.size(); ID++)
+            {
+                if (States[ID] != EState::Waiting)
+                    continue;
+
+                STask& rTask = mTasks[ID];
+                bool Ready = true;
+                bool Skip = false;
+
+                for (const TaskID Dependency : rTask.Dependencies)
+                {
+                    if (States[Dependency] != EState::Done)
+                        Ready = false;
+                    else if (!mTasks[Dependency].Succeeded)
+                        Skip = true;
+                }
+
+                if (!Ready)
+                    continue;
+
+                Changed = true;
+
+                if (Skip)
+                {
+                    States[ID] = EState::Done;
+                    NumDone++;
+                    AllSucceeded = false;
+                    warnf("Skipping %s; a task it depends on failed", *rTask.Name);
+                    continue;
+                }
+
+                States[ID] = EState::Running;
+                rPool.Submit([&, ID]()
+                {
+                    STask& rRunTask = mTasks[ID];
+                    rRunTask.StartTime = CTimer::GlobalTime() - RunStartTime;
+                    const bool Success = rRunTask.Func();
+                    rRunTask.EndTime = CTimer::GlobalTime() - RunStartTime;
+
+                    std::lock_guard Lock(Mutex);
+                    rRunTask.Ran = true;
+                    rRunTask.Succeeded = Success;
+                    Finished.push_back(ID);
+                    TaskFinished.notify_one();
+                });
+            }
+        }
+
+        if (NumDone == mTasks.size())
+            break;
+
+        if (pProgress)
+        {
+            TString Running;
+
+            for (TaskID ID = 0; ID < mTasks.size(); ID++)
+            {
+                if (States[ID] != EState::Running)
+                    continue;
+
+                if (!Running.IsEmpty())
+                    Running += ", ";
+
+                Running += mTasks[ID].Name;
+            }
+
+            pProgress->Report(NumDone, mTasks.size(), Running);
+        }
+
+        // Wait for at least one running task to finish
+        std::vector<TaskID> JustFinished;
+        {
+            std::unique_lock Lock(Mutex);
+            TaskFinished.wait(Lock, [&Finished] { return !Finished.empty(); });
+            JustFinished.swap(Finished);
+        }
+
+        for (const TaskID ID : JustFinished)
+        {
+            States[ID] = EState::Done;
+            NumDone++;
+
+            if (!mTasks[ID].Succeeded)
+            {
+                AllSucceeded = false;
+                errorf("%s failed", *mTasks[ID].Name);
+            }
+        }
+    }
+
+    mTotalTime = CTimer::GlobalTime() - RunStartTime;
+    return AllSucceeded;
+}
+
+void CTaskGraph::LogProfile(const TString& rkTitle) const
+{
+    std::vector<TaskID> Order(mTasks.size());
+    std::iota(Order.begin(), Order.end(), 0);
+    std::stable_sort(Order.begin(), Order.end(), [this](TaskID Left, TaskID Right) {
+        return mTasks[Left].StartTime < mTasks[Right].StartTime;
+    });
+
+    debugf("%s: %.3fms total", *rkTitle, mTotalTime * 1000.0);
+
+    for (const TaskID ID : Order)
+    {
+        const STask& rkTask = mTasks[ID];
+
+        if (!rkTask.Ran)
+        {
+            debugf("\t%-28s skipped", *rkTask.Name);
+            continue;
+        }
+
+        // Time between the last dependency finishing and the task starting is time spent queued on the pool
+        double ReadyTime = 0.0;
+
+        for (const TaskID Dependency : rkTask.Dependencies)
+            ReadyTime = std::max(ReadyTime, mTasks[Dependency].EndTime);
+
+        debugf("\t%-28s %9.3fms  (starts at %.3fms, queued %.3fms)%s", *rkTask.Name,
+               (rkTask.EndTime - rkTask.StartTime) * 1000.0, rkTask.StartTime * 1000.0,
+               std::max(rkTask.StartTime - ReadyTime, 0.0) * 1000.0, rkTask.Succeeded ? "" : " FAILED");
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef CTASKGRAPH_H
+#define CTASKGRAPH_H
+
+#include <Common/BasicTypes.h>
+#include <Common/TString.h>
+#include <functional>
+#include <vector>
+
+class CJobPool;
+class IProgressNotifier;
+
+/**
+ * A set of tasks with dependencies between them, run on the job pool. Each task starts as soon
+ * as every task it depends on has finished, so independent tasks run concurrently. A task that
+ * fails, or depends on one that failed or was skipped, causes its dependents to be skipped.
+ *
+ * Every task's start and end time is recorded for LogProfile.
+ */
+class CTaskGraph
+{
+public:
+    using TaskID = uint32;
+
+    struct STask
+    {
+        TString Name;
+        std::function<bool()> Func;
+        std::vector<TaskID> Dependencies;
+
+        // Filled in by Run; times are relative to the start of the run, in seconds
+        bool Ran = false;
+        bool Succeeded = false;
+        double StartTime = 0.0;
+        double EndTime = 0.0;
+    };
+
+private:
+    std::vector<STask> mTasks;
+    double mTotalTime = 0.0;
+
+public:
+    /** Add a task. Dependencies must have been added already, so the graph can't have cycles. */
+    TaskID AddTask(TString Name, std::function<bool()> Func, std::vector<TaskID> Dependencies = {});
+
+    /** Run every task and block until they're done. Returns whether every task ran and succeeded.
+     *  Progress is reported from the calling thread as tasks finish. */
+    bool Run(CJobPool& rPool, IProgressNotifier *pProgress = nullptr);
+
+    /** Log each task's timing, in the order the tasks started, with the time spent waiting on dependencies */
+    void LogProfile(const TString& rkTitle) const;
+
+    const STask& Task(TaskID ID) const  { return mTasks[ID]; }
+    size_t NumTasks() const             { return mTasks.size(); }
+    double TotalTime() const            { return mTotalTime; }
+};
+
+#endif // CTASKGRAPH_H
@@ -0,0 +1,237 @@
+#include "CTrace.h"
+#include <Common/Log.h>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+std::atomic<CTraceCounter*> CTraceCounter::spFirst{nullptr};
+
+CTraceCounter gResourcesLoadedCounter("Resources loaded");
+CTraceCounter gBytesDecompressedCounter("Bytes decompressed");
+CTraceCounter gDrawCallsCounter("Draw calls");
+CTraceCounter gShaderBindsCounter("Shader binds");
+
+CTraceCounter::CTraceCounter(const char *pkName)
+    : mpkName(pkName)
+    , mpNext(spFirst.load())
+{
+    while (!spFirst.compare_exchange_weak(mpNext, this)) {}
+}
+
+namespace NTrace
+{
+
+std::atomic<bool> gEnabled{false};
+
+namespace
+{
+
+struct SEvent
+{
+    const char *pkName;
+    int64 Time;
+    int64 EndTimeOrValue;   // End time for zones, value for counter samples
+    bool IsCounter;
+};
+
+/**
+ * Events recorded by one thread. Only that thread adds events; the mutex is for readers.
+ * Once the buffer is full it's used as a ring, and NextEvent is the oldest event.
+ */
+struct SThreadEvents
+{
+    uint32 ThreadID;
+    TString Name;
+    std::mutex Mutex;
+    std::vector<SEvent> Events;
+    size_t NextEvent = 0;
+    uint64 NumDropped = 0;
+};
+
+/** Buffers are never freed, so the trace keeps events from threads that have exited */
+std::mutex gThreadsMutex;
+std::vector<std::unique_ptr<SThreadEvents>> gThreads;
+std::atomic<int64> gStartTime{0};
+
+thread_local SThreadEvents *tpThreadEvents = nullptr;
+
+SThreadEvents& ThreadEvents()
+{
+    if (!tpThreadEvents)
+    {
+        std::lock_guard Lock(gThreadsMutex);
+        auto pEvents = std::make_unique<SThreadEvents>();
+        pEvents->ThreadID = static_cast<uint32>(gThreads.size()) + 1;
+        tpThreadEvents = pEvents.get();
+        gThreads.push_back(std::move(pEvents));
+    }
+
+    return *tpThreadEvents;
+}
+
+void AddEvent(const SEvent& rkEvent)
+{
+    SThreadEvents& rEvents = ThreadEvents();
+    std::lock_guard Lock(rEvents.Mutex);
+
+    if (rEvents.Events.size() < gkMaxEventsPerThread)
+    {
+        rEvents.Events.push_back(rkEvent);
+        return;
+    }
+
+    rEvents.Events[rEvents.NextEvent] = rkEvent;
+    rEvents.NextEvent = (rEvents.NextEvent + 1) % gkMaxEventsPerThread;
+    rEvents.NumDropped++;
+}
+
+void WriteEscaped(FILE *pFile, const char *pkString)
+{
+    for (const char *pkChar = pkString; *pkChar; pkChar++)
+    {
+        if (*pkChar == '"' || *pkChar == '\\')
+            std::fputc('\\', pFile);
+
+        std::fputc(*pkChar, pFile);
+    }
+}
+
+}
+
+void SetEnabled(bool Enabled)
+{
+    if (Enabled)
+    {
+        int64 Expected = 0;
+        gStartTime.compare_exchange_strong(Expected, Now());
+    }
+
+    gEnabled = Enabled;
+}
+
+void Clear()
+{
+    std::lock_guard Lock(gThreadsMutex);
+
+    for (auto& pThread : gThreads)
+    {
+        std::lock_guard ThreadLock(pThread->Mutex);
+        pThread->Events.clear();
+        pThread->NextEvent = 0;
+        pThread->NumDropped = 0;
+    }
+
+    gStartTime = (IsEnabled() ? Now() : 0);
+}
+
+void SetThreadName(const TString& rkName)
+{
+    SThreadEvents& rEvents = ThreadEvents();
+    std::lock_guard Lock(rEvents.Mutex);
+    rEvents.Name = rkName;
+}
+
+void RecordZone(const char *pkName, int64 StartTime, int64 EndTime)
+{
+    AddEvent(SEvent{pkName, StartTime, EndTime, false});
+}
+
+void SampleCounters()
+{
+    const int64 Time = Now();
+
+    for (CTraceCounter *pCounter = CTraceCounter::spFirst.load(); pCounter; pCounter = pCounter->mpNext)
+    {
+        // Only sample counters that changed, and only once per change if threads sample at the same time
+        const int64 Value = pCounter->Value();
+
+        if (pCounter->mSampledValue.exchange(Value, std::memory_order_relaxed) != Value)
+            AddEvent(SEvent{pCounter->Name(), Time, Value, true});
+    }
+}
+
+bool WriteChromeTrace(const TString& rkPath)
+{
+    using FILEPtr = std::unique_ptr<FILE, decltype(&std::fclose)>;
+    FILEPtr pFile{std::fopen(*rkPath, "w"), std::fclose};
+
+    if (!pFile)
+    {
+        errorf("Failed to open trace file for writing: %s", *rkPath);
+        return false;
+    }
+
+    // Make sure the trace ends with the latest value of every counter
+    SampleCounters();
+
+    std::lock_guard Lock(gThreadsMutex);
+    const int64 StartTime = gStartTime;
+    uint32 NumWritten = 0;
+    uint64 NumDropped = 0;
+    const char *pkSeparator = "";
+
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", pFile.get());
+
+    for (auto& pThread : gThreads)
+    {
+        std::lock_guard ThreadLock(pThread->Mutex);
+
+        if (!pThread->Name.IsEmpty())
+        {
+            std::fprintf(pFile.get(), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"", pkSeparator, pThread->ThreadID);
+            WriteEscaped(pFile.get(), *pThread->Name);
+            std::fputs("\"}}", pFile.get());
+            pkSeparator = ",\n";
+        }
+
+        // Timestamps are in microseconds. Write the oldest events first in case the buffer wrapped around.
+        const size_t NumEvents = pThread->Events.size();
+        NumDropped += pThread->NumDropped;
+
+        for (size_t EventIdx = 0; EventIdx < NumEvents; EventIdx++)
+        {
+            const SEvent& rkEvent = pThread->Events[(pThread->NextEvent + EventIdx) % NumEvents];
+            std::fprintf(pFile.get(), "%s{\"name\":\"", pkSeparator);
+            WriteEscaped(pFile.get(), rkEvent.pkName);
+
+            if (rkEvent.IsCounter)
+            {
+                std::fprintf(pFile.get(), "\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"args\":{\"value\":%lld}}",
+                             (rkEvent.Time - StartTime) / 1000.0, static_cast<long long>(rkEvent.EndTimeOrValue));
+            }
+            else
+            {
+                std::fprintf(pFile.get(), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                             (rkEvent.Time - StartTime) / 1000.0, (rkEvent.EndTimeOrValue - rkEvent.Time) / 1000.0, pThread->ThreadID);
+            }
+
+            pkSeparator = ",\n";
+            NumWritten++;
+        }
+    }
+
+    std::fputs("\n]}\n", pFile.get());
+    debugf("Wrote %d trace events to %s", static_cast<int>(NumWritten), *rkPath);
+
+    if (NumDropped > 0)
+        warnf("%llu older trace events were overwritten and are missing from the trace", static_cast<unsigned long long>(NumDropped));
+
+    return true;
+}
+
+uint32 NumEvents()
+{
+    std::lock_guard Lock(gThreadsMutex);
+    uint32 NumEvents = 0;
+
+    for (auto& pThread : gThreads)
+    {
+        std::lock_guard ThreadLock(pThread->Mutex);
+        NumEvents += static_cast<uint32>(pThread->Events.size());
+    }
+
+    return NumEvents;
+}
+
+}
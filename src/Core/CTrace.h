@@ -0,0 +1,118 @@
+#ifndef CTRACE_H
+#define CTRACE_H
+
+#include <Common/BasicTypes.h>
+#include <Common/TString.h>
+#include <atomic>
+#include <chrono>
+
+/**
+ * Lightweight instrumentation for profiling offline. Zones mark a named span of time on the calling
+ * thread and nest the same way as the scopes that declare them. Counters keep running totals of
+ * things like resources loaded or draw calls.
+ *
+ * This is cheap enough to leave in release builds. While tracing is off, a zone costs a relaxed atomic
+ * load and a counter costs a relaxed atomic add. While it's on, each zone also reads the clock twice and
+ * appends an event to a per-thread buffer. Each buffer holds up to gkMaxEventsPerThread events; after that
+ * the oldest events are overwritten, so a long session keeps only the most recent part of the trace.
+ * Recorded events can be written out as Chrome trace-event JSON, which opens in chrome://tracing or Perfetto.
+ */
+namespace NTrace
+{
+
+extern std::atomic<bool> gEnabled;
+
+/** Number of events each thread keeps before it starts overwriting its oldest ones */
+constexpr uint32 gkMaxEventsPerThread = 256 * 1024;
+
+inline bool IsEnabled()
+{
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+/** Current time in nanoseconds, on the clock used for event timestamps */
+inline int64 Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/** Start or stop recording events. Events recorded so far are kept until Clear is called. */
+void SetEnabled(bool Enabled);
+
+/** Drop every recorded event */
+void Clear();
+
+/** Name the calling thread in the trace output */
+void SetThreadName(const TString& rkName);
+
+/** Record a zone that ran on the calling thread from StartTime to EndTime. Used by CTraceZone. */
+void RecordZone(const char *pkName, int64 StartTime, int64 EndTime);
+
+/** Record the value of every counter that changed since it was last sampled. Call this once per frame. */
+void SampleCounters();
+
+/** Write every recorded event to a Chrome trace-event JSON file */
+bool WriteChromeTrace(const TString& rkPath);
+
+/** Number of recorded events that are still buffered */
+uint32 NumEvents();
+
+}
+
+/** Records the time from construction to destruction as a zone. Use through TRACE_ZONE. */
+class CTraceZone
+{
+    const char *mpkName;
+    int64 mStartTime;
+
+public:
+    explicit CTraceZone(const char *pkName)
+        : mpkName(pkName)
+        , mStartTime(NTrace::IsEnabled() ? NTrace::Now() : -1)
+    {}
+
+    ~CTraceZone()
+    {
+        if (mStartTime >= 0)
+            NTrace::RecordZone(mpkName, mStartTime, NTrace::Now());
+    }
+
+    CTraceZone(const CTraceZone&) = delete;
+    CTraceZone& operator=(const CTraceZone&) = delete;
+};
+
+/** Trace the rest of the enclosing scope as a zone called Name */
+#define TRACE_ZONE(Name) CTraceZone TraceZone_##Name(#Name)
+
+/**
+ * A running total that's included in the trace. Counters are sampled by NTrace::SampleCounters,
+ * so a counter shows up in the trace as a step graph with a step wherever its value changed.
+ * Counters must have static storage duration.
+ */
+class CTraceCounter
+{
+    const char *mpkName;
+    std::atomic<int64> mValue{0};
+    std::atomic<int64> mSampledValue{0};
+    CTraceCounter *mpNext;
+
+    static std::atomic<CTraceCounter*> spFirst;
+    friend void NTrace::SampleCounters();
+
+public:
+    explicit CTraceCounter(const char *pkName);
+
+    CTraceCounter(const CTraceCounter&) = delete;
+    CTraceCounter& operator=(const CTraceCounter&) = delete;
+
+    void Add(int64 Amount)          { mValue.fetch_add(Amount, std::memory_order_relaxed); }
+    int64 Value() const             { return mValue.load(std::memory_order_relaxed); }
+    const char* Name() const        { return mpkName; }
+};
+
+extern CTraceCounter gResourcesLoadedCounter;
+extern CTraceCounter gBytesDecompressedCounter;
+extern CTraceCounter gDrawCallsCounter;
+extern CTraceCounter gShaderBindsCounter;
+
+#endif // CTRACE_H
@@ -1,4 +1,5 @@
 #include "CompressionUtil.h"
+#include "CTrace.h"
 #include <Common/Common.h>
 
 #if USE_LZOKAY
@@ -99,7 +100,8 @@ namespace CompressionUtil
             return false;
         }
 
-        else return true;
+        gBytesDecompressedCounter.Add(rTotalOut);
+        return true;
     }
 
     bool DecompressLZO(uint8 *pSrc, uint32 SrcLen, uint8 *pDst, uint32 DstLen, uint32& rTotalOut)
@@ -115,6 +117,7 @@ namespace CompressionUtil
             return false;
         }
 
+        gBytesDecompressedCounter.Add(rTotalOut);
         return true;
 #else
         lzo_init();
@@ -128,6 +131,7 @@ namespace CompressionUtil
             return false;
         }
 
+        gBytesDecompressedCounter.Add(rTotalOut);
         return true;
 #endif
     }
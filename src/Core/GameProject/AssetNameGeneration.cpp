@@ -301,7 +301,7 @@ void GenerateAssetNames(CGameProject *pProj)
 
                             if (pScanProperty)
                             {
-                                CAssetID ScanID = pScanProperty->Value(pInst->PropertyData());
+                                CAssetID ScanID = pScanProperty->Value(pInst->ReadOnlyPropertyData());
                                 CResourceEntry *pEntry = pStore->FindEntry(ScanID);
 
                                 if (pEntry && !pEntry->IsNamed())
@@ -317,7 +317,7 @@ void GenerateAssetNames(CGameProject *pProj)
                                     if (pScan)
                                     {
                                         CAssetID StringID = pScan->ScanStringPropertyRef();
-                                        CResourceEntry* pStringEntry = gpResourceStore->FindEntry(StringID);
+                                        CResourceEntry* pStringEntry = ActiveResourceStore()->FindEntry(StringID);
 
                                         if (pStringEntry)
                                         {
@@ -341,7 +341,7 @@ void GenerateAssetNames(CGameProject *pProj)
 
                             if (pStringProperty)
                             {
-                                CAssetID StringID = pStringProperty->Value(pInst->PropertyData());
+                                CAssetID StringID = pStringProperty->Value(pInst->ReadOnlyPropertyData());
                                 CResourceEntry *pEntry = pStore->FindEntry(StringID);
 
                                 if (pEntry && !pEntry->IsNamed())
@@ -367,7 +367,7 @@ void GenerateAssetNames(CGameProject *pProj)
 
                         if (pModelProperty)
                         {
-                            CAssetID ModelID = pModelProperty->Value(pInst->PropertyData());
+                            CAssetID ModelID = pModelProperty->Value(pInst->ReadOnlyPropertyData());
                             CResourceEntry *pEntry = pStore->FindEntry(ModelID);
 
                             if (pEntry && !pEntry->IsCategorized())
@@ -396,7 +396,7 @@ void GenerateAssetNames(CGameProject *pProj)
             if (pPortalEntry)
                 ApplyGeneratedName(pPortalEntry, WorldMasterDir, AreaName);
 
-            pStore->DestroyUnreferencedResources();
+            pStore->ReleaseUnreferencedResources();
 #endif
         }
     }
@@ -442,7 +442,7 @@ void GenerateAssetNames(CGameProject *pProj)
             }
         }
 
-        pStore->DestroyUnreferencedResources();
+        pStore->ReleaseUnreferencedResources();
     }
 #endif
 
@@ -518,7 +518,7 @@ void GenerateAssetNames(CGameProject *pProj)
 
             if (pProj->Game() >= EGame::CorruptionProto && pProj->Game() <= EGame::Corruption && pkChar->ID == 0)
             {
-                CResourceEntry *pAnimDataEntry = gpResourceStore->FindEntry( pkChar->AnimDataID );
+                CResourceEntry *pAnimDataEntry = ActiveResourceStore()->FindEntry( pkChar->AnimDataID );
 
                 if (pAnimDataEntry)
                 {
@@ -622,7 +622,7 @@ void GenerateAssetNames(CGameProject *pProj)
         if (ScanName.IsEmpty())
         {
             const CAssetID StringID = pScan->ScanStringPropertyRef().Get();
-            if (const auto* pString = static_cast<CStringTable*>(gpResourceStore->LoadResource(StringID, EResourceType::StringTable)))
+            if (const auto* pString = static_cast<CStringTable*>(ActiveResourceStore()->LoadResource(StringID, EResourceType::StringTable)))
                 ScanName = pString->Entry()->Name();
         }
 
@@ -0,0 +1,672 @@
+#include "CAsyncResourceLoader.h"
+#include "CDependencyTree.h"
+#include "CResourceEntry.h"
+#include "CResourceStore.h"
+#include "Core/CJobPool.h"
+#include "Core/CTrace.h"
+#include "Core/Resource/CResource.h"
+#include <Common/CTimer.h>
+#include <Common/FileUtil.h>
+#include <Common/Log.h>
+#include <Common/Macros.h>
+#include <algorithm>
+#include <set>
+
+/** Most dependency data a single request reads ahead; anything past this is loaded from disk as usual */
+constexpr uint64 gkMaxDependencyReadBytes = 64 * 1024 * 1024;
+
+struct CResourceLoadRequest::SRead
+{
+    enum class EState
+    {
+        Queued,
+        Reading,
+        Done
+    };
+
+    CResourceEntry *pEntry = nullptr;
+    TString RawPath;
+    TString CookedPath;
+
+    // Number of pending requests that use this read. Main thread only.
+    uint32 NumUsers = 0;
+
+    // Guarded by the loader's mutex. Data and HasRawVersion are written by
+    // the thread doing the read and only touched elsewhere once State is Done.
+    EState State = EState::Queued;
+    std::pair<int, uint32> QueueKey;
+    std::vector<uint8> Data;
+    bool HasRawVersion = false;
+};
+
+struct CResourceLoadRequest::SParse
+{
+    enum class EState
+    {
+        Queued,
+        Parsing,
+        Done
+    };
+
+    CResourceEntry *pEntry = nullptr;
+
+    // Guarded by the loader's mutex. pResource is written by the thread doing
+    // the parse and only touched elsewhere once State is Done. It keeps the
+    // resource loaded until the request takes it over on the main thread.
+    EState State = EState::Queued;
+    TResPtr<CResource> pResource;
+};
+
+// ************ CResourceLoadRequest ************
+CResourceLoadRequest::CResourceLoadRequest(CAsyncResourceLoader *pLoader, CResourceEntry *pEntry, EResourceLoadPriority Priority, uint32 Sequence)
+    : mpLoader(pLoader)
+    , mpEntry(pEntry)
+    , mPriority(Priority)
+    , mSequence(Sequence)
+{
+}
+
+CResource* CResourceLoadRequest::Wait()
+{
+    if (!mIsComplete)
+        mpLoader->Complete(*this);
+
+    return mpResource;
+}
+
+void CResourceLoadRequest::RaisePriority(EResourceLoadPriority Priority)
+{
+    if (mIsComplete || Priority <= mPriority)
+        return;
+
+    mPriority = Priority;
+
+    for (const auto& pRead : mReads)
+        mpLoader->SetReadPriority(*pRead, Priority);
+}
+
+void CResourceLoadRequest::OnComplete(std::function<void(CResource*)> Func)
+{
+    if (mIsComplete)
+        Func(mpResource);
+    else
+        mCallbacks.push_back(std::move(Func));
+}
+
+// ************ CAsyncResourceLoader ************
+CAsyncResourceLoader::CAsyncResourceLoader(CResourceStore *pStore)
+    : mpStore(pStore)
+{
+}
+
+CAsyncResourceLoader::~CAsyncResourceLoader()
+{
+    CancelAll();
+}
+
+TResourceLoadHandle CAsyncResourceLoader::Load(CResourceEntry *pEntry, EResourceLoadPriority Priority)
+{
+    ASSERT(pEntry && pEntry->ResourceStore() == mpStore);
+    auto pRequest = std::make_shared<CResourceLoadRequest>(this, pEntry, Priority, mNextSequence++);
+
+    if (pEntry->IsLoaded())
+    {
+        pRequest->mpResource = pEntry->Load();
+        pRequest->mIsComplete = true;
+        return pRequest;
+    }
+
+    // If there's already a pending request for this entry, share its reads
+    pRequest->mReads.push_back(QueueRead(pEntry, Priority));
+
+    // Read ahead everything in the cached dependency tree that isn't loaded yet
+    std::set<CAssetID> Visited { pEntry->ID() };
+    std::vector<CResourceEntry*> Stack { pEntry };
+    uint64 DependencyBytes = 0;
+
+    while (!Stack.empty() && DependencyBytes < gkMaxDependencyReadBytes)
+    {
+        CResourceEntry *pCurrent = Stack.back();
+        Stack.pop_back();
+
+        if (!pCurrent->Dependencies())
+            continue;
+
+        std::set<CAssetID> References;
+        pCurrent->Dependencies()->GetAllResourceReferences(References);
+
+        for (const CAssetID& rkID : References)
+        {
+            if (!Visited.insert(rkID).second)
+                continue;
+
+            CResourceEntry *pDependency = mpStore->FindEntry(rkID);
+
+            if (pDependency && !pDependency->IsLoaded())
+            {
+                pRequest->mReads.push_back(QueueRead(pDependency, Priority));
+                Stack.push_back(pDependency);
+                DependencyBytes += pDependency->Size();
+            }
+        }
+    }
+
+    mRequests.push_back(pRequest);
+    return pRequest;
+}
+
+void CAsyncResourceLoader::Update(double TimeBudget)
+{
+    // Resume parsing if the store paused it to unload resources
+    ResumeParsing();
+
+    if (mRequests.empty())
+        return;
+
+    const double StartTime = CTimer::GlobalTime();
+
+    // Take the list so requests made from completion callbacks don't invalidate it
+    std::vector<TResourceLoadHandle> Pending = std::move(mRequests);
+    mRequests.clear();
+
+    std::stable_sort(Pending.begin(), Pending.end(), [](const TResourceLoadHandle& rkLeft, const TResourceLoadHandle& rkRight) {
+        return rkLeft->mPriority > rkRight->mPriority;
+    });
+
+    std::vector<TResourceLoadHandle> Remaining;
+    Remaining.reserve(Pending.size());
+
+    for (const TResourceLoadHandle& pRequest : Pending)
+    {
+        if (pRequest->mIsComplete)
+            continue;
+
+        const bool IsImmediate = (pRequest->mPriority == EResourceLoadPriority::Immediate);
+
+        if (!pRequest->mpParse)
+        {
+            // Nobody is holding the handle or waiting on a callback anymore
+            if (pRequest.use_count() == 1 && pRequest->mCallbacks.empty())
+            {
+                ReleaseReads(*pRequest);
+                continue;
+            }
+
+            if (!IsRequestReady(*pRequest))
+            {
+                Remaining.push_back(pRequest);
+                continue;
+            }
+
+            // Immediate requests are needed for the next frame, so they're parsed right here instead
+            if (!IsImmediate)
+                QueueParse(*pRequest);
+        }
+
+        // Parsing is done on the job pool, so the budget only covers completion callbacks
+        if (IsImmediate)
+            Complete(*pRequest);
+        else if (CTimer::GlobalTime() - StartTime < TimeBudget && IsParseFinished(*pRequest->mpParse))
+            Finish(*pRequest);
+        else
+            Remaining.push_back(pRequest);
+    }
+
+    Remaining.insert(Remaining.end(), mRequests.begin(), mRequests.end());
+    mRequests = std::move(Remaining);
+
+    // Drop data from finished reads that no request needs anymore
+    std::lock_guard ReadsLock(mReadsMutex);
+
+    for (auto Iter = mReads.begin(); Iter != mReads.end(); )
+    {
+        if (Iter->second->NumUsers == 0 && IsReadFinished(*Iter->second))
+            Iter = mReads.erase(Iter);
+        else
+            ++Iter;
+    }
+}
+
+void CAsyncResourceLoader::PauseParsing()
+{
+    std::unique_lock Lock(mMutex);
+    mIsParsingPaused = true;
+    mJobProgress.wait(Lock, [this] { return !mIsParseJobRunning; });
+}
+
+bool CAsyncResourceLoader::IsParsing()
+{
+    std::unique_lock Lock(mMutex);
+    return mIsParseJobRunning;
+}
+
+void CAsyncResourceLoader::CancelAll()
+{
+    for (const TResourceLoadHandle& pRequest : mRequests)
+    {
+        CancelParse(*pRequest);
+        ReleaseReads(*pRequest);
+    }
+
+    mRequests.clear();
+
+    {
+        std::unique_lock Lock(mMutex);
+        mReadQueue.clear();
+        mParseQueue.clear();
+        mJobProgress.wait(Lock, [this] { return mNumReadJobs == 0 && !mIsParseJobRunning; });
+    }
+
+    std::lock_guard ReadsLock(mReadsMutex);
+    mReads.clear();
+}
+
+void CAsyncResourceLoader::CancelEntry(CResourceEntry *pEntry)
+{
+    // A running parse could be loading the entry as a dependency
+    PauseParsing();
+
+    for (auto Iter = mRequests.begin(); Iter != mRequests.end(); )
+    {
+        CResourceLoadRequest& rRequest = **Iter;
+
+        if (rRequest.mpEntry != pEntry)
+        {
+            ++Iter;
+            continue;
+        }
+
+        CancelParse(rRequest);
+        ReleaseReads(rRequest);
+        rRequest.mIsComplete = true;
+
+        for (const auto& rkCallback : rRequest.mCallbacks)
+            rkCallback(nullptr);
+
+        rRequest.mCallbacks.clear();
+        Iter = mRequests.erase(Iter);
+    }
+
+    // Other requests may still list the entry as a dependency; make sure nothing reads it from here on
+    const auto Find = mReads.find(pEntry);
+
+    if (Find != mReads.end())
+    {
+        SRead& rRead = *Find->second;
+
+        {
+            std::unique_lock Lock(mMutex);
+
+            if (rRead.State == SRead::EState::Queued)
+            {
+                const auto Range = mReadQueue.equal_range(rRead.QueueKey);
+                const auto QueueIter = std::find_if(Range.first, Range.second, [&rRead](const auto& rkPair) { return rkPair.second.get() == &rRead; });
+
+                if (QueueIter != Range.second)
+                    mReadQueue.erase(QueueIter);
+
+                rRead.State = SRead::EState::Done;
+            }
+
+            mJobProgress.wait(Lock, [&rRead] { return rRead.State == SRead::EState::Done; });
+            rRead.Data.clear();
+            rRead.pEntry = nullptr;
+        }
+
+        std::lock_guard ReadsLock(mReadsMutex);
+        mReads.erase(Find);
+    }
+}
+
+bool CAsyncResourceLoader::TakeCookedData(CResourceEntry *pEntry, std::vector<uint8>& rOut)
+{
+    std::shared_ptr<SRead> pRead;
+    {
+        std::lock_guard ReadsLock(mReadsMutex);
+        const auto Find = mReads.find(pEntry);
+
+        if (Find == mReads.end())
+            return false;
+
+        pRead = Find->second;
+    }
+
+    SRead& rRead = *pRead;
+    std::unique_lock Lock(mMutex);
+
+    if (rRead.State != SRead::EState::Done || rRead.HasRawVersion || rRead.Data.empty())
+        return false;
+
+    rOut = std::move(rRead.Data);
+    rRead.Data.clear();
+    return true;
+}
+
+std::shared_ptr<CAsyncResourceLoader::SRead> CAsyncResourceLoader::QueueRead(CResourceEntry *pEntry, EResourceLoadPriority Priority)
+{
+    const auto Find = mReads.find(pEntry);
+
+    if (Find != mReads.end())
+    {
+        SetReadPriority(*Find->second, Priority);
+        Find->second->NumUsers++;
+        return Find->second;
+    }
+
+    auto pRead = std::make_shared<SRead>();
+    pRead->pEntry = pEntry;
+    pRead->RawPath = pEntry->RawAssetPath();
+    pRead->CookedPath = pEntry->CookedAssetPath();
+    pRead->NumUsers = 1;
+    {
+        std::lock_guard ReadsLock(mReadsMutex);
+        mReads.emplace(pEntry, pRead);
+    }
+
+    std::unique_lock Lock(mMutex);
+    pRead->QueueKey = { -static_cast<int>(Priority), mNextSequence++ };
+    mReadQueue.emplace(pRead->QueueKey, pRead);
+
+    // I/O bound, so a few jobs are enough; more would just fight over the disk
+    const uint32 MaxReadJobs = std::clamp(CJobPool::Global().NumWorkers(), 1u, 4u);
+
+    if (mNumReadJobs < MaxReadJobs)
+    {
+        mNumReadJobs++;
+        CJobPool::Global().Submit([this] { ReadJob(); });
+    }
+
+    return pRead;
+}
+
+void CAsyncResourceLoader::ReleaseReads(CResourceLoadRequest& rRequest)
+{
+    for (const auto& pRead : rRequest.mReads)
+    {
+        if (--pRead->NumUsers > 0)
+            continue;
+
+        bool IsReading = false;
+
+        {
+            std::unique_lock Lock(mMutex);
+
+            if (pRead->State == SRead::EState::Queued)
+            {
+                const auto Range = mReadQueue.equal_range(pRead->QueueKey);
+                const auto QueueIter = std::find_if(Range.first, Range.second, [&pRead](const auto& rkPair) { return rkPair.second == pRead; });
+
+                if (QueueIter != Range.second)
+                    mReadQueue.erase(QueueIter);
+            }
+
+            IsReading = (pRead->State == SRead::EState::Reading);
+        }
+
+        // Reads that are still running are dropped by Update once they finish
+        const auto Find = mReads.find(pRead->pEntry);
+
+        if (!IsReading && Find != mReads.end() && Find->second == pRead)
+        {
+            std::lock_guard ReadsLock(mReadsMutex);
+            mReads.erase(Find);
+        }
+    }
+
+    rRequest.mReads.clear();
+}
+
+void CAsyncResourceLoader::SetReadPriority(SRead& rRead, EResourceLoadPriority Priority)
+{
+    std::unique_lock Lock(mMutex);
+    const int Key = -static_cast<int>(Priority);
+
+    if (rRead.State != SRead::EState::Queued || Key >= rRead.QueueKey.first)
+        return;
+
+    const auto Range = mReadQueue.equal_range(rRead.QueueKey);
+    const auto QueueIter = std::find_if(Range.first, Range.second, [&rRead](const auto& rkPair) { return rkPair.second.get() == &rRead; });
+
+    if (QueueIter == Range.second)
+        return;
+
+    std::shared_ptr<SRead> pRead = QueueIter->second;
+    mReadQueue.erase(QueueIter);
+    rRead.QueueKey.first = Key;
+    mReadQueue.emplace(rRead.QueueKey, std::move(pRead));
+}
+
+bool CAsyncResourceLoader::IsReadFinished(const SRead& rkRead)
+{
+    std::unique_lock Lock(mMutex);
+    return rkRead.State == SRead::EState::Done;
+}
+
+bool CAsyncResourceLoader::IsRequestReady(const CResourceLoadRequest& rkRequest)
+{
+    // Wait for the dependencies too; otherwise the loader would read them from disk itself
+    return std::all_of(rkRequest.mReads.begin(), rkRequest.mReads.end(), [this](const auto& pRead) {
+        return IsReadFinished(*pRead);
+    });
+}
+
+void CAsyncResourceLoader::ReadNow(SRead& rRead)
+{
+    std::unique_lock Lock(mMutex);
+
+    if (rRead.State == SRead::EState::Queued)
+    {
+        const auto Range = mReadQueue.equal_range(rRead.QueueKey);
+        const auto QueueIter = std::find_if(Range.first, Range.second, [&rRead](const auto& rkPair) { return rkPair.second.get() == &rRead; });
+
+        if (QueueIter != Range.second)
+            mReadQueue.erase(QueueIter);
+
+        rRead.State = SRead::EState::Reading;
+        Lock.unlock();
+        ReadFile(rRead);
+        Lock.lock();
+        rRead.State = SRead::EState::Done;
+        mJobProgress.notify_all();
+    }
+    else
+    {
+        mJobProgress.wait(Lock, [&rRead] { return rRead.State == SRead::EState::Done; });
+    }
+}
+
+void CAsyncResourceLoader::QueueParse(CResourceLoadRequest& rRequest)
+{
+    ASSERT(!rRequest.mpParse);
+    rRequest.mpParse = std::make_shared<SParse>();
+    rRequest.mpParse->pEntry = rRequest.mpEntry;
+
+    std::unique_lock Lock(mMutex);
+    mParseQueue.push_back(rRequest.mpParse);
+    StartParseJob();
+}
+
+void CAsyncResourceLoader::ResumeParsing()
+{
+    std::unique_lock Lock(mMutex);
+    mIsParsingPaused = false;
+    StartParseJob();
+}
+
+void CAsyncResourceLoader::StartParseJob()
+{
+    // Caller must hold mMutex
+    if (!mIsParseJobRunning && !mIsParsingPaused && !mParseQueue.empty())
+    {
+        mIsParseJobRunning = true;
+        CJobPool::Global().Submit([this] { ParseJob(); });
+    }
+}
+
+bool CAsyncResourceLoader::IsParseFinished(const SParse& rkParse)
+{
+    std::unique_lock Lock(mMutex);
+    return rkParse.State == SParse::EState::Done;
+}
+
+void CAsyncResourceLoader::CancelParse(CResourceLoadRequest& rRequest)
+{
+    if (!rRequest.mpParse)
+        return;
+
+    {
+        std::unique_lock Lock(mMutex);
+        SParse& rParse = *rRequest.mpParse;
+
+        if (rParse.State == SParse::EState::Queued)
+        {
+            const auto QueueIter = std::find(mParseQueue.begin(), mParseQueue.end(), rRequest.mpParse);
+
+            if (QueueIter != mParseQueue.end())
+                mParseQueue.erase(QueueIter);
+
+            rParse.State = SParse::EState::Done;
+        }
+
+        mJobProgress.wait(Lock, [&rParse] { return rParse.State == SParse::EState::Done; });
+    }
+
+    rRequest.mpParse.reset();
+}
+
+void CAsyncResourceLoader::Complete(CResourceLoadRequest& rRequest)
+{
+    ASSERT(!rRequest.mIsComplete);
+
+    // Only one parse can run at a time, so stop the parse job before parsing on this thread.
+    // If the job had already started on this request, this also waits for it to finish.
+    bool WasPaused;
+    {
+        std::unique_lock Lock(mMutex);
+        WasPaused = mIsParsingPaused;
+    }
+    PauseParsing();
+
+    if (!rRequest.mpParse)
+    {
+        // Do our own read here instead of waiting for a read job to get to it.
+        // Dependencies that haven't been read yet are loaded from disk as usual.
+        if (!rRequest.mReads.empty())
+            ReadNow(*rRequest.mReads.front());
+
+        rRequest.mpParse = std::make_shared<SParse>();
+        rRequest.mpParse->pEntry = rRequest.mpEntry;
+        ParseResource(*rRequest.mpParse);
+        rRequest.mpParse->State = SParse::EState::Done;
+    }
+    else
+    {
+        std::unique_lock Lock(mMutex);
+        SParse& rParse = *rRequest.mpParse;
+
+        // The parse job is stopped, so the parse is either still queued or already done.
+        // Do it here instead of waiting for the parse job to get to it.
+        if (rParse.State == SParse::EState::Queued)
+        {
+            const auto QueueIter = std::find(mParseQueue.begin(), mParseQueue.end(), rRequest.mpParse);
+
+            if (QueueIter != mParseQueue.end())
+                mParseQueue.erase(QueueIter);
+
+            rParse.State = SParse::EState::Parsing;
+            Lock.unlock();
+            ParseResource(rParse);
+            Lock.lock();
+            rParse.State = SParse::EState::Done;
+            mJobProgress.notify_all();
+        }
+
+        ASSERT(rParse.State == SParse::EState::Done);
+    }
+
+    // Let the parse job carry on with the rest of the queue, unless parsing was already paused
+    if (!WasPaused)
+        ResumeParsing();
+
+    Finish(rRequest);
+}
+
+void CAsyncResourceLoader::Finish(CResourceLoadRequest& rRequest)
+{
+    ASSERT(!rRequest.mIsComplete && rRequest.mpParse);
+
+    rRequest.mpResource = rRequest.mpParse->pResource;
+    rRequest.mpParse.reset();
+    rRequest.mIsComplete = true;
+    ReleaseReads(rRequest);
+
+    if (!rRequest.mpResource)
+        errorf("Asynchronous load failed: %s", *rRequest.mpEntry->CookedAssetPath(true));
+
+    const auto Callbacks = std::move(rRequest.mCallbacks);
+    rRequest.mCallbacks.clear();
+
+    for (const auto& rkCallback : Callbacks)
+        rkCallback(rRequest.mpResource);
+}
+
+void CAsyncResourceLoader::ReadJob()
+{
+    std::unique_lock Lock(mMutex);
+
+    while (!mReadQueue.empty())
+    {
+        std::shared_ptr<SRead> pRead = mReadQueue.begin()->second;
+        mReadQueue.erase(mReadQueue.begin());
+        pRead->State = SRead::EState::Reading;
+
+        Lock.unlock();
+        ReadFile(*pRead);
+        Lock.lock();
+
+        pRead->State = SRead::EState::Done;
+        mJobProgress.notify_all();
+    }
+
+    mNumReadJobs--;
+    mJobProgress.notify_all();
+}
+
+void CAsyncResourceLoader::ParseJob()
+{
+    std::unique_lock Lock(mMutex);
+
+    while (!mParseQueue.empty() && !mIsParsingPaused)
+    {
+        std::shared_ptr<SParse> pParse = mParseQueue.front();
+        mParseQueue.pop_front();
+        pParse->State = SParse::EState::Parsing;
+
+        Lock.unlock();
+        ParseResource(*pParse);
+        Lock.lock();
+
+        pParse->State = SParse::EState::Done;
+        mJobProgress.notify_all();
+    }
+
+    mIsParseJobRunning = false;
+    mJobProgress.notify_all();
+}
+
+void CAsyncResourceLoader::ParseResource(SParse& rParse)
+{
+    TRACE_ZONE(AsyncParseResource);
+
+    // Dependencies the loader asks for pick up the data that was read ahead through TakeCookedData
+    rParse.pResource = rParse.pEntry->Load();
+}
+
+void CAsyncResourceLoader::ReadFile(SRead& rRead)
+{
+    // Raw resources are read with the XML reader when they are parsed, so there's nothing to read ahead
+    rRead.HasRawVersion = FileUtil::Exists(rRead.RawPath);
+
+    if (!rRead.HasRawVersion && !FileUtil::LoadFileToBuffer(rRead.CookedPath, rRead.Data))
+        rRead.Data.clear();
+}
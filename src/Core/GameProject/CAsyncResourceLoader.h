@@ -0,0 +1,168 @@
+#ifndef CASYNCRESOURCELOADER_H
+#define CASYNCRESOURCELOADER_H
+
+#include "Core/Resource/TResPtr.h"
+#include <Common/BasicTypes.h>
+#include <Common/TString.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class CAsyncResourceLoader;
+class CResource;
+class CResourceEntry;
+class CResourceStore;
+
+/** Priority of an asynchronous resource load. Higher priority loads are read and finished first. */
+enum class EResourceLoadPriority
+{
+    Prefetch,       // Speculative loads, e.g. assets the user is likely to open next
+    Normal,
+    Immediate,      // Needed for the next frame; finished regardless of the per-tick time budget
+};
+
+/**
+ * An asynchronous resource load. Returned by CResourceStore::LoadResourceAsync and only used on
+ * the main thread. Once the load is finished, the request keeps a reference to the resource, so
+ * it stays loaded for as long as the handle is held.
+ */
+class CResourceLoadRequest
+{
+    friend class CAsyncResourceLoader;
+    struct SRead;
+    struct SParse;
+
+    CAsyncResourceLoader *mpLoader;
+    CResourceEntry *mpEntry;
+    EResourceLoadPriority mPriority;
+    uint32 mSequence;
+    bool mIsComplete = false;
+    TResPtr<CResource> mpResource;
+    std::vector<std::function<void(CResource*)>> mCallbacks;
+
+    /** Reads of the resource and its dependencies that this request is waiting on or holding data for */
+    std::vector<std::shared_ptr<SRead>> mReads;
+
+    /** Parse of the resource on the job pool, once everything it reads ahead is ready */
+    std::shared_ptr<SParse> mpParse;
+
+public:
+    CResourceLoadRequest(CAsyncResourceLoader *pLoader, CResourceEntry *pEntry, EResourceLoadPriority Priority, uint32 Sequence);
+
+    /** Finish the load right away on the calling thread, blocking until the file has been read */
+    CResource* Wait();
+
+    /** Bump the priority of a load that hasn't finished yet. Priorities are never lowered. */
+    void RaisePriority(EResourceLoadPriority Priority);
+
+    /** Call Func on the main thread once the load is finished; immediately if it already is */
+    void OnComplete(std::function<void(CResource*)> Func);
+
+    bool IsComplete() const                         { return mIsComplete; }
+    CResource* Resource() const                     { return mpResource; }
+    CResourceEntry* Entry() const                   { return mpEntry; }
+    EResourceLoadPriority Priority() const          { return mPriority; }
+};
+using TResourceLoadHandle = std::shared_ptr<CResourceLoadRequest>;
+
+/**
+ * Loads resources in the background for a resource store.
+ *
+ * First the cooked data for the requested resource and every resource in its cached dependency tree
+ * is read in on the job pool, highest priority first. Once all of it is ready, Update() queues the
+ * request to be parsed on the job pool too; any dependencies the loader asks for are loaded from the
+ * data that was read ahead instead of from disk. Update() then runs the completion callbacks of parsed
+ * requests on the main thread, within a time budget. GPU buffers are created on first use, which is
+ * always on the main thread.
+ *
+ * Only one parse runs at a time, since two parses at once could each hold the load latch of a
+ * resource the other one needs. The parse job handles requests in the order they were queued, and
+ * requests that are finished on the main thread right away pause the job while they parse. Unloading
+ * must not overlap a parse either, so the store pauses parsing before it unloads anything; the next
+ * Update() resumes it.
+ *
+ * Resources with a raw version are read with the XML reader when they're parsed, since that
+ * can't read from memory.
+ */
+class CAsyncResourceLoader
+{
+    friend class CResourceLoadRequest;
+    using SRead = CResourceLoadRequest::SRead;
+    using SParse = CResourceLoadRequest::SParse;
+
+    CResourceStore *mpStore;
+
+    /** Pending requests, in the order they were made. Main thread only. */
+    std::vector<TResourceLoadHandle> mRequests;
+
+    /** Reads for each entry that is being read or has data waiting to be used. Only changed on the
+     *  main thread, under mReadsMutex since TakeCookedData can be called by loads on any thread. */
+    std::map<CResourceEntry*, std::shared_ptr<SRead>> mReads;
+    std::mutex mReadsMutex;
+    uint32 mNextSequence = 0;
+
+    /** Everything below is shared with the read jobs */
+    std::mutex mMutex;
+    std::condition_variable mJobProgress;
+    std::multimap<std::pair<int, uint32>, std::shared_ptr<SRead>> mReadQueue;
+    uint32 mNumReadJobs = 0;
+    std::deque<std::shared_ptr<SParse>> mParseQueue;
+    bool mIsParseJobRunning = false;
+    bool mIsParsingPaused = false;
+
+public:
+    explicit CAsyncResourceLoader(CResourceStore *pStore);
+    ~CAsyncResourceLoader();
+
+    CAsyncResourceLoader(const CAsyncResourceLoader&) = delete;
+    CAsyncResourceLoader& operator=(const CAsyncResourceLoader&) = delete;
+
+    /** Start loading a resource. Requests for resources that are already loaded are complete right away. */
+    TResourceLoadHandle Load(CResourceEntry *pEntry, EResourceLoadPriority Priority);
+
+    /** Queue parses for requests whose data is ready, and finish parsed requests, highest priority first,
+     *  for up to TimeBudget seconds. Also resumes parsing if it was paused. */
+    void Update(double TimeBudget);
+
+    /** Stop starting new parses and wait for the running one. Called before the store unloads resources. */
+    void PauseParsing();
+
+    /** Whether a parse is running on the job pool; PauseParsing would have to wait for it */
+    bool IsParsing();
+
+    /** Drop every pending request and wait for running reads. Called before the store clears its entries. */
+    void CancelAll();
+
+    /** Drop requests and reads for an entry that is about to be deleted. Its requests finish with no resource. */
+    void CancelEntry(CResourceEntry *pEntry);
+
+    /** If the cooked data for pEntry has already been read, move it to rOut. Used by CResourceEntry::Load. */
+    bool TakeCookedData(CResourceEntry *pEntry, std::vector<uint8>& rOut);
+
+    uint32 NumPendingRequests() const   { return mRequests.size(); }
+
+private:
+    std::shared_ptr<SRead> QueueRead(CResourceEntry *pEntry, EResourceLoadPriority Priority);
+    void ReleaseReads(CResourceLoadRequest& rRequest);
+    void SetReadPriority(SRead& rRead, EResourceLoadPriority Priority);
+    bool IsReadFinished(const SRead& rkRead);
+    bool IsRequestReady(const CResourceLoadRequest& rkRequest);
+    void ReadNow(SRead& rRead);
+    void QueueParse(CResourceLoadRequest& rRequest);
+    void ResumeParsing();
+    void StartParseJob();
+    bool IsParseFinished(const SParse& rkParse);
+    void CancelParse(CResourceLoadRequest& rRequest);
+    void Complete(CResourceLoadRequest& rRequest);
+    void Finish(CResourceLoadRequest& rRequest);
+    void ReadJob();
+    void ParseJob();
+    static void ReadFile(SRead& rRead);
+    static void ParseResource(SParse& rParse);
+};
+
+#endif // CASYNCRESOURCELOADER_H
@@ -0,0 +1,233 @@
+#include "CDependencyGraph.h"
+#include "CDependencyTree.h"
+#include "CResourceIterator.h"
+#include <Common/Log.h>
+
+CDependencyGraph::CDependencyGraph(CResourceStore *pStore)
+    : mGame(pStore->Game())
+{
+    // Assign node indices
+    for (CResourceIterator It(pStore); It; ++It)
+    {
+        mIndexMap.emplace(It->ID(), static_cast<uint32>(mEntries.size()));
+        mEntries.push_back(*It);
+        mTypes.push_back(It->ResourceType());
+    }
+
+    // Flatten each dependency tree into an op list
+    mFirstOp.resize(mEntries.size());
+    mNumOps.resize(mEntries.size());
+
+    for (uint32 Node = 0; Node < mEntries.size(); Node++)
+    {
+        mFirstOp[Node] = mOps.size();
+        CompileNode(mEntries[Node]->Dependencies());
+        mNumOps[Node] = mOps.size() - mFirstOp[Node];
+    }
+
+    FindContextDependentNodes();
+    BuildClosures();
+}
+
+uint32 CDependencyGraph::NodeIndex(const CAssetID& rkID) const
+{
+    const auto Find = mIndexMap.find(rkID);
+    return (Find != mIndexMap.cend() ? Find->second : UINT32_MAX);
+}
+
+bool CDependencyGraph::IsValidPackageDependency(uint32 Parent, uint32 Child) const
+{
+    // Dependency groups only list the assets that need to be loaded together; they don't pull anything into the package
+    if (Parent != UINT32_MAX && mTypes[Parent] == EResourceType::DependencyGroup)
+        return false;
+
+    const EResourceType ResType = mTypes[Child];
+
+    return  ResType != EResourceType::Midi &&
+           (ResType != EResourceType::AudioGroup || mGame >= EGame::EchoesDemo) &&
+           (ResType != EResourceType::World || Parent == UINT32_MAX) &&
+           (ResType != EResourceType::Area || Parent == UINT32_MAX || mTypes[Parent] == EResourceType::World);
+}
+
+// ************ PRIVATE ************
+void CDependencyGraph::CompileNode(IDependencyNode *pNode)
+{
+    if (!pNode)
+        return;
+
+    const EDependencyNodeType Type = pNode->Type();
+
+    if (Type == EDependencyNodeType::Resource || Type == EDependencyNodeType::ScriptProperty || Type == EDependencyNodeType::CharacterProperty ||
+        Type == EDependencyNodeType::AnimEvent)
+    {
+        const auto *pDep = static_cast<CResourceDependency*>(pNode);
+        const uint32 Target = NodeIndex(pDep->ID());
+
+        if (Target == UINT32_MAX)
+            return;
+
+        if (Type == EDependencyNodeType::AnimEvent)
+            mOps.push_back(SDependencyOp{ EDependencyOp::AnimEvent, Target, static_cast<CAnimEventDependency*>(pNode)->CharIndex(), nullptr });
+        else
+            mOps.push_back(SDependencyOp{ EDependencyOp::Resource, Target, 0, nullptr });
+
+        return;
+    }
+
+    // Nodes that gate their children get an op followed by the children's ops
+    size_t BlockOp = SIZE_MAX;
+
+    if (Type == EDependencyNodeType::SetCharacter)
+    {
+        BlockOp = mOps.size();
+        mOps.push_back(SDependencyOp{ EDependencyOp::SetCharacter, static_cast<CSetCharacterDependency*>(pNode)->CharSetIndex(), 0, nullptr });
+    }
+    else if (Type == EDependencyNodeType::SetAnimation)
+    {
+        BlockOp = mOps.size();
+        mOps.push_back(SDependencyOp{ EDependencyOp::SetAnimation, 0, 0, static_cast<CSetAnimationDependency*>(pNode) });
+    }
+    else if (Type == EDependencyNodeType::ScriptInstance)
+    {
+        BlockOp = mOps.size();
+        mOps.push_back(SDependencyOp{ EDependencyOp::ScriptInstance, static_cast<CScriptInstanceDependency*>(pNode)->ObjectType(), 0, nullptr });
+    }
+
+    for (size_t ChildIdx = 0; ChildIdx < pNode->NumChildren(); ChildIdx++)
+        CompileNode(pNode->ChildByIndex(ChildIdx));
+
+    if (BlockOp != SIZE_MAX)
+        mOps[BlockOp].Extra = mOps.size() - BlockOp - 1;
+}
+
+void CDependencyGraph::FindContextDependentNodes()
+{
+    // Character, animation and event ops depend on the character usage at the point the asset is added,
+    // and script instances depend on the object type. Anything that can reach one of those nodes is context dependent too.
+    const uint32 NumNodes = mEntries.size();
+    mIsContextDependent.assign(NumNodes, false);
+
+    std::vector<uint32> ReverseFirst(NumNodes + 1, 0);
+    std::vector<uint32> ReverseEdges;
+    std::vector<uint32> Queue;
+
+    for (uint32 Node = 0; Node < NumNodes; Node++)
+    {
+        // Areas, worlds and animsets also change the builder's state when they're added
+        if (mTypes[Node] == EResourceType::Area || mTypes[Node] == EResourceType::World || mTypes[Node] == EResourceType::AnimSet)
+            mIsContextDependent[Node] = true;
+
+        for (const SDependencyOp *pOp = OpsBegin(Node); pOp != OpsEnd(Node); pOp++)
+        {
+            if (pOp->Type == EDependencyOp::SetCharacter || pOp->Type == EDependencyOp::SetAnimation || pOp->Type == EDependencyOp::ScriptInstance ||
+                (pOp->Type == EDependencyOp::AnimEvent && pOp->Extra != UINT32_MAX))
+            {
+                mIsContextDependent[Node] = true;
+            }
+            else if ((pOp->Type == EDependencyOp::Resource || pOp->Type == EDependencyOp::AnimEvent) && IsValidPackageDependency(Node, pOp->Value))
+            {
+                ReverseFirst[pOp->Value + 1]++;
+            }
+        }
+
+        if (mIsContextDependent[Node])
+            Queue.push_back(Node);
+    }
+
+    // Build reverse edge lists
+    for (uint32 Node = 0; Node < NumNodes; Node++)
+        ReverseFirst[Node + 1] += ReverseFirst[Node];
+
+    ReverseEdges.resize(ReverseFirst[NumNodes]);
+    std::vector<uint32> ReverseFill(ReverseFirst.begin(), ReverseFirst.end() - 1);
+
+    for (uint32 Node = 0; Node < NumNodes; Node++)
+    {
+        for (const SDependencyOp *pOp = OpsBegin(Node); pOp != OpsEnd(Node); pOp++)
+        {
+            if ((pOp->Type == EDependencyOp::Resource || (pOp->Type == EDependencyOp::AnimEvent && pOp->Extra == UINT32_MAX)) &&
+                IsValidPackageDependency(Node, pOp->Value))
+            {
+                ReverseEdges[ReverseFill[pOp->Value]++] = Node;
+            }
+        }
+    }
+
+    // Propagate to everything that references a context dependent node
+    while (!Queue.empty())
+    {
+        const uint32 Node = Queue.back();
+        Queue.pop_back();
+
+        for (uint32 EdgeIdx = ReverseFirst[Node]; EdgeIdx < ReverseFill[Node]; EdgeIdx++)
+        {
+            const uint32 Parent = ReverseEdges[EdgeIdx];
+
+            if (!mIsContextDependent[Parent])
+            {
+                mIsContextDependent[Parent] = true;
+                Queue.push_back(Parent);
+            }
+        }
+    }
+}
+
+void CDependencyGraph::BuildClosures()
+{
+    const uint32 NumNodes = mEntries.size();
+    mHasClosure.assign(NumNodes, false);
+    mFirstClosure.assign(NumNodes, 0);
+    mNumClosure.assign(NumNodes, 0);
+
+    std::vector<uint32> Visited(NumNodes, 0);
+    uint32 NumCyclic = 0;
+
+    for (uint32 Node = 0; Node < NumNodes; Node++)
+    {
+        if (mIsContextDependent[Node])
+            continue;
+
+        // The cached list can't be used for nodes that are part of a cycle; while the cycle is being walked,
+        // some of its assets are marked as added before their own dependencies have been added.
+        const uint32 First = mClosures.size();
+        bool IsCyclic = false;
+        BuildClosure(UINT32_MAX, Node, Node, Node + 1, Visited, IsCyclic);
+
+        if (IsCyclic)
+        {
+            mClosures.resize(First);
+            NumCyclic++;
+            continue;
+        }
+
+        mHasClosure[Node] = true;
+        mFirstClosure[Node] = First;
+        mNumClosure[Node] = mClosures.size() - First;
+    }
+
+    if (NumCyclic > 0)
+        debugf("Dependency graph: %u assets are part of a dependency cycle", NumCyclic);
+}
+
+void CDependencyGraph::BuildClosure(uint32 Parent, uint32 Node, uint32 Root, uint32 Stamp, std::vector<uint32>& rVisited, bool& rIsCyclic)
+{
+    if (Parent != UINT32_MAX && !IsValidPackageDependency(Parent, Node))
+        return;
+
+    if (Parent != UINT32_MAX && Node == Root)
+        rIsCyclic = true;
+
+    if (rVisited[Node] == Stamp)
+        return;
+
+    rVisited[Node] = Stamp;
+
+    // Context-free nodes only have unconditional ops
+    for (const SDependencyOp *pOp = OpsBegin(Node); pOp != OpsEnd(Node); pOp++)
+    {
+        if (pOp->Type == EDependencyOp::Resource || pOp->Type == EDependencyOp::AnimEvent)
+            BuildClosure(Node, pOp->Value, Root, Stamp, rVisited, rIsCyclic);
+    }
+
+    mClosures.push_back(Node);
+}
@@ -0,0 +1,102 @@
+#ifndef CDEPENDENCYGRAPH_H
+#define CDEPENDENCYGRAPH_H
+
+#include "Core/Resource/EResType.h"
+#include <Common/BasicTypes.h>
+#include <Common/CAssetID.h>
+#include <Common/EGame.h>
+#include <map>
+#include <vector>
+
+class CResourceEntry;
+class CResourceStore;
+class CSetAnimationDependency;
+class IDependencyNode;
+
+/** Operation in a compiled dependency list */
+enum class EDependencyOp : uint8
+{
+    Resource,           // Value: target node
+    AnimEvent,          // Value: target node; Extra: character index, or UINT32_MAX if it applies to every character
+    SetCharacter,       // Value: character set index; Extra: number of child ops
+    SetAnimation,       // pAnim: animation node; Extra: number of child ops
+    ScriptInstance,     // Value: object type; Extra: number of child ops
+};
+
+struct SDependencyOp
+{
+    EDependencyOp Type;
+    uint32 Value;
+    uint32 Extra;
+    CSetAnimationDependency* pAnim;
+};
+
+/**
+ * Project-wide compiled form of every resource's dependency tree, used to build package dependency lists.
+ *
+ * Each resource entry gets a node index, and its dependency tree is flattened into a list of ops that
+ * refer to other nodes by index. Conditional subtrees (characters, animations and script instances)
+ * are stored inline, followed by their children, so they can be skipped in one step.
+ *
+ * Package dependency lists are built by walking the graph depth-first and skipping assets that have
+ * already been added. Most assets (textures, models, particles, ...) give the same list no matter which
+ * characters are in use, so their full dependency list is computed once when the graph is built and
+ * reused everywhere they're referenced. Only areas, animsets and assets that can reach them still need
+ * to be walked for each reference.
+ *
+ * The graph is owned by the resource store and is rebuilt the next time it's needed after any
+ * resource's dependencies change.
+ */
+class CDependencyGraph
+{
+    EGame mGame;
+
+    /** Per node data */
+    std::vector<CResourceEntry*> mEntries;
+    std::vector<EResourceType> mTypes;
+    std::vector<uint32> mFirstOp;
+    std::vector<uint32> mNumOps;
+
+    /** Per node; whether the node's package dependency list can depend on character usage or area state */
+    std::vector<bool> mIsContextDependent;
+
+    /** Per node; whether the node has a cached dependency list. Context-free nodes that are part of a cycle don't. */
+    std::vector<bool> mHasClosure;
+
+    /** Per node; offset and size of the node's cached dependency list in mClosures */
+    std::vector<uint32> mFirstClosure;
+    std::vector<uint32> mNumClosure;
+
+    std::vector<SDependencyOp> mOps;
+    std::vector<uint32> mClosures;
+    std::map<CAssetID, uint32> mIndexMap;
+
+    void CompileNode(IDependencyNode *pNode);
+    void FindContextDependentNodes();
+    void BuildClosures();
+    void BuildClosure(uint32 Parent, uint32 Node, uint32 Root, uint32 Stamp, std::vector<uint32>& rVisited, bool& rIsCyclic);
+
+public:
+    explicit CDependencyGraph(CResourceStore *pStore);
+
+    /** Node index of the given asset, or UINT32_MAX if it isn't in the store */
+    uint32 NodeIndex(const CAssetID& rkID) const;
+
+    /** Whether a package dependency on Child is allowed from Parent (UINT32_MAX for top-level package resources) */
+    bool IsValidPackageDependency(uint32 Parent, uint32 Child) const;
+
+    /** Accessors */
+    uint32 NumNodes() const                             { return mEntries.size(); }
+    CResourceEntry* Entry(uint32 Node) const            { return mEntries[Node]; }
+    EResourceType Type(uint32 Node) const               { return mTypes[Node]; }
+    const SDependencyOp* OpsBegin(uint32 Node) const    { return mOps.data() + mFirstOp[Node]; }
+    const SDependencyOp* OpsEnd(uint32 Node) const      { return mOps.data() + mFirstOp[Node] + mNumOps[Node]; }
+    bool IsContextDependent(uint32 Node) const          { return mIsContextDependent[Node]; }
+    bool HasClosure(uint32 Node) const                  { return mHasClosure[Node]; }
+
+    /** Cached package dependency list of a node with HasClosure(): its dependencies, depth first, followed by the node itself */
+    const uint32* ClosureBegin(uint32 Node) const       { return mClosures.data() + mFirstClosure[Node]; }
+    const uint32* ClosureEnd(uint32 Node) const         { return mClosures.data() + mFirstClosure[Node] + mNumClosure[Node]; }
+};
+
+#endif // CDEPENDENCYGRAPH_H
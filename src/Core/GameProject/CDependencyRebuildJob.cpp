@@ -0,0 +1,187 @@
+#include "CDependencyRebuildJob.h"
+#include "CDependencyTree.h"
+#include "CResourceEntry.h"
+#include "CResourceIterator.h"
+#include "CResourceStore.h"
+#include "Core/CJobPool.h"
+#include "Core/CTrace.h"
+#include "Core/IProgressNotifier.h"
+#include "Core/Resource/CResource.h"
+#include <Common/FileIO.h>
+#include <Common/FileUtil.h>
+#include <Common/Log.h>
+#include <algorithm>
+
+CDependencyRebuildJob::CDependencyRebuildJob(CResourceStore *pStore)
+    : mpStore(pStore)
+{
+}
+
+void CDependencyRebuildJob::AddEntry(CResourceEntry *pEntry)
+{
+    ASSERT(pEntry->ResourceStore() == mpStore);
+    mEntries.push_back(pEntry);
+}
+
+void CDependencyRebuildJob::AddAllEntries()
+{
+    for (CResourceIterator It(mpStore); It; ++It)
+        mEntries.push_back(*It);
+}
+
+bool CDependencyRebuildJob::Run(IProgressNotifier *pProgress)
+{
+    TRACE_ZONE(RebuildDependencies);
+
+    if (mEntries.empty())
+        return true;
+
+    // Make sure loader functions access the correct store
+    CScopedResourceStore StoreScope(mpStore);
+
+    const std::vector<size_t> BatchStarts = SplitBatches();
+    const size_t NumBatches = BatchStarts.size() - 1;
+    std::vector<std::unique_ptr<CDependencyTree>> NewTrees(mEntries.size());
+    bool Cancelled = false;
+
+    for (size_t BatchIdx = 0; BatchIdx < NumBatches && !Cancelled; BatchIdx++)
+    {
+        const size_t Begin = BatchStarts[BatchIdx];
+        const size_t End = BatchStarts[BatchIdx + 1];
+        const TBatchData BatchData = ReadBatch(Begin, End);
+
+        bool LoadedAny = false;
+
+        for (size_t EntryIdx = Begin; EntryIdx < End; EntryIdx++)
+        {
+            CResourceEntry *pEntry = mEntries[EntryIdx];
+
+            if (pProgress)
+            {
+                if (pProgress->ShouldCancel())
+                {
+                    Cancelled = true;
+                    break;
+                }
+
+                if ((EntryIdx & 0x3) == 0 || pEntry->ResourceType() == EResourceType::Area)
+                    pProgress->Report(EntryIdx, mEntries.size(), TString::Format("Processing asset %zu/%zu: %s", EntryIdx, mEntries.size(), *pEntry->CookedAssetPath(true).GetFileName()));
+            }
+
+            LoadedAny |= !pEntry->IsLoaded();
+            NewTrees[EntryIdx] = BuildDependencyTree(pEntry, BatchData[EntryIdx - Begin]);
+        }
+
+        if (LoadedAny)
+            mpStore->DestroyUnreferencedResources();
+    }
+
+    if (Cancelled)
+        return false;
+
+    // Commit all of the new trees at once
+    for (size_t EntryIdx = 0; EntryIdx < mEntries.size(); EntryIdx++)
+        mEntries[EntryIdx]->SetDependencies(std::move(NewTrees[EntryIdx]));
+
+    mpStore->SetCacheDirty();
+    mpStore->InvalidateDependencyGraph();
+    return true;
+}
+
+// ************ PRIVATE ************
+std::vector<size_t> CDependencyRebuildJob::SplitBatches() const
+{
+    // Loaded resources take more memory than their cooked data, but the file size is a good enough estimate.
+    const uint64 BatchBudget = std::max<uint64>(mMemoryBudget, 1);
+    std::vector<size_t> BatchStarts { 0 };
+    uint64 BatchSize = 0;
+
+    for (size_t EntryIdx = 0; EntryIdx < mEntries.size(); EntryIdx++)
+    {
+        const uint64 EntrySize = mEntries[EntryIdx]->Size();
+
+        if (BatchSize > 0 && BatchSize + EntrySize > BatchBudget)
+        {
+            BatchStarts.push_back(EntryIdx);
+            BatchSize = 0;
+        }
+
+        BatchSize += EntrySize;
+    }
+
+    BatchStarts.push_back(mEntries.size());
+    return BatchStarts;
+}
+
+CDependencyRebuildJob::TBatchData CDependencyRebuildJob::ReadBatch(size_t Begin, size_t End) const
+{
+    // Paths are looked up first so the pool threads don't touch the entries
+    std::vector<TString> RawPaths(End - Begin);
+    std::vector<TString> CookedPaths(End - Begin);
+
+    for (size_t EntryIdx = Begin; EntryIdx < End; EntryIdx++)
+    {
+        const CResourceEntry *pkEntry = mEntries[EntryIdx];
+
+        if (!pkEntry->IsLoaded() && pkEntry->TypeInfo()->CanHaveDependencies())
+        {
+            RawPaths[EntryIdx - Begin] = pkEntry->RawAssetPath();
+            CookedPaths[EntryIdx - Begin] = pkEntry->CookedAssetPath();
+        }
+    }
+
+    TBatchData Data(CookedPaths.size());
+
+    CJobPool::Global().ParallelFor(CookedPaths.size(), 4, [&](size_t ReadBegin, size_t ReadEnd)
+    {
+        for (size_t Idx = ReadBegin; Idx < ReadEnd; Idx++)
+        {
+            if (CookedPaths[Idx].IsEmpty())
+                continue;
+
+            // Raw versions are loaded in preference to cooked ones; see CResourceEntry::Load
+            if (FileUtil::Exists(RawPaths[Idx]))
+            {
+                Data[Idx].HasRawVersion = true;
+                continue;
+            }
+
+            CFileInStream File(CookedPaths[Idx], EEndian::BigEndian);
+
+            if (File.IsValid())
+            {
+                Data[Idx].CookedData.resize(File.Size());
+                File.ReadBytes(Data[Idx].CookedData.data(), Data[Idx].CookedData.size());
+            }
+        }
+    });
+
+    return Data;
+}
+
+std::unique_ptr<CDependencyTree> CDependencyRebuildJob::BuildDependencyTree(CResourceEntry *pEntry, const SPrefetchedData& rkData)
+{
+    if (!pEntry->TypeInfo()->CanHaveDependencies())
+        return std::make_unique<CDependencyTree>();
+
+    if (!pEntry->IsLoaded())
+    {
+        if (!rkData.HasRawVersion && !rkData.CookedData.empty())
+        {
+            CMemoryInStream Input(rkData.CookedData.data(), rkData.CookedData.size(), EEndian::BigEndian);
+            pEntry->LoadCooked(Input);
+        }
+        else
+        {
+            pEntry->Load();
+        }
+    }
+
+    if (!pEntry->Resource())
+    {
+        errorf("%s: Unable to update cached dependencies; failed to load resource", *pEntry->CookedAssetPath(true));
+        return std::make_unique<CDependencyTree>();
+    }
+
+    return pEntry->Resource()->BuildDependencyTree();
+}
@@ -0,0 +1,61 @@
+#ifndef CDEPENDENCYREBUILDJOB_H
+#define CDEPENDENCYREBUILDJOB_H
+
+#include <Common/BasicTypes.h>
+#include <memory>
+#include <vector>
+
+class CDependencyTree;
+class CResourceEntry;
+class CResourceStore;
+class IProgressNotifier;
+
+/**
+ * Regenerates the dependency trees of a set of resource entries in batches.
+ *
+ * Entries are split into batches that fit in the memory budget. The cooked data for each batch is
+ * read in parallel on the job pool, then the batch is loaded and analyzed on the calling thread.
+ * The calling thread helps with the reads, so the job is safe to run from inside another job.
+ * Resources that a batch loads stay in memory until the whole batch is done, so assets shared by
+ * several entries in the batch are only loaded once, and unreferenced resources are only destroyed
+ * once per batch.
+ *
+ * The new trees are committed to the entries together once every batch is done. If the job is
+ * cancelled, all of the entries keep their old dependencies.
+ */
+class CDependencyRebuildJob
+{
+    /** Data read ahead of time for one entry */
+    struct SPrefetchedData
+    {
+        std::vector<char> CookedData;
+        bool HasRawVersion = false;
+    };
+    using TBatchData = std::vector<SPrefetchedData>;
+
+    CResourceStore *mpStore;
+    std::vector<CResourceEntry*> mEntries;
+
+    /** Approximate limit on cooked data held in memory at once, in bytes */
+    uint64 mMemoryBudget = 256 * 1024 * 1024;
+
+public:
+    explicit CDependencyRebuildJob(CResourceStore *pStore);
+
+    void AddEntry(CResourceEntry *pEntry);
+    void AddAllEntries();
+
+    /** Rebuild dependencies for every entry. Returns false if the job was cancelled, in which case nothing is changed. */
+    bool Run(IProgressNotifier *pProgress = nullptr);
+
+    void SetMemoryBudget(uint64 Budget)     { mMemoryBudget = Budget; }
+    uint64 MemoryBudget() const             { return mMemoryBudget; }
+    size_t NumEntries() const               { return mEntries.size(); }
+
+private:
+    std::vector<size_t> SplitBatches() const;
+    TBatchData ReadBatch(size_t Begin, size_t End) const;
+    static std::unique_ptr<CDependencyTree> BuildDependencyTree(CResourceEntry *pEntry, const SPrefetchedData& rkData);
+};
+
+#endif // CDEPENDENCYREBUILDJOB_H
@@ -205,7 +205,7 @@ std::unique_ptr<CScriptInstanceDependency> CScriptInstanceDependency::BuildTree(
 {
     auto pInst = std::make_unique<CScriptInstanceDependency>();
     pInst->mObjectType = pInstance->ObjectTypeID();
-    pInst->ParseProperties(pInstance->Area()->Entry(), pInstance->Template()->Properties(), pInstance->PropertyData());
+    pInst->ParseProperties(pInstance->Area()->Entry(), pInstance->Template()->Properties(), pInstance->ReadOnlyPropertyData());
     return pInst;
 }
 
@@ -1,12 +1,14 @@
 #include "CGameExporter.h"
+#include "CDependencyRebuildJob.h"
 #include "CGameInfo.h"
+#include "CMetadataStore.h"
 #include "CResourceIterator.h"
 #include "CResourceStore.h"
+#include "Core/CTrace.h"
 #include "Core/CompressionUtil.h"
 #include "Core/Resource/CWorld.h"
 #include "Core/Resource/Script/CGameTemplate.h"
 #include <Common/Macros.h>
-#include <Common/CScopedTimer.h>
 #include <Common/FileIO.h>
 #include <Common/FileUtil.h>
 #include <Common/Serialization/CXMLWriter.h>
@@ -41,7 +43,7 @@ CGameExporter::CGameExporter(EDiscType DiscType, EGame Game, bool FrontEnd, EReg
 
 bool CGameExporter::Export(nod::DiscBase *pDisc, const TString& rkOutputDir, CAssetNameMap *pNameMap, CGameInfo *pGameInfo, IProgressNotifier *pProgress)
 {
-    SCOPED_TIMER(ExportGame);
+    TRACE_ZONE(ExportGame);
 
     mpDisc = pDisc;
     mpNameMap = pNameMap;
@@ -77,8 +79,7 @@ bool CGameExporter::Export(nod::DiscBase *pDisc, const TString& rkOutputDir, CAs
     mpStore = mpProject->ResourceStore();
     mResourcesDir = mpStore->ResourcesDir();
 
-    CResourceStore *pOldStore = gpResourceStore;
-    gpResourceStore = mpStore;
+    CScopedResourceStore StoreScope(mpStore);
 
     // Export cooked data
     LoadPaks();
@@ -94,8 +95,6 @@ bool CGameExporter::Export(nod::DiscBase *pDisc, const TString& rkOutputDir, CAs
     // Export finished!
     mProjectPath = mpProject->ProjectPath();
     mpProject.reset();
-    if (pOldStore != nullptr)
-        gpResourceStore = pOldStore;
     return !mpProgress->ShouldCancel();
 }
 
@@ -172,7 +171,7 @@ bool CGameExporter::ShouldExportDiscNode(const nod::Node *pkNode, bool IsInRoot)
 bool CGameExporter::ExtractDiscData()
 {
     // todo: handle dol, apploader, multiple partitions, wii ticket blob
-    SCOPED_TIMER(ExtractDiscData);
+    TRACE_ZONE(ExtractDiscData);
 
     // Init progress
     mpProgress->SetTask(eES_ExtractDisc, "Extracting disc files");
@@ -264,7 +263,7 @@ bool CGameExporter::ExtractDiscNodeRecursive(const nod::Node *pkNode, const TStr
 void CGameExporter::LoadPaks()
 {
 #if LOAD_PAKS
-    SCOPED_TIMER(LoadPaks);
+    TRACE_ZONE(LoadPaks);
 
     mPaks.sort([](const TString& rkLeft, const TString& rkRight) -> bool {
         return rkLeft.ToUpper() < rkRight.ToUpper();
@@ -535,7 +534,7 @@ void CGameExporter::LoadResource(const SResourceInstance& rkResource, std::vecto
 
 void CGameExporter::ExportCookedResources()
 {
-    SCOPED_TIMER(ExportCookedResources);
+    TRACE_ZONE(ExportCookedResources);
     FileUtil::MakeDirectory(mResourcesDir);
 
     mpProgress->SetTask(eES_ExportCooked, "Unpacking cooked assets");
@@ -561,13 +560,23 @@ void CGameExporter::ExportResourceEditorData()
         // Note this has to be done after all cooked resources are exported
         // because we have to load the resource to build its dependency tree and
         // some resources will fail to load if their dependencies don't exist
-        SCOPED_TIMER(SaveRawResources);
+        TRACE_ZONE(SaveRawResources);
         mpProgress->SetTask(eES_GenerateRaw, "Generating editor data");
         int ResIndex = 0;
 
-        // todo: we're wasting a ton of time loading the same resources over and over because most resources automatically
-        // load all their dependencies and then we just clear it out from memory even though we'll need it again later. we
-        // should really be doing this by dependency order instead of by ID order.
+        // Resources that can't be serialized only need their dependencies generated; that's done afterwards in
+        // batches, which keeps shared dependencies loaded across a batch instead of reloading them for every asset.
+        CDependencyRebuildJob DependencyJob(mpStore);
+
+        if (mUsePackedMetadata)
+            mpStore->MigrateToPackedMetadata();
+
+        // Packed metadata is written out in one go once every resource has been processed
+        CMetadataStore *pMetadata = mpStore->MetadataStore();
+
+        if (pMetadata)
+            pMetadata->BeginBulkWrite();
+
         for (CResourceIterator It(mpStore); It && !mpProgress->ShouldCancel(); ++It, ++ResIndex)
         {
             // Update progress
@@ -601,17 +610,26 @@ void CGameExporter::ExportResourceEditorData()
             if (It->TypeInfo()->CanBeSerialized())
                 It->Save(true);
             else
-                It->UpdateDependencies();
+                DependencyJob.AddEntry(*It);
 
             // Set flags, save metadata
             It->SaveMetadata(true);
         }
+
+        if (pMetadata)
+            pMetadata->EndBulkWrite();
+
+        if (!mpProgress->ShouldCancel())
+        {
+            mpProgress->SetTask(eES_GenerateRaw, "Generating dependencies");
+            DependencyJob.Run(mpProgress);
+        }
     }
 
     if (!mpProgress->ShouldCancel())
     {
         // All resources should have dependencies generated, so save the project files
-        SCOPED_TIMER(SaveResourceDatabase);
+        TRACE_ZONE(SaveResourceDatabase);
 #if EXPORT_COOKED
         [[maybe_unused]] const bool ResDBSaveSuccess = mpStore->SaveDatabaseCache();
         ASSERT(ResDBSaveSuccess);
@@ -42,6 +42,7 @@ class CGameExporter
     nod::DiscBase *mpDisc = nullptr;
     EDiscType mDiscType;
     bool mFrontEnd;
+    bool mUsePackedMetadata = false;
 
     // Resources
     TStringList mPaks;
@@ -79,6 +80,9 @@ public:
     void LoadResource(const CAssetID& rkID, std::vector<uint8>& rBuffer);
     bool ShouldExportDiscNode(const nod::Node *pkNode, bool IsInRoot) const;
 
+    /** Store resource metadata in a single packed file instead of one .rsmeta file per resource */
+    void SetUsePackedMetadata(bool Packed)  { mUsePackedMetadata = Packed; }
+
     TString ProjectPath() const  { return mProjectPath; }
 
 protected:
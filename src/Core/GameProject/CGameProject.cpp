@@ -1,10 +1,15 @@
 #include "CGameProject.h"
 #include "CResourceIterator.h"
 #include "IUIRelay.h"
+#include "Core/CJobPool.h"
+#include "Core/CTaskGraph.h"
+#include "Core/CTrace.h"
 #include "Core/Resource/Script/CGameTemplate.h"
+#include "Core/Resource/Script/NGameList.h"
 #include <Common/Serialization/XML.h>
 #include <nod/DiscGCN.hpp>
 #include <nod/DiscWii.hpp>
+#include <atomic>
 
 #if NOD_UCS2
 #define TStringToNodString(string) ToWChar(string)
@@ -62,14 +67,8 @@ bool CGameProject::Serialize(IArchive& rArc)
             TString PackageName = packagePath.GetFileName(false);
             TString PackageDir = packagePath.GetFileDirectory();
 
-            auto pPackage = std::make_unique<CPackage>(this, std::move(PackageName), std::move(PackageDir));
-            const bool PackageLoadSuccess = pPackage->Load();
-            mPackages.push_back(std::move(pPackage));
-
-            if (!PackageLoadSuccess)
-            {
-                return false;
-            }
+            // The package definitions are loaded by LoadProject
+            mPackages.push_back(std::make_unique<CPackage>(this, std::move(PackageName), std::move(PackageDir)));
         }
     }
 
@@ -198,6 +197,8 @@ std::unique_ptr<CGameProject> CGameProject::CreateProjectForExport(
 
 std::unique_ptr<CGameProject> CGameProject::LoadProject(const TString& rkProjPath, IProgressNotifier *pProgress)
 {
+    TRACE_ZONE(LoadProject);
+
     // Init project
     auto pProj = std::unique_ptr<CGameProject>(new CGameProject());
     pProj->mProjectRoot = rkProjPath.GetFileDirectory();
@@ -206,9 +207,8 @@ std::unique_ptr<CGameProject> CGameProject::LoadProject(const TString& rkProjPat
     // Init progress
     pProgress->SetTask(0, "Loading project: " + rkProjPath.GetFileName());
 
-    // Load main project file
+    // Load main project file. Everything else depends on the game and package list in here.
     pProgress->Report("Loading project settings");
-    bool LoadSuccess = false;
 
     const TString ProjPath = rkProjPath;
     CXMLReader Reader(ProjPath);
@@ -219,86 +219,132 @@ std::unique_ptr<CGameProject> CGameProject::LoadProject(const TString& rkProjPat
     }
 
     pProj->mGame = Reader.Game();
+    {
+        TRACE_ZONE(LoadProjectSettings);
+
+        if (!pProj->Serialize(Reader))
+            return nullptr;
+    }
+
+    // The rest of the load runs as a graph of stages on the job pool; independent stages run at the same time.
+    CGameProject *pProject = pProj.get();
+    pProject->mpResourceStore = std::make_unique<CResourceStore>(pProject);
+    CResourceStore *pStore = pProject->mpResourceStore.get();
+    const uint16 FileVersion = Reader.FileVersion();
+    CTaskGraph Stages;
+
+    const auto PackagesStage = Stages.AddTask("Load packages", [pProject]()
+    {
+        TRACE_ZONE(LoadPackages);
+        std::atomic<bool> Success = true;
+
+        CJobPool::Global().ParallelFor(pProject->mPackages.size(), 1, [pProject, &Success](size_t Begin, size_t End)
+        {
+            for (size_t PkgIdx = Begin; PkgIdx < End; PkgIdx++)
+            {
+                if (!pProject->mPackages[PkgIdx]->Load())
+                    Success = false;
+            }
+        });
+
+        return Success.load();
+    });
 
-    if (pProj->Serialize(Reader))
+    const auto DatabaseStage = Stages.AddTask("Load resource database", [pStore]()
     {
-        // Load resource database
-        pProgress->Report("Loading resource database");
-        pProj->mpResourceStore = std::make_unique<CResourceStore>(pProj.get());
-        LoadSuccess = pProj->mpResourceStore->LoadDatabaseCache();
+        TRACE_ZONE(LoadResourceDatabase);
 
         // Removed database validation step. We used to do this on project load to make sure all data was correct, but this takes a long
         // time and significantly extends how long it takes to open a project. In actual practice, this isn't needed most of the time, and
         // in the odd case that it is needed, there is a button in the resource browser to rebuild the database. So in the interest of
         // making project startup faster, we no longer validate the database.
-#if 0
-        if (LoadSuccess)
-        {
-            pProgress->Report("Validating resource database");
-            bool DatabaseIsValid = pProj->mpResourceStore->AreAllEntriesValid();
+        return pStore->LoadDatabaseCache();
+    });
 
-            // Resource database is corrupt. Ask the user if they want to rebuild it.
-            if (!DatabaseIsValid)
-            {
-                bool ShouldRebuild = gpUIRelay->AskYesNoQuestion("Error", "The resource database is corrupt. Attempt to repair it?");
+    Stages.AddTask("Load game info", [pProject]()
+    {
+        TRACE_ZONE(LoadGameInfo);
+        pProject->mpGameInfo->LoadGameInfo(pProject->mGame);
+        return true;
+    });
 
-                if (ShouldRebuild)
-                {
-                    pProgress->Report("Repairing resource database");
-                    pProj->mpResourceStore->RebuildFromDirectory();
-                }
-                else
-                    LoadSuccess = false;
-            }
-        }
-#endif
-    }
+    // Script and tweak loading need the game template; it would otherwise be loaded on first use
+    const auto TemplateStage = Stages.AddTask("Load game template", [pProject]()
+    {
+        TRACE_ZONE(LoadGameTemplate);
+        NGameList::GetGameTemplate(pProject->mGame);
+        return true;
+    });
 
-    if (!LoadSuccess)
+    Stages.AddTask("Prepare project directory", [pProject, ProjPath]()
     {
-        return nullptr;
-    }
+        TRACE_ZONE(PrepareProjectDirectory);
+        pProject->mProjFileLock.Lock(ProjPath);
 
-    pProj->mProjFileLock.Lock(ProjPath);
-    pProj->mpGameInfo->LoadGameInfo(pProj->mGame);
+        // Create hidden files directory, if needed
+        const TString HiddenDir = pProject->HiddenFilesDir();
 
-    // Perform update
-    if (Reader.FileVersion() < static_cast<uint16>(EProjectVersion::Current))
-    {
-        pProgress->Report("Updating project");
+        if (!FileUtil::Exists(HiddenDir))
+        {
+            FileUtil::MakeDirectory(HiddenDir);
+            FileUtil::MarkHidden(HiddenDir, true);
+        }
 
-        CResourceStore* pOldStore = gpResourceStore;
-        gpResourceStore = pProj->mpResourceStore.get();
+        return true;
+    });
 
-        for (CResourceIterator It; It; ++It)
+    // Resource loaders look up dependencies through the active store, so the stages below point their
+    // own thread at the new store while they run. Each stage runs on one thread, so they can't undo each other.
+    const auto UpdateStage = Stages.AddTask("Update project", [pProject, pStore, FileVersion]()
+    {
+        TRACE_ZONE(UpdateProject);
+        CScopedResourceStore StoreScope(pStore);
+
+        if (FileVersion < static_cast<uint16>(EProjectVersion::Current))
         {
-            if (It->TypeInfo()->CanBeSerialized() && !It->HasRawVersion())
+            for (CResourceIterator It(pStore); It; ++It)
             {
-                It->Save(true, false);
+                if (It->TypeInfo()->CanBeSerialized() && !It->HasRawVersion())
+                {
+                    It->Save(true, false);
 
-                // Touch the cooked file to update its last modified time.
-                // This prevents PWE from erroneously thinking the cooked file is outdated
-                // (due to the raw file we just made having a more recent last modified time)
-                FileUtil::UpdateLastModifiedTime( It->CookedAssetPath() );
+                    // Touch the cooked file to update its last modified time.
+                    // This prevents PWE from erroneously thinking the cooked file is outdated
+                    // (due to the raw file we just made having a more recent last modified time)
+                    FileUtil::UpdateLastModifiedTime( It->CookedAssetPath() );
+                }
             }
+
+            pStore->ConditionalSaveStore();
+            pProject->Save();
         }
 
-        pProj->mpResourceStore->ConditionalSaveStore();
-        pProj->Save();
+        return true;
+    }, { PackagesStage, DatabaseStage, TemplateStage });
 
-        gpResourceStore = pOldStore;
-    }
+    Stages.AddTask("Load audio", [pProject, pStore]()
+    {
+        TRACE_ZONE(LoadAudio);
+        CScopedResourceStore StoreScope(pStore);
+        pProject->mpAudioManager->LoadAssets();
+        return true;
+    }, { UpdateStage });
+
+    Stages.AddTask("Load tweaks", [pProject, pStore]()
+    {
+        TRACE_ZONE(LoadTweaks);
+        CScopedResourceStore StoreScope(pStore);
+        pProject->mpTweakManager->LoadTweaks();
+        return true;
+    }, { UpdateStage });
 
-    // Create hidden files directory, if needed
-    const TString HiddenDir = pProj->HiddenFilesDir();
+    const bool LoadSuccess = Stages.Run(CJobPool::Global(), pProgress);
+    Stages.LogProfile("Project open profile (" + rkProjPath.GetFileName() + ")");
 
-    if (!FileUtil::Exists(HiddenDir))
+    if (!LoadSuccess)
     {
-        FileUtil::MakeDirectory(HiddenDir);
-        FileUtil::MarkHidden(HiddenDir, true);
+        return nullptr;
     }
 
-    pProj->mpAudioManager->LoadAssets();
-    pProj->mpTweakManager->LoadTweaks();
     return pProj;
 }
@@ -0,0 +1,333 @@
+#include "CMetadataStore.h"
+#include <Common/CFourCC.h>
+#include <Common/FileIO.h>
+#include <Common/FileUtil.h>
+#include <Common/Log.h>
+#include <Common/Serialization/Binary.h>
+
+namespace
+{
+/** Bump this whenever the layout of the log file changes */
+constexpr uint32 kLogVersion = 1;
+constexpr uint32 kHeaderSize = 8;
+
+enum : uint8
+{
+    kOpWrite = 0,
+    kOpRemove = 1,
+};
+
+/** Compact once the log holds this many more records than there are live ones */
+constexpr uint32 kMinWastedRecords = 4096;
+}
+
+CMetadataStore::CMetadataStore(TString Path, EGame Game)
+    : mPath(std::move(Path))
+    , mGame(Game)
+{
+}
+
+CMetadataStore::~CMetadataStore()
+{
+    Close();
+}
+
+bool CMetadataStore::Load()
+{
+    CloseLogFile();
+    mRecords.clear();
+    mNumLogRecords = 0;
+    mPendingLog.clear();
+    mNumPendingRecords = 0;
+
+    if (!FileUtil::Exists(mPath))
+        return true;
+
+    std::vector<uint8> FileData;
+
+    if (!FileUtil::LoadFileToBuffer(mPath, FileData))
+        return false;
+
+    if (FileData.size() < kHeaderSize)
+    {
+        errorf("Failed to load metadata store; file is too small: %s", *mPath);
+        return false;
+    }
+
+    {
+        CMemoryInStream Header(FileData.data(), kHeaderSize, EEndian::LittleEndian);
+
+        if (Header.ReadLong() != FOURCC('RMET') || Header.ReadLong() != kLogVersion)
+        {
+            errorf("Failed to load metadata store; invalid header: %s", *mPath);
+            return false;
+        }
+    }
+
+    // Replay the log; later records replace earlier ones
+    size_t Offset = kHeaderSize;
+    bool Truncated = false;
+
+    while (Offset < FileData.size())
+    {
+        if (FileData.size() - Offset < 4)
+        {
+            Truncated = true;
+            break;
+        }
+
+        CMemoryInStream SizeStream(FileData.data() + Offset, 4, EEndian::LittleEndian);
+        const uint32 RecordSize = SizeStream.ReadLong();
+        Offset += 4;
+
+        if (FileData.size() - Offset < RecordSize || RecordSize < 2)
+        {
+            Truncated = true;
+            break;
+        }
+
+        CMemoryInStream Input(FileData.data() + Offset, RecordSize, EEndian::LittleEndian);
+        Offset += RecordSize;
+
+        const uint8 Op = Input.ReadByte();
+        const EIDLength IDLength = static_cast<EIDLength>(Input.ReadByte());
+        const CAssetID ID(Input, IDLength);
+
+        if (Op == kOpWrite)
+        {
+            SRecord& rRecord = mRecords[ID];
+            rRecord.Directory = Input.ReadString();
+            rRecord.Name = Input.ReadString();
+            rRecord.ArchiveVersion = Input.ReadLong();
+            rRecord.Data.resize(Input.ReadLong());
+            Input.ReadBytes(rRecord.Data.data(), rRecord.Data.size());
+        }
+        else
+        {
+            mRecords.erase(ID);
+        }
+
+        mNumLogRecords++;
+    }
+
+    // Anything appended after a partial record would be unreadable, so rewrite the log now
+    if (Truncated)
+    {
+        warnf("Metadata store has a truncated record at the end; dropping it: %s", *mPath);
+        return Compact();
+    }
+
+    return true;
+}
+
+bool CMetadataStore::WriteRecord(const CAssetID& rkID, const TString& rkDirectory, const TString& rkName, const std::function<void(IArchive&)>& rkSerialize)
+{
+    SRecord& rRecord = mRecords[rkID];
+    rRecord.Directory = rkDirectory;
+    rRecord.Name = rkName;
+    rRecord.ArchiveVersion = IArchive::skCurrentArchiveVersion;
+    rRecord.Data.clear();
+
+    {
+        CVectorOutStream Output(&rRecord.Data, EEndian::LittleEndian);
+        CBinaryWriter Writer(&Output, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, mGame));
+        rkSerialize(Writer);
+    }
+
+    AppendRecord(kOpWrite, rkID, &rRecord);
+    return mBulkWriteDepth > 0 || Flush();
+}
+
+bool CMetadataStore::ReadRecord(const CAssetID& rkID, const std::function<void(IArchive&)>& rkSerialize) const
+{
+    const SRecord* pkRecord = FindRecord(rkID);
+
+    if (!pkRecord)
+        return false;
+
+    CMemoryInStream Input(pkRecord->Data.data(), pkRecord->Data.size(), EEndian::LittleEndian);
+    CBinaryReader Reader(&Input, CSerialVersion(pkRecord->ArchiveVersion, 0, mGame));
+    rkSerialize(Reader);
+    return true;
+}
+
+bool CMetadataStore::RemoveRecord(const CAssetID& rkID)
+{
+    const auto Iter = mRecords.find(rkID);
+
+    if (Iter == mRecords.end())
+        return true;
+
+    mRecords.erase(Iter);
+    AppendRecord(kOpRemove, rkID, nullptr);
+    return mBulkWriteDepth > 0 || Flush();
+}
+
+void CMetadataStore::BeginBulkWrite()
+{
+    mBulkWriteDepth++;
+}
+
+bool CMetadataStore::EndBulkWrite()
+{
+    ASSERT(mBulkWriteDepth > 0);
+    mBulkWriteDepth--;
+    return mBulkWriteDepth > 0 || Flush();
+}
+
+bool CMetadataStore::Compact()
+{
+    CloseLogFile();
+
+    std::vector<char> FileData;
+    WriteHeader(FileData);
+    mPendingLog.clear();
+    mNumPendingRecords = 0;
+
+    for (const auto& [ID, Record] : mRecords)
+        AppendRecord(kOpWrite, ID, &Record);
+
+    FileData.insert(FileData.end(), mPendingLog.cbegin(), mPendingLog.cend());
+    const uint32 NumRecords = mNumPendingRecords;
+    mPendingLog.clear();
+    mNumPendingRecords = 0;
+
+    // Write to a temporary file first so a failed write doesn't lose the existing log
+    const TString TempPath = mPath + ".tmp";
+
+    {
+        CFileOutStream File(TempPath, EEndian::LittleEndian);
+
+        if (!File.IsValid())
+        {
+            errorf("Failed to compact metadata store; unable to open %s", *TempPath);
+            return false;
+        }
+
+        File.WriteBytes(FileData.data(), FileData.size());
+    }
+
+    if ((FileUtil::Exists(mPath) && !FileUtil::DeleteFile(mPath)) || !FileUtil::MoveFile(TempPath, mPath))
+    {
+        errorf("Failed to compact metadata store; unable to replace %s", *mPath);
+        return false;
+    }
+
+    mNumLogRecords = NumRecords;
+    return true;
+}
+
+bool CMetadataStore::NeedsCompaction() const
+{
+    return NumLogRecords() > mRecords.size() * 2 + kMinWastedRecords;
+}
+
+void CMetadataStore::Close()
+{
+    Flush();
+
+    if (NeedsCompaction())
+        Compact();
+
+    CloseLogFile();
+}
+
+const CMetadataStore::SRecord* CMetadataStore::FindRecord(const CAssetID& rkID) const
+{
+    const auto Iter = mRecords.find(rkID);
+    return (Iter != mRecords.cend() ? &Iter->second : nullptr);
+}
+
+// ************ PRIVATE ************
+void CMetadataStore::AppendRecord(uint8 Op, const CAssetID& rkID, const SRecord *pkRecord)
+{
+    std::vector<char> RecordData;
+
+    {
+        CVectorOutStream Output(&RecordData, EEndian::LittleEndian);
+        Output.WriteByte(Op);
+        Output.WriteByte(static_cast<uint8>(rkID.Length()));
+        rkID.Write(Output);
+
+        if (pkRecord)
+        {
+            Output.WriteString(pkRecord->Directory);
+            Output.WriteString(pkRecord->Name);
+            Output.WriteLong(pkRecord->ArchiveVersion);
+            Output.WriteLong(pkRecord->Data.size());
+            Output.WriteBytes(pkRecord->Data.data(), pkRecord->Data.size());
+        }
+    }
+
+    // Records are prefixed with their size so a truncated record can be detected
+    std::vector<char> SizeData;
+
+    {
+        CVectorOutStream Output(&SizeData, EEndian::LittleEndian);
+        Output.WriteLong(RecordData.size());
+    }
+
+    mPendingLog.insert(mPendingLog.end(), SizeData.cbegin(), SizeData.cend());
+    mPendingLog.insert(mPendingLog.end(), RecordData.cbegin(), RecordData.cend());
+
+    mNumPendingRecords++;
+}
+
+bool CMetadataStore::Flush()
+{
+    if (mPendingLog.empty())
+        return true;
+
+    if (!mpLogFile)
+    {
+        const bool IsNewFile = !FileUtil::Exists(mPath);
+        mpLogFile = std::fopen(*mPath, "ab");
+
+        if (!mpLogFile)
+        {
+            errorf("Failed to open metadata store for writing: %s", *mPath);
+            return false;
+        }
+
+        if (IsNewFile)
+        {
+            std::vector<char> Header;
+            WriteHeader(Header);
+            std::fwrite(Header.data(), 1, Header.size(), mpLogFile);
+        }
+    }
+
+    const bool Success = std::fwrite(mPendingLog.data(), 1, mPendingLog.size(), mpLogFile) == mPendingLog.size() &&
+                         std::fflush(mpLogFile) == 0;
+
+    if (!Success)
+    {
+        errorf("Failed to write to metadata store: %s", *mPath);
+        return false;
+    }
+
+    mNumLogRecords += mNumPendingRecords;
+    mPendingLog.clear();
+    mNumPendingRecords = 0;
+
+    if (mBulkWriteDepth == 0 && NeedsCompaction())
+        return Compact();
+
+    return true;
+}
+
+void CMetadataStore::CloseLogFile()
+{
+    if (mpLogFile)
+    {
+        std::fclose(mpLogFile);
+        mpLogFile = nullptr;
+    }
+}
+
+void CMetadataStore::WriteHeader(std::vector<char>& rOut)
+{
+    CVectorOutStream Output(&rOut, EEndian::LittleEndian);
+    Output.WriteLong(FOURCC('RMET'));
+    Output.WriteLong(kLogVersion);
+}
@@ -0,0 +1,97 @@
+#ifndef CMETADATASTORE_H
+#define CMETADATASTORE_H
+
+#include <Common/BasicTypes.h>
+#include <Common/CAssetID.h>
+#include <Common/EGame.h>
+#include <Common/TString.h>
+#include <Common/Serialization/IArchive.h>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * Packed storage for resource entry metadata, used in place of one .rsmeta file per resource.
+ *
+ * Metadata is kept in a single append-only log file. Each save appends a record holding the
+ * entry's location and serialized metadata, and removing an entry appends a tombstone. The whole
+ * log is read and replayed in one go when the store is opened, which leaves an in-memory index of
+ * the latest record for each asset. Once superseded records make up most of the log, it's compacted
+ * by writing out the live records to a new file that replaces the old one.
+ *
+ * A truncated record at the end of the log (e.g. from a crash mid-write) is dropped on load.
+ */
+class CMetadataStore
+{
+public:
+    struct SRecord
+    {
+        TString Directory;
+        TString Name;
+        uint32 ArchiveVersion = 0;
+        std::vector<char> Data;
+    };
+
+private:
+    /** Path of the log file */
+    TString mPath;
+    EGame mGame;
+
+    /** Latest record for each asset */
+    std::map<CAssetID, SRecord> mRecords;
+
+    /** Number of records in the log file, including superseded ones */
+    uint32 mNumLogRecords = 0;
+
+    /** Records that haven't been written to the log file yet */
+    std::vector<char> mPendingLog;
+    uint32 mNumPendingRecords = 0;
+    uint32 mBulkWriteDepth = 0;
+
+    FILE *mpLogFile = nullptr;
+
+public:
+    CMetadataStore(TString Path, EGame Game);
+    ~CMetadataStore();
+
+    CMetadataStore(const CMetadataStore&) = delete;
+    CMetadataStore& operator=(const CMetadataStore&) = delete;
+
+    /** Read and replay the log file. Returns false if the file exists but isn't a valid metadata log. */
+    bool Load();
+
+    /** Serialize a new record for the given asset, replacing its existing record */
+    bool WriteRecord(const CAssetID& rkID, const TString& rkDirectory, const TString& rkName, const std::function<void(IArchive&)>& rkSerialize);
+
+    /** Deserialize the record for the given asset. Returns false if there is no record. */
+    bool ReadRecord(const CAssetID& rkID, const std::function<void(IArchive&)>& rkSerialize) const;
+
+    /** Remove the record for the given asset */
+    bool RemoveRecord(const CAssetID& rkID);
+
+    /** While a bulk write is active, new records are only written to disk when it ends */
+    void BeginBulkWrite();
+    bool EndBulkWrite();
+
+    /** Rewrite the log file with only the live records */
+    bool Compact();
+    bool NeedsCompaction() const;
+
+    /** Write pending records, compact the log if needed, and close the log file */
+    void Close();
+
+    const SRecord* FindRecord(const CAssetID& rkID) const;
+    const std::map<CAssetID, SRecord>& Records() const  { return mRecords; }
+    uint32 NumRecords() const                           { return mRecords.size(); }
+    uint32 NumLogRecords() const                        { return mNumLogRecords + mNumPendingRecords; }
+    TString Path() const                                { return mPath; }
+
+private:
+    void AppendRecord(uint8 Op, const CAssetID& rkID, const SRecord *pkRecord);
+    bool Flush();
+    void CloseLogFile();
+    static void WriteHeader(std::vector<char>& rOut);
+};
+
+#endif // CMETADATASTORE_H
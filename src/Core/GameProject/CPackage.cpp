@@ -2,6 +2,7 @@
 #include "DependencyListBuilders.h"
 #include "CGameProject.h"
 #include "Core/CompressionUtil.h"
+#include "Core/CTrace.h"
 #include "Core/Resource/Cooker/CWorldCooker.h"
 #include <Common/Macros.h>
 #include <Common/FileIO.h>
@@ -72,7 +73,7 @@ void CPackage::MarkDirty()
 
 void CPackage::Cook(IProgressNotifier *pProgress)
 {
-    SCOPED_TIMER(CookPackage);
+    TRACE_ZONE(CookPackage);
 
     // Build asset list
     pProgress->Report(-1, -1, "Building dependency list");
@@ -177,7 +178,7 @@ void CPackage::Cook(IProgressNotifier *pProgress)
         // Initialize entry, recook assets if needed
         const uint32 AssetOffset = Pak.Tell();
         const CAssetID ID = *Iter;
-        CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
+        CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
         ASSERT(pEntry != nullptr);
 
         if (pEntry->NeedsRecook())
@@ -416,7 +417,7 @@ void CPackage::CompareOriginalAssetList(const std::list<CAssetID>& rkNewList)
     {
         if (NewListSet.find(ID) == NewListSet.end())
         {
-            const CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
+            const CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
             const TString Extension = (pEntry != nullptr ? "." + pEntry->CookedExtension() : "");
             warnf("Missing resource: %s%s", *ID.ToString(), *Extension);
         }
@@ -427,7 +428,7 @@ void CPackage::CompareOriginalAssetList(const std::list<CAssetID>& rkNewList)
     {
         if (OldListSet.find(ID) == OldListSet.end())
         {
-            const CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
+            const CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
             const TString Extension = (pEntry != nullptr ? "." + pEntry->CookedExtension() : "");
             warnf("Extra resource: %s%s", *ID.ToString(), *Extension);
         }
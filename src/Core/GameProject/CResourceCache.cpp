@@ -0,0 +1,140 @@
+#include "CResourceCache.h"
+#include "CResourceEntry.h"
+#include "Core/Resource/CResource.h"
+#include <Common/Macros.h>
+
+uint64 CResourceCache::sDefaultBudget = 256 * 1024 * 1024;
+
+CResourceCache::CResourceCache()
+    : mBudget(sDefaultBudget)
+{
+}
+
+void CResourceCache::Insert(CResourceEntry *pEntry, bool AsOldest /*= false*/)
+{
+    // Cooked files are often compressed, so prefer the resource's own estimate where it has one
+    const CResource *pkResource = pEntry->Resource();
+    const size_t MemoryUsage = (pkResource ? pkResource->MemoryUsage() : 0);
+    const uint64 Size = (MemoryUsage > 0 ? MemoryUsage : pEntry->Size());
+
+    std::lock_guard Lock(mMutex);
+    ASSERT(mResources.find(pEntry) == mResources.cend());
+
+    const auto Position = (AsOldest ? mLRU.insert(mLRU.end(), pEntry) : mLRU.insert(mLRU.begin(), pEntry));
+    mResources.insert_or_assign(pEntry, SCachedResource{Position, Size});
+
+    STypeStats& rType = mStats.Types[pEntry->ResourceType()];
+    rType.CachedBytes += Size;
+    rType.NumCached++;
+    mStats.CachedBytes += Size;
+    mStats.NumCached++;
+}
+
+bool CResourceCache::Remove(CResourceEntry *pEntry)
+{
+    std::lock_guard Lock(mMutex);
+    return RemoveLocked(pEntry);
+}
+
+bool CResourceCache::RemoveLocked(CResourceEntry *pEntry)
+{
+    const auto Find = mResources.find(pEntry);
+
+    if (Find == mResources.cend())
+        return false;
+
+    const uint64 Size = Find->second.Size;
+    mLRU.erase(Find->second.Position);
+    mResources.erase(Find);
+
+    STypeStats& rType = mStats.Types[pEntry->ResourceType()];
+    rType.CachedBytes -= Size;
+    rType.NumCached--;
+    mStats.CachedBytes -= Size;
+    mStats.NumCached--;
+    return true;
+}
+
+void CResourceCache::RecordLoad(CResourceEntry *pEntry, bool WasLoaded)
+{
+    std::lock_guard Lock(mMutex);
+
+    // Loads of resources that are loaded and still referenced don't count either way
+    if (!WasLoaded)
+        mStats.Misses++;
+    else if (RemoveLocked(pEntry))
+        mStats.Hits++;
+}
+
+void CResourceCache::RecordEviction()
+{
+    std::lock_guard Lock(mMutex);
+    mStats.Evictions++;
+}
+
+void CResourceCache::Reserve(uint64 Bytes)
+{
+    std::lock_guard Lock(mMutex);
+    mStats.ReservedBytes += Bytes;
+}
+
+void CResourceCache::Unreserve(uint64 Bytes)
+{
+    std::lock_guard Lock(mMutex);
+    ASSERT(mStats.ReservedBytes >= Bytes);
+    mStats.ReservedBytes -= Bytes;
+}
+
+void CResourceCache::Clear()
+{
+    std::lock_guard Lock(mMutex);
+    mLRU.clear();
+    mResources.clear();
+    mStats.CachedBytes = 0;
+    mStats.NumCached = 0;
+    mStats.Types.clear();
+}
+
+void CResourceCache::ResetCounters()
+{
+    std::lock_guard Lock(mMutex);
+    mStats.Hits = 0;
+    mStats.Misses = 0;
+    mStats.Evictions = 0;
+}
+
+bool CResourceCache::Contains(CResourceEntry *pEntry) const
+{
+    std::lock_guard Lock(mMutex);
+    return mResources.find(pEntry) != mResources.cend();
+}
+
+bool CResourceCache::IsOverBudget() const
+{
+    std::lock_guard Lock(mMutex);
+    return !mLRU.empty() && mStats.CachedBytes + mStats.ReservedBytes > mBudget;
+}
+
+CResourceEntry* CResourceCache::LeastRecentlyUsed() const
+{
+    std::lock_guard Lock(mMutex);
+    return mLRU.empty() ? nullptr : mLRU.back();
+}
+
+CResourceCache::SStats CResourceCache::Stats() const
+{
+    std::lock_guard Lock(mMutex);
+    return mStats;
+}
+
+void CResourceCache::SetBudget(uint64 Budget)
+{
+    std::lock_guard Lock(mMutex);
+    mBudget = Budget;
+}
+
+uint64 CResourceCache::Budget() const
+{
+    std::lock_guard Lock(mMutex);
+    return mBudget;
+}
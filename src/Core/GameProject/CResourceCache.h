@@ -0,0 +1,106 @@
+#ifndef CRESOURCECACHE_H
+#define CRESOURCECACHE_H
+
+#include "Core/Resource/EResType.h"
+#include <Common/BasicTypes.h>
+#include <list>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+class CResourceEntry;
+
+/**
+ * Tracks loaded resources that are no longer referenced, in least recently used order, so the
+ * store can keep them resident up to a memory budget instead of unloading them right away.
+ * The cache only does the bookkeeping; the store decides when resources go in and unloads
+ * whatever the cache asks it to evict.
+ *
+ * Resource sizes come from CResource::MemoryUsage, falling back to the size of the cooked
+ * file for resource types that don't track their memory usage. Every resource load
+ * records a hit or miss, and loads can run on job threads, so the cache is internally locked.
+ */
+class CResourceCache
+{
+public:
+    struct STypeStats
+    {
+        uint64 CachedBytes = 0;
+        uint32 NumCached = 0;
+    };
+
+    struct SStats
+    {
+        /** Loads that were served by a cached resource */
+        uint64 Hits = 0;
+        /** Loads that had to read the resource from disk */
+        uint64 Misses = 0;
+        /** Resources unloaded to get back under the budget */
+        uint64 Evictions = 0;
+
+        uint64 CachedBytes = 0;
+        uint32 NumCached = 0;
+        /** Memory held outside the cache that counts against its budget, e.g. prefetched resources */
+        uint64 ReservedBytes = 0;
+        std::map<EResourceType, STypeStats> Types;
+    };
+
+private:
+    struct SCachedResource
+    {
+        std::list<CResourceEntry*>::iterator Position;
+        uint64 Size;
+    };
+
+    /** Front is the most recently used resource */
+    std::list<CResourceEntry*> mLRU;
+    std::unordered_map<CResourceEntry*, SCachedResource> mResources;
+
+    /** Memory budget in bytes; 0 disables the cache */
+    uint64 mBudget;
+    SStats mStats;
+    mutable std::mutex mMutex;
+
+    static uint64 sDefaultBudget;
+
+public:
+    CResourceCache();
+
+    /** Add an unreferenced resource. Resources that were released as a side effect of unloading
+     *  another resource can be added as the oldest, since they were last used at the same time. */
+    void Insert(CResourceEntry *pEntry, bool AsOldest = false);
+
+    /** Remove a resource because it's in use again or was unloaded. Returns whether it was cached. */
+    bool Remove(CResourceEntry *pEntry);
+
+    /** Record a load request; a cached resource is removed from the cache and counted as a hit */
+    void RecordLoad(CResourceEntry *pEntry, bool WasLoaded);
+    void RecordEviction();
+
+    /** Count memory held outside the cache against its budget, so cached resources make room for it */
+    void Reserve(uint64 Bytes);
+    void Unreserve(uint64 Bytes);
+
+    /** Remove every resource without resetting the counters */
+    void Clear();
+    void ResetCounters();
+
+    bool Contains(CResourceEntry *pEntry) const;
+    bool IsOverBudget() const;
+    CResourceEntry* LeastRecentlyUsed() const;
+
+    /** Snapshot of the counters and usage */
+    SStats Stats() const;
+
+    void SetBudget(uint64 Budget);
+    uint64 Budget() const;
+
+    /** Budget for caches created after this is set. The editor sets this from its settings. */
+    static void SetDefaultBudget(uint64 Budget) { sDefaultBudget = Budget; }
+    static uint64 DefaultBudget()               { return sDefaultBudget; }
+
+private:
+    bool RemoveLocked(CResourceEntry *pEntry);
+};
+
+#endif // CRESOURCECACHE_H
@@ -0,0 +1,121 @@
+#include "CResourceDirectoryScan.h"
+#include "CResourceStore.h"
+#include "Core/CJobPool.h"
+#include "Core/IProgressNotifier.h"
+#include "Core/Resource/CResTypeInfo.h"
+#include <Common/FileUtil.h>
+#include <algorithm>
+#include <iterator>
+
+/** Minimum number of metadata files loaded by each job */
+constexpr size_t gkMetadataFilesPerJob = 128;
+
+CResourceDirectoryScan::CResourceDirectoryScan(CResourceStore *pStore)
+    : mpStore(pStore)
+    , mResourcesDir(pStore->ResourcesDir())
+{
+}
+
+bool CResourceDirectoryScan::Run(IProgressNotifier *pProgress /*= nullptr*/)
+{
+    mDirectories.clear();
+    mFiles.clear();
+    mUnknownFiles.clear();
+
+    return WalkDirectories(pProgress) && LoadMetadataFiles(pProgress);
+}
+
+bool CResourceDirectoryScan::WalkDirectories(IProgressNotifier *pProgress)
+{
+    struct SDirectoryContents
+    {
+        std::vector<TString> SubDirectories;
+        std::vector<SResourceFile> Files;
+        std::vector<TString> UnknownFiles;
+    };
+
+    // Each pass lists every directory at one depth of the tree. Results are merged in the same order
+    // as the input, so the scan always finds files in the same order no matter how the jobs are run.
+    std::vector<TString> Level{mResourcesDir};
+
+    while (!Level.empty())
+    {
+        if (pProgress)
+        {
+            if (pProgress->ShouldCancel())
+                return false;
+
+            pProgress->Report(TString::Format("Scanning directories: %zu resources found", mFiles.size()));
+        }
+
+        std::vector<SDirectoryContents> Contents(Level.size());
+
+        CJobPool::Global().ParallelFor(Level.size(), 1, [&](size_t Begin, size_t End)
+        {
+            for (size_t DirIdx = Begin; DirIdx < End; DirIdx++)
+            {
+                SDirectoryContents& rContents = Contents[DirIdx];
+                TStringList DirContents;
+                FileUtil::GetDirectoryContents(Level[DirIdx], DirContents, false);
+
+                for (const TString& rkPath : DirContents)
+                {
+                    if (rkPath.EndsWith(".rsmeta") && FileUtil::IsFile(rkPath))
+                        AddMetadataFile(rkPath, rContents.Files, rContents.UnknownFiles);
+                    else if (FileUtil::IsDirectory(rkPath))
+                        rContents.SubDirectories.push_back(rkPath);
+                }
+            }
+        });
+
+        std::vector<TString> NextLevel;
+
+        for (SDirectoryContents& rContents : Contents)
+        {
+            for (TString& rDir : rContents.SubDirectories)
+            {
+                mDirectories.push_back(rDir.ChopFront(mResourcesDir.Size()));
+                NextLevel.push_back(std::move(rDir));
+            }
+
+            std::move(rContents.Files.begin(), rContents.Files.end(), std::back_inserter(mFiles));
+            std::move(rContents.UnknownFiles.begin(), rContents.UnknownFiles.end(), std::back_inserter(mUnknownFiles));
+        }
+
+        Level = std::move(NextLevel);
+    }
+
+    return true;
+}
+
+bool CResourceDirectoryScan::LoadMetadataFiles(IProgressNotifier *pProgress)
+{
+    // Files are loaded in rounds so progress can be reported from this thread in between. Each round gives
+    // every thread one job's worth of files. ParallelFor has this thread help run the round, so this is
+    // safe to call from a pool worker.
+    const size_t FilesPerRound = gkMetadataFilesPerJob * (CJobPool::Global().NumWorkers() + 1);
+
+    for (size_t RoundBegin = 0; RoundBegin < mFiles.size(); RoundBegin += FilesPerRound)
+    {
+        const size_t RoundEnd = std::min(RoundBegin + FilesPerRound, mFiles.size());
+
+        CJobPool::Global().ParallelFor(RoundEnd - RoundBegin, gkMetadataFilesPerJob, [this, RoundBegin](size_t Begin, size_t End)
+        {
+            for (size_t FileIdx = RoundBegin + Begin; FileIdx < RoundBegin + End; FileIdx++)
+            {
+                SResourceFile& rFile = mFiles[FileIdx];
+                rFile.pEntry = CResourceEntry::BuildFromMetadataFile(mpStore, rFile.pTypeInfo, rFile.MetadataPath, rFile.Name);
+            }
+        });
+
+        if (pProgress)
+        {
+            if (pProgress->ShouldCancel())
+                return false;
+
+            pProgress->Report(RoundEnd, mFiles.size(), TString::Format("Loading metadata %zu/%zu", RoundEnd, mFiles.size()));
+        }
+    }
+
+    return true;
+}
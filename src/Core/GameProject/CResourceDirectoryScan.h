@@ -0,0 +1,62 @@
+#ifndef CRESOURCEDIRECTORYSCAN_H
+#define CRESOURCEDIRECTORYSCAN_H
+
+#include "CResourceEntry.h"
+#include <Common/TString.h>
+#include <memory>
+#include <vector>
+
+class CResourceStore;
+class CResTypeInfo;
+class IProgressNotifier;
+
+/**
+ * Scans a store's resources directory for metadata files and loads them into new resource entries.
+ *
+ * The directory tree is walked one level at a time, with every directory in a level listed in parallel
+ * on the job pool, and then the metadata files that were found are read in parallel. Neither the store
+ * nor its virtual directories are thread-safe, so the entries built by the scan aren't registered with
+ * either; the store merges the results on the calling thread once the scan is done.
+ */
+class CResourceDirectoryScan
+{
+public:
+    struct SResourceFile
+    {
+        TString MetadataPath;
+        TString Directory;
+        TString Name;
+        CResTypeInfo *pTypeInfo = nullptr;
+
+        /** Entry loaded from the metadata file, or null if it failed to load */
+        std::unique_ptr<CResourceEntry> pEntry;
+    };
+
+private:
+    CResourceStore *mpStore;
+    TString mResourcesDir;
+
+    /** Every directory that was found, relative to the resources directory */
+    std::vector<TString> mDirectories;
+    std::vector<SResourceFile> mFiles;
+
+    /** Metadata files whose resource type couldn't be identified */
+    std::vector<TString> mUnknownFiles;
+
+public:
+    explicit CResourceDirectoryScan(CResourceStore *pStore);
+
+    /** Walk the resources directory and load every metadata file. Returns false if the scan was cancelled. */
+    bool Run(IProgressNotifier *pProgress = nullptr);
+
+    const std::vector<TString>& Directories() const     { return mDirectories; }
+    std::vector<SResourceFile>& Files()                 { return mFiles; }
+    const std::vector<TString>& UnknownFiles() const    { return mUnknownFiles; }
+
+private:
+    bool WalkDirectories(IProgressNotifier *pProgress);
+    bool LoadMetadataFiles(IProgressNotifier *pProgress);
+    void AddMetadataFile(const TString& rkPath, std::vector<SResourceFile>& rFiles, std::vector<TString>& rUnknownFiles) const;
+};
+
+#endif // CRESOURCEDIRECTORYSCAN_H
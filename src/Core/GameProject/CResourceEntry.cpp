@@ -1,6 +1,9 @@
 #include "CResourceEntry.h"
+#include "CAsyncResourceLoader.h"
 #include "CGameProject.h"
+#include "CMetadataStore.h"
 #include "CResourceStore.h"
+#include "Core/CTrace.h"
 #include "Core/Resource/CResource.h"
 #include "Core/Resource/Cooker/CResourceCooker.h"
 #include "Core/Resource/Factory/CResourceFactory.h"
@@ -39,11 +42,12 @@ std::unique_ptr<CResourceEntry> CResourceEntry::CreateNewResource(CResourceStore
     // then instantiate the new resource data so it can be saved as soon as possible.
     if (!ExistingResource)
     {
-        pEntry->mpResource = CResourceFactory::CreateResource(pEntry.get());
+        std::unique_ptr<CResource> pResource = CResourceFactory::CreateResource(pEntry.get());
 
-        if (pEntry->mpResource)
+        if (pResource)
         {
-            pEntry->mpResource->InitializeNewResource();
+            pResource->InitializeNewResource();
+            pEntry->mpResource = pResource.release();
         }
     }
 
@@ -60,10 +64,11 @@ std::unique_ptr<CResourceEntry> CResourceEntry::BuildFromArchive(CResourceStore
     return pEntry;
 }
 
-std::unique_ptr<CResourceEntry> CResourceEntry::BuildFromDirectory(CResourceStore *pStore, CResTypeInfo *pTypeInfo,
-                                                                   const TString& rkDirPath, const TString& rkName)
+std::unique_ptr<CResourceEntry> CResourceEntry::BuildFromMetadataFile(CResourceStore *pStore, CResTypeInfo *pTypeInfo,
+                                                                      const TString& rkMetadataPath, const TString& rkName)
 {
     // Initialize as much entry info as possible from the input data, then load the rest from the metadata file.
+    // The entry isn't added to a directory, so this doesn't touch the store and can be called from a job thread.
     ASSERT(pTypeInfo);
 
     auto pEntry = std::unique_ptr<CResourceEntry>(new CResourceEntry(pStore));
@@ -71,38 +76,52 @@ std::unique_ptr<CResourceEntry> CResourceEntry::BuildFromDirectory(CResourceStor
     pEntry->mName = rkName;
     pEntry->mCachedUppercaseName = rkName.ToUpper();
 
-    pEntry->mpDirectory = pStore->GetVirtualDirectory(rkDirPath, true);
-    ASSERT(pEntry->mpDirectory);
-    pEntry->mpDirectory->AddChild("", pEntry.get());
+    CBinaryReader MetaFile(rkMetadataPath, FOURCC('META'));
 
-    // Make sure we're valid, then load the remaining data from the metadata file
-    ASSERT(pEntry->HasCookedVersion() || pEntry->HasRawVersion());
-    bool Success = pEntry->LoadMetadata();
-    ASSERT(Success);
+    if (!MetaFile.IsValid())
+        return nullptr;
 
+    pEntry->SerializeEntryInfo(MetaFile, true);
     return pEntry;
 }
 
-CResourceEntry::~CResourceEntry() = default;
-
-bool CResourceEntry::LoadMetadata()
+std::unique_ptr<CResourceEntry> CResourceEntry::BuildFromMetadataStore(CResourceStore *pStore, const CAssetID& rkID)
 {
-    ASSERT(!mMetadataDirty);
+    // Load the entry info from its packed metadata record
+    const CMetadataStore *pkMetadata = pStore->MetadataStore();
+    const CMetadataStore::SRecord *pkRecord = pkMetadata->FindRecord(rkID);
+    ASSERT(pkRecord);
 
-    TString Path = MetadataFilePath();
-    CBinaryReader MetaFile(Path, FOURCC('META'));
+    auto pEntry = std::unique_ptr<CResourceEntry>(new CResourceEntry(pStore));
+    pEntry->mName = pkRecord->Name;
+    pEntry->mCachedUppercaseName = pkRecord->Name.ToUpper();
+    pkMetadata->ReadRecord(rkID, [&pEntry](IArchive& rArc) { pEntry->SerializeEntryInfo(rArc, true); });
 
-    if (MetaFile.IsValid())
-    {
-        SerializeEntryInfo(MetaFile, true);
-        return true;
-    }
-    else
-    {
-        errorf("%s: Failed to load metadata file!", *Path);
-    }
+    // Directories are created while scanning the resources directory, so if it doesn't exist, neither does the resource
+    pEntry->mpDirectory = pStore->GetVirtualDirectory(pkRecord->Directory, false);
 
-    return false;
+    if (!pEntry->mpTypeInfo || !pEntry->mpDirectory || (!pEntry->HasCookedVersion() && !pEntry->HasRawVersion()))
+        return nullptr;
+
+    pEntry->mpDirectory->AddChild("", pEntry.get());
+    return pEntry;
+}
+
+CResourceEntry::~CResourceEntry()
+{
+    delete mpResource.load();
+}
+
+void CResourceEntry::AttachToDirectory(const TString& rkDirPath)
+{
+    // Finish setting up an entry created by BuildFromMetadataFile
+    ASSERT(!mpDirectory);
+    mpDirectory = mpStore->GetVirtualDirectory(rkDirPath, true);
+    ASSERT(mpDirectory);
+    mpDirectory->AddChild("", this);
+
+    // Make sure we're valid
+    ASSERT(HasCookedVersion() || HasRawVersion());
 }
 
 bool CResourceEntry::SaveMetadata(bool ForceSave /*= false*/)
@@ -112,6 +131,13 @@ bool CResourceEntry::SaveMetadata(bool ForceSave /*= false*/)
 
     if (mMetadataDirty || ForceSave)
     {
+        if (CMetadataStore *pMetadata = mpStore->MetadataStore())
+        {
+            const bool Success = pMetadata->WriteRecord(mID, DirectoryPath(), mName, [this](IArchive& rArc) { SerializeEntryInfo(rArc, true); });
+            mMetadataDirty &= !Success;
+            return Success;
+        }
+
         TString Path = MetadataFilePath();
         TString Dir = Path.GetFileDirectory();
         FileUtil::MakeDirectory(Dir);
@@ -166,26 +192,36 @@ void CResourceEntry::UpdateDependencies()
     if (!mpTypeInfo->CanHaveDependencies())
     {
         mpDependencies = std::make_unique<CDependencyTree>();
+        mpStore->InvalidateDependencyGraph();
         return;
     }
 
     bool WasLoaded = IsLoaded();
 
-    if (!mpResource)
-        Load();
+    CResource *pResource = Resource();
+
+    if (!pResource)
+        pResource = Load();
 
-    if (!mpResource)
+    if (!pResource)
     {
         errorf("Unable to update cached dependencies; failed to load resource");
         mpDependencies = std::make_unique<CDependencyTree>();
         return;
     }
 
-    mpDependencies = mpResource->BuildDependencyTree();
+    mpDependencies = pResource->BuildDependencyTree();
     mpStore->SetCacheDirty();
+    mpStore->InvalidateDependencyGraph();
 
     if (!WasLoaded)
-        mpStore->DestroyUnreferencedResources();
+        mpStore->ReleaseUnreferencedResources();
+}
+
+void CResourceEntry::SetDependencies(std::unique_ptr<CDependencyTree>&& pDependencies)
+{
+    // The caller is responsible for marking the store's cache dirty
+    mpDependencies = std::move(pDependencies);
 }
 
 bool CResourceEntry::HasRawVersion() const
@@ -279,8 +315,8 @@ bool CResourceEntry::Save(bool SkipCacheSave /*= false*/, bool FlagForRecook /*=
     {
         ShouldCollectGarbage = !IsLoaded();
 
-        Load();
-        if (!mpResource) return false;
+        CResource *pResource = Load();
+        if (!pResource) return false;
 
         // Note: We call Serialize directly for resources to avoid having a redundant resource root node in the output file.
         TString Path = RawAssetPath();
@@ -291,7 +327,7 @@ bool CResourceEntry::Save(bool SkipCacheSave /*= false*/, bool FlagForRecook /*=
         SerialName.RemoveWhitespace();
 
         CXMLWriter Writer(Path, SerialName, 0, Game());
-        mpResource->Serialize(Writer);
+        pResource->Serialize(Writer);
 
         if (!Writer.Save())
         {
@@ -340,15 +376,14 @@ bool CResourceEntry::Save(bool SkipCacheSave /*= false*/, bool FlagForRecook /*=
     }
 
     if (ShouldCollectGarbage)
-        mpStore->DestroyUnreferencedResources();
+        mpStore->ReleaseUnreferencedResources();
 
     return true;
 }
 
 bool CResourceEntry::Cook()
 {
-    Load();
-    if (!mpResource) return false;
+    if (!Load()) return false;
 
     TString Path = CookedAssetPath();
     TString Dir = Path.GetFileDirectory();
@@ -376,44 +411,66 @@ bool CResourceEntry::Cook()
 
 CResource* CResourceEntry::Load()
 {
+    // Safe to call from any thread. Dependencies are loaded while the latch is held, so two threads
+    // loading resources that reference each other can deadlock; don't do that in parallel.
+    std::lock_guard Lock(mLoadMutex);
+
+    // A raw loader that asks for its own entry again gets the partially loaded resource, same as on one thread
+    if (mpLoadingResource)
+        return mpLoadingResource;
+
+    CResource *pLoaded = mpResource;
+    mpStore->ResourceCache().RecordLoad(this, pLoaded != nullptr);
+
     // If the asset is already loaded then just return it immediately
-    if (mpResource)
-        return mpResource.get();
+    if (pLoaded)
+        return pLoaded;
+
+    TRACE_ZONE(LoadResource);
 
     // Always try to load raw version as the raw version contains extra editor-only data.
     // If there is no raw version (which will be the case for resource types that don't
     // support serialization yet) then load the cooked version as a backup.
     if (HasRawVersion())
     {
-        mpResource = CResourceFactory::CreateResource(this);
+        std::unique_ptr<CResource> pResource = CResourceFactory::CreateResource(this);
 
-        if (mpResource)
+        if (pResource)
         {
-            // Set gpResourceStore to ensure the correct resource store is accessed by loader functions
-            CResourceStore *pOldStore = gpResourceStore;
-            gpResourceStore = mpStore;
-
+            // Ensure the correct resource store is accessed by loader functions
+            CScopedResourceStore StoreScope(mpStore);
             CXMLReader Reader(RawAssetPath());
 
             if (!Reader.IsValid())
             {
                 errorf("Failed to load raw resource; falling back on cooked. Raw path: %s", *RawAssetPath());
-                mpResource.reset();
             }
 
             else
             {
-                mpResource->Serialize(Reader);
+                mpLoadingResource = pResource.get();
+                pResource->Serialize(Reader);
+                mpLoadingResource = nullptr;
+
+                // Only publish the resource once it's fully loaded
+                mpResource = pResource.release();
                 mpStore->TrackLoadedResource(this);
-                gpResourceStore = pOldStore;
+                return mpResource;
             }
         }
-
-        if (mpResource)
-            return mpResource.get();
     }
 
     ASSERT(!mpResource);
+
+    // Use the cooked data if it was already read in the background
+    std::vector<uint8> Prefetched;
+
+    if (mpStore->AsyncLoader()->TakeCookedData(this, Prefetched))
+    {
+        CMemoryInStream Input(Prefetched.data(), Prefetched.size(), EEndian::BigEndian);
+        return LoadCooked(Input);
+    }
+
     if (HasCookedVersion())
     {
         CFileInStream File(CookedAssetPath(), EEndian::BigEndian);
@@ -437,29 +494,34 @@ CResource* CResourceEntry::Load()
 CResource* CResourceEntry::LoadCooked(IInputStream& rInput)
 {
     // Overload to allow for load from an arbitrary input stream.
-    if (mpResource)
-        return mpResource.get();
+    std::lock_guard Lock(mLoadMutex);
+
+    if (CResource *pLoaded = mpResource)
+        return pLoaded;
 
     if (!rInput.IsValid())
         return nullptr;
 
-    // Set gpResourceStore to ensure the correct resource store is accessed by loader functions
-    CResourceStore *pOldStore = gpResourceStore;
-    gpResourceStore = mpStore;
+    // Ensure the correct resource store is accessed by loader functions
+    CScopedResourceStore StoreScope(mpStore);
 
-    mpResource = CResourceFactory::LoadCookedResource(this, rInput);
-    if (mpResource)
-        mpStore->TrackLoadedResource(this);
+    std::unique_ptr<CResource> pResource = CResourceFactory::LoadCookedResource(this, rInput);
+    if (!pResource)
+        return nullptr;
 
-    gpResourceStore = pOldStore;
-    return mpResource.get();
+    mpResource = pResource.release();
+    mpStore->TrackLoadedResource(this);
+    return mpResource;
 }
 
 bool CResourceEntry::Unload()
 {
-    ASSERT(mpResource != nullptr);
-    ASSERT(!mpResource->IsReferenced());
-    mpResource.reset();
+    std::lock_guard Lock(mLoadMutex);
+    CResource *pResource = mpResource;
+    ASSERT(pResource != nullptr);
+    ASSERT(!pResource->IsReferenced());
+    mpResource = nullptr;
+    delete pResource;
     return true;
 }
 
@@ -648,6 +710,7 @@ void CResourceEntry::MarkDeleted(bool InDeleted)
     if (IsMarkedForDeletion() != InDeleted)
     {
         SetFlagEnabled(EResEntryFlag::MarkedForDeletion, InDeleted);
+        mpStore->InvalidateDependencyGraph();
 
         // Restore old name/directory if un-deleting
         if (!InDeleted)
@@ -723,6 +786,15 @@ void CResourceEntry::MarkDeleted(bool InDeleted)
             }
         }
 
+        // Packed metadata records are dropped while the resource is deleted, and written back out when it's restored
+        if (CMetadataStore *pMetadata = mpStore->MetadataStore())
+        {
+            if (InDeleted)
+                pMetadata->RemoveRecord(mID);
+            else
+                SaveMetadata(true);
+        }
+
         mpStore->SetCacheDirty();
         debugf("%s FOR DELETION: [%s] %s", InDeleted ? "MARKED" : "UNMARKED", *ID().ToString(), *CookedPath.GetFileName());
     }
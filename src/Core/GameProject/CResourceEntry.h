@@ -8,7 +8,9 @@
 #include <Common/CAssetID.h>
 #include <Common/CFourCC.h>
 #include <Common/Flags.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 class CDependencyTree;
 class CGameProject;
@@ -29,7 +31,9 @@ DECLARE_FLAGS(EResEntryFlag, FResEntryFlags)
 
 class CResourceEntry
 {
-    std::unique_ptr<CResource> mpResource;
+    // The loaded resource, owned by the entry. Only written under the load latch, and only once the
+    // resource is fully loaded, so other threads can check it without taking the latch.
+    std::atomic<CResource*> mpResource{nullptr};
     CResTypeInfo *mpTypeInfo = nullptr;
     CResourceStore *mpStore;
     std::unique_ptr<CDependencyTree> mpDependencies;
@@ -42,6 +46,13 @@ class CResourceEntry
     mutable uint64 mCachedSize = UINT64_MAX;
     mutable TString mCachedUppercaseName; // This is used to speed up case-insensitive sorting and filtering.
 
+    // Load latch. Concurrent loads of this entry wait here and share the first one's result. It's
+    // recursive so a loader that asks for its own entry again behaves as it does on one thread.
+    std::recursive_mutex mLoadMutex;
+
+    // Raw resource that is still being deserialized. Guarded by the load latch, so only the loading thread sees it.
+    CResource *mpLoadingResource = nullptr;
+
     // Private constructor
     explicit CResourceEntry(CResourceStore *pStore);
 
@@ -50,14 +61,16 @@ public:
                                                              const TString& rkDir, const TString& rkName,
                                                              EResourceType Type, bool ExistingResource = false);
     static std::unique_ptr<CResourceEntry> BuildFromArchive(CResourceStore *pStore, IArchive& rArc);
-    static std::unique_ptr<CResourceEntry> BuildFromDirectory(CResourceStore *pStore, CResTypeInfo *pTypeInfo,
-                                                              const TString& rkDirPath, const TString& rkName);
+    static std::unique_ptr<CResourceEntry> BuildFromMetadataFile(CResourceStore *pStore, CResTypeInfo *pTypeInfo,
+                                                                 const TString& rkMetadataPath, const TString& rkName);
+    static std::unique_ptr<CResourceEntry> BuildFromMetadataStore(CResourceStore *pStore, const CAssetID& rkID);
     ~CResourceEntry();
 
-    bool LoadMetadata();
+    void AttachToDirectory(const TString& rkDirPath);
     bool SaveMetadata(bool ForceSave = false);
     void SerializeEntryInfo(IArchive& rArc, bool MetadataOnly);
     void UpdateDependencies();
+    void SetDependencies(std::unique_ptr<CDependencyTree>&& pDependencies);
 
     bool HasRawVersion() const;
     bool HasCookedVersion() const;
@@ -99,7 +112,7 @@ public:
     bool IsLoaded() const                    { return mpResource != nullptr; }
     bool IsCategorized() const               { return mpDirectory && !mpDirectory->FullPath().CaseInsensitiveCompare( mpStore->DefaultResourceDirPath() ); }
     bool IsNamed() const                     { return mName != mID.ToString(); }
-    CResource* Resource() const              { return mpResource.get(); }
+    CResource* Resource() const              { return mpResource; }
     CResTypeInfo* TypeInfo() const           { return mpTypeInfo; }
     CResourceStore* ResourceStore() const    { return mpStore; }
     CDependencyTree* Dependencies() const    { return mpDependencies.get(); }
@@ -12,7 +12,7 @@ protected:
     CResourceEntry *mpCurEntry = nullptr;
 
 public:
-    explicit CResourceIterator(const CResourceStore *pkStore = gpResourceStore)
+    explicit CResourceIterator(const CResourceStore *pkStore = ActiveResourceStore())
         : mpkStore(pkStore)
     {
         mIter = mpkStore->mResourceEntries.cbegin();
@@ -75,7 +75,7 @@ template<EResourceType ResType>
 class TResourceIterator : public CResourceIterator
 {
 public:
-    explicit TResourceIterator(CResourceStore *pStore = gpResourceStore)
+    explicit TResourceIterator(CResourceStore *pStore = ActiveResourceStore())
         : CResourceIterator(pStore)
     {
         if (mpCurEntry && mpCurEntry->ResourceType() != ResType)
@@ -1,7 +1,14 @@
 #include "CResourceStore.h"
+#include "CAsyncResourceLoader.h"
+#include "CDependencyGraph.h"
+#include "CDependencyRebuildJob.h"
 #include "CGameExporter.h"
 #include "CGameProject.h"
+#include "CMetadataStore.h"
+#include "CResourceDirectoryScan.h"
 #include "CResourceIterator.h"
+#include "Core/CTrace.h"
+#include "Core/IProgressNotifier.h"
 #include "Core/IUIRelay.h"
 #include "Core/Resource/CResource.h"
 #include <Common/Macros.h>
@@ -16,20 +23,26 @@ TString gDataDir;
 bool gResourcesWritable = false;
 bool gTemplatesWritable = false;
 CResourceStore *gpResourceStore = nullptr;
+thread_local CResourceStore *gpThreadResourceStore = nullptr;
 CResourceStore *gpEditorStore = nullptr;
 
 // Constructor for editor store
 CResourceStore::CResourceStore(const TString& rkDatabasePath)
+    : mpAsyncLoader(std::make_unique<CAsyncResourceLoader>(this))
 {
     mpDatabaseRoot = new CVirtualDirectory(this);
     mDatabasePath = FileUtil::MakeAbsolute(rkDatabasePath.GetFileDirectory());
     if ((mDatabasePathExists = FileUtil::IsDirectory(mDatabasePath)))
+    {
+        OpenMetadataStore();
         LoadDatabaseCache();
+    }
 }
 
 // Main constructor for game projects and game exporter
 CResourceStore::CResourceStore(CGameProject *pProject)
     : mGame(EGame::Invalid)
+    , mpAsyncLoader(std::make_unique<CAsyncResourceLoader>(this))
 {
     SetProject(pProject);
 }
@@ -89,6 +102,8 @@ bool CResourceStore::SerializeDatabaseCache(IArchive& rArc)
                     rArc.ParamEnd();
                 }
             }
+
+            InvalidateDependencyGraph();
         }
         else
         {
@@ -204,6 +219,7 @@ void CResourceStore::SetProject(CGameProject *pProj)
     mDatabasePath = mpProj->ProjectRoot();
     mpDatabaseRoot = new CVirtualDirectory(this);
     mGame = mpProj->Game();
+    OpenMetadataStore();
 
     // Clear deleted files from previous runs
     const TString DeletedPath = DeletedResourcePath();
@@ -216,19 +232,21 @@ void CResourceStore::SetProject(CGameProject *pProj)
 
 void CResourceStore::CloseProject()
 {
+    // Pending loads reference entries that are about to be deleted
+    mpAsyncLoader->CancelAll();
+
     // Destroy unreferenced resources first. (This is necessary to avoid invalid memory accesses when
     // various TResPtrs are destroyed. There might be a cleaner solution than this.)
     DestroyUnreferencedResources();
 
     // There should be no loaded resources!!!
     // If there are, that means something didn't clean up resource references properly on project close!!!
-    if (!mLoadedResources.empty())
+    if (NumLoadedResources() > 0)
     {
-        warnf("%d resources still loaded on project close:", mLoadedResources.size());
+        warnf("%d resources still loaded on project close:", NumLoadedResources());
 
-        for (const auto& entry : mLoadedResources)
+        for (const CResourceEntry *pEntry : LoadedResources())
         {
-            const CResourceEntry *pEntry = entry.second;
             warnf("\t%s.%s", *pEntry->Name(), *pEntry->CookedExtension().ToString());
         }
 
@@ -236,7 +254,10 @@ void CResourceStore::CloseProject()
     }
 
     // Delete all entries from old project
+    InvalidateDependencyGraph();
     mResourceEntries.clear();
+    mUncacheableResources.clear();
+    mpMetadataStore.reset();
 
     // Clear deleted files from previous runs
     const TString DeletedPath = DeletedResourcePath();
@@ -330,18 +351,21 @@ bool CResourceStore::AreAllEntriesValid() const
 void CResourceStore::ClearDatabase()
 {
     // THIS OPERATION REQUIRES THAT ALL RESOURCES ARE UNREFERENCED
+    mpAsyncLoader->CancelAll();
     DestroyUnreferencedResources();
 
-    if (!mLoadedResources.empty())
+    if (NumLoadedResources() > 0)
     {
         debugf("ERROR: Resources still loaded:");
-        for (const auto& [asset, entry] : mLoadedResources)
-            debugf("\t[%s] %s", *asset.ToString(), *entry->CookedAssetPath(true));
+        for (const CResourceEntry *pEntry : LoadedResources())
+            debugf("\t[%s] %s", *pEntry->ID().ToString(), *pEntry->CookedAssetPath(true));
         ASSERT(false);
     }
 
     // Clear out existing resource entries and directories
+    InvalidateDependencyGraph();
     mResourceEntries.clear();
+    mUncacheableResources.clear();
 
     delete mpDatabaseRoot;
     mpDatabaseRoot = new CVirtualDirectory(this);
@@ -349,86 +373,104 @@ void CResourceStore::ClearDatabase()
     mDatabaseCacheDirty = true;
 }
 
-bool CResourceStore::BuildFromDirectory(bool ShouldGenerateCacheFile)
+bool CResourceStore::BuildFromDirectory(bool ShouldGenerateCacheFile, IProgressNotifier *pProgress /*= nullptr*/)
 {
     ASSERT(mResourceEntries.empty());
 
-    // Get list of resources
-    TString ResDir = ResourcesDir();
-    TStringList ResourceList;
-    FileUtil::GetDirectoryContents(ResDir, ResourceList);
+    if (pProgress)
+    {
+        pProgress->SetNumTasks(ShouldGenerateCacheFile ? 2 : 1);
+        pProgress->SetTask(0, "Scanning resources");
+    }
+
+    // Get list of resources. Metadata files are read on the job pool; the results are merged in here.
+    CResourceDirectoryScan Scan(this);
+
+    if (!Scan.Run(pProgress))
+        return false;
+
+    for (const TString& rkDir : Scan.Directories())
+        CreateVirtualDirectory(rkDir);
 
-    for (const auto& Path : ResourceList)
+    for (const TString& rkPath : Scan.UnknownFiles())
+        errorf("Found resource but couldn't register because failed to identify resource type: %s", *rkPath);
+
+    for (CResourceDirectoryScan::SResourceFile& rFile : Scan.Files())
     {
-        TString RelPath = Path.ChopFront(ResDir.Size());
+        ASSERT(IsValidResourcePath(rFile.Directory, rFile.Name));
 
-        if (FileUtil::IsFile(Path) && Path.EndsWith(".rsmeta"))
+        if (!rFile.pEntry)
         {
-            // Determine resource name
-            TString DirPath = RelPath.GetFileDirectory();
-            TString CookedFilename = RelPath.GetFileName(false); // This call removes the .rsmeta extension
-            TString ResName = CookedFilename.GetFileName(false); // This call removes the cooked extension
-            ASSERT(IsValidResourcePath(DirPath, ResName));
+            errorf("%s: Failed to load metadata file!", *rFile.MetadataPath);
+            continue;
+        }
 
-            // Determine resource type
-            TString CookedExtension = CookedFilename.GetFileExtension();
-            CResTypeInfo* pTypeInfo = CResTypeInfo::TypeForCookedExtension(Game(), CFourCC(CookedExtension));
+        // Validate the entry
+        const CAssetID ID = rFile.pEntry->ID();
+        ASSERT(mResourceEntries.find(ID) == mResourceEntries.cend());
+        ASSERT(ID.Length() == CAssetID::GameIDLength(mGame));
 
-            if (!pTypeInfo)
-            {
-                errorf("Found resource but couldn't register because failed to identify resource type: %s", *RelPath);
+        rFile.pEntry->AttachToDirectory(rFile.Directory);
+        mResourceEntries.insert_or_assign(ID, std::move(rFile.pEntry));
+    }
+
+    InvalidateDependencyGraph();
+
+    // Register resources that have packed metadata
+    if (mpMetadataStore)
+    {
+        for (const auto& [ID, Record] : mpMetadataStore->Records())
+        {
+            if (mResourceEntries.find(ID) != mResourceEntries.cend())
                 continue;
-            }
 
-            // Create resource entry
-            auto pEntry = CResourceEntry::BuildFromDirectory(this, pTypeInfo, DirPath, ResName);
+            auto pEntry = CResourceEntry::BuildFromMetadataStore(this, ID);
 
-            // Validate the entry
-            const CAssetID ID = pEntry->ID();
-            ASSERT(mResourceEntries.find(ID) == mResourceEntries.cend());
-            ASSERT(ID.Length() == CAssetID::GameIDLength(mGame));
+            if (!pEntry)
+            {
+                warnf("Found metadata for a resource that doesn't exist: [%s] %s%s", *ID.ToString(), *Record.Directory, *Record.Name);
+                continue;
+            }
 
             mResourceEntries.insert_or_assign(ID, std::move(pEntry));
         }
-        else if (FileUtil::IsDirectory(Path))
-        {
-            CreateVirtualDirectory(RelPath);
-        }
+
+        InvalidateDependencyGraph();
     }
 
     // Generate new cache file
     if (ShouldGenerateCacheFile)
     {
-        // Make sure gpResourceStore points to this store
-        CResourceStore *pOldStore = gpResourceStore;
-        gpResourceStore = this;
+        // Make sure loader functions access this store
+        CScopedResourceStore StoreScope(this);
 
         // Make sure audio manager is loaded correctly so AGSC dependencies can be looked up
         if (mpProj)
             mpProj->AudioManager()->LoadAssets();
 
         // Update dependencies
-        for (CResourceIterator It(this); It; ++It)
-            It->UpdateDependencies();
+        if (pProgress)
+            pProgress->SetTask(1, "Generating dependencies");
+
+        CDependencyRebuildJob DependencyJob(this);
+        DependencyJob.AddAllEntries();
+        DependencyJob.Run(pProgress);
 
         // Update database file
         mDatabaseCacheDirty = true;
         ConditionalSaveStore();
-
-        // Restore old gpResourceStore
-        gpResourceStore = pOldStore;
     }
 
     return true;
 }
 
-void CResourceStore::RebuildFromDirectory()
+void CResourceStore::RebuildFromDirectory(IProgressNotifier *pProgress /*= nullptr*/)
 {
     if (mpProj)
         mpProj->AudioManager()->ClearAssets();
 
     ClearDatabase();
-    BuildFromDirectory(true);
+    BuildFromDirectory(true, pProgress);
 }
 
 bool CResourceStore::IsResourceRegistered(const CAssetID& rkID) const
@@ -454,6 +496,7 @@ CResourceEntry* CResourceStore::CreateNewResource(const CAssetID& rkID, EResourc
 
             mResourceEntries.insert_or_assign(rkID, std::move(res));
             mDatabaseCacheDirty = true;
+            InvalidateDependencyGraph();
 
             if (resPtr->IsLoaded())
             {
@@ -490,6 +533,21 @@ CResource* CResourceStore::LoadResource(const CAssetID& rkID)
     return pEntry->Load();
 }
 
+TResourceLoadHandle CResourceStore::LoadResourceAsync(const CAssetID& rkID, EResourceLoadPriority Priority)
+{
+    if (!rkID.IsValid())
+        return nullptr;
+
+    CResourceEntry *pEntry = FindEntry(rkID);
+    if (!pEntry)
+    {
+        warnf("Can't find requested resource with ID \"%s\"", *rkID.ToString());
+        return nullptr;
+    }
+
+    return mpAsyncLoader->Load(pEntry, Priority);
+}
+
 CResource* CResourceStore::LoadResource(const CAssetID& rkID, EResourceType Type)
 {
     CResource *pRes = LoadResource(rkID);
@@ -544,9 +602,30 @@ CResource* CResourceStore::LoadResource(const TString& rkPath)
 
 void CResourceStore::TrackLoadedResource(CResourceEntry *pEntry)
 {
+    // Called from CResourceEntry::Load, which can run on any thread
     ASSERT(pEntry->IsLoaded());
-    ASSERT(mLoadedResources.find(pEntry->ID()) == mLoadedResources.end());
-    mLoadedResources.insert_or_assign(pEntry->ID(), pEntry);
+    SLoadedShard& rShard = LoadedShard(pEntry->ID());
+    std::lock_guard Lock(rShard.Mutex);
+    ASSERT(rShard.Resources.find(pEntry->ID()) == rShard.Resources.end());
+    rShard.Resources.insert_or_assign(pEntry->ID(), pEntry);
+    mNumLoadedResources++;
+    gResourcesLoadedCounter.Add(1);
+}
+
+std::vector<CResourceEntry*> CResourceStore::LoadedResources() const
+{
+    std::vector<CResourceEntry*> Out;
+    Out.reserve(NumLoadedResources());
+
+    for (const SLoadedShard& rkShard : mLoadedShards)
+    {
+        std::lock_guard Lock(rkShard.Mutex);
+
+        for (const auto& [ID, pEntry] : rkShard.Resources)
+            Out.push_back(pEntry);
+    }
+
+    return Out;
 }
 
 void CResourceStore::DestroyUnreferencedResources()
@@ -554,41 +633,137 @@ void CResourceStore::DestroyUnreferencedResources()
     // This can be updated to avoid the do-while loop when reference lookup is implemented.
     uint32 NumDeleted;
 
+    // Unloading is main thread only and must not overlap loads on job threads.
+    mpAsyncLoader->PauseParsing();
+
     do
     {
         NumDeleted = 0;
-        auto It = mLoadedResources.begin();
 
-        while (It != mLoadedResources.end())
+        for (SLoadedShard& rShard : mLoadedShards)
         {
-            CResourceEntry *pEntry = It->second;
+            std::lock_guard Lock(rShard.Mutex);
+            auto It = rShard.Resources.begin();
 
-            if (!pEntry->Resource()->IsReferenced() && pEntry->Unload())
+            while (It != rShard.Resources.end())
             {
-                It = mLoadedResources.erase(It);
-                NumDeleted++;
+                CResourceEntry *pEntry = It->second;
+
+                if (!pEntry->Resource()->IsReferenced() && pEntry->Unload())
+                {
+                    mUncacheableResources.erase(pEntry);
+                    It = rShard.Resources.erase(It);
+                    mNumLoadedResources--;
+                    NumDeleted++;
+                }
+                else
+                {
+                    ++It;
+                }
             }
-            else
+        }
+    } while (NumDeleted > 0);
+
+    // Everything that was cached has either been destroyed or is referenced again
+    mResourceCache.Clear();
+}
+
+void CResourceStore::ReleaseUnreferencedResources()
+{
+    // Like DestroyUnreferencedResources, but unreferenced resources are moved to the resource cache
+    // instead of being unloaded, and only the least recently used ones are unloaded once the cache is
+    // over budget. Unloading a resource can release the last references to its dependencies, so keep
+    // going until a pass doesn't unload anything. Dependencies that were released that way were last
+    // used at the same time as the resource that held them, so they're cached as the oldest resources.
+    mpAsyncLoader->PauseParsing();
+    const bool CacheEnabled = (mResourceCache.Budget() > 0);
+    bool FirstPass = true;
+    bool UnloadedAny;
+
+    do
+    {
+        UnloadedAny = false;
+
+        for (SLoadedShard& rShard : mLoadedShards)
+        {
+            std::lock_guard Lock(rShard.Mutex);
+            auto It = rShard.Resources.begin();
+
+            while (It != rShard.Resources.end())
             {
-                ++It;
+                CResourceEntry *pEntry = It->second;
+
+                if (pEntry->Resource()->IsReferenced())
+                {
+                    mResourceCache.Remove(pEntry);
+                    ++It;
+                }
+                else if (!CacheEnabled || mUncacheableResources.find(pEntry) != mUncacheableResources.end())
+                {
+                    mResourceCache.Remove(pEntry);
+                    mUncacheableResources.erase(pEntry);
+                    pEntry->Unload();
+                    It = rShard.Resources.erase(It);
+                    mNumLoadedResources--;
+                    UnloadedAny = true;
+                }
+                else
+                {
+                    if (!mResourceCache.Contains(pEntry))
+                        mResourceCache.Insert(pEntry, !FirstPass);
+
+                    ++It;
+                }
             }
         }
-    } while (NumDeleted > 0);
+
+        while (mResourceCache.IsOverBudget())
+        {
+            UnloadResource(mResourceCache.LeastRecentlyUsed());
+            mResourceCache.RecordEviction();
+            UnloadedAny = true;
+        }
+
+        FirstPass = false;
+    } while (UnloadedAny);
+}
+
+void CResourceStore::ExcludeLoadedResourcesFromCache()
+{
+    // Used when loaded resources might have changes that were never saved. They'll be
+    // unloaded as soon as they're unreferenced so the next load reads them from disk.
+    for (CResourceEntry *pEntry : LoadedResources())
+        mUncacheableResources.insert(pEntry);
+}
+
+void CResourceStore::SetResourceCacheBudget(uint64 Budget)
+{
+    mResourceCache.SetBudget(Budget);
+    ReleaseUnreferencedResources();
+}
+
+void CResourceStore::UnloadResource(CResourceEntry *pEntry)
+{
+    ASSERT(pEntry->IsLoaded());
+    mResourceCache.Remove(pEntry);
+    mUncacheableResources.erase(pEntry);
+    pEntry->Unload();
+
+    SLoadedShard& rShard = LoadedShard(pEntry->ID());
+    std::lock_guard Lock(rShard.Mutex);
+    const auto It = rShard.Resources.find(pEntry->ID());
+    ASSERT(It != rShard.Resources.end());
+    rShard.Resources.erase(It);
+    mNumLoadedResources--;
 }
 
 bool CResourceStore::DeleteResourceEntry(CResourceEntry *pEntry)
 {
     const CAssetID ID = pEntry->ID();
+    mpAsyncLoader->CancelEntry(pEntry);
 
     if (pEntry->IsLoaded())
-    {
-        if (!pEntry->Unload())
-            return false;
-
-        const auto It = mLoadedResources.find(ID);
-        ASSERT(It != mLoadedResources.end());
-        mLoadedResources.erase(It);
-    }
+        UnloadResource(pEntry);
 
     if (pEntry->Directory())
         pEntry->Directory()->RemoveChildResource(pEntry);
@@ -596,11 +771,114 @@ bool CResourceStore::DeleteResourceEntry(CResourceEntry *pEntry)
     const auto It = mResourceEntries.find(ID);
     ASSERT(It != mResourceEntries.end());
     mResourceEntries.erase(It);
+    InvalidateDependencyGraph();
+
+    if (mpMetadataStore)
+        mpMetadataStore->RemoveRecord(ID);
 
     delete pEntry;
     return true;
 }
 
+CDependencyGraph* CResourceStore::DependencyGraph()
+{
+    if (!mpDependencyGraph)
+        mpDependencyGraph = std::make_unique<CDependencyGraph>(this);
+
+    return mpDependencyGraph.get();
+}
+
+void CResourceStore::InvalidateDependencyGraph()
+{
+    mpDependencyGraph.reset();
+}
+
+bool CResourceStore::MigrateToPackedMetadata()
+{
+    if (mpMetadataStore)
+        return true;
+
+    mpMetadataStore = std::make_unique<CMetadataStore>(MetadataStorePath(), mGame);
+    mpMetadataStore->BeginBulkWrite();
+
+    // Entries without a metadata file have unsaved metadata; that stays unsaved until the entry is next saved
+    std::vector<TString> MigratedFiles;
+
+    for (CResourceIterator It(this); It; ++It)
+    {
+        const TString MetaPath = It->MetadataFilePath();
+
+        if (FileUtil::Exists(MetaPath))
+        {
+            It->SaveMetadata(true);
+            MigratedFiles.push_back(MetaPath);
+        }
+    }
+
+    if (!mpMetadataStore->EndBulkWrite())
+    {
+        errorf("Failed to migrate resource metadata to %s", *MetadataStorePath());
+        mpMetadataStore.reset();
+        FileUtil::DeleteFile(MetadataStorePath());
+        return false;
+    }
+
+    for (const TString& rkPath : MigratedFiles)
+        FileUtil::DeleteFile(rkPath);
+
+    debugf("Migrated %zu metadata files to %s", MigratedFiles.size(), *MetadataStorePath());
+    return true;
+}
+
+bool CResourceStore::MigrateToPerFileMetadata()
+{
+    if (!mpMetadataStore)
+        return true;
+
+    std::unique_ptr<CMetadataStore> pPackedStore = std::move(mpMetadataStore);
+    bool Success = true;
+    uint32 NumMigrated = 0;
+
+    for (CResourceIterator It(this); It; ++It)
+    {
+        if (pPackedStore->FindRecord(It->ID()))
+        {
+            Success &= It->SaveMetadata(true);
+            NumMigrated++;
+        }
+    }
+
+    if (!Success)
+    {
+        errorf("Failed to migrate resource metadata to per-file metadata; keeping %s", *pPackedStore->Path());
+        mpMetadataStore = std::move(pPackedStore);
+        return false;
+    }
+
+    const TString PackedPath = pPackedStore->Path();
+    pPackedStore.reset();
+    FileUtil::DeleteFile(PackedPath);
+
+    debugf("Migrated %u resources from %s to metadata files", NumMigrated, *PackedPath);
+    return true;
+}
+
+void CResourceStore::OpenMetadataStore()
+{
+    // Packed metadata is used if the project has a packed metadata file
+    mpMetadataStore.reset();
+
+    if (FileUtil::Exists(MetadataStorePath()))
+    {
+        mpMetadataStore = std::make_unique<CMetadataStore>(MetadataStorePath(), mGame);
+
+        if (!mpMetadataStore->Load())
+        {
+            errorf("Failed to load packed resource metadata: %s", *MetadataStorePath());
+        }
+    }
+}
+
 #ifdef _WIN32
 static int wrap_fopen(FILE** pFile, const char *filename, const char *mode)
 {
@@ -1,19 +1,30 @@
 #ifndef CRESOURCESTORE_H
 #define CRESOURCESTORE_H
 
+#include "CResourceCache.h"
 #include "CVirtualDirectory.h"
 #include "Core/Resource/EResType.h"
 #include <Common/CAssetID.h>
 #include <Common/CFourCC.h>
 #include <Common/FileUtil.h>
 #include <Common/TString.h>
+#include <array>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
+#include <vector>
 
+class CAsyncResourceLoader;
+class CDependencyGraph;
 class CGameExporter;
 class CGameProject;
+class CMetadataStore;
 class CResource;
+class CResourceLoadRequest;
+class IProgressNotifier;
+enum class EResourceLoadPriority;
 
 enum class EDatabaseVersion
 {
@@ -32,9 +43,33 @@ class CResourceStore
     EGame mGame{EGame::Prime};
     CVirtualDirectory *mpDatabaseRoot = nullptr;
     std::map<CAssetID, std::unique_ptr<CResourceEntry>> mResourceEntries;
-    std::map<CAssetID, CResourceEntry*> mLoadedResources;
+
+    // Loaded resources, split into shards by asset ID so loads on job threads rarely contend
+    struct SLoadedShard
+    {
+        mutable std::mutex Mutex;
+        std::map<CAssetID, CResourceEntry*> Resources;
+    };
+    static constexpr size_t mskNumLoadedShards = 16;
+    std::array<SLoadedShard, mskNumLoadedShards> mLoadedShards;
+    std::atomic<uint32> mNumLoadedResources{0};
     bool mDatabaseCacheDirty = false;
 
+    // Unreferenced resources that are kept loaded until the memory budget runs out
+    CResourceCache mResourceCache;
+
+    // Loaded resources that must be unloaded as soon as they're unreferenced instead of being cached
+    std::set<CResourceEntry*> mUncacheableResources;
+
+    // Background reads for LoadResourceAsync
+    std::unique_ptr<CAsyncResourceLoader> mpAsyncLoader;
+
+    // Compiled dependency trees; built on demand and discarded whenever any dependencies change
+    std::unique_ptr<CDependencyGraph> mpDependencyGraph;
+
+    // Packed entry metadata; null if entries use per-file metadata
+    std::unique_ptr<CMetadataStore> mpMetadataStore;
+
     // Directory paths
     TString mDatabasePath;
     bool mDatabasePathExists = false;
@@ -62,16 +97,25 @@ public:
     CResourceEntry* FindEntry(const TString& rkPath) const;
     bool AreAllEntriesValid() const;
     void ClearDatabase();
-    bool BuildFromDirectory(bool ShouldGenerateCacheFile);
-    void RebuildFromDirectory();
+    bool BuildFromDirectory(bool ShouldGenerateCacheFile, IProgressNotifier *pProgress = nullptr);
+    void RebuildFromDirectory(IProgressNotifier *pProgress = nullptr);
 
     template<typename ResType> ResType* LoadResource(const CAssetID& rkID)  { return static_cast<ResType*>(LoadResource(rkID, ResType::StaticType())); }
     CResource* LoadResource(const CAssetID& rkID);
     CResource* LoadResource(const CAssetID& rkID, EResourceType Type);
     CResource* LoadResource(const TString& rkPath);
+    std::shared_ptr<CResourceLoadRequest> LoadResourceAsync(const CAssetID& rkID, EResourceLoadPriority Priority);
     void TrackLoadedResource(CResourceEntry *pEntry);
+    std::vector<CResourceEntry*> LoadedResources() const;
     void DestroyUnreferencedResources();
+    void ReleaseUnreferencedResources();
+    void ExcludeLoadedResourcesFromCache();
+    void SetResourceCacheBudget(uint64 Budget);
     bool DeleteResourceEntry(CResourceEntry *pEntry);
+    CDependencyGraph* DependencyGraph();
+    void InvalidateDependencyGraph();
+    bool MigrateToPackedMetadata();
+    bool MigrateToPerFileMetadata();
 
     void ImportNamesFromPakContentsTxt(const TString& rkTxtPath, bool UnnamedOnly);
 
@@ -85,13 +129,23 @@ public:
     bool DatabasePathExists() const          { return mDatabasePathExists; }
     TString ResourcesDir() const             { return IsEditorStore() ? DatabaseRootPath() : DatabaseRootPath() + "Resources/"; }
     TString DatabasePath() const             { return DatabaseRootPath() + "ResourceDatabaseCache.bin"; }
+    TString MetadataStorePath() const        { return DatabaseRootPath() + "ResourceMetadata.bin"; }
+    CMetadataStore* MetadataStore() const    { return mpMetadataStore.get(); }
+    bool UsesPackedMetadata() const          { return mpMetadataStore != nullptr; }
     CVirtualDirectory* RootDirectory() const { return mpDatabaseRoot; }
     uint32 NumTotalResources() const         { return mResourceEntries.size(); }
-    uint32 NumLoadedResources() const        { return mLoadedResources.size(); }
+    uint32 NumLoadedResources() const        { return mNumLoadedResources.load(); }
+    CResourceCache& ResourceCache()          { return mResourceCache; }
+    CAsyncResourceLoader* AsyncLoader() const { return mpAsyncLoader.get(); }
     bool IsCacheDirty() const                { return mDatabaseCacheDirty; }
 
     void SetCacheDirty()                     { mDatabaseCacheDirty = true; }
     bool IsEditorStore() const               { return mpProj == nullptr; }
+
+private:
+    SLoadedShard& LoadedShard(const CAssetID& rkID) { return mLoadedShards[rkID.ToLongLong() % mskNumLoadedShards]; }
+    void OpenMetadataStore();
+    void UnloadResource(CResourceEntry *pEntry);
 };
 
 extern TString gDataDir;
@@ -100,4 +154,38 @@ extern bool gTemplatesWritable;
 extern CResourceStore *gpResourceStore;
 extern CResourceStore *gpEditorStore;
 
+/** Overrides gpResourceStore on the calling thread; set with CScopedResourceStore */
+extern thread_local CResourceStore *gpThreadResourceStore;
+
+/** The store that resource loaders and lookups on the calling thread should use */
+inline CResourceStore* ActiveResourceStore()
+{
+    return gpThreadResourceStore ? gpThreadResourceStore : gpResourceStore;
+}
+
+/**
+ * Points the calling thread at a store while a scope runs, so loader functions access the correct store.
+ * Only the thread-local override is changed; gpResourceStore is left alone, so loads on different
+ * threads don't race on it and can be for different stores.
+ */
+class CScopedResourceStore
+{
+    CResourceStore *mpOldStore;
+
+public:
+    explicit CScopedResourceStore(CResourceStore *pStore)
+        : mpOldStore(gpThreadResourceStore)
+    {
+        gpThreadResourceStore = pStore;
+    }
+
+    ~CScopedResourceStore()
+    {
+        gpThreadResourceStore = mpOldStore;
+    }
+
+    CScopedResourceStore(const CScopedResourceStore&) = delete;
+    CScopedResourceStore& operator=(const CScopedResourceStore&) = delete;
+};
+
 #endif // CRESOURCESTORE_H
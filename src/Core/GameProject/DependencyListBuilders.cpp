@@ -180,6 +180,12 @@ void CCharacterUsageMap::ParseDependencyNode(IDependencyNode *pNode)
 // ************ CPackageDependencyListBuilder ************
 void CPackageDependencyListBuilder::BuildDependencyList(bool AllowDuplicates, std::list<CAssetID>& rOut)
 {
+    mpGraph = mpStore->DependencyGraph();
+    mPackageUsedAssets.assign(mpGraph->NumNodes(), false);
+    mAreaUsedAssets.assign(mpGraph->NumNodes(), 0);
+    mAreaGeneration = 1;
+    mClosureUniversalState.assign(mpGraph->NumNodes(), 0);
+
     mEnableDuplicates = AllowDuplicates;
     FindUniversalAreaAssets();
 
@@ -197,7 +203,9 @@ void CPackageDependencyListBuilder::BuildDependencyList(bool AllowDuplicates, st
             continue;
         }
 
-        mIsUniversalAreaAsset = mUniversalAreaAssets.find(rkRes.ID) != mUniversalAreaAssets.cend();
+        const uint32 Node = mpGraph->NodeIndex(rkRes.ID);
+        ASSERT(Node != UINT32_MAX);
+        mIsUniversalAreaAsset = mUniversalAreaAssets[Node];
 
         if (rkRes.Type == "MLVL")
         {
@@ -209,41 +217,40 @@ void CPackageDependencyListBuilder::BuildDependencyList(bool AllowDuplicates, st
             mCharacterUsageMap.FindUsagesForAsset(pEntry);
         }
 
-        AddDependency(nullptr, rkRes.ID, rOut);
+        AddDependency(UINT32_MAX, Node, rOut);
         mpWorld = nullptr;
     }
 }
 
-void CPackageDependencyListBuilder::AddDependency(CResourceEntry *pCurEntry, const CAssetID& rkID, std::list<CAssetID>& rOut)
+void CPackageDependencyListBuilder::AddDependency(uint32 ParentNode, uint32 Node, std::list<CAssetID>& rOut)
 {
-    if (pCurEntry && pCurEntry->ResourceType() == EResourceType::DependencyGroup)
-        return;
-
-    CResourceEntry *pEntry = mpStore->FindEntry(rkID);
-    if (!pEntry)
-        return;
-
-    EResourceType ResType = pEntry->ResourceType();
-
     // Is this entry valid?
-    bool IsValid =  ResType != EResourceType::Midi &&
-                   (ResType != EResourceType::AudioGroup || mGame >= EGame::EchoesDemo) &&
-                   (ResType != EResourceType::World || !pCurEntry) &&
-                   (ResType != EResourceType::Area || !pCurEntry || pCurEntry->ResourceType() == EResourceType::World);
+    if (!mpGraph->IsValidPackageDependency(ParentNode, Node))
+        return;
 
-    if (!IsValid)
+    if (IsAssetUsed(Node) || (!mIsUniversalAreaAsset && mUniversalAreaAssets[Node]))
         return;
 
-    if ((mCurrentAreaHasDuplicates && mAreaUsedAssets.find(rkID) != mAreaUsedAssets.end()) ||
-        (!mCurrentAreaHasDuplicates && mPackageUsedAssets.find(rkID) != mPackageUsedAssets.end()) ||
-        (!mIsUniversalAreaAsset && mUniversalAreaAssets.find(rkID) != mUniversalAreaAssets.end()))
+    // If the result doesn't depend on where we are, add the cached list. Anything in it that
+    // has already been added had its own dependencies added along with it, so it can just be skipped.
+    if (CanUseCachedList(Node))
     {
+        for (const uint32 *pkIt = mpGraph->ClosureBegin(Node); pkIt != mpGraph->ClosureEnd(Node); pkIt++)
+        {
+            if (!IsAssetUsed(*pkIt))
+            {
+                MarkAssetUsed(*pkIt);
+                rOut.push_back(mpGraph->Entry(*pkIt)->ID());
+            }
+        }
         return;
     }
 
     // Entry is valid, parse its sub-dependencies
-    mPackageUsedAssets.insert(rkID);
-    mAreaUsedAssets.insert(rkID);
+    CResourceEntry *pEntry = mpGraph->Entry(Node);
+    const CAssetID ID = pEntry->ID();
+    const EResourceType ResType = mpGraph->Type(Node);
+    MarkAssetUsed(Node);
 
     // New area - toggle duplicates and find character usages
     if (ResType == EResourceType::Area)
@@ -251,14 +258,14 @@ void CPackageDependencyListBuilder::AddDependency(CResourceEntry *pCurEntry, con
         if (mGame <= EGame::Echoes)
             mCharacterUsageMap.FindUsagesForArea(mpWorld, pEntry);
 
-        mAreaUsedAssets.clear();
+        mAreaGeneration++;
         mCurrentAreaHasDuplicates = false;
 
         if (mEnableDuplicates)
         {
             for (size_t iArea = 0; iArea < mpWorld->NumAreas(); iArea++)
             {
-                if (mpWorld->AreaResourceID(iArea) == rkID)
+                if (mpWorld->AreaResourceID(iArea) == ID)
                 {
                     mCurrentAreaHasDuplicates = mpWorld->DoesAreaAllowPakDuplicates(iArea);
                     break;
@@ -269,13 +276,12 @@ void CPackageDependencyListBuilder::AddDependency(CResourceEntry *pCurEntry, con
     // Animset - keep track of the current animset ID
     else if (ResType == EResourceType::AnimSet)
     {
-        mCurrentAnimSetID = rkID;
+        mCurrentAnimSetID = ID;
     }
 
     // Evaluate dependencies of this entry
-    CDependencyTree *pTree = pEntry->Dependencies();
-    EvaluateDependencyNode(pEntry, pTree, rOut);
-    rOut.push_back(rkID);
+    EvaluateOps(Node, mpGraph->OpsBegin(Node), mpGraph->OpsEnd(Node), rOut);
+    rOut.push_back(ID);
 
     // Revert current animset ID
     if (ResType == EResourceType::AnimSet)
@@ -285,60 +291,47 @@ void CPackageDependencyListBuilder::AddDependency(CResourceEntry *pCurEntry, con
         mCurrentAreaHasDuplicates = false;
 }
 
-void CPackageDependencyListBuilder::EvaluateDependencyNode(CResourceEntry *pCurEntry, IDependencyNode *pNode, std::list<CAssetID>& rOut)
+void CPackageDependencyListBuilder::EvaluateOps(uint32 Node, const SDependencyOp *pkBegin, const SDependencyOp *pkEnd, std::list<CAssetID>& rOut)
 {
-    if (!pNode)
-        return;
+    for (const SDependencyOp *pkOp = pkBegin; pkOp < pkEnd; pkOp++)
+    {
+        switch (pkOp->Type)
+        {
+        // Straight resource dependencies should just be added to the tree directly
+        case EDependencyOp::Resource:
+            AddDependency(Node, pkOp->Value, rOut);
+            break;
 
-    const EDependencyNodeType Type = pNode->Type();
-    bool ParseChildren = false;
+        // Anim events should be added if either they apply to characters, or their character index is used
+        case EDependencyOp::AnimEvent:
+            if (pkOp->Extra == UINT32_MAX || mCharacterUsageMap.IsCharacterUsed(mCurrentAnimSetID, pkOp->Extra))
+                AddDependency(Node, pkOp->Value, rOut);
+            break;
 
-    // Straight resource dependencies should just be added to the tree directly
-    if (Type == EDependencyNodeType::Resource || Type == EDependencyNodeType::ScriptProperty || Type == EDependencyNodeType::CharacterProperty)
-    {
-        const auto *pDep = static_cast<CResourceDependency*>(pNode);
-        AddDependency(pCurEntry, pDep->ID(), rOut);
-    }
-    // Anim events should be added if either they apply to characters, or their character index is used
-    else if (Type == EDependencyNodeType::AnimEvent)
-    {
-        const auto *pDep = static_cast<CAnimEventDependency*>(pNode);
-        const uint32 CharIndex = pDep->CharIndex();
+        // Set characters should only be added if their character index is used
+        case EDependencyOp::SetCharacter:
+            if (mCharacterUsageMap.IsCharacterUsed(mCurrentAnimSetID, pkOp->Value) || mIsPlayerActor)
+                EvaluateOps(Node, pkOp + 1, pkOp + 1 + pkOp->Extra, rOut);
 
-        if (CharIndex == UINT32_MAX || mCharacterUsageMap.IsCharacterUsed(mCurrentAnimSetID, CharIndex))
-            AddDependency(pCurEntry, pDep->ID(), rOut);
-    }
-    // Set characters should only be added if their character index is used
-    else if (Type == EDependencyNodeType::SetCharacter)
-    {
-        const auto *pChar = static_cast<CSetCharacterDependency*>(pNode);
-        ParseChildren = mCharacterUsageMap.IsCharacterUsed(mCurrentAnimSetID, pChar->CharSetIndex()) || mIsPlayerActor;
-    }
-    // Set animations should only be added if they're being used by at least one used character
-    else if (Type == EDependencyNodeType::SetAnimation)
-    {
-        auto *pAnim = static_cast<CSetAnimationDependency*>(pNode);
-        ParseChildren = mCharacterUsageMap.IsAnimationUsed(mCurrentAnimSetID, pAnim) || (mIsPlayerActor && pAnim->IsUsedByAnyCharacter());
-    }
-    else
-    {
-        ParseChildren = true;
-    }
+            pkOp += pkOp->Extra;
+            break;
 
-    // Analyze this node's children
-    if (ParseChildren)
-    {
-        if (Type == EDependencyNodeType::ScriptInstance)
-        {
-            const uint32 ObjType = static_cast<CScriptInstanceDependency*>(pNode)->ObjectType();
-            mIsPlayerActor = (ObjType == 0x4C || ObjType == FOURCC('PLAC'));
-        }
+        // Set animations should only be added if they're being used by at least one used character
+        case EDependencyOp::SetAnimation:
+            if (mCharacterUsageMap.IsAnimationUsed(mCurrentAnimSetID, pkOp->pAnim) || (mIsPlayerActor && pkOp->pAnim->IsUsedByAnyCharacter()))
+                EvaluateOps(Node, pkOp + 1, pkOp + 1 + pkOp->Extra, rOut);
 
-        for (size_t iChild = 0; iChild < pNode->NumChildren(); iChild++)
-            EvaluateDependencyNode(pCurEntry, pNode->ChildByIndex(iChild), rOut);
+            pkOp += pkOp->Extra;
+            break;
 
-        if (Type == EDependencyNodeType::ScriptInstance)
+        case EDependencyOp::ScriptInstance:
+            mIsPlayerActor = (pkOp->Value == 0x4C || pkOp->Value == FOURCC('PLAC'));
+            EvaluateOps(Node, pkOp + 1, pkOp + 1 + pkOp->Extra, rOut);
             mIsPlayerActor = false;
+
+            pkOp += pkOp->Extra;
+            break;
+        }
     }
 }
 
@@ -346,6 +339,15 @@ void CPackageDependencyListBuilder::FindUniversalAreaAssets()
 {
     CGameProject *pProject = mpStore->Project();
     CPackage *pPackage = pProject->FindPackage("UniverseArea");
+    mUniversalAreaAssets.assign(mpGraph->NumNodes(), false);
+
+    const auto MarkUniversal = [this](const CAssetID& rkID)
+    {
+        const uint32 Node = mpGraph->NodeIndex(rkID);
+
+        if (Node != UINT32_MAX)
+            mUniversalAreaAssets[Node] = true;
+    };
 
     if (pPackage)
     {
@@ -356,12 +358,12 @@ void CPackageDependencyListBuilder::FindUniversalAreaAssets()
 
             if (rkRes.ID.IsValid())
             {
-                mUniversalAreaAssets.insert(rkRes.ID);
+                MarkUniversal(rkRes.ID);
 
                 // For the universal area world, load it into memory to make sure we can exclude the area/map IDs
                 if (rkRes.Type == "MLVL")
                 {
-                    CWorld *pUniverseWorld = gpResourceStore->LoadResource<CWorld>(rkRes.ID);
+                    CWorld *pUniverseWorld = ActiveResourceStore()->LoadResource<CWorld>(rkRes.ID);
 
                     if (pUniverseWorld)
                     {
@@ -371,7 +373,7 @@ void CPackageDependencyListBuilder::FindUniversalAreaAssets()
                             const CAssetID AreaID = pUniverseWorld->AreaResourceID(AreaIdx);
 
                             if (AreaID.IsValid())
-                                mUniversalAreaAssets.insert(AreaID);
+                                MarkUniversal(AreaID);
                         }
 
                         // Map IDs
@@ -384,7 +386,7 @@ void CPackageDependencyListBuilder::FindUniversalAreaAssets()
                                 const CAssetID DepID = pMapWorld->DependencyByIndex(DepIdx);
 
                                 if (DepID.IsValid())
-                                    mUniversalAreaAssets.insert(DepID);
+                                    MarkUniversal(DepID);
                             }
                         }
                     }
@@ -394,6 +396,43 @@ void CPackageDependencyListBuilder::FindUniversalAreaAssets()
     }
 }
 
+bool CPackageDependencyListBuilder::IsAssetUsed(uint32 Node) const
+{
+    return mCurrentAreaHasDuplicates ? mAreaUsedAssets[Node] == mAreaGeneration : mPackageUsedAssets[Node];
+}
+
+void CPackageDependencyListBuilder::MarkAssetUsed(uint32 Node)
+{
+    mPackageUsedAssets[Node] = true;
+    mAreaUsedAssets[Node] = mAreaGeneration;
+}
+
+bool CPackageDependencyListBuilder::CanUseCachedList(uint32 Node)
+{
+    if (!mUseCachedLists || !mpGraph->HasClosure(Node))
+        return false;
+
+    // Universal area assets are skipped outside of the UniverseArea package, along with everything
+    // only they reference, so any cached list that contains one has to be walked instead.
+    uint8& rState = mClosureUniversalState[Node];
+
+    if (rState == 0)
+    {
+        rState = 1;
+
+        for (const uint32 *pkIt = mpGraph->ClosureBegin(Node); pkIt != mpGraph->ClosureEnd(Node); pkIt++)
+        {
+            if (mUniversalAreaAssets[*pkIt])
+            {
+                rState = 2;
+                break;
+            }
+        }
+    }
+
+    return rState == 1;
+}
+
 // ************ CAreaDependencyListBuilder ************
 void CAreaDependencyListBuilder::BuildDependencyList(std::list<CAssetID>& rAssetsOut, std::list<uint32>& rLayerOffsetsOut, std::set<CAssetID> *pAudioGroupsOut)
 {
@@ -1,6 +1,7 @@
 #ifndef DEPENDENCYLISTBUILDERS
 #define DEPENDENCYLISTBUILDERS
 
+#include "CDependencyGraph.h"
 #include "CDependencyTree.h"
 #include "CGameProject.h"
 #include "CPackage.h"
@@ -36,21 +37,35 @@ protected:
 };
 
 // ************ CPackageDependencyListBuilder ************
+/**
+ * Builds the dependency list for a package by walking the store's compiled dependency graph.
+ * Assets whose dependency lists don't depend on character usage reuse the list cached in the graph;
+ * used assets are tracked in per-node vectors instead of sets.
+ */
 class CPackageDependencyListBuilder
 {
     const CPackage *mpkPackage;
     CResourceStore *mpStore;
+    CDependencyGraph *mpGraph = nullptr;
     EGame mGame;
     TResPtr<CWorld> mpWorld;
     CAssetID mCurrentAnimSetID;
     CCharacterUsageMap mCharacterUsageMap;
-    std::set<CAssetID> mPackageUsedAssets;
-    std::set<CAssetID> mAreaUsedAssets;
-    std::set<CAssetID> mUniversalAreaAssets;
+
+    /** Per node; assets added to the package, and assets added since the current area started (stamped with mAreaGeneration) */
+    std::vector<bool> mPackageUsedAssets;
+    std::vector<uint32> mAreaUsedAssets;
+    uint32 mAreaGeneration = 1;
+
+    /** Per node; assets in the UniverseArea package, and whether each node's cached list contains one (0 = not checked yet) */
+    std::vector<bool> mUniversalAreaAssets;
+    std::vector<uint8> mClosureUniversalState;
+
     bool mEnableDuplicates = false;
     bool mCurrentAreaHasDuplicates = false;
     bool mIsUniversalAreaAsset = false;
     bool mIsPlayerActor = false;
+    bool mUseCachedLists = true;
 
 public:
     explicit CPackageDependencyListBuilder(const CPackage *pkPackage)
@@ -62,9 +77,17 @@ public:
     }
 
     void BuildDependencyList(bool AllowDuplicates, std::list<CAssetID>& rOut);
-    void AddDependency(CResourceEntry *pCurEntry, const CAssetID& rkID, std::list<CAssetID>& rOut);
-    void EvaluateDependencyNode(CResourceEntry *pCurEntry, IDependencyNode *pNode, std::list<CAssetID>& rOut);
+    void AddDependency(uint32 ParentNode, uint32 Node, std::list<CAssetID>& rOut);
+    void EvaluateOps(uint32 Node, const SDependencyOp *pkBegin, const SDependencyOp *pkEnd, std::list<CAssetID>& rOut);
     void FindUniversalAreaAssets();
+
+    /** Walk every asset's dependencies instead of using the graph's cached lists; used to validate them */
+    void SetUseCachedLists(bool Use)    { mUseCachedLists = Use; }
+
+protected:
+    bool IsAssetUsed(uint32 Node) const;
+    void MarkAssetUsed(uint32 Node);
+    bool CanUseCachedList(uint32 Node);
 };
 
 // ************ CAreaDependencyListBuilder ************
@@ -1,9 +1,39 @@
 #include "NCoreTests.h"
+#include "CBinaryDelta.h"
+#include "CJobPool.h"
+#include "CTrace.h"
+#include "IProgressNotifier.h"
 #include "IUIRelay.h"
+#include "Core/GameProject/CAsyncResourceLoader.h"
+#include "Core/GameProject/CDependencyGraph.h"
+#include "Core/GameProject/CDependencyRebuildJob.h"
 #include "Core/GameProject/CGameProject.h"
+#include "Core/GameProject/CMetadataStore.h"
+#include "Core/GameProject/CResourceDirectoryScan.h"
 #include "Core/GameProject/CResourceEntry.h"
 #include "Core/GameProject/CResourceIterator.h"
+#include "Core/GameProject/DependencyListBuilders.h"
+#include "Core/Render/CBoneTransformData.h"
+#include "Core/Render/CFrustumCuller.h"
+#include "Core/Resource/Animation/CAnimSet.h"
+#include "Core/Resource/Area/CGameArea.h"
+#include "Core/Resource/Cooker/CScriptCooker.h"
+#include "Core/Resource/Factory/CAreaLoader.h"
 #include "Core/Resource/Cooker/CResourceCooker.h"
+#include "Core/Resource/Factory/CScriptLoader.h"
+#include "Core/Resource/Script/CLink.h"
+#include "Core/Resource/Script/NGameList.h"
+#include "Core/Resource/Script/Property/CPropertyNameGenerator.h"
+#include "Core/Resource/TResPtr.h"
+#include <Common/CTimer.h>
+#include <Common/FileUtil.h>
+#include <Common/Hash/CCRC32.h>
+#include <Common/Hash/CFNV1A.h>
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <set>
+#include <thread>
 
 namespace NCoreTests
 {
@@ -67,6 +97,178 @@ bool RunTests(int argc, char* argv[])
         return true;
     }
 
+    if( ParseToken("ValidateFrustumCuller", argc, argv) )
+    {
+        ValidateFrustumCuller();
+        return true;
+    }
+
+    if( ParseToken("BenchmarkSkeletonPoses", argc, argv) )
+    {
+        const char* pkSamples = ParseParameter("-samples", argc, argv);
+        const uint NumSamples = (pkSamples ? TString(pkSamples).ToInt32(10) : 100);
+
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkSkeletonPoses(NumSamples);
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkGameTemplateLoad", argc, argv) )
+    {
+        BenchmarkGameTemplateLoad();
+        return true;
+    }
+
+    if( ParseToken("BenchmarkLoadAllGameTemplates", argc, argv) )
+    {
+        const char* pkRuns = ParseParameter("-runs", argc, argv);
+        const uint NumRuns = (pkRuns ? TString(pkRuns).ToInt32(10) : 2);
+        BenchmarkLoadAllGameTemplates(NumRuns);
+        return true;
+    }
+
+    if( ParseToken("BenchmarkScriptLoad", argc, argv) )
+    {
+        const char* pkRuns = ParseParameter("-runs", argc, argv);
+        const uint NumRuns = (pkRuns ? TString(pkRuns).ToInt32(10) : 5);
+
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkScriptLoad(NumRuns);
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkAreaLoad", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkAreaLoad();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkPropertyCopy", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkPropertyCopy();
+        }
+        return true;
+    }
+
+    if( ParseToken("ValidateUndoDeltas", argc, argv) )
+    {
+        const char* pkEdits = ParseParameter("-edits", argc, argv);
+        const uint NumEdits = (pkEdits ? TString(pkEdits).ToInt32(10) : 2000);
+
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            ValidateUndoDeltas(NumEdits);
+        }
+        return true;
+    }
+
+    if( ParseToken("ValidateLinkIndex", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            ValidateLinkIndex();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkPropertyNameHashing", argc, argv) )
+    {
+        BenchmarkPropertyNameHashing();
+        return true;
+    }
+
+    if( ParseToken("BenchmarkPackageDependencies", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkPackageDependencies();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkDependencyRebuild", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkDependencyRebuild();
+        }
+        return true;
+    }
+
+    if( ParseToken("ValidateMetadataStore", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            ValidateMetadataStore();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkDirectoryScan", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkDirectoryScan();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkResourceCache", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkResourceCache();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkAsyncLoading", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            BenchmarkAsyncLoading();
+        }
+        return true;
+    }
+
+    if( ParseToken("StressTestConcurrentLoading", argc, argv) )
+    {
+        if( gpUIRelay->OpenProject(ParseParameter("-project", argc, argv)) )
+        {
+            StressTestConcurrentLoading();
+        }
+        return true;
+    }
+
+    if( ParseToken("BenchmarkProjectOpen", argc, argv) )
+    {
+        const char* pkProject = ParseParameter("-project", argc, argv);
+        const char* pkRuns = ParseParameter("-runs", argc, argv);
+        const uint NumRuns = (pkRuns ? TString(pkRuns).ToInt32(10) : 3);
+
+        if( pkProject )
+        {
+            BenchmarkProjectOpen(pkProject, NumRuns);
+        }
+        return true;
+    }
+
+    if( ParseToken("ValidateTrace", argc, argv) )
+    {
+        const char* pkOutput = ParseParameter("-output", argc, argv);
+        ValidateTrace(pkOutput ? pkOutput : "TraceTest.json");
+        return true;
+    }
+
     // No test being run.
     return false;
 }
@@ -204,4 +406,1950 @@ bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents)
     return TestSuccess;
 }
 
+/** Validate batched frustum culling results match the per-box reference tests */
+bool ValidateFrustumCuller()
+{
+    debugf("Validating frustum culler...");
+
+    // Fixed seed so results are reproducible
+    std::mt19937 Random(0x50574521);
+    std::uniform_real_distribution<float> Coord(-100.f, 100.f);
+    std::uniform_real_distribution<float> Extent(0.f, 20.f);
+    std::uniform_real_distribution<float> Normal(-1.f, 1.f);
+    std::uniform_real_distribution<float> FieldOfView(30.f, 90.f);
+    std::uniform_real_distribution<float> FarDist(50.f, 250.f);
+
+    const uint kNumFrusta = 256;
+    uint NumTested = 0, NumInvalid = 0;
+
+    for (uint iFrustum = 0; iFrustum < kNumFrusta; iFrustum++)
+    {
+        // Arbitrary planes, checked against the scalar reference
+        CFrustumCuller::CPlaneArray Planes;
+
+        for (CFrustumCuller::SCullPlane& rPlane : Planes)
+        {
+            CVector3f PlaneNormal(Normal(Random), Normal(Random), Normal(Random));
+            PlaneNormal = PlaneNormal.Normalized();
+            rPlane = { PlaneNormal.X, PlaneNormal.Y, PlaneNormal.Z, Coord(Random) };
+        }
+
+        // A real view frustum, checked against CFrustumPlanes::BoxInFrustum as used by the scene nodes
+        CVector3f ViewPos(Coord(Random), Coord(Random), Coord(Random));
+        CVector3f ViewDir(Normal(Random), Normal(Random), Normal(Random));
+        ViewDir = ViewDir.Normalized();
+
+        CFrustumPlanes Frustum;
+        Frustum.SetPlanes(ViewPos, ViewDir, FieldOfView(Random), 1.7777777f, 0.1f, FarDist(Random));
+
+        // Vary the box count so partially filled SIMD blocks get covered too
+        const uint NumBoxes = Random() % 100;
+        std::vector<CAABox> Boxes;
+        CFrustumCuller Culler;
+
+        for (uint iBox = 0; iBox < NumBoxes; iBox++)
+        {
+            const CVector3f Min(Coord(Random), Coord(Random), Coord(Random));
+            const CVector3f Max = Min + CVector3f(Extent(Random), Extent(Random), Extent(Random));
+            Boxes.emplace_back(Min, Max);
+            Culler.AddBox(Boxes.back());
+        }
+
+        Culler.Cull(Planes);
+
+        for (uint iBox = 0; iBox < NumBoxes; iBox++)
+        {
+            if (Culler.IsVisible(iBox) != CFrustumCuller::ScalarBoxInFrustum(Planes, Boxes[iBox]))
+                NumInvalid++;
+
+            NumTested++;
+        }
+
+        Culler.Cull(Frustum);
+
+        for (uint iBox = 0; iBox < NumBoxes; iBox++)
+        {
+            if (Culler.IsVisible(iBox) != Frustum.BoxInFrustum(Boxes[iBox]))
+                NumInvalid++;
+
+            NumTested++;
+        }
+    }
+
+    const bool TestSuccess = (NumInvalid == 0);
+    debugf("Test %s; checked %d boxes, %d passed, %d failed",
+           TestSuccess ? "SUCCEEDED" : "FAILED",
+           NumTested, NumTested - NumInvalid, NumInvalid);
+
+    return TestSuccess;
+}
+
+/** Pose every character in every ANCS at many time samples and compare against the recursive skeleton update */
+bool BenchmarkSkeletonPoses(uint NumSamples)
+{
+    debugf("Benchmarking skeleton poses with %d samples per animation...", NumSamples);
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Skeleton benchmark failed; no project loaded");
+        return false;
+    }
+
+    // Gather every skeleton/animation pair up front so loading isn't included in the timings
+    struct SPoseJob
+    {
+        CSkeleton* pSkeleton;
+        CAnimation* pAnim;
+    };
+    std::vector<SPoseJob> Jobs;
+
+    for (TResourceIterator<EResourceType::AnimSet> It(pStore); It; ++It)
+    {
+        CAnimSet* pSet = static_cast<CAnimSet*>(It->Load());
+        if (!pSet) continue;
+
+        for (size_t iChar = 0; iChar < pSet->NumCharacters(); iChar++)
+        {
+            CSkeleton* pSkel = pSet->Character(iChar)->pSkeleton;
+            if (!pSkel || !pSkel->RootBone()) continue;
+
+            for (size_t iAnim = 0; iAnim < pSet->NumAnimations(); iAnim++)
+            {
+                if (CAnimation* pAnim = pSet->FindAnimationAsset(iAnim))
+                    Jobs.push_back(SPoseJob{pSkel, pAnim});
+            }
+        }
+    }
+
+    double RecursiveTime = 0.0, FlatTime = 0.0;
+    float MaxError = 0.f;
+    uint64 NumPoses = 0;
+
+    for (const SPoseJob& rkJob : Jobs)
+    {
+        CBoneTransformData RecursiveData(rkJob.pSkeleton);
+        CBoneTransformData FlatData(rkJob.pSkeleton);
+        const float Step = rkJob.pAnim->Duration() / static_cast<float>(std::max<uint>(NumSamples, 1));
+
+        double StartTime = CTimer::GlobalTime();
+        for (uint iSample = 0; iSample < NumSamples; iSample++)
+            rkJob.pSkeleton->UpdateTransformRecursive(RecursiveData, rkJob.pAnim, Step * iSample, false);
+        RecursiveTime += CTimer::GlobalTime() - StartTime;
+
+        StartTime = CTimer::GlobalTime();
+        for (uint iSample = 0; iSample < NumSamples; iSample++)
+            rkJob.pSkeleton->UpdateTransform(FlatData, rkJob.pAnim, Step * iSample, false);
+        FlatTime += CTimer::GlobalTime() - StartTime;
+
+        // Both buffers now hold the pose for the last sample; make sure they agree
+        for (size_t BoneID = 0; BoneID < RecursiveData.NumTrackedBones(); BoneID++)
+        {
+            const CBone* pkBone = rkJob.pSkeleton->BoneByID(static_cast<uint32>(BoneID));
+            if (!pkBone) continue;
+
+            const float Error = pkBone->TransformedPosition(RecursiveData).Distance(pkBone->TransformedPosition(FlatData));
+            MaxError = std::max(MaxError, Error);
+        }
+
+        NumPoses += NumSamples;
+    }
+
+    // The flat path uses nlerp for rotations while the recursive path uses slerp, so allow for a little drift
+    const bool TestSuccess = (MaxError < 0.005f);
+    debugf( "Test %s; posed %d skeleton/animation pairs, %llu poses. Recursive: %.3fs, flat: %.3fs, max bone position error %f",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Jobs.size()), static_cast<unsigned long long>(NumPoses),
+            RecursiveTime, FlatTime, MaxError );
+
+    return TestSuccess;
+}
+
+/** Time opening every game template in GameList.xml, and then loading all of its sub-templates */
+bool BenchmarkGameTemplateLoad()
+{
+    // Start from a clean slate so previously loaded templates don't skew the results
+    NGameList::Shutdown();
+
+    double TotalOpenTime = 0.0;
+    double TotalFullTime = 0.0;
+    uint NumGames = 0;
+
+    for (int GameIdx = 0; GameIdx < static_cast<int>(EGame::Max); GameIdx++)
+    {
+        const auto Game = static_cast<EGame>(GameIdx);
+
+        double StartTime = CTimer::GlobalTime();
+        CGameTemplate* pGameTemplate = NGameList::GetGameTemplate(Game);
+        const double OpenTime = CTimer::GlobalTime() - StartTime;
+
+        if (!pGameTemplate)
+            continue;
+
+        StartTime = CTimer::GlobalTime();
+        pGameTemplate->LoadAllTemplates();
+        const double FullTime = CTimer::GlobalTime() - StartTime;
+
+        debugf( "%s: %d script templates; open %.3fms, load all %.3fms",
+                *GetGameName(Game), static_cast<int>(pGameTemplate->NumScriptTemplates()),
+                OpenTime * 1000.0, FullTime * 1000.0 );
+
+        TotalOpenTime += OpenTime;
+        TotalFullTime += FullTime;
+        NumGames++;
+    }
+
+    debugf( "Loaded %d game templates. Open: %.3fms, load all: %.3fms",
+            static_cast<int>(NumGames), TotalOpenTime * 1000.0, TotalFullTime * 1000.0 );
+
+    return NumGames > 0;
+}
+
+/** Hash the layout of a property tree, in order */
+static void HashPropertyTree(IProperty* pProperty, CFNV1A& rHash)
+{
+    const TString Name = pProperty->Name();
+    rHash.HashData(*Name, Name.Size());
+    rHash.HashLong(pProperty->ID());
+    rHash.HashLong(static_cast<uint32>(pProperty->Type()));
+    rHash.HashLong(static_cast<uint32>(pProperty->NumChildren()));
+
+    for (size_t ChildIdx = 0; ChildIdx < pProperty->NumChildren(); ChildIdx++)
+        HashPropertyTree(pProperty->ChildByIndex(ChildIdx), rHash);
+}
+
+/** Time NGameList::LoadAllGameTemplates from a clean start, and check every run produces the same templates */
+bool BenchmarkLoadAllGameTemplates(uint NumRuns)
+{
+    uint64 FirstHash = 0;
+    bool AllMatch = true;
+
+    for (uint RunIdx = 0; RunIdx < std::max<uint>(NumRuns, 1); RunIdx++)
+    {
+        // Shutting down also writes out the template caches, so runs after the first will load from them
+        NGameList::Shutdown();
+
+        const double StartTime = CTimer::GlobalTime();
+        NGameList::LoadAllGameTemplates();
+        const double LoadTime = CTimer::GlobalTime() - StartTime;
+
+        CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+        uint NumTemplates = 0;
+
+        for (int GameIdx = 0; GameIdx < static_cast<int>(EGame::Max); GameIdx++)
+        {
+            CGameTemplate* pGameTemplate = NGameList::GetGameTemplate(static_cast<EGame>(GameIdx));
+            if (!pGameTemplate) continue;
+
+            for (uint32 TemplateIdx = 0; TemplateIdx < pGameTemplate->NumScriptTemplates(); TemplateIdx++)
+            {
+                HashPropertyTree(pGameTemplate->TemplateByIndex(TemplateIdx)->Properties(), Hash);
+                NumTemplates++;
+            }
+        }
+
+        const uint64 RunHash = Hash.GetHash64();
+        if (RunIdx == 0)
+            FirstHash = RunHash;
+        else if (RunHash != FirstHash)
+            AllMatch = false;
+
+        debugf( "Run %d: loaded %d script templates in %.3fms (hash %016llX)",
+                static_cast<int>(RunIdx), static_cast<int>(NumTemplates), LoadTime * 1000.0,
+                static_cast<unsigned long long>(RunHash) );
+    }
+
+    debugf( "Test %s; all runs %s", AllMatch ? "SUCCEEDED" : "FAILED", AllMatch ? "loaded identical templates" : "did NOT load identical templates" );
+    return AllMatch;
+}
+
+/** Time reloading the script layers of every area with and without compiled property plans, and check both cook back to the same data */
+bool BenchmarkScriptLoad(uint NumRuns)
+{
+    debugf("Benchmarking script layer loading with %d runs...", NumRuns);
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Script load benchmark failed; no project loaded");
+        return false;
+    }
+
+    // Cook every layer up front with the regular cooker so area loading isn't included in the timings.
+    // Generated objects are written inline, so SCGN instances are covered as well.
+    struct SLayerData
+    {
+        CGameArea* pArea;
+        std::vector<char> Data;
+    };
+    std::vector<SLayerData> Layers;
+    const bool PlansWereEnabled = CScriptPropertyPlan::IsEnabled();
+    CScriptPropertyPlan::SetEnabled(false);
+
+    for (TResourceIterator<EResourceType::Area> It(pStore); It; ++It)
+    {
+        CGameArea* pArea = static_cast<CGameArea*>(It->Load());
+        if (!pArea) continue;
+
+        CScriptCooker Cooker(pArea->Game(), false);
+
+        for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+        {
+            SLayerData& rLayer = Layers.emplace_back();
+            rLayer.pArea = pArea;
+            CVectorOutStream LayerStream(&rLayer.Data, EEndian::BigEndian);
+            Cooker.WriteLayer(LayerStream, pArea->ScriptLayer(LayerIdx));
+        }
+    }
+
+    // Run the regular path first, then the compiled plans
+    bool TestSuccess = true;
+
+    for (const bool UsePlans : {false, true})
+    {
+        CScriptPropertyPlan::SetEnabled(UsePlans);
+
+        double TotalTime = 0.0;
+        uint64 NumInstances = 0;
+        uint NumMismatches = 0;
+
+        for (uint RunIdx = 0; RunIdx < std::max<uint>(NumRuns, 1); RunIdx++)
+        {
+            for (const SLayerData& rkLayer : Layers)
+            {
+                CMemoryInStream LayerStream(rkLayer.Data.data(), rkLayer.Data.size(), EEndian::BigEndian);
+
+                const double StartTime = CTimer::GlobalTime();
+                std::unique_ptr<CScriptLayer> pLayer = CScriptLoader::LoadLayer(LayerStream, rkLayer.pArea, rkLayer.pArea->Game());
+                TotalTime += CTimer::GlobalTime() - StartTime;
+
+                if (!pLayer)
+                {
+                    NumMismatches++;
+                    continue;
+                }
+
+                NumInstances += pLayer->NumInstances();
+
+                // Only need to verify the output once
+                if (RunIdx == 0)
+                {
+                    std::vector<char> NewData;
+                    CVectorOutStream NewStream(&NewData, EEndian::BigEndian);
+                    CScriptCooker(rkLayer.pArea->Game(), false).WriteLayer(NewStream, pLayer.get());
+
+                    if (NewData != rkLayer.Data)
+                        NumMismatches++;
+                }
+            }
+        }
+
+        debugf( "%s: loaded %d layers %d times, %llu instances in %.3fms (%.3fus per instance), %d layers did not round trip",
+                UsePlans ? "Compiled plans" : "Regular path",
+                static_cast<int>(Layers.size()), static_cast<int>(std::max<uint>(NumRuns, 1)),
+                static_cast<unsigned long long>(NumInstances), TotalTime * 1000.0,
+                NumInstances > 0 ? TotalTime * 1000000.0 / NumInstances : 0.0, NumMismatches );
+
+        TestSuccess &= (NumMismatches == 0);
+    }
+
+    CScriptPropertyPlan::SetEnabled(PlansWereEnabled);
+    debugf("Test %s", TestSuccess ? "SUCCEEDED" : "FAILED");
+    return TestSuccess;
+}
+
+/** Time loading every area with serial and parallel script layer loading, and check both produce the same script data */
+bool BenchmarkAreaLoad()
+{
+    debugf("Benchmarking area loading...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Area load benchmark failed; no project loaded");
+        return false;
+    }
+
+    const TString ResourcesDir = pProject->ResourcesDir(false);
+    const bool WasParallel = CAreaLoader::ParallelScriptLoading();
+    double SerialTime = 0.0, ParallelTime = 0.0;
+    uint NumAreas = 0, NumMismatches = 0;
+
+    for (TResourceIterator<EResourceType::Area> It(pStore); It; ++It)
+    {
+        std::vector<char> ScriptData[2];
+        bool Loaded = true;
+
+        for (int Mode = 0; Mode < 2; Mode++)
+        {
+            CFileInStream File(ResourcesDir / It->CookedAssetPath(true), EEndian::BigEndian);
+
+            if (!File.IsValid())
+            {
+                Loaded = false;
+                break;
+            }
+
+            CAreaLoader::SetParallelScriptLoading(Mode == 1);
+            const double StartTime = CTimer::GlobalTime();
+            std::unique_ptr<CGameArea> pArea = CAreaLoader::LoadMREA(File, *It);
+            (Mode == 1 ? ParallelTime : SerialTime) += CTimer::GlobalTime() - StartTime;
+
+            if (!pArea)
+            {
+                Loaded = false;
+                break;
+            }
+
+            // Cook the script layers so the two results can be compared
+            CVectorOutStream ScriptStream(&ScriptData[Mode], EEndian::BigEndian);
+            CScriptCooker Cooker(pArea->Game(), false);
+
+            for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+            {
+                if (CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx))
+                    Cooker.WriteLayer(ScriptStream, pLayer);
+            }
+        }
+
+        if (!Loaded)
+            continue;
+
+        if (ScriptData[0] != ScriptData[1])
+        {
+            errorf("%s: Script data differs between serial and parallel loading", *It->CookedAssetPath(true));
+            NumMismatches++;
+        }
+
+        NumAreas++;
+    }
+
+    CAreaLoader::SetParallelScriptLoading(WasParallel);
+
+    const bool TestSuccess = (NumMismatches == 0);
+    debugf( "Test %s; loaded %d areas. Serial: %.3fms, parallel: %.3fms, %d areas differed",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(NumAreas), SerialTime * 1000.0, ParallelTime * 1000.0, NumMismatches );
+
+    return TestSuccess;
+}
+
+/** Time copying the properties of every script object in every area, check the copies cook to the same data
+ *  as the originals, and check that a copy only stops sharing its data with the original once it is modified */
+bool BenchmarkPropertyCopy()
+{
+    debugf("Benchmarking script property copies...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Property copy benchmark failed; no project loaded");
+        return false;
+    }
+
+    const TString ResourcesDir = pProject->ResourcesDir(false);
+    double SerializeTime = 0.0, CopyTime = 0.0;
+    uint NumObjects = 0, NumMismatches = 0;
+    uint64 SharedBytes = 0;
+
+    for (TResourceIterator<EResourceType::Area> It(pStore); It; ++It)
+    {
+        CFileInStream File(ResourcesDir / It->CookedAssetPath(true), EEndian::BigEndian);
+
+        if (!File.IsValid())
+            continue;
+
+        std::unique_ptr<CGameArea> pArea = CAreaLoader::LoadMREA(File, *It);
+
+        if (!pArea)
+            continue;
+
+        for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+        {
+            CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx);
+
+            if (!pLayer)
+                continue;
+
+            for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+            {
+                CScriptObject* pInst = pLayer->InstanceByIndex(InstIdx);
+                CScriptTemplate* pTemplate = pInst->Template();
+                CStructProperty* pProperties = pTemplate->Properties();
+                CScriptObject SerializedCopy(pInst->InstanceID(), pArea.get(), pLayer, pTemplate);
+                CScriptObject DirectCopy(pInst->InstanceID(), pArea.get(), pLayer, pTemplate);
+
+                // Previous implementation of CScriptObject::CopyProperties, for comparison
+                double StartTime = CTimer::GlobalTime();
+                {
+                    CSerialVersion Version(0, IArchive::skCurrentArchiveVersion, pTemplate->Game());
+                    CVectorOutStream DataStream;
+                    CBasicBinaryWriter DataWriter(&DataStream, Version);
+                    pProperties->SerializeValue(pInst->ReadOnlyPropertyData(), DataWriter);
+
+                    CBasicBinaryReader DataReader(DataStream.Data(), DataStream.Size(), Version);
+                    pProperties->SerializeValue(SerializedCopy.PropertyData(), DataReader);
+                }
+                SerializeTime += CTimer::GlobalTime() - StartTime;
+
+                StartTime = CTimer::GlobalTime();
+                DirectCopy.CopyProperties(pInst);
+                CopyTime += CTimer::GlobalTime() - StartTime;
+
+                // Cook all three and compare
+                std::vector<char> CookedData[3];
+                CScriptObject* Objects[3] = { pInst, &SerializedCopy, &DirectCopy };
+
+                for (int ObjIdx = 0; ObjIdx < 3; ObjIdx++)
+                {
+                    CVectorOutStream Out(&CookedData[ObjIdx], EEndian::BigEndian);
+                    CScriptCooker Cooker(pArea->Game(), false);
+                    Cooker.WriteProperty(Out, pProperties, Objects[ObjIdx]->ReadOnlyPropertyData(), false);
+                }
+
+                if (CookedData[2] != CookedData[0] || CookedData[2] != CookedData[1])
+                {
+                    errorf("%s: Copied properties of instance 0x%08X differ from the original",
+                           *It->CookedAssetPath(true), static_cast<uint32>(pInst->InstanceID()));
+                    NumMismatches++;
+                }
+
+                // The direct copy shares the original's data until one of its properties is written
+                if (!DirectCopy.SharesPropertyData())
+                {
+                    errorf("%s: Copy of instance 0x%08X doesn't share its property data",
+                           *It->CookedAssetPath(true), static_cast<uint32>(pInst->InstanceID()));
+                    NumMismatches++;
+                }
+                else
+                {
+                    SharedBytes += DirectCopy.PropertyDataSize();
+                }
+
+                if (DirectCopy.HasInstanceName())
+                {
+                    const TString OriginalName = pInst->InstanceName();
+                    DirectCopy.SetName(OriginalName + " Copy");
+
+                    if (DirectCopy.SharesPropertyData() || pInst->InstanceName() != OriginalName || DirectCopy.InstanceName() != OriginalName + " Copy")
+                    {
+                        errorf("%s: Renaming a copy of instance 0x%08X didn't give the copy its own property data",
+                               *It->CookedAssetPath(true), static_cast<uint32>(pInst->InstanceID()));
+                        NumMismatches++;
+                    }
+                }
+
+                NumObjects++;
+            }
+        }
+    }
+
+    const bool TestSuccess = (NumMismatches == 0);
+    debugf( "Test %s; copied %d objects. Serialized copy: %.3fms, direct copy: %.3fms, %d objects differed, %.1f KB shared until first write",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(NumObjects), SerializeTime * 1000.0, CopyTime * 1000.0, NumMismatches, SharedBytes / 1024.0 );
+
+    return TestSuccess;
+}
+
+/** Collect the properties that the undo delta test knows how to edit */
+static void GatherEditableProperties(IProperty* pProperty, std::vector<IProperty*>& rOut)
+{
+    switch (pProperty->Type())
+    {
+    case EPropertyType::Bool:
+    case EPropertyType::Int:
+    case EPropertyType::Float:
+    case EPropertyType::Vector:
+    case EPropertyType::String:
+        rOut.push_back(pProperty);
+        break;
+
+    case EPropertyType::Struct:
+        for (size_t ChildIdx = 0; ChildIdx < pProperty->NumChildren(); ChildIdx++)
+            GatherEditableProperties(pProperty->ChildByIndex(ChildIdx), rOut);
+        break;
+
+    default:
+        break;
+    }
+}
+
+/** Replay a scripted property editing session on every area's script objects, recording undo deltas,
+ *  then undo and redo the whole session and check every object ends up back in the right state */
+bool ValidateUndoDeltas(uint NumEdits)
+{
+    debugf("Validating undo deltas...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Undo delta test failed; no project loaded");
+        return false;
+    }
+
+    // Load areas until there are enough objects to edit
+    const TString ResourcesDir = pProject->ResourcesDir(false);
+    std::vector<std::unique_ptr<CGameArea>> Areas;
+    std::vector<CScriptObject*> Objects;
+
+    for (TResourceIterator<EResourceType::Area> It(pStore); It && Objects.size() < NumEdits; ++It)
+    {
+        CFileInStream File(ResourcesDir / It->CookedAssetPath(true), EEndian::BigEndian);
+        if (!File.IsValid()) continue;
+
+        std::unique_ptr<CGameArea> pArea = CAreaLoader::LoadMREA(File, *It);
+        if (!pArea) continue;
+
+        for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+        {
+            if (CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx))
+            {
+                for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+                    Objects.push_back(pLayer->InstanceByIndex(InstIdx));
+            }
+        }
+
+        Areas.push_back(std::move(pArea));
+    }
+
+    if (Objects.empty())
+    {
+        errorf("Undo delta test failed; no script objects found");
+        return false;
+    }
+
+    // Each undo record covers the whole property data of one object, like TSerializeUndoCommand
+    auto SaveState = [](CScriptObject* pInst, std::vector<char>& rOut)
+    {
+        CVectorOutStream Out(&rOut, EEndian::SystemEndian);
+        CBasicBinaryWriter Writer(&Out, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, pInst->Template()->Game()));
+        pInst->Template()->Properties()->SerializeValue(pInst->PropertyData(), Writer);
+    };
+
+    auto RestoreState = [](CScriptObject* pInst, std::vector<char>& rData)
+    {
+        CBasicBinaryReader Reader(rData.data(), rData.size(), CSerialVersion(IArchive::skCurrentArchiveVersion, 0, pInst->Template()->Game()));
+        pInst->Template()->Properties()->SerializeValue(pInst->PropertyData(), Reader);
+    };
+
+    std::vector<std::vector<char>> InitialStates(Objects.size());
+
+    for (size_t ObjIdx = 0; ObjIdx < Objects.size(); ObjIdx++)
+        SaveState(Objects[ObjIdx], InitialStates[ObjIdx]);
+
+    struct SRecord
+    {
+        size_t ObjectIndex;
+        CBinaryDelta Delta;
+    };
+    std::vector<SRecord> Records;
+
+    // Fixed seed so results are reproducible
+    std::mt19937 Random(0x50574521);
+    size_t FullSnapshotMemory = 0;
+    uint NumMergedEdits = 0;
+    bool Success = true;
+
+    for (uint EditIdx = 0; EditIdx < NumEdits; EditIdx++)
+    {
+        const size_t ObjIdx = Random() % Objects.size();
+        CScriptObject* pInst = Objects[ObjIdx];
+        void* pData = pInst->PropertyData();
+
+        std::vector<IProperty*> Editable;
+        GatherEditableProperties(pInst->Template()->Properties(), Editable);
+        if (Editable.empty()) continue;
+
+        IProperty* pProperty = Editable[Random() % Editable.size()];
+
+        // One in four edits is a drag that gets merged into a single undo record, like a spin box being dragged
+        const uint NumSteps = (Random() % 4 == 0 ? 8 : 1);
+        std::vector<char> OldState, NewState;
+        SaveState(pInst, OldState);
+
+        for (uint StepIdx = 0; StepIdx < NumSteps; StepIdx++)
+        {
+            switch (pProperty->Type())
+            {
+            case EPropertyType::Bool:   TPropCast<CBoolProperty>(pProperty)->ValueRef(pData) = (StepIdx % 2 == 0);   break;
+            case EPropertyType::Int:    TPropCast<CIntProperty>(pProperty)->ValueRef(pData) += 7;                    break;
+            case EPropertyType::Float:  TPropCast<CFloatProperty>(pProperty)->ValueRef(pData) += 1.5f;               break;
+            case EPropertyType::Vector: TPropCast<CVectorProperty>(pProperty)->ValueRef(pData) += CVector3f(1, 2, 3); break;
+            case EPropertyType::String: TPropCast<CStringProperty>(pProperty)->ValueRef(pData) += "_edit";           break;
+            default: break;
+            }
+
+            NewState.clear();
+            SaveState(pInst, NewState);
+
+            if (StepIdx == 0)
+            {
+                Records.push_back(SRecord{ObjIdx, CBinaryDelta::Create(OldState, NewState)});
+            }
+            else
+            {
+                // Merge the same way the undo commands do: walk back from the current state to the record's old state
+                CBinaryDelta StepDelta = CBinaryDelta::Create(OldState, NewState);
+                std::vector<char> MergedOld = NewState;
+                Success &= StepDelta.ApplyBackward(MergedOld) && Records.back().Delta.ApplyBackward(MergedOld);
+                Records.back().Delta = CBinaryDelta::Create(MergedOld, NewState);
+                NumMergedEdits++;
+            }
+
+            // A full snapshot command keeps both states
+            FullSnapshotMemory += (StepIdx == 0 ? OldState.size() + NewState.size() : 0);
+            OldState = NewState;
+        }
+    }
+
+    // Final states, for checking redo
+    std::vector<std::vector<char>> FinalStates(Objects.size());
+
+    for (size_t ObjIdx = 0; ObjIdx < Objects.size(); ObjIdx++)
+        SaveState(Objects[ObjIdx], FinalStates[ObjIdx]);
+
+    size_t DeltaMemory = 0;
+
+    for (const SRecord& rkRecord : Records)
+        DeltaMemory += rkRecord.Delta.MemoryUsage();
+
+    // Undo everything, then redo everything
+    for (int Pass = 0; Pass < 2; Pass++)
+    {
+        const bool Redo = (Pass == 1);
+
+        for (size_t Step = 0; Step < Records.size(); Step++)
+        {
+            const SRecord& rkRecord = Records[Redo ? Step : Records.size() - Step - 1];
+            CScriptObject* pInst = Objects[rkRecord.ObjectIndex];
+            std::vector<char> State;
+            SaveState(pInst, State);
+
+            if (Redo ? rkRecord.Delta.ApplyForward(State) : rkRecord.Delta.ApplyBackward(State))
+            {
+                RestoreState(pInst, State);
+            }
+            else
+            {
+                errorf("%s of edit %d failed; object state doesn't match the delta", Redo ? "Redo" : "Undo", static_cast<int>(Step));
+                Success = false;
+            }
+        }
+
+        const std::vector<std::vector<char>>& rkExpected = (Redo ? FinalStates : InitialStates);
+
+        for (size_t ObjIdx = 0; ObjIdx < Objects.size(); ObjIdx++)
+        {
+            std::vector<char> State;
+            SaveState(Objects[ObjIdx], State);
+
+            if (State != rkExpected[ObjIdx])
+            {
+                errorf("Instance 0x%08X doesn't match its %s state after %s", static_cast<uint32>(Objects[ObjIdx]->InstanceID()),
+                       Redo ? "final" : "initial", Redo ? "redo" : "undo");
+                Success = false;
+            }
+        }
+    }
+
+    // Deltas should be far smaller than storing both full states of each object
+    Success &= (DeltaMemory < FullSnapshotMemory);
+
+    debugf( "Test %s; %d undo records (%d merged edits) on %d objects. Full snapshots: %d KB, deltas: %d KB",
+            Success ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Records.size()), static_cast<int>(NumMergedEdits), static_cast<int>(Objects.size()),
+            static_cast<int>(FullSnapshotMemory / 1024), static_cast<int>(DeltaMemory / 1024) );
+
+    return Success;
+}
+
+/** Check the cached link indices of a loaded area against the objects' link lists */
+static uint CheckAreaLinks(CGameArea* pArea, const TString& rkAreaName)
+{
+    uint NumErrors = 0;
+
+    for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+    {
+        CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx);
+
+        for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+        {
+            CScriptObject* pInst = pLayer->InstanceByIndex(InstIdx);
+
+            for (size_t LinkIdx = 0; LinkIdx < pInst->NumLinks(ELinkType::Outgoing); LinkIdx++)
+            {
+                if (pInst->Link(ELinkType::Outgoing, LinkIdx)->SenderIndex() != LinkIdx)
+                {
+                    errorf("%s: Outgoing link %d of instance 0x%08X has the wrong sender index",
+                           *rkAreaName, static_cast<int>(LinkIdx), static_cast<uint32>(pInst->InstanceID()));
+                    NumErrors++;
+                }
+            }
+
+            for (size_t LinkIdx = 0; LinkIdx < pInst->NumLinks(ELinkType::Incoming); LinkIdx++)
+            {
+                if (pInst->Link(ELinkType::Incoming, LinkIdx)->ReceiverIndex() != LinkIdx)
+                {
+                    errorf("%s: Incoming link %d of instance 0x%08X has the wrong receiver index",
+                           *rkAreaName, static_cast<int>(LinkIdx), static_cast<uint32>(pInst->InstanceID()));
+                    NumErrors++;
+                }
+            }
+        }
+    }
+
+    return NumErrors;
+}
+
+/** Write out every object's link lists in order, for comparing two copies of an area */
+static std::vector<uint32> DumpAreaLinks(CGameArea* pArea)
+{
+    std::vector<uint32> Out;
+
+    for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+    {
+        CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx);
+
+        for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+        {
+            CScriptObject* pInst = pLayer->InstanceByIndex(InstIdx);
+
+            for (ELinkType Type : { ELinkType::Outgoing, ELinkType::Incoming })
+            {
+                Out.push_back(pInst->NumLinks(Type));
+
+                for (size_t LinkIdx = 0; LinkIdx < pInst->NumLinks(Type); LinkIdx++)
+                {
+                    const CLink* pkLink = pInst->Link(Type, LinkIdx);
+                    Out.insert(Out.end(), { pkLink->SenderID(), pkLink->ReceiverID(), pkLink->State(), pkLink->Message() });
+                }
+            }
+        }
+    }
+
+    return Out;
+}
+
+bool ValidateLinkIndex()
+{
+    debugf("Validating script link index...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Link index test failed; no project loaded");
+        return false;
+    }
+
+    const TString ResourcesDir = pProject->ResourcesDir(false);
+    double SingleTime = 0.0, BatchTime = 0.0;
+    uint NumAreas = 0, NumDeleted = 0, NumErrors = 0;
+
+    for (TResourceIterator<EResourceType::Area> It(pStore); It; ++It)
+    {
+        const TString AreaPath = ResourcesDir / It->CookedAssetPath(true);
+        std::unique_ptr<CGameArea> pAreas[2];
+
+        for (auto& pArea : pAreas)
+        {
+            CFileInStream File(AreaPath, EEndian::BigEndian);
+
+            if (File.IsValid())
+                pArea = CAreaLoader::LoadMREA(File, *It);
+        }
+
+        if (!pAreas[0] || !pAreas[1])
+            continue;
+
+        NumErrors += CheckAreaLinks(pAreas[0].get(), It->CookedAssetPath(true));
+
+        // Delete every other outgoing link in the area, one at a time in the first copy and as one batch in the second
+        std::vector<CLink*> ToDelete[2];
+
+        for (int AreaIdx = 0; AreaIdx < 2; AreaIdx++)
+        {
+            CGameArea* pArea = pAreas[AreaIdx].get();
+
+            for (size_t LayerIdx = 0; LayerIdx < pArea->NumScriptLayers(); LayerIdx++)
+            {
+                CScriptLayer* pLayer = pArea->ScriptLayer(LayerIdx);
+
+                for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+                {
+                    CScriptObject* pInst = pLayer->InstanceByIndex(InstIdx);
+
+                    for (size_t LinkIdx = 0; LinkIdx < pInst->NumLinks(ELinkType::Outgoing); LinkIdx += 2)
+                        ToDelete[AreaIdx].push_back(pInst->Link(ELinkType::Outgoing, LinkIdx));
+                }
+            }
+        }
+
+        double StartTime = CTimer::GlobalTime();
+        for (CLink* pLink : ToDelete[0])
+        {
+            if (CScriptObject* pSender = pLink->Sender())
+                pSender->RemoveLink(ELinkType::Outgoing, pLink);
+            if (CScriptObject* pReceiver = pLink->Receiver())
+                pReceiver->RemoveLink(ELinkType::Incoming, pLink);
+
+            delete pLink;
+        }
+        SingleTime += CTimer::GlobalTime() - StartTime;
+
+        StartTime = CTimer::GlobalTime();
+        pAreas[1]->DeleteLinks(ToDelete[1]);
+        BatchTime += CTimer::GlobalTime() - StartTime;
+
+        NumDeleted += ToDelete[1].size();
+        NumErrors += CheckAreaLinks(pAreas[1].get(), It->CookedAssetPath(true));
+
+        if (DumpAreaLinks(pAreas[0].get()) != DumpAreaLinks(pAreas[1].get()))
+        {
+            errorf("%s: Batched link deletion left different links than deleting links one at a time", *It->CookedAssetPath(true));
+            NumErrors++;
+        }
+
+        NumAreas++;
+    }
+
+    const bool TestSuccess = (NumErrors == 0);
+    debugf( "Test %s; checked %d areas, deleted %d links. One at a time: %.3fms, batched: %.3fms, %d errors",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(NumAreas), static_cast<int>(NumDeleted), SingleTime * 1000.0, BatchTime * 1000.0, NumErrors );
+
+    return TestSuccess;
+}
+
+bool BenchmarkPropertyNameHashing()
+{
+    debugf("Benchmarking property name hashing...");
+
+    // Load the generator word list
+    std::vector<TString> Words;
+    FILE* pListFile = std::fopen(*(gDataDir + "resources/WordList.txt"), "r");
+
+    if (!pListFile)
+    {
+        errorf("Property name hashing benchmark failed; couldn't open the word list");
+        return false;
+    }
+
+    char WordBuffer[64];
+
+    while (std::fgets(WordBuffer, sizeof(WordBuffer), pListFile))
+    {
+        TString Word = TString(WordBuffer).Trimmed();
+
+        if (!Word.IsEmpty())
+        {
+            Word[0] = TString::CharToUpper(Word[0]);
+            Words.push_back(Word);
+        }
+    }
+
+    std::fclose(pListFile);
+
+    const std::vector<TString> TypeNames = { "bool", "int", "float", "choice", "asset", "struct", "Vector", "Color" };
+    const uint32 NumWords = Words.size();
+    const uint32 NumTypes = TypeNames.size();
+    const TString Suffix;
+
+    // Hash every two word name with CCRC32, caching the hash of the first word like the generator used to
+    std::vector<uint32> ScalarIDs(static_cast<size_t>(NumWords) * NumWords * NumTypes);
+    double StartTime = CTimer::GlobalTime();
+
+    for (uint32 FirstIdx = 0; FirstIdx < NumWords; FirstIdx++)
+    {
+        CCRC32 FirstHash;
+        FirstHash.Hash(*Words[FirstIdx]);
+
+        for (uint32 LastIdx = 0; LastIdx < NumWords; LastIdx++)
+        {
+            CCRC32 BaseHash = FirstHash;
+            BaseHash.Hash(*Words[LastIdx]);
+            BaseHash.Hash(*Suffix);
+
+            for (uint32 TypeIdx = 0; TypeIdx < NumTypes; TypeIdx++)
+            {
+                CCRC32 FullHash = BaseHash;
+                FullHash.Hash(*TypeNames[TypeIdx]);
+                ScalarIDs[(static_cast<size_t>(FirstIdx) * NumWords + LastIdx) * NumTypes + TypeIdx] = FullHash.Digest();
+            }
+        }
+    }
+
+    const double ScalarTime = CTimer::GlobalTime() - StartTime;
+
+    // Same names with the batched kernel
+    std::vector<uint32> KernelIDs(ScalarIDs.size());
+    std::vector<uint32> Rows;
+    CPropertyNameHashKernel Kernel;
+    Kernel.Init(Words, TypeNames, "", Suffix, ENameCasing::PascalCase);
+    StartTime = CTimer::GlobalTime();
+
+    for (uint32 FirstIdx = 0; FirstIdx < NumWords; FirstIdx++)
+    {
+        const uint32 StemHash = Kernel.AppendWord(Kernel.PrefixHash(), FirstIdx, true);
+        Kernel.PrepareLastWords(StemHash, Rows);
+        Kernel.HashLastWords(Rows, false, 0, NumWords, &KernelIDs[static_cast<size_t>(FirstIdx) * NumWords * NumTypes]);
+    }
+
+    const double KernelTime = CTimer::GlobalTime() - StartTime;
+
+    size_t NumMismatches = 0;
+
+    for (size_t IdIdx = 0; IdIdx < ScalarIDs.size(); IdIdx++)
+    {
+        if (ScalarIDs[IdIdx] != KernelIDs[IdIdx])
+            NumMismatches++;
+    }
+
+    const bool TestSuccess = (NumMismatches == 0);
+    const double NumIDs = static_cast<double>(ScalarIDs.size());
+    debugf( "Test %s; hashed %.0f IDs. CCRC32: %.3fms (%.1fM IDs/s), batched: %.3fms (%.1fM IDs/s), %d mismatches",
+            TestSuccess ? "SUCCEEDED" : "FAILED", NumIDs,
+            ScalarTime * 1000.0, NumIDs / ScalarTime / 1000000.0,
+            KernelTime * 1000.0, NumIDs / KernelTime / 1000000.0,
+            static_cast<int>(NumMismatches) );
+
+    return TestSuccess;
+}
+
+/** Time building the dependency graph and every package's dependency list, and check the cached lists give the same result as walking every asset */
+bool BenchmarkPackageDependencies()
+{
+    debugf("Benchmarking package dependency lists...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Package dependency benchmark failed; no project loaded");
+        return false;
+    }
+
+    pStore->InvalidateDependencyGraph();
+    double StartTime = CTimer::GlobalTime();
+    const CDependencyGraph* pkGraph = pStore->DependencyGraph();
+    const double GraphTime = CTimer::GlobalTime() - StartTime;
+
+    uint NumCached = 0;
+
+    for (uint32 Node = 0; Node < pkGraph->NumNodes(); Node++)
+    {
+        if (pkGraph->HasClosure(Node))
+            NumCached++;
+    }
+
+    double CachedTime = 0.0, WalkTime = 0.0;
+    uint NumAssets = 0, NumMismatches = 0;
+
+    for (size_t PackageIdx = 0; PackageIdx < pProject->NumPackages(); PackageIdx++)
+    {
+        const CPackage* pkPackage = pProject->PackageByIndex(PackageIdx);
+        std::list<CAssetID> AssetLists[2];
+
+        for (int Mode = 0; Mode < 2; Mode++)
+        {
+            CPackageDependencyListBuilder Builder(pkPackage);
+            Builder.SetUseCachedLists(Mode == 0);
+
+            StartTime = CTimer::GlobalTime();
+            Builder.BuildDependencyList(true, AssetLists[Mode]);
+            (Mode == 0 ? CachedTime : WalkTime) += CTimer::GlobalTime() - StartTime;
+        }
+
+        if (AssetLists[0] != AssetLists[1])
+        {
+            errorf("%s: Dependency list differs between cached and walked dependencies (%d vs %d assets)",
+                   *pkPackage->Name(), static_cast<int>(AssetLists[0].size()), static_cast<int>(AssetLists[1].size()));
+            NumMismatches++;
+        }
+
+        NumAssets += AssetLists[0].size();
+    }
+
+    const bool TestSuccess = (NumMismatches == 0);
+    debugf( "Test %s; %d nodes (%d cached), graph built in %.3fms. %d packages, %d assets. Cached: %.3fms, walked: %.3fms, %d packages differed",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(pkGraph->NumNodes()), static_cast<int>(NumCached), GraphTime * 1000.0,
+            static_cast<int>(pProject->NumPackages()), static_cast<int>(NumAssets), CachedTime * 1000.0, WalkTime * 1000.0, NumMismatches );
+
+    return TestSuccess;
+}
+
+static std::vector<char> SerializeDependencies(CResourceEntry* pEntry)
+{
+    std::vector<char> Data;
+
+    if (CDependencyTree* pTree = pEntry->Dependencies())
+    {
+        CVectorOutStream Out(&Data, EEndian::SystemEndian);
+        CBasicBinaryWriter Writer(&Out, 0, pEntry->Game());
+        pTree->Serialize(Writer);
+    }
+
+    return Data;
+}
+
+/** Time regenerating every resource's dependencies one entry at a time and with a batched rebuild job, and check both give the same trees */
+bool BenchmarkDependencyRebuild()
+{
+    debugf("Benchmarking dependency rebuild...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Dependency rebuild benchmark failed; no project loaded");
+        return false;
+    }
+
+    std::vector<CResourceEntry*> Entries;
+
+    for (CResourceIterator It(pStore); It; ++It)
+        Entries.push_back(*It);
+
+    // Rebuild one entry at a time
+    std::vector<std::vector<char>> SerialTrees(Entries.size());
+    double StartTime = CTimer::GlobalTime();
+
+    for (CResourceEntry* pEntry : Entries)
+        pEntry->UpdateDependencies();
+
+    const double SerialTime = CTimer::GlobalTime() - StartTime;
+
+    for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+        SerialTrees[EntryIdx] = SerializeDependencies(Entries[EntryIdx]);
+
+    // Rebuild with the batched job
+    CDependencyRebuildJob Job(pStore);
+    Job.AddAllEntries();
+
+    StartTime = CTimer::GlobalTime();
+    const bool JobSuccess = Job.Run();
+    const double JobTime = CTimer::GlobalTime() - StartTime;
+
+    uint NumMismatches = 0;
+
+    for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+    {
+        if (SerializeDependencies(Entries[EntryIdx]) != SerialTrees[EntryIdx])
+        {
+            errorf("%s: Dependencies differ between serial and batched rebuild", *Entries[EntryIdx]->CookedAssetPath(true));
+            NumMismatches++;
+        }
+    }
+
+    const bool TestSuccess = JobSuccess && (NumMismatches == 0);
+    debugf( "Test %s; rebuilt dependencies for %d resources. Serial: %.3fms, batched: %.3fms, %d resources differed",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Entries.size()), SerialTime * 1000.0, JobTime * 1000.0, NumMismatches );
+
+    return TestSuccess;
+}
+
+static std::map<CAssetID, std::vector<char>> SnapshotEntryMetadata(CResourceStore* pStore)
+{
+    std::map<CAssetID, std::vector<char>> Snapshot;
+
+    for (CResourceIterator It(pStore); It; ++It)
+    {
+        std::vector<char>& rData = Snapshot[It->ID()];
+        CVectorOutStream Out(&rData, EEndian::SystemEndian);
+        Out.WriteString(It->DirectoryPath());
+        Out.WriteString(It->Name());
+
+        CBasicBinaryWriter Writer(&Out, 0, pStore->Game());
+        It->SerializeEntryInfo(Writer, true);
+    }
+
+    return Snapshot;
+}
+
+static double RebuildEntriesFromDirectory(CResourceStore* pStore)
+{
+    const double StartTime = CTimer::GlobalTime();
+    pStore->ClearDatabase();
+    pStore->BuildFromDirectory(false);
+    return CTimer::GlobalTime() - StartTime;
+}
+
+/** Migrate the project's metadata to the packed store and back, rebuilding the database from each, and check every entry's metadata survives */
+bool ValidateMetadataStore()
+{
+    debugf("Validating packed metadata store...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+    CGameProject* pProject = (pStore ? pStore->Project() : nullptr);
+
+    if (!pProject)
+    {
+        errorf("Metadata store validation failed; no project loaded");
+        return false;
+    }
+
+    // The database can only be cleared with nothing loaded
+    pProject->AudioManager()->ClearAssets();
+    pStore->DestroyUnreferencedResources();
+
+    // Start from per-file metadata. Entries without saved metadata aren't rebuilt from either format,
+    // so the reference snapshot is taken from the rebuilt database.
+    const bool WasPacked = pStore->UsesPackedMetadata();
+    pStore->MigrateToPerFileMetadata();
+    const double PerFileTime = RebuildEntriesFromDirectory(pStore);
+
+    const std::map<CAssetID, std::vector<char>> Original = SnapshotEntryMetadata(pStore);
+    uint NumMismatches = 0;
+
+    const auto CheckSnapshot = [&](const char* pkMode)
+    {
+        const std::map<CAssetID, std::vector<char>> Current = SnapshotEntryMetadata(pStore);
+
+        for (const auto& [ID, Data] : Original)
+        {
+            const auto Find = Current.find(ID);
+
+            if (Find == Current.cend() || Find->second != Data)
+            {
+                errorf("[%s] %s metadata differs from the original", *ID.ToString(), pkMode);
+                NumMismatches++;
+            }
+        }
+
+        if (Current.size() != Original.size())
+        {
+            errorf("%s database has %d entries, expected %d", pkMode, static_cast<int>(Current.size()), static_cast<int>(Original.size()));
+            NumMismatches++;
+        }
+    };
+
+    // Packed metadata
+    double StartTime = CTimer::GlobalTime();
+    const bool MigrateSuccess = pStore->MigrateToPackedMetadata();
+    const double MigrateTime = CTimer::GlobalTime() - StartTime;
+    const double PackedTime = RebuildEntriesFromDirectory(pStore);
+    CheckSnapshot("Packed");
+
+    // Rewrite every record, then make sure the compacted log reads back the same records
+    CMetadataStore* pMetadata = pStore->MetadataStore();
+    uint NumLogRecords = 0;
+
+    if (pMetadata)
+    {
+        for (CResourceIterator It(pStore); It; ++It)
+            It->SaveMetadata(true);
+
+        NumLogRecords = pMetadata->NumLogRecords();
+        pMetadata->Compact();
+
+        CMetadataStore Reloaded(pMetadata->Path(), pStore->Game());
+
+        if (!Reloaded.Load() || Reloaded.NumRecords() != pMetadata->NumRecords() || Reloaded.NumLogRecords() != pMetadata->NumRecords())
+        {
+            errorf("Compacted metadata store doesn't match the original (%d records, %d in the reloaded log)",
+                   static_cast<int>(pMetadata->NumRecords()), static_cast<int>(Reloaded.NumLogRecords()));
+            NumMismatches++;
+        }
+    }
+
+    // Back to per-file
+    pStore->MigrateToPerFileMetadata();
+    RebuildEntriesFromDirectory(pStore);
+    CheckSnapshot("Migrated back");
+
+    if (WasPacked)
+        pStore->MigrateToPackedMetadata();
+
+    // Restore the full database, including dependencies
+    pStore->ClearDatabase();
+    pStore->LoadDatabaseCache();
+    pProject->AudioManager()->LoadAssets();
+
+    const bool TestSuccess = MigrateSuccess && (NumMismatches == 0);
+    debugf( "Test %s; %d entries. Migrated in %.3fms; per-file scan: %.3fms, packed scan: %.3fms, %d log records before compaction, %d mismatches",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Original.size()), MigrateTime * 1000.0, PerFileTime * 1000.0, PackedTime * 1000.0,
+            static_cast<int>(NumLogRecords), NumMismatches );
+
+    return TestSuccess;
+}
+
+static std::vector<char> SerializeEntryMetadata(CResourceEntry* pEntry, EGame Game)
+{
+    std::vector<char> Data;
+    CVectorOutStream Out(&Data, EEndian::SystemEndian);
+    CBasicBinaryWriter Writer(&Out, 0, Game);
+    pEntry->SerializeEntryInfo(Writer, true);
+    return Data;
+}
+
+/** Time scanning the resources directory one file at a time and with the parallel directory scan, and check both find the same resources */
+bool BenchmarkDirectoryScan()
+{
+    debugf("Benchmarking resource directory scan...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+
+    if (!pStore || !pStore->Project())
+    {
+        errorf("Directory scan benchmark failed; no project loaded");
+        return false;
+    }
+
+    // Serial scan, the same way the store used to do it
+    std::map<TString, std::vector<char>> SerialResults;
+    uint NumSerialDirs = 0;
+
+    double StartTime = CTimer::GlobalTime();
+    {
+        const TString ResDir = pStore->ResourcesDir();
+        TStringList ResourceList;
+        FileUtil::GetDirectoryContents(ResDir, ResourceList);
+
+        for (const TString& rkPath : ResourceList)
+        {
+            if (FileUtil::IsFile(rkPath) && rkPath.EndsWith(".rsmeta"))
+            {
+                const TString RelPath = rkPath.ChopFront(ResDir.Size());
+                const TString CookedFilename = RelPath.GetFileName(false);
+                CResTypeInfo* pTypeInfo = CResTypeInfo::TypeForCookedExtension(pStore->Game(), CFourCC(CookedFilename.GetFileExtension()));
+
+                if (!pTypeInfo)
+                    continue;
+
+                auto pEntry = CResourceEntry::BuildFromMetadataFile(pStore, pTypeInfo, rkPath, CookedFilename.GetFileName(false));
+                SerialResults[RelPath] = (pEntry ? SerializeEntryMetadata(pEntry.get(), pStore->Game()) : std::vector<char>());
+            }
+            else if (FileUtil::IsDirectory(rkPath))
+            {
+                NumSerialDirs++;
+            }
+        }
+    }
+    const double SerialTime = CTimer::GlobalTime() - StartTime;
+
+    // Parallel scan
+    CResourceDirectoryScan Scan(pStore);
+
+    StartTime = CTimer::GlobalTime();
+    const bool ScanSuccess = Scan.Run();
+    const double ParallelTime = CTimer::GlobalTime() - StartTime;
+
+    // Compare
+    uint NumMismatches = 0;
+
+    for (CResourceDirectoryScan::SResourceFile& rFile : Scan.Files())
+    {
+        const TString RelPath = rFile.MetadataPath.ChopFront(pStore->ResourcesDir().Size());
+        const auto Find = SerialResults.find(RelPath);
+        const std::vector<char> Data = (rFile.pEntry ? SerializeEntryMetadata(rFile.pEntry.get(), pStore->Game()) : std::vector<char>());
+
+        if (Find == SerialResults.cend() || Find->second != Data)
+        {
+            errorf("%s doesn't match the serial scan", *RelPath);
+            NumMismatches++;
+        }
+    }
+
+    if (Scan.Files().size() != SerialResults.size() || Scan.Directories().size() != NumSerialDirs)
+    {
+        errorf("Parallel scan found %d resources in %d directories; serial scan found %d in %d",
+               static_cast<int>(Scan.Files().size()), static_cast<int>(Scan.Directories().size()),
+               static_cast<int>(SerialResults.size()), static_cast<int>(NumSerialDirs));
+        NumMismatches++;
+    }
+
+    const bool TestSuccess = ScanSuccess && (NumMismatches == 0);
+    debugf( "Test %s; %d resources in %d directories. Serial: %.3fms, parallel (%d workers): %.3fms, %d mismatches",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Scan.Files().size()), static_cast<int>(Scan.Directories().size()),
+            SerialTime * 1000.0, static_cast<int>(CJobPool::Global().NumWorkers()), ParallelTime * 1000.0, NumMismatches );
+
+    return TestSuccess;
+}
+
+/** Load a set of models twice with the resource cache between the two passes, and check hits, evictions and size accounting */
+bool BenchmarkResourceCache()
+{
+    debugf("Benchmarking resource cache...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+
+    if (!pStore || !pStore->Project())
+    {
+        errorf("Resource cache benchmark failed; no project loaded");
+        return false;
+    }
+
+    constexpr uint kMaxModels = 500;
+    std::vector<CResourceEntry*> Entries;
+
+    for (TResourceIterator<EResourceType::Model> It(pStore); It && Entries.size() < kMaxModels; ++It)
+        Entries.push_back(*It);
+
+    // Start with nothing cached and a budget big enough to keep everything
+    CResourceCache& rCache = pStore->ResourceCache();
+    const uint64 OldBudget = rCache.Budget();
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(UINT64_MAX);
+    rCache.ResetCounters();
+
+    const auto LoadAll = [&]()
+    {
+        std::vector<TResPtr<CResource>> Resources;
+        Resources.reserve(Entries.size());
+
+        const double StartTime = CTimer::GlobalTime();
+
+        for (CResourceEntry* pEntry : Entries)
+            Resources.emplace_back(pEntry->Load());
+
+        const double Time = CTimer::GlobalTime() - StartTime;
+        Resources.clear();
+        pStore->ReleaseUnreferencedResources();
+        return Time;
+    };
+
+    const double ColdTime = LoadAll();
+    const CResourceCache::SStats ColdStats = rCache.Stats();
+    const double WarmTime = LoadAll();
+    const CResourceCache::SStats WarmStats = rCache.Stats();
+    uint NumErrors = 0;
+
+    // The second pass should only hit the cache
+    if (WarmStats.Misses != ColdStats.Misses || WarmStats.Hits - ColdStats.Hits < Entries.size())
+    {
+        errorf("Second pass had %d misses and %d hits; expected 0 misses and at least %d hits",
+               static_cast<int>(WarmStats.Misses - ColdStats.Misses), static_cast<int>(WarmStats.Hits - ColdStats.Hits), static_cast<int>(Entries.size()));
+        NumErrors++;
+    }
+
+    // Per-type sizes should add up to the total
+    const auto CheckAccounting = [&](const char* pkWhen)
+    {
+        const CResourceCache::SStats& rkStats = rCache.Stats();
+        uint64 TypeBytes = 0;
+        uint32 TypeCount = 0;
+
+        for (const auto& [Type, rkTypeStats] : rkStats.Types)
+        {
+            TypeBytes += rkTypeStats.CachedBytes;
+            TypeCount += rkTypeStats.NumCached;
+        }
+
+        if (TypeBytes != rkStats.CachedBytes || TypeCount != rkStats.NumCached)
+        {
+            errorf("%s: per-type totals (%d resources, %llu bytes) don't match the cache totals (%d resources, %llu bytes)", pkWhen,
+                   static_cast<int>(TypeCount), static_cast<unsigned long long>(TypeBytes),
+                   static_cast<int>(rkStats.NumCached), static_cast<unsigned long long>(rkStats.CachedBytes));
+            NumErrors++;
+        }
+    };
+    CheckAccounting("Full cache");
+
+    // Halving the budget should evict down to it
+    const uint64 FullBytes = rCache.Stats().CachedBytes;
+    const uint32 FullCount = rCache.Stats().NumCached;
+    pStore->SetResourceCacheBudget(FullBytes / 2);
+    CheckAccounting("Trimmed cache");
+
+    if (rCache.Stats().CachedBytes > FullBytes / 2 || (FullCount > 1 && rCache.Stats().Evictions == 0))
+    {
+        errorf("Trimmed cache holds %llu bytes after %d evictions; budget is %llu",
+               static_cast<unsigned long long>(rCache.Stats().CachedBytes), static_cast<int>(rCache.Stats().Evictions),
+               static_cast<unsigned long long>(FullBytes / 2));
+        NumErrors++;
+    }
+
+    // Memory reserved for resources held outside the cache counts against the budget too
+    const uint64 ReservedBytes = FullBytes / 4;
+    rCache.Reserve(ReservedBytes);
+    pStore->ReleaseUnreferencedResources();
+    CheckAccounting("Reserved cache");
+
+    if (rCache.Stats().CachedBytes + ReservedBytes > FullBytes / 2 && rCache.Stats().NumCached > 0)
+    {
+        errorf("Cache holds %llu bytes with %llu reserved; budget is %llu",
+               static_cast<unsigned long long>(rCache.Stats().CachedBytes), static_cast<unsigned long long>(ReservedBytes),
+               static_cast<unsigned long long>(FullBytes / 2));
+        NumErrors++;
+    }
+
+    rCache.Unreserve(ReservedBytes);
+
+    // Restore the cache
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(OldBudget);
+
+    if (rCache.Stats().NumCached != 0)
+    {
+        errorf("%d resources still cached after flushing", static_cast<int>(rCache.Stats().NumCached));
+        NumErrors++;
+    }
+
+    const bool TestSuccess = (NumErrors == 0);
+    debugf( "Test %s; %d models, %d resources (%.2f MB) cached. Cold pass: %.3fms, cached pass: %.3fms, %d evictions at half budget",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Entries.size()), static_cast<int>(FullCount), FullBytes / (1024.0 * 1024.0),
+            ColdTime * 1000.0, WarmTime * 1000.0, static_cast<int>(rCache.Stats().Evictions) );
+
+    rCache.ResetCounters();
+    return TestSuccess;
+}
+
+/** Time loading a set of models synchronously and through the async loader, and check both give the same resources and that loads finish in priority order */
+bool BenchmarkAsyncLoading()
+{
+    debugf("Benchmarking async resource loading...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+
+    if (!pStore || !pStore->Project())
+    {
+        errorf("Async loading benchmark failed; no project loaded");
+        return false;
+    }
+
+    constexpr uint kMaxModels = 300;
+    std::vector<CResourceEntry*> Entries;
+
+    for (TResourceIterator<EResourceType::Model> It(pStore); It && Entries.size() < kMaxModels; ++It)
+        Entries.push_back(*It);
+
+    // Caching would turn the second pass into cache hits
+    const uint64 OldBudget = pStore->ResourceCache().Budget();
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(0);
+
+    // Synchronous pass; record what each entry loads as
+    std::vector<EResourceType> SyncTypes(Entries.size(), EResourceType::Invalid);
+    double SyncTime = 0.0;
+    {
+        std::vector<TResPtr<CResource>> Resources;
+        const double StartTime = CTimer::GlobalTime();
+
+        for (CResourceEntry* pEntry : Entries)
+            Resources.emplace_back(pEntry->Load());
+
+        SyncTime = CTimer::GlobalTime() - StartTime;
+
+        for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+        {
+            if (Resources[EntryIdx])
+                SyncTypes[EntryIdx] = Resources[EntryIdx]->Type();
+        }
+    }
+    pStore->DestroyUnreferencedResources();
+
+    // Async pass. Alternate normal and prefetch requests, and bump one to immediate.
+    // Within any one update, requests must finish in priority order. Update 0 is for
+    // requests that finish as soon as they're made because the model is already loaded.
+    CAsyncResourceLoader* pLoader = pStore->AsyncLoader();
+    std::vector<TResourceLoadHandle> Requests;
+    std::vector<std::pair<uint, EResourceLoadPriority>> CompletionOrder;
+    uint UpdateIdx = 0;
+    uint NumErrors = 0;
+
+    const double AsyncStartTime = CTimer::GlobalTime();
+
+    for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+    {
+        const EResourceLoadPriority Priority = (EntryIdx % 2 == 0 ? EResourceLoadPriority::Normal : EResourceLoadPriority::Prefetch);
+        TResourceLoadHandle pRequest = pLoader->Load(Entries[EntryIdx], Priority);
+        CResourceLoadRequest* pRawRequest = pRequest.get();
+        pRequest->OnComplete([&, pRawRequest](CResource*) { CompletionOrder.emplace_back(UpdateIdx, pRawRequest->Priority()); });
+        Requests.push_back(std::move(pRequest));
+    }
+
+    if (!Requests.empty())
+        Requests.back()->RaisePriority(EResourceLoadPriority::Immediate);
+
+    const double IssueTime = CTimer::GlobalTime() - AsyncStartTime;
+    double UpdateTime = 0.0;
+
+    while (pLoader->NumPendingRequests() > 0)
+    {
+        UpdateIdx++;
+        const double UpdateStart = CTimer::GlobalTime();
+        pLoader->Update(0.004);
+        UpdateTime += CTimer::GlobalTime() - UpdateStart;
+        std::this_thread::yield();
+    }
+
+    const double AsyncTime = CTimer::GlobalTime() - AsyncStartTime;
+
+    for (size_t OrderIdx = 1; OrderIdx < CompletionOrder.size(); OrderIdx++)
+    {
+        const auto& [PrevUpdate, PrevPriority] = CompletionOrder[OrderIdx - 1];
+        const auto& [CurUpdate, CurPriority] = CompletionOrder[OrderIdx];
+
+        if (CurUpdate != 0 && PrevUpdate == CurUpdate && PrevPriority < CurPriority)
+        {
+            errorf("Update %d finished a priority %d load before a priority %d load", static_cast<int>(CurUpdate),
+                   static_cast<int>(PrevPriority), static_cast<int>(CurPriority));
+            NumErrors++;
+        }
+    }
+
+    for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+    {
+        const CResourceLoadRequest& rkRequest = *Requests[EntryIdx];
+        const EResourceType AsyncType = (rkRequest.Resource() ? rkRequest.Resource()->Type() : EResourceType::Invalid);
+
+        if (!rkRequest.IsComplete() || AsyncType != SyncTypes[EntryIdx] || rkRequest.Resource() != Entries[EntryIdx]->Resource())
+        {
+            errorf("Async load of %s doesn't match the synchronous load", *Entries[EntryIdx]->CookedAssetPath(true));
+            NumErrors++;
+        }
+    }
+
+    Requests.clear();
+    pStore->DestroyUnreferencedResources();
+
+    // Waiting on a request should finish it right away
+    if (!Entries.empty())
+    {
+        TResourceLoadHandle pRequest = pStore->LoadResourceAsync(Entries.front()->ID(), EResourceLoadPriority::Prefetch);
+
+        const bool Loaded = (pRequest && pRequest->Wait() != nullptr);
+
+        if (!pRequest || !pRequest->IsComplete() || Loaded != (SyncTypes.front() != EResourceType::Invalid))
+        {
+            errorf("Waiting on an async load of %s failed", *Entries.front()->CookedAssetPath(true));
+            NumErrors++;
+        }
+    }
+
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(OldBudget);
+
+    const bool TestSuccess = (NumErrors == 0);
+    debugf( "Test %s; %d models. Synchronous: %.3fms. Async: %.3fms total over %d updates, %.3fms on the main thread (%.3fms issuing requests)",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Entries.size()), SyncTime * 1000.0, AsyncTime * 1000.0, static_cast<int>(UpdateIdx),
+            (UpdateTime + IssueTime) * 1000.0, IssueTime * 1000.0 );
+
+    return TestSuccess;
+}
+
+/** Load every resource several times from many threads at once, and check each resource is only loaded once and the loaded resource index is consistent */
+bool StressTestConcurrentLoading()
+{
+    debugf("Stress testing concurrent resource loading...");
+
+    // There must be a project loaded
+    CResourceStore* pStore = gpResourceStore;
+
+    if (!pStore || !pStore->Project())
+    {
+        errorf("Concurrent loading stress test failed; no project loaded");
+        return false;
+    }
+
+    std::vector<CResourceEntry*> Entries;
+
+    for (CResourceIterator It(pStore); It; ++It)
+        Entries.push_back(*It);
+
+    // Start with nothing loaded and nothing cached. The game template is loaded on demand by the
+    // script loader; load it up front so its one-off cost isn't part of the timings below.
+    const uint64 OldBudget = pStore->ResourceCache().Budget();
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(0);
+    NGameList::GetGameTemplate(pStore->Game());
+    const uint32 NumInitiallyLoaded = pStore->NumLoadedResources();
+
+    // Every entry gets loaded this many times, in random order, so most loads overlap with
+    // another load of the same entry or of one of its dependencies
+    constexpr uint kLoadsPerEntry = 4;
+    const uint NumThreads = std::max(8u, std::thread::hardware_concurrency());
+
+    std::vector<uint> Order(Entries.size() * kLoadsPerEntry);
+    for (uint SlotIdx = 0; SlotIdx < Order.size(); SlotIdx++)
+        Order[SlotIdx] = SlotIdx;
+
+    std::shuffle(Order.begin(), Order.end(), std::mt19937(0x7E57));
+
+    std::vector<TResPtr<CResource>> Results(Order.size());
+    std::atomic<size_t> NextSlot = 0;
+
+    const double StartTime = CTimer::GlobalTime();
+    {
+        std::vector<std::thread> Threads;
+
+        for (uint ThreadIdx = 0; ThreadIdx < NumThreads; ThreadIdx++)
+        {
+            Threads.emplace_back([&]()
+            {
+                for (size_t OrderIdx = NextSlot++; OrderIdx < Order.size(); OrderIdx = NextSlot++)
+                {
+                    const uint SlotIdx = Order[OrderIdx];
+                    Results[SlotIdx] = Entries[SlotIdx / kLoadsPerEntry]->Load();
+                }
+            });
+        }
+
+        for (std::thread& rThread : Threads)
+            rThread.join();
+    }
+    const double Time = CTimer::GlobalTime() - StartTime;
+
+    // Every load of an entry must have given the same resource, and it must be the one the entry holds
+    uint NumErrors = 0;
+    uint NumLoaded = 0;
+
+    for (size_t EntryIdx = 0; EntryIdx < Entries.size(); EntryIdx++)
+    {
+        CResourceEntry* pEntry = Entries[EntryIdx];
+
+        for (uint LoadIdx = 0; LoadIdx < kLoadsPerEntry; LoadIdx++)
+        {
+            if (Results[EntryIdx * kLoadsPerEntry + LoadIdx] != pEntry->Resource())
+            {
+                errorf("Load %d of %s gave a different resource than the entry holds", static_cast<int>(LoadIdx), *pEntry->CookedAssetPath(true));
+                NumErrors++;
+                break;
+            }
+        }
+
+        if (pEntry->IsLoaded())
+            NumLoaded++;
+    }
+
+    // Every loaded resource must be in the loaded resource index exactly once
+    const std::vector<CResourceEntry*> Loaded = pStore->LoadedResources();
+    const std::set<CResourceEntry*> LoadedSet(Loaded.begin(), Loaded.end());
+
+    if (Loaded.size() != LoadedSet.size() || Loaded.size() != pStore->NumLoadedResources() || Loaded.size() != NumLoaded)
+    {
+        errorf("Loaded resource index has %d entries (%d unique), count is %d, but %d entries are loaded",
+               static_cast<int>(Loaded.size()), static_cast<int>(LoadedSet.size()),
+               static_cast<int>(pStore->NumLoadedResources()), static_cast<int>(NumLoaded));
+        NumErrors++;
+    }
+
+    for (CResourceEntry* pEntry : Loaded)
+    {
+        if (!pEntry->IsLoaded())
+        {
+            errorf("%s is in the loaded resource index but isn't loaded", *pEntry->CookedAssetPath(true));
+            NumErrors++;
+        }
+    }
+
+    Results.clear();
+    pStore->DestroyUnreferencedResources();
+    pStore->SetResourceCacheBudget(OldBudget);
+
+    if (pStore->NumLoadedResources() > NumInitiallyLoaded)
+    {
+        errorf("%d resources are still loaded after unloading everything", static_cast<int>(pStore->NumLoadedResources() - NumInitiallyLoaded));
+        NumErrors++;
+    }
+
+    const bool TestSuccess = (NumErrors == 0);
+    debugf( "Test %s; %d resources loaded %d times each from %d threads in %.3fms; %d loaded successfully",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(Entries.size()), static_cast<int>(kLoadsPerEntry), static_cast<int>(NumThreads),
+            Time * 1000.0, static_cast<int>(NumLoaded) );
+
+    return TestSuccess;
+}
+
+bool BenchmarkProjectOpen(const TString& rkProjPath, uint NumRuns)
+{
+    debugf("Benchmarking project open...");
+
+    // Each run opens the project from scratch; the stage profile for every run is logged by LoadProject.
+    // The first run is kept separate since it also loads the game template, which stays loaded afterwards.
+    double FirstTime = 0.0;
+    double TotalTime = 0.0;
+    double BestTime = 0.0;
+    uint NumFailed = 0;
+
+    for (uint RunIdx = 0; RunIdx < NumRuns; RunIdx++)
+    {
+        const double StartTime = CTimer::GlobalTime();
+        std::unique_ptr<CGameProject> pProject = CGameProject::LoadProject(rkProjPath, gpNullProgress);
+        const double Time = CTimer::GlobalTime() - StartTime;
+
+        if (!pProject)
+        {
+            errorf("Failed to open %s", *rkProjPath);
+            NumFailed++;
+            continue;
+        }
+
+        if (RunIdx == 0)
+        {
+            FirstTime = Time;
+            continue;
+        }
+
+        TotalTime += Time;
+        BestTime = (RunIdx == 1 ? Time : std::min(BestTime, Time));
+    }
+
+    const uint NumWarmRuns = (NumRuns > 1 ? NumRuns - 1 : 0);
+    const bool TestSuccess = (NumFailed == 0);
+    debugf( "Test %s; %d runs on %d workers; first open %.3fms, later opens %.3fms average, %.3fms best",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(NumRuns), static_cast<int>(CJobPool::Global().NumWorkers()), FirstTime * 1000.0,
+            NumWarmRuns > 0 ? TotalTime * 1000.0 / NumWarmRuns : 0.0, BestTime * 1000.0 );
+
+    return TestSuccess;
+}
+
+static CTraceCounter gTraceTestCounter("Trace test");
+
+bool ValidateTrace(const TString& rkOutputPath)
+{
+    debugf("Validating trace output...");
+    uint NumErrors = 0;
+
+    // Zones should cost next to nothing while tracing is off, and record nothing
+    constexpr uint kNumDisabledZones = 10000000;
+    const bool WasEnabled = NTrace::IsEnabled();
+    NTrace::SetEnabled(false);
+    NTrace::Clear();
+
+    const double DisabledStartTime = CTimer::GlobalTime();
+
+    for (uint ZoneIdx = 0; ZoneIdx < kNumDisabledZones; ZoneIdx++)
+    {
+        TRACE_ZONE(DisabledZone);
+    }
+
+    const double DisabledTime = CTimer::GlobalTime() - DisabledStartTime;
+
+    if (NTrace::NumEvents() != 0)
+    {
+        errorf("%d events were recorded while tracing was off", static_cast<int>(NTrace::NumEvents()));
+        NumErrors++;
+    }
+
+    // Record nested zones on every thread in the job pool, plus one around the whole thing
+    constexpr uint kNumJobs = 64;
+    NTrace::SetEnabled(true);
+    {
+        TRACE_ZONE(TraceTest);
+
+        CJobPool::Global().ParallelFor(kNumJobs, 1, [](size_t Begin, size_t End)
+        {
+            for (size_t JobIdx = Begin; JobIdx < End; JobIdx++)
+            {
+                TRACE_ZONE(TraceTestOuter);
+                TRACE_ZONE(TraceTestInner);
+                gTraceTestCounter.Add(1);
+            }
+        });
+    }
+    NTrace::SetEnabled(WasEnabled);
+
+    if (!NTrace::WriteChromeTrace(rkOutputPath))
+        return false;
+
+    // Check the right events made it to the file
+    std::vector<uint8> FileData;
+    FileUtil::LoadFileToBuffer(rkOutputPath, FileData);
+    const std::string Json(FileData.begin(), FileData.end());
+
+    const auto CountOccurrences = [&Json](const std::string& rkPattern)
+    {
+        uint Count = 0;
+
+        for (size_t Pos = Json.find(rkPattern); Pos != std::string::npos; Pos = Json.find(rkPattern, Pos + 1))
+            Count++;
+
+        return Count;
+    };
+
+    const uint NumZones = CountOccurrences("\"ph\":\"X\"");
+    const uint ExpectedZones = 1 + kNumJobs * 2;
+
+    if (NumZones != ExpectedZones)
+    {
+        errorf("Trace has %d zones; expected %d", static_cast<int>(NumZones), static_cast<int>(ExpectedZones));
+        NumErrors++;
+    }
+
+    if (CountOccurrences("{\"name\":\"TraceTestInner\"") != kNumJobs || CountOccurrences("{\"name\":\"TraceTestOuter\"") != kNumJobs)
+    {
+        errorf("Trace doesn't have one inner and one outer zone per job");
+        NumErrors++;
+    }
+
+    const std::string LastSample = "{\"name\":\"Trace test\",\"ph\":\"C\"";
+
+    if (CountOccurrences(LastSample) == 0 || Json.find("\"value\":" + std::to_string(gTraceTestCounter.Value()) + "}") == std::string::npos)
+    {
+        errorf("Trace is missing samples of the test counter");
+        NumErrors++;
+    }
+
+    if (Json.compare(0, 1, "{") != 0 || Json.find("\n]}") == std::string::npos)
+    {
+        errorf("Trace file isn't a complete JSON object");
+        NumErrors++;
+    }
+
+    FileUtil::DeleteFile(rkOutputPath);
+
+    // A thread that records more events than its buffer holds should keep only the most recent ones
+    constexpr uint kNumOverflowZones = NTrace::gkMaxEventsPerThread + 1000;
+    NTrace::Clear();
+    NTrace::SetEnabled(true);
+
+    for (uint ZoneIdx = 0; ZoneIdx < kNumOverflowZones; ZoneIdx++)
+    {
+        TRACE_ZONE(OverflowZone);
+    }
+
+    NTrace::SetEnabled(WasEnabled);
+
+    if (NTrace::NumEvents() != NTrace::gkMaxEventsPerThread)
+    {
+        errorf("%d events are buffered after overflowing the buffer; expected %d", static_cast<int>(NTrace::NumEvents()), static_cast<int>(NTrace::gkMaxEventsPerThread));
+        NumErrors++;
+    }
+
+    NTrace::Clear();
+
+    const bool TestSuccess = (NumErrors == 0);
+    debugf( "Test %s; %d zones recorded from %d threads; disabled zones cost %.2fns each",
+            TestSuccess ? "SUCCEEDED" : "FAILED",
+            static_cast<int>(NumZones), static_cast<int>(CJobPool::Global().NumWorkers() + 1),
+            DisabledTime * 1e9 / kNumDisabledZones );
+
+    return TestSuccess;
+}
+
 } // end namespace NCoreTests
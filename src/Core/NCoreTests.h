@@ -13,6 +13,63 @@ bool RunTests(int argc, char *argv[]);
 /** Validate all cooker output for the given resource type matches the original asset data */
 bool ValidateCooker(EResourceType ResourceType, bool DumpInvalidFileContents);
 
+/** Validate batched frustum culling results match a per-box reference test */
+bool ValidateFrustumCuller();
+
+/** Pose every character in every ANCS at many time samples and compare against the recursive skeleton update */
+bool BenchmarkSkeletonPoses(uint NumSamples);
+
+/** Time opening every game in GameList.xml with lazy template loading, then loading every sub-template */
+bool BenchmarkGameTemplateLoad();
+
+/** Time loading every template for every game, and check repeated runs give identical results */
+bool BenchmarkLoadAllGameTemplates(uint NumRuns);
+
+/** Time loading the SCLY/SCGN instances of every area with and without compiled property plans, and check both cook back to the same data */
+bool BenchmarkScriptLoad(uint NumRuns);
+
+/** Time loading every area with serial and parallel script layer loading, and check both produce the same script data */
+bool BenchmarkAreaLoad();
+
+/** Time copying the properties of every script object in every area, and check the copies cook to the same data as the originals */
+bool BenchmarkPropertyCopy();
+
+/** Replay a scripted property editing session with delta undo records, then undo and redo all of it and check the results and memory use */
+bool ValidateUndoDeltas(uint NumEdits);
+
+/** Check the cached link indices for every area, and time bulk link deletion against deleting links one at a time */
+bool ValidateLinkIndex();
+
+/** Hash every two word name from the generator word list with CCRC32 and with the batched name kernel, and check both give the same IDs */
+bool BenchmarkPropertyNameHashing();
+
+/** Time building the dependency graph and every package's dependency list, and check the cached lists give the same result as walking every asset */
+bool BenchmarkPackageDependencies();
+
+/** Time regenerating every resource's dependencies one entry at a time and with a batched rebuild job, and check both give the same trees */
+bool BenchmarkDependencyRebuild();
+
+/** Migrate the project's metadata to the packed store and back, rebuilding the database from each, and check every entry's metadata survives */
+bool ValidateMetadataStore();
+
+/** Time scanning the resources directory one file at a time and with the parallel directory scan, and check both find the same resources */
+bool BenchmarkDirectoryScan();
+
+/** Load a set of models twice with the resource cache between the two passes, and check hits, evictions and size accounting */
+bool BenchmarkResourceCache();
+
+/** Time loading a set of models synchronously and through the async loader, and check both give the same resources and that loads finish in priority order */
+bool BenchmarkAsyncLoading();
+
+/** Load every resource several times from many threads at once, and check each resource is only loaded once and the loaded resource index is consistent */
+bool StressTestConcurrentLoading();
+
+/** Open a project several times, reporting how long each open takes; each run logs its per-stage profile */
+bool BenchmarkProjectOpen(const TString& rkProjPath, uint NumRuns);
+
+/** Record zones and counters from several threads, write them as a Chrome trace, and check the output; also measures the cost of a zone while tracing is off */
+bool ValidateTrace(const TString& rkOutputPath);
+
 }
 
 #endif // NCORETESTS_H
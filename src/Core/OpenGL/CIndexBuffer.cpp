@@ -1,4 +1,5 @@
 #include "CIndexBuffer.h"
+#include "Core/CTrace.h"
 
 CIndexBuffer::CIndexBuffer() = default;
 
@@ -68,6 +69,7 @@ void CIndexBuffer::DrawElements()
     Bind();
     glDrawElements(mPrimitiveType, mIndices.size(), GL_UNSIGNED_SHORT, nullptr);
     Unbind();
+    gDrawCallsCounter.Add(1);
 }
 
 void CIndexBuffer::DrawElements(uint offset, uint size)
@@ -75,6 +77,7 @@ void CIndexBuffer::DrawElements(uint offset, uint size)
     Bind();
     glDrawElements(mPrimitiveType, size, GL_UNSIGNED_SHORT, (char*)0 + (offset * 2));
     Unbind();
+    gDrawCallsCounter.Add(1);
 }
 
 bool CIndexBuffer::IsBuffered() const
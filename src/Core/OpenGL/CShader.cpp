@@ -1,4 +1,5 @@
 #include "CShader.h"
+#include "Core/CTrace.h"
 #include "Core/Render/CGraphics.h"
 #include <Common/BasicTypes.h>
 #include <Common/Log.h>
@@ -203,6 +204,7 @@ void CShader::SetCurrent()
     {
         glUseProgram(mProgram);
         spCurrentShader = this;
+        gShaderBindsCounter.Add(1);
 
         UniformBlockBinding(mMVPBlockIndex, CGraphics::MVPBlockBindingPoint());
         UniformBlockBinding(mVertexBlockIndex, CGraphics::VertexBlockBindingPoint());
@@ -0,0 +1,155 @@
+#include "CFrustumCuller.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PWE_CULL_SSE 1
+#include <emmintrin.h>
+#endif
+
+void CFrustumCuller::Clear()
+{
+    mMinX.clear(); mMinY.clear(); mMinZ.clear();
+    mMaxX.clear(); mMaxY.clear(); mMaxZ.clear();
+    mVisibility.clear();
+    mNumBoxes = 0;
+    mNumVisible = 0;
+}
+
+void CFrustumCuller::Reserve(uint32 NumBoxes)
+{
+    const uint32 Padded = (NumBoxes + 3) & ~3u;
+    mMinX.reserve(Padded); mMinY.reserve(Padded); mMinZ.reserve(Padded);
+    mMaxX.reserve(Padded); mMaxY.reserve(Padded); mMaxZ.reserve(Padded);
+}
+
+uint32 CFrustumCuller::AddBox(const CAABox& rkBox)
+{
+    const CVector3f Min = rkBox.Min();
+    const CVector3f Max = rkBox.Max();
+    mMinX.push_back(Min.X); mMinY.push_back(Min.Y); mMinZ.push_back(Min.Z);
+    mMaxX.push_back(Max.X); mMaxY.push_back(Max.Y); mMaxZ.push_back(Max.Z);
+    return mNumBoxes++;
+}
+
+void CFrustumCuller::Cull(const CFrustumPlanes& rkFrustum)
+{
+    Cull(ExtractPlanes(rkFrustum));
+}
+
+void CFrustumCuller::Cull(const CPlaneArray& rkPlanes)
+{
+    // Pad out to a whole number of SIMD blocks; padding results are masked off below
+    const uint32 Padded = (mNumBoxes + 3) & ~3u;
+    mMinX.resize(Padded); mMinY.resize(Padded); mMinZ.resize(Padded);
+    mMaxX.resize(Padded); mMaxY.resize(Padded); mMaxZ.resize(Padded);
+
+    mVisibility.assign((mNumBoxes + 31) / 32, 0);
+    mNumVisible = 0;
+
+    for (uint32 Base = 0; Base < Padded; Base += 4)
+    {
+        uint32 Mask = CullBlock(rkPlanes, Base);
+
+        if (Base + 4 > mNumBoxes)
+            Mask &= (1u << (mNumBoxes - Base)) - 1;
+
+        mVisibility[Base / 32] |= Mask << (Base % 32);
+
+        for (uint32 Bits = Mask; Bits != 0; Bits &= Bits - 1)
+            mNumVisible++;
+    }
+
+    mMinX.resize(mNumBoxes); mMinY.resize(mNumBoxes); mMinZ.resize(mNumBoxes);
+    mMaxX.resize(mNumBoxes); mMaxY.resize(mNumBoxes); mMaxZ.resize(mNumBoxes);
+}
+
+uint32 CFrustumCuller::CullBlock(const CPlaneArray& rkPlanes, uint32 Base) const
+{
+    // A box is outside a plane if its corner furthest along the plane normal (the "positive vertex")
+    // is behind it. That corner is picked per-axis by the sign of the normal, which is uniform for
+    // the whole block, so each plane test is just a select of min/max followed by a dot product.
+#if PWE_CULL_SSE
+    __m128 Inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    const __m128 Zero = _mm_setzero_ps();
+
+    for (const SCullPlane& rkPlane : rkPlanes)
+    {
+        const __m128 PX = _mm_loadu_ps(&(rkPlane.NormalX >= 0.f ? mMaxX : mMinX)[Base]);
+        const __m128 PY = _mm_loadu_ps(&(rkPlane.NormalY >= 0.f ? mMaxY : mMinY)[Base]);
+        const __m128 PZ = _mm_loadu_ps(&(rkPlane.NormalZ >= 0.f ? mMaxZ : mMinZ)[Base]);
+
+        __m128 Dist = _mm_mul_ps(PX, _mm_set1_ps(rkPlane.NormalX));
+        Dist = _mm_add_ps(Dist, _mm_mul_ps(PY, _mm_set1_ps(rkPlane.NormalY)));
+        Dist = _mm_add_ps(Dist, _mm_mul_ps(PZ, _mm_set1_ps(rkPlane.NormalZ)));
+        Dist = _mm_add_ps(Dist, _mm_set1_ps(rkPlane.Dist));
+        Inside = _mm_and_ps(Inside, _mm_cmpgt_ps(Dist, Zero));
+    }
+
+    return static_cast<uint32>(_mm_movemask_ps(Inside));
+#else
+    uint32 Mask = 0;
+
+    for (uint32 iBox = 0; iBox < 4; iBox++)
+    {
+        const uint32 Index = Base + iBox;
+        bool Inside = true;
+
+        for (const SCullPlane& rkPlane : rkPlanes)
+        {
+            const float PX = (rkPlane.NormalX >= 0.f ? mMaxX : mMinX)[Index];
+            const float PY = (rkPlane.NormalY >= 0.f ? mMaxY : mMinY)[Index];
+            const float PZ = (rkPlane.NormalZ >= 0.f ? mMaxZ : mMinZ)[Index];
+            const float Dist = PX * rkPlane.NormalX + PY * rkPlane.NormalY + PZ * rkPlane.NormalZ + rkPlane.Dist;
+
+            if (!(Dist > 0.f))
+            {
+                Inside = false;
+                break;
+            }
+        }
+
+        if (Inside)
+            Mask |= (1u << iBox);
+    }
+
+    return Mask;
+#endif
+}
+
+CFrustumCuller::CPlaneArray CFrustumCuller::ExtractPlanes(const CFrustumPlanes& rkFrustum)
+{
+    CPlaneArray Planes{};
+
+    for (size_t iPlane = 0; iPlane < Planes.size(); iPlane++)
+    {
+        const CPlane& rkPlane = rkFrustum.GetPlane(static_cast<CFrustumPlanes::EFrustumSide>(iPlane));
+        const CVector3f Normal = rkPlane.Normal();
+        Planes[iPlane] = SCullPlane{Normal.X, Normal.Y, Normal.Z, rkPlane.Dist()};
+    }
+
+    return Planes;
+}
+
+bool CFrustumCuller::ScalarBoxInFrustum(const CPlaneArray& rkPlanes, const CAABox& rkBox)
+{
+    // Reference implementation; tests all eight corners like CFrustumPlanes::BoxInFrustum
+    const CVector3f Min = rkBox.Min();
+    const CVector3f Max = rkBox.Max();
+
+    for (const SCullPlane& rkPlane : rkPlanes)
+    {
+        bool AnyInside = false;
+
+        for (uint32 iCorner = 0; iCorner < 8 && !AnyInside; iCorner++)
+        {
+            const float X = (iCorner & 1) ? Max.X : Min.X;
+            const float Y = (iCorner & 2) ? Max.Y : Min.Y;
+            const float Z = (iCorner & 4) ? Max.Z : Min.Z;
+            AnyInside = (X * rkPlane.NormalX + Y * rkPlane.NormalY + Z * rkPlane.NormalZ + rkPlane.Dist) > 0.f;
+        }
+
+        if (!AnyInside)
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,53 @@
+#ifndef CFRUSTUMCULLER_H
+#define CFRUSTUMCULLER_H
+
+#include <Common/BasicTypes.h>
+#include <Common/Math/CAABox.h>
+#include <Common/Math/CFrustumPlanes.h>
+#include <array>
+#include <vector>
+
+/**
+ * Batched frustum culling of axis-aligned bounding boxes.
+ * Boxes are gathered into structure-of-arrays storage and tested against all six
+ * frustum planes four at a time with SSE (falling back to a scalar loop on other
+ * targets). The result is a visibility bitmask indexed by the order boxes were added.
+ * This does not touch any graphics state, so it can be exercised without a GL context.
+ */
+class CFrustumCuller
+{
+public:
+    /** Plane in the form Normal.Dot(Point) + Dist; points with a positive result are inside */
+    struct SCullPlane
+    {
+        float NormalX, NormalY, NormalZ, Dist;
+    };
+    using CPlaneArray = std::array<SCullPlane, 6>;
+
+private:
+    std::vector<float> mMinX, mMinY, mMinZ;
+    std::vector<float> mMaxX, mMaxY, mMaxZ;
+    std::vector<uint32> mVisibility;
+    uint32 mNumBoxes = 0;
+    uint32 mNumVisible = 0;
+
+public:
+    void Clear();
+    void Reserve(uint32 NumBoxes);
+    uint32 AddBox(const CAABox& rkBox);
+    void Cull(const CFrustumPlanes& rkFrustum);
+    void Cull(const CPlaneArray& rkPlanes);
+
+    bool IsVisible(uint32 Index) const  { return (mVisibility[Index / 32] & (1u << (Index % 32))) != 0; }
+    const std::vector<uint32>& VisibilityMask() const { return mVisibility; }
+    uint32 NumBoxes() const             { return mNumBoxes; }
+    uint32 NumVisible() const           { return mNumVisible; }
+
+    static CPlaneArray ExtractPlanes(const CFrustumPlanes& rkFrustum);
+    static bool ScalarBoxInFrustum(const CPlaneArray& rkPlanes, const CAABox& rkBox);
+
+private:
+    uint32 CullBlock(const CPlaneArray& rkPlanes, uint32 Base) const;
+};
+
+#endif // CFRUSTUMCULLER_H
@@ -2,6 +2,7 @@
 #include "CDrawUtil.h"
 #include "CGraphics.h"
 #include "CRenderer.h"
+#include "Core/CJobPool.h"
 #include <algorithm>
 
 // ************ CSubBucket ************
@@ -17,17 +18,30 @@ void CRenderBucket::CSubBucket::Add(const SRenderablePtr& rkPtr)
 
 void CRenderBucket::CSubBucket::Sort(const CCamera* pkCamera, bool DebugVisualization)
 {
-    std::stable_sort(mRenderables.begin(), mRenderables.begin() + mSize,
-                     [&, pkCamera](const auto& rkLeft, const auto& rkRight) {
-                         const CVector3f CamPos = pkCamera->Position();
-                         const CVector3f CamDir = pkCamera->Direction();
-
-                         const CVector3f DistL = rkLeft.AABox.ClosestPointAlongVector(CamDir) - CamPos;
-                         const CVector3f DistR = rkRight.AABox.ClosestPointAlongVector(CamDir) - CamPos;
-                         const float DotL = DistL.Dot(CamDir);
-                         const float DotR = DistR.Dot(CamDir);
-                         return DotL > DotR;
-                     });
+    const CVector3f CamPos = pkCamera->Position();
+    const CVector3f CamDir = pkCamera->Direction();
+
+    // Calculate each renderable's depth once up front instead of on every comparison.
+    // Large buckets have their keys calculated in parallel.
+    mSortKeys.resize(mSize);
+
+    CJobPool::Global().ParallelFor(mSize, 256, [&](size_t Begin, size_t End)
+    {
+        for (size_t iPtr = Begin; iPtr < End; iPtr++)
+        {
+            const CVector3f Dist = mRenderables[iPtr].AABox.ClosestPointAlongVector(CamDir) - CamPos;
+            mSortKeys[iPtr] = std::make_pair(Dist.Dot(CamDir), static_cast<uint32>(iPtr));
+        }
+    });
+
+    std::stable_sort(mSortKeys.begin(), mSortKeys.end(), [](const auto& rkLeft, const auto& rkRight) {
+        return rkLeft.first > rkRight.first;
+    });
+
+    mSortScratch.assign(mRenderables.begin(), mRenderables.begin() + mSize);
+
+    for (size_t iPtr = 0; iPtr < mSize; iPtr++)
+        mRenderables[iPtr] = mSortScratch[mSortKeys[iPtr].second];
 
     if (!DebugVisualization)
         return;
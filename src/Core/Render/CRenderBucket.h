@@ -17,6 +17,8 @@ class CRenderBucket
     class CSubBucket
     {
         std::vector<SRenderablePtr> mRenderables;
+        std::vector<std::pair<float, uint32>> mSortKeys;
+        std::vector<SRenderablePtr> mSortScratch;
         uint32 mEstSize = 0;
         uint32 mSize = 0;
 
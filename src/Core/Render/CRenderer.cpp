@@ -2,6 +2,7 @@
 
 #include "CDrawUtil.h"
 #include "CGraphics.h"
+#include "Core/CTrace.h"
 #include "Core/GameProject/CResourceStore.h"
 #include "Core/Resource/Factory/CTextureDecoder.h"
 #include <Common/Math/CTransform4f.h>
@@ -104,6 +105,8 @@ void CRenderer::SetViewportSize(uint32 Width, uint32 Height)
 // ************ RENDER ************
 void CRenderer::RenderBuckets(const SViewInfo& rkViewInfo)
 {
+    TRACE_ZONE(RenderBuckets);
+
     if (!mInitialized)
         Init();
 
@@ -2,7 +2,113 @@
 #include <Common/Math/CTransform4f.h>
 #include <Common/Math/MathUtil.h>
 
+#include <algorithm>
 #include <cfloat>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PWE_ANIM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+
+/** Keys for one channel type gathered from every animated bone. Components are stored
+ *  component-major (all X values, then all Y values...) so they can be processed four bones at a time. */
+struct SPoseChannelScratch
+{
+    std::vector<size_t> Bones;
+    std::vector<float> Low;
+    std::vector<float> High;
+
+    void Reset(size_t MaxBones, size_t NumComponents)
+    {
+        Bones.clear();
+        Low.resize(MaxBones * NumComponents);
+        High.resize(MaxBones * NumComponents);
+    }
+};
+
+/** Lerp Count floats from pLow towards pkHigh, writing the result back into pLow */
+void LerpComponents(float *pLow, const float *pkHigh, float t, size_t Count)
+{
+    size_t i = 0;
+
+#if PWE_ANIM_SSE
+    const __m128 T = _mm_set1_ps(t);
+
+    for (; i + 4 <= Count; i += 4)
+    {
+        const __m128 Low = _mm_loadu_ps(pLow + i);
+        const __m128 High = _mm_loadu_ps(pkHigh + i);
+        _mm_storeu_ps(pLow + i, _mm_add_ps(Low, _mm_mul_ps(_mm_sub_ps(High, Low), T)));
+    }
+#endif
+
+    for (; i < Count; i++)
+        pLow[i] += (pkHigh[i] - pLow[i]) * t;
+}
+
+/** Normalized lerp of Count quaternions stored component-major (W, X, Y, Z), with Stride floats between
+ *  components. Results are written back into pLow. */
+void NlerpQuaternions(float *pLow, const float *pkHigh, float t, size_t Count, size_t Stride)
+{
+    float *pLowW = pLow, *pLowX = pLow + Stride, *pLowY = pLow + Stride * 2, *pLowZ = pLow + Stride * 3;
+    const float *pkHighW = pkHigh, *pkHighX = pkHigh + Stride, *pkHighY = pkHigh + Stride * 2, *pkHighZ = pkHigh + Stride * 3;
+    size_t i = 0;
+
+#if PWE_ANIM_SSE
+    const __m128 T = _mm_set1_ps(t);
+    const __m128 SignMask = _mm_set1_ps(-0.f);
+
+    for (; i + 4 <= Count; i += 4)
+    {
+        const __m128 LowW = _mm_loadu_ps(pLowW + i), LowX = _mm_loadu_ps(pLowX + i);
+        const __m128 LowY = _mm_loadu_ps(pLowY + i), LowZ = _mm_loadu_ps(pLowZ + i);
+        __m128 HighW = _mm_loadu_ps(pkHighW + i), HighX = _mm_loadu_ps(pkHighX + i);
+        __m128 HighY = _mm_loadu_ps(pkHighY + i), HighZ = _mm_loadu_ps(pkHighZ + i);
+
+        // Flip the high key where needed so we interpolate along the shortest arc
+        const __m128 Dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(LowW, HighW), _mm_mul_ps(LowX, HighX)),
+                                      _mm_add_ps(_mm_mul_ps(LowY, HighY), _mm_mul_ps(LowZ, HighZ)));
+        const __m128 Flip = _mm_and_ps(_mm_cmplt_ps(Dot, _mm_setzero_ps()), SignMask);
+        HighW = _mm_xor_ps(HighW, Flip); HighX = _mm_xor_ps(HighX, Flip);
+        HighY = _mm_xor_ps(HighY, Flip); HighZ = _mm_xor_ps(HighZ, Flip);
+
+        const __m128 W = _mm_add_ps(LowW, _mm_mul_ps(_mm_sub_ps(HighW, LowW), T));
+        const __m128 X = _mm_add_ps(LowX, _mm_mul_ps(_mm_sub_ps(HighX, LowX), T));
+        const __m128 Y = _mm_add_ps(LowY, _mm_mul_ps(_mm_sub_ps(HighY, LowY), T));
+        const __m128 Z = _mm_add_ps(LowZ, _mm_mul_ps(_mm_sub_ps(HighZ, LowZ), T));
+
+        const __m128 Length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(W, W), _mm_mul_ps(X, X)),
+                                                     _mm_add_ps(_mm_mul_ps(Y, Y), _mm_mul_ps(Z, Z))));
+        _mm_storeu_ps(pLowW + i, _mm_div_ps(W, Length));
+        _mm_storeu_ps(pLowX + i, _mm_div_ps(X, Length));
+        _mm_storeu_ps(pLowY + i, _mm_div_ps(Y, Length));
+        _mm_storeu_ps(pLowZ + i, _mm_div_ps(Z, Length));
+    }
+#endif
+
+    for (; i < Count; i++)
+    {
+        const float Dot = pLowW[i] * pkHighW[i] + pLowX[i] * pkHighX[i] + pLowY[i] * pkHighY[i] + pLowZ[i] * pkHighZ[i];
+        const float Sign = (Dot < 0.f ? -1.f : 1.f);
+
+        const float W = pLowW[i] + (pkHighW[i] * Sign - pLowW[i]) * t;
+        const float X = pLowX[i] + (pkHighX[i] * Sign - pLowX[i]) * t;
+        const float Y = pLowY[i] + (pkHighY[i] * Sign - pLowY[i]) * t;
+        const float Z = pLowZ[i] + (pkHighZ[i] * Sign - pLowZ[i]) * t;
+        const float Length = std::sqrt(W * W + X * X + Y * Y + Z * Z);
+
+        pLowW[i] = W / Length; pLowX[i] = X / Length;
+        pLowY[i] = Y / Length; pLowZ[i] = Z / Length;
+    }
+}
+
+}
+
+std::atomic<bool> CAnimation::sQuantizeOnLoad{false};
 
 CAnimation::CAnimation(CResourceEntry *pEntry /*= 0*/)
     : CResource(pEntry)
@@ -16,17 +122,26 @@ std::unique_ptr<CDependencyTree> CAnimation::BuildDependencyTree() const
     return pTree;
 }
 
+bool CAnimation::CalculateKeyframe(float Time, uint32& rOutLowKey, float& rOutLerpFactor) const
+{
+    if (mDuration == 0.f) return false;
+
+    if (Time >= mDuration) Time = mDuration;
+    if (Time >= FLT_EPSILON) Time -= FLT_EPSILON;
+    rOutLerpFactor = fmodf(Time, mTickInterval) / mTickInterval;
+    rOutLowKey = (uint32) (Time / mTickInterval);
+    if (rOutLowKey == (mNumKeys - 1)) rOutLowKey = mNumKeys - 2;
+    return true;
+}
+
 void CAnimation::EvaluateTransform(float Time, uint32 BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const
 {
     const bool kInterpolate = true;
     if (!pOutTranslation && !pOutRotation && !pOutScale) return;
-    if (mDuration == 0.f) return;
 
-    if (Time >= mDuration) Time = mDuration;
-    if (Time >= FLT_EPSILON) Time -= FLT_EPSILON;
-    float t = fmodf(Time, mTickInterval) / mTickInterval;
-    uint32 LowKey = (uint32) (Time / mTickInterval);
-    if (LowKey == (mNumKeys - 1)) LowKey = mNumKeys - 2;
+    uint32 LowKey;
+    float t;
+    if (!CalculateKeyframe(Time, LowKey, t)) return;
 
     uint8 ScaleChannel = mBoneInfo[BoneID].ScaleChannelIdx;
     uint8 RotChannel = mBoneInfo[BoneID].RotationChannelIdx;
@@ -34,27 +149,261 @@ void CAnimation::EvaluateTransform(float Time, uint32 BoneID, CVector3f *pOutTra
 
     if (ScaleChannel != 0xFF && pOutScale)
     {
-        const CVector3f& rkLow = mScaleChannels[ScaleChannel][LowKey];
-        const CVector3f& rkHigh = mScaleChannels[ScaleChannel][LowKey + 1];
-        *pOutScale = (kInterpolate ? Math::Lerp<CVector3f>(rkLow, rkHigh, t) : rkLow);
+        const CVector3f Low = ScaleKey(ScaleChannel, LowKey);
+        const CVector3f High = ScaleKey(ScaleChannel, LowKey + 1);
+        *pOutScale = (kInterpolate ? Math::Lerp<CVector3f>(Low, High, t) : Low);
     }
 
     if (RotChannel != 0xFF && pOutRotation)
     {
-        const CQuaternion& rkLow = mRotationChannels[RotChannel][LowKey];
-        const CQuaternion& rkHigh = mRotationChannels[RotChannel][LowKey + 1];
-        *pOutRotation = (kInterpolate ? rkLow.Slerp(rkHigh, t) : rkLow);
+        const CQuaternion Low = RotationKey(RotChannel, LowKey);
+        const CQuaternion High = RotationKey(RotChannel, LowKey + 1);
+        *pOutRotation = (kInterpolate ? Low.Slerp(High, t) : Low);
     }
 
     if (TransChannel != 0xFF && pOutTranslation)
     {
-        const CVector3f& rkLow = mTranslationChannels[TransChannel][LowKey];
-        const CVector3f& rkHigh = mTranslationChannels[TransChannel][LowKey + 1];
-        *pOutTranslation = (kInterpolate ? Math::Lerp<CVector3f>(rkLow, rkHigh, t) : rkLow);
+        const CVector3f Low = TranslationKey(TransChannel, LowKey);
+        const CVector3f High = TranslationKey(TransChannel, LowKey + 1);
+        *pOutTranslation = (kInterpolate ? Math::Lerp<CVector3f>(Low, High, t) : Low);
     }
 }
 
+void CAnimation::EvaluatePose(float Time, const uint32 *pkBoneIDs, size_t NumBones, CVector3f *pOutTranslations, CQuaternion *pOutRotations, CVector3f *pOutScales) const
+{
+    // Batched version of EvaluateTransform. The keyframe pair is only calculated once, then the keys
+    // for each channel type are gathered into SoA scratch buffers and interpolated four bones at a time.
+    // Rotations use nlerp rather than slerp; keys are a single tick apart, so the difference is negligible.
+    // Outputs are left untouched for bones that have no channel of that type, so callers should fill in
+    // defaults beforehand.
+    uint32 LowKey;
+    float t;
+    if (!CalculateKeyframe(Time, LowKey, t)) return;
+
+    thread_local SPoseChannelScratch Scratch;
+
+    // Scale
+    Scratch.Reset(NumBones, 3);
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        const uint8 Channel = mBoneInfo[pkBoneIDs[iBone]].ScaleChannelIdx;
+        if (Channel == 0xFF) continue;
+
+        const size_t Idx = Scratch.Bones.size();
+        const CVector3f Low = ScaleKey(Channel, LowKey);
+        const CVector3f High = ScaleKey(Channel, LowKey + 1);
+        Scratch.Low[Idx] = Low.X; Scratch.Low[NumBones + Idx] = Low.Y; Scratch.Low[NumBones * 2 + Idx] = Low.Z;
+        Scratch.High[Idx] = High.X; Scratch.High[NumBones + Idx] = High.Y; Scratch.High[NumBones * 2 + Idx] = High.Z;
+        Scratch.Bones.push_back(iBone);
+    }
+
+    for (size_t iComp = 0; iComp < 3; iComp++)
+        LerpComponents(&Scratch.Low[NumBones * iComp], &Scratch.High[NumBones * iComp], t, Scratch.Bones.size());
+
+    for (size_t Idx = 0; Idx < Scratch.Bones.size(); Idx++)
+        pOutScales[Scratch.Bones[Idx]] = CVector3f(Scratch.Low[Idx], Scratch.Low[NumBones + Idx], Scratch.Low[NumBones * 2 + Idx]);
+
+    // Rotation
+    Scratch.Reset(NumBones, 4);
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        const uint8 Channel = mBoneInfo[pkBoneIDs[iBone]].RotationChannelIdx;
+        if (Channel == 0xFF) continue;
+
+        const size_t Idx = Scratch.Bones.size();
+        const CQuaternion Low = RotationKey(Channel, LowKey);
+        const CQuaternion High = RotationKey(Channel, LowKey + 1);
+        Scratch.Low[Idx] = Low.W; Scratch.Low[NumBones + Idx] = Low.X;
+        Scratch.Low[NumBones * 2 + Idx] = Low.Y; Scratch.Low[NumBones * 3 + Idx] = Low.Z;
+        Scratch.High[Idx] = High.W; Scratch.High[NumBones + Idx] = High.X;
+        Scratch.High[NumBones * 2 + Idx] = High.Y; Scratch.High[NumBones * 3 + Idx] = High.Z;
+        Scratch.Bones.push_back(iBone);
+    }
+
+    NlerpQuaternions(Scratch.Low.data(), Scratch.High.data(), t, Scratch.Bones.size(), NumBones);
+
+    for (size_t Idx = 0; Idx < Scratch.Bones.size(); Idx++)
+    {
+        CQuaternion& rOut = pOutRotations[Scratch.Bones[Idx]];
+        rOut.W = Scratch.Low[Idx];
+        rOut.X = Scratch.Low[NumBones + Idx];
+        rOut.Y = Scratch.Low[NumBones * 2 + Idx];
+        rOut.Z = Scratch.Low[NumBones * 3 + Idx];
+    }
+
+    // Translation
+    Scratch.Reset(NumBones, 3);
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        const uint8 Channel = mBoneInfo[pkBoneIDs[iBone]].TranslationChannelIdx;
+        if (Channel == 0xFF) continue;
+
+        const size_t Idx = Scratch.Bones.size();
+        const CVector3f Low = TranslationKey(Channel, LowKey);
+        const CVector3f High = TranslationKey(Channel, LowKey + 1);
+        Scratch.Low[Idx] = Low.X; Scratch.Low[NumBones + Idx] = Low.Y; Scratch.Low[NumBones * 2 + Idx] = Low.Z;
+        Scratch.High[Idx] = High.X; Scratch.High[NumBones + Idx] = High.Y; Scratch.High[NumBones * 2 + Idx] = High.Z;
+        Scratch.Bones.push_back(iBone);
+    }
+
+    for (size_t iComp = 0; iComp < 3; iComp++)
+        LerpComponents(&Scratch.Low[NumBones * iComp], &Scratch.High[NumBones * iComp], t, Scratch.Bones.size());
+
+    for (size_t Idx = 0; Idx < Scratch.Bones.size(); Idx++)
+        pOutTranslations[Scratch.Bones[Idx]] = CVector3f(Scratch.Low[Idx], Scratch.Low[NumBones + Idx], Scratch.Low[NumBones * 2 + Idx]);
+}
+
 bool CAnimation::HasTranslation(uint32 BoneID) const
 {
     return (mBoneInfo[BoneID].TranslationChannelIdx != 0xFF);
 }
+
+void CAnimation::QuantizeChannels()
+{
+    if (mIsQuantized)
+        return;
+
+    std::vector<float> Components;
+
+    const auto QuantizeVectors = [&Components](const std::vector<std::vector<CVector3f>>& rkChannels, std::vector<SQuantizedChannel>& rOut)
+    {
+        rOut.resize(rkChannels.size());
+
+        for (size_t iChan = 0; iChan < rkChannels.size(); iChan++)
+        {
+            Components.clear();
+
+            for (const CVector3f& rkKey : rkChannels[iChan])
+                Components.insert(Components.end(), {rkKey.X, rkKey.Y, rkKey.Z});
+
+            QuantizeChannel(Components.data(), rkChannels[iChan].size(), 3, rOut[iChan]);
+        }
+    };
+
+    QuantizeVectors(mScaleChannels, mQuantizedScaleChannels);
+    QuantizeVectors(mTranslationChannels, mQuantizedTranslationChannels);
+    mQuantizedRotationChannels.resize(mRotationChannels.size());
+
+    for (size_t iChan = 0; iChan < mRotationChannels.size(); iChan++)
+    {
+        Components.clear();
+
+        for (const CQuaternion& rkKey : mRotationChannels[iChan])
+            Components.insert(Components.end(), {rkKey.W, rkKey.X, rkKey.Y, rkKey.Z});
+
+        QuantizeChannel(Components.data(), mRotationChannels[iChan].size(), 4, mQuantizedRotationChannels[iChan]);
+    }
+
+    // Release the expanded keys
+    std::vector<TScaleChannel>().swap(mScaleChannels);
+    std::vector<TRotationChannel>().swap(mRotationChannels);
+    std::vector<TTranslationChannel>().swap(mTranslationChannels);
+    mIsQuantized = true;
+}
+
+size_t CAnimation::MemoryUsage() const
+{
+    size_t Size = sizeof(CAnimation);
+
+    for (const TScaleChannel& rkChannel : mScaleChannels)
+        Size += sizeof(TScaleChannel) + rkChannel.capacity() * sizeof(CVector3f);
+    for (const TRotationChannel& rkChannel : mRotationChannels)
+        Size += sizeof(TRotationChannel) + rkChannel.capacity() * sizeof(CQuaternion);
+    for (const TTranslationChannel& rkChannel : mTranslationChannels)
+        Size += sizeof(TTranslationChannel) + rkChannel.capacity() * sizeof(CVector3f);
+
+    for (const auto* pkChannels : {&mQuantizedScaleChannels, &mQuantizedRotationChannels, &mQuantizedTranslationChannels})
+    {
+        for (const SQuantizedChannel& rkChannel : *pkChannels)
+            Size += sizeof(SQuantizedChannel) + rkChannel.Values.capacity() * sizeof(uint16);
+    }
+
+    return Size;
+}
+
+CVector3f CAnimation::ScaleKey(uint8 Channel, uint32 Key) const
+{
+    if (!mIsQuantized)
+        return mScaleChannels[Channel][Key];
+
+    const SQuantizedChannel& rkChannel = mQuantizedScaleChannels[Channel];
+    const uint16 *pkValues = &rkChannel.Values[Key * 3];
+    return CVector3f(rkChannel.Offset[0] + pkValues[0] * rkChannel.Scale[0],
+                     rkChannel.Offset[1] + pkValues[1] * rkChannel.Scale[1],
+                     rkChannel.Offset[2] + pkValues[2] * rkChannel.Scale[2]);
+}
+
+CQuaternion CAnimation::RotationKey(uint8 Channel, uint32 Key) const
+{
+    if (!mIsQuantized)
+        return mRotationChannels[Channel][Key];
+
+    const SQuantizedChannel& rkChannel = mQuantizedRotationChannels[Channel];
+    const uint16 *pkValues = &rkChannel.Values[Key * 4];
+
+    CQuaternion Out;
+    Out.W = rkChannel.Offset[0] + pkValues[0] * rkChannel.Scale[0];
+    Out.X = rkChannel.Offset[1] + pkValues[1] * rkChannel.Scale[1];
+    Out.Y = rkChannel.Offset[2] + pkValues[2] * rkChannel.Scale[2];
+    Out.Z = rkChannel.Offset[3] + pkValues[3] * rkChannel.Scale[3];
+
+    // Quantization error leaves the quaternion slightly off unit length
+    const float Length = std::sqrt(Out.W * Out.W + Out.X * Out.X + Out.Y * Out.Y + Out.Z * Out.Z);
+
+    if (Length > FLT_EPSILON)
+    {
+        Out.W /= Length;
+        Out.X /= Length;
+        Out.Y /= Length;
+        Out.Z /= Length;
+    }
+
+    return Out;
+}
+
+CVector3f CAnimation::TranslationKey(uint8 Channel, uint32 Key) const
+{
+    if (!mIsQuantized)
+        return mTranslationChannels[Channel][Key];
+
+    const SQuantizedChannel& rkChannel = mQuantizedTranslationChannels[Channel];
+    const uint16 *pkValues = &rkChannel.Values[Key * 3];
+    return CVector3f(rkChannel.Offset[0] + pkValues[0] * rkChannel.Scale[0],
+                     rkChannel.Offset[1] + pkValues[1] * rkChannel.Scale[1],
+                     rkChannel.Offset[2] + pkValues[2] * rkChannel.Scale[2]);
+}
+
+void CAnimation::QuantizeChannel(const float *pkComponents, size_t NumKeys, size_t NumComponents, SQuantizedChannel& rOut)
+{
+    // Each component gets its own range, so channels that barely move keep most of their precision
+    constexpr float kMaxValue = 65535.f;
+    rOut.Values.resize(NumKeys * NumComponents);
+
+    for (size_t iComp = 0; iComp < NumComponents; iComp++)
+    {
+        float Min = FLT_MAX;
+        float Max = -FLT_MAX;
+
+        for (size_t iKey = 0; iKey < NumKeys; iKey++)
+        {
+            Min = std::min(Min, pkComponents[iKey * NumComponents + iComp]);
+            Max = std::max(Max, pkComponents[iKey * NumComponents + iComp]);
+        }
+
+        if (NumKeys == 0)
+            Min = Max = 0.f;
+
+        const float Scale = (Max - Min) / kMaxValue;
+        rOut.Offset[iComp] = Min;
+        rOut.Scale[iComp] = Scale;
+
+        for (size_t iKey = 0; iKey < NumKeys; iKey++)
+        {
+            const float Value = (Scale > 0.f ? (pkComponents[iKey * NumComponents + iComp] - Min) / Scale : 0.f);
+            rOut.Values[iKey * NumComponents + iComp] = static_cast<uint16>(std::clamp(std::round(Value), 0.f, kMaxValue));
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include <Common/Math/CQuaternion.h>
 #include <Common/Math/CVector3f.h>
 #include <array>
+#include <atomic>
 #include <vector>
 
 class CAnimation : public CResource
@@ -34,18 +35,50 @@ class CAnimation : public CResource
     };
     std::array<SBoneChannelInfo, 100> mBoneInfo;
 
+    // Quantized channel storage. Each key stores one uint16 per component, decoded as
+    // Offset + Value * Scale. Used in place of the expanded channels when mIsQuantized is set.
+    struct SQuantizedChannel
+    {
+        std::array<float, 4> Offset{};
+        std::array<float, 4> Scale{};
+        std::vector<uint16> Values;
+    };
+    std::vector<SQuantizedChannel> mQuantizedScaleChannels;
+    std::vector<SQuantizedChannel> mQuantizedRotationChannels;
+    std::vector<SQuantizedChannel> mQuantizedTranslationChannels;
+    bool mIsQuantized = false;
+
+    static std::atomic<bool> sQuantizeOnLoad;
+
     TResPtr<CAnimEventData> mpEventData;
 
 public:
     explicit CAnimation(CResourceEntry *pEntry = nullptr);
     std::unique_ptr<CDependencyTree> BuildDependencyTree() const override;
     void EvaluateTransform(float Time, uint32 BoneID, CVector3f *pOutTranslation, CQuaternion *pOutRotation, CVector3f *pOutScale) const;
+    void EvaluatePose(float Time, const uint32 *pkBoneIDs, size_t NumBones, CVector3f *pOutTranslations, CQuaternion *pOutRotations, CVector3f *pOutScales) const;
     bool HasTranslation(uint32 BoneID) const;
+    void QuantizeChannels();
+    size_t MemoryUsage() const override;
+
+    bool IsQuantized() const             { return mIsQuantized; }
 
     float Duration() const               { return mDuration; }
     uint32 NumKeys() const               { return mNumKeys; }
     float TickInterval() const           { return mTickInterval; }
     CAnimEventData* EventData() const    { return mpEventData; }
+
+    /** Whether newly loaded animations should have their channels quantized to save memory */
+    static void SetQuantizeOnLoad(bool Enable)  { sQuantizeOnLoad = Enable; }
+    static bool QuantizeOnLoad()                { return sQuantizeOnLoad; }
+
+private:
+    bool CalculateKeyframe(float Time, uint32& rOutLowKey, float& rOutLerpFactor) const;
+    CVector3f ScaleKey(uint8 Channel, uint32 Key) const;
+    CQuaternion RotationKey(uint8 Channel, uint32 Key) const;
+    CVector3f TranslationKey(uint8 Channel, uint32 Key) const;
+
+    static void QuantizeChannel(const float *pkComponents, size_t NumKeys, size_t NumComponents, SQuantizedChannel& rOut);
 };
 
 #endif // CANIMATION_H
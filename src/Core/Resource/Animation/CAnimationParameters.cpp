@@ -194,7 +194,7 @@ void CAnimationParameters::SetResource(const CAssetID& rkID)
         // Validate ID
         if (mCharacterID.IsValid())
         {
-            CResourceEntry *pEntry = gpResourceStore->FindEntry(rkID);
+            CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(rkID);
 
             if (!pEntry)
                 errorf("Invalid resource ID passed to CAnimationParameters: %s", *rkID.ToString());
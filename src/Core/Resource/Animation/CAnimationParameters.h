@@ -34,7 +34,7 @@ public:
     // Accessors
     EGame Version() const            { return mGame; }
     CAssetID ID() const              { return mCharacterID; }
-    CAnimSet* AnimSet() const        { return (CAnimSet*) gpResourceStore->LoadResource(mCharacterID); }
+    CAnimSet* AnimSet() const        { return (CAnimSet*) ActiveResourceStore()->LoadResource(mCharacterID); }
     uint32 CharacterIndex() const    { return mCharIndex; }
     uint32 AnimIndex() const         { return mAnimIndex; }
     void SetCharIndex(uint32 Index)  { mCharIndex = Index; }
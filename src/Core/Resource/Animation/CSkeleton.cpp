@@ -107,10 +107,84 @@ uint32 CSkeleton::MaxBoneID() const
 
 void CSkeleton::UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot)
 {
+    ASSERT(rData.NumTrackedBones() >= MaxBoneID());
+    const size_t NumBones = mFlatBones.size();
+
+    // Scratch pose buffers. These are thread-local so poses can be evaluated from worker threads.
+    thread_local std::vector<CVector3f> Positions;
+    thread_local std::vector<CQuaternion> Rotations;
+    thread_local std::vector<CVector3f> Scales;
+    Positions.resize(NumBones);
+    Rotations.assign(NumBones, CQuaternion::Identity());
+    Scales.assign(NumBones, CVector3f::One());
+
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+        Positions[iBone] = mFlatBones[iBone].pBone->LocalPosition();
+
+    // Sample every channel for the whole skeleton in one go
+    if (pAnim)
+        pAnim->EvaluatePose(Time, mFlatBoneIDs.data(), NumBones, Positions.data(), Rotations.data(), Scales.data());
+
+    // Parents are always processed before their children, so a single pass composes the whole hierarchy.
+    // Note that only the parent's local scale is applied to children, same as CBone::UpdateTransform.
+    for (size_t iBone = 0; iBone < NumBones; iBone++)
+    {
+        const SFlatBone& rkBone = mFlatBones[iBone];
+
+        if (AnchorRoot && rkBone.IsRoot)
+            Positions[iBone] = CVector3f::Zero();
+
+        if (rkBone.ParentIndex >= 0)
+        {
+            const size_t Parent = static_cast<size_t>(rkBone.ParentIndex);
+            Positions[iBone] = Positions[Parent] + (Rotations[Parent] * (Scales[Parent] * Positions[iBone]));
+            Rotations[iBone] = Rotations[Parent] * Rotations[iBone];
+        }
+
+        CTransform4f& rTransform = rData[mFlatBoneIDs[iBone]];
+        rTransform.SetIdentity();
+        rTransform.Scale(Scales[iBone]);
+        rTransform.Rotate(Rotations[iBone]);
+        rTransform.Translate(Positions[iBone]);
+        rTransform *= rkBone.pBone->InverseBindMatrix();
+    }
+}
+
+void CSkeleton::UpdateTransformRecursive(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot)
+{
+    // Reference implementation that walks the bone tree; kept for validating UpdateTransform
     ASSERT(rData.NumTrackedBones() >= MaxBoneID());
     mpRootBone->UpdateTransform(rData, SBoneTransformInfo(), pAnim, Time, AnchorRoot);
 }
 
+void CSkeleton::BuildFlatHierarchy()
+{
+    mFlatBones.clear();
+    mFlatBoneIDs.clear();
+
+    if (!mpRootBone)
+        return;
+
+    mFlatBones.reserve(mBones.size());
+    mFlatBoneIDs.reserve(mBones.size());
+
+    // Depth-first, visiting children in order, so the flattened order matches the recursive walk
+    std::vector<std::pair<CBone*, int32>> Stack{{mpRootBone, -1}};
+
+    while (!Stack.empty())
+    {
+        const auto [pBone, ParentIndex] = Stack.back();
+        Stack.pop_back();
+
+        const auto Index = static_cast<int32>(mFlatBones.size());
+        mFlatBones.push_back(SFlatBone{pBone, ParentIndex, pBone->IsRoot()});
+        mFlatBoneIDs.push_back(pBone->ID());
+
+        for (size_t iChild = pBone->NumChildren(); iChild > 0; iChild--)
+            Stack.emplace_back(pBone->ChildByIndex(iChild - 1), Index);
+    }
+}
+
 void CSkeleton::Draw(FRenderOptions /*Options*/, const CBoneTransformData *pkData)
 {
     glBlendFunc(GL_ONE, GL_ZERO);
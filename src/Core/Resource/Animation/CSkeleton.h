@@ -29,12 +29,23 @@ class CSkeleton : public CResource
     CBone *mpRootBone = nullptr;
     std::vector<std::unique_ptr<CBone>> mBones;
 
+    // Bones reachable from the root, flattened so that parents always come before their children
+    struct SFlatBone
+    {
+        CBone *pBone;
+        int32 ParentIndex;
+        bool IsRoot;
+    };
+    std::vector<SFlatBone> mFlatBones;
+    std::vector<uint32> mFlatBoneIDs;
+
     static constexpr float skSphereRadius = 0.025f;
 
 public:
     explicit CSkeleton(CResourceEntry *pEntry = nullptr);
     ~CSkeleton() override;
     void UpdateTransform(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot);
+    void UpdateTransformRecursive(CBoneTransformData& rData, CAnimation *pAnim, float Time, bool AnchorRoot);
     CBone* BoneByID(uint32 BoneID) const;
     CBone* BoneByName(std::string_view name) const;
     uint32 MaxBoneID() const;
@@ -44,6 +55,9 @@ public:
 
     size_t NumBones() const  { return mBones.size(); }
     CBone* RootBone() const  { return mpRootBone; }
+
+private:
+    void BuildFlatHierarchy();
 };
 
 class CBone
@@ -79,6 +93,7 @@ public:
     CVector3f LocalPosition() const              { return mLocalPosition; }
     CQuaternion Rotation() const                 { return mRotation; }
     CQuaternion LocalRotation() const            { return mLocalRotation; }
+    const CTransform4f& InverseBindMatrix() const { return mInvBind; }
     TString Name() const                         { return mName; }
     bool IsSelected() const                      { return mSelected; }
 
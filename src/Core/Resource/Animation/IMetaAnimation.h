@@ -35,12 +35,12 @@ public:
     CAnimPrimitive(const CAssetID& rkAnimAssetID, uint32 CharAnimID, const TString& rkAnimName)
         : mID(CharAnimID), mName(rkAnimName)
     {
-        mpAnim = gpResourceStore->LoadResource(rkAnimAssetID);
+        mpAnim = ActiveResourceStore()->LoadResource(rkAnimAssetID);
     }
 
     CAnimPrimitive(IInputStream& rInput, EGame Game)
     {
-        mpAnim = gpResourceStore->LoadResource( CAssetID(rInput, Game) );
+        mpAnim = ActiveResourceStore()->LoadResource( CAssetID(rInput, Game) );
         mID = rInput.ReadLong();
         mName = rInput.ReadString();
     }
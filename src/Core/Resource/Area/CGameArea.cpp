@@ -1,7 +1,10 @@
 #include "CGameArea.h"
+#include "Core/Resource/Script/CLink.h"
 #include "Core/Resource/Script/CScriptLayer.h"
 #include "Core/Render/CRenderer.h"
 
+#include <unordered_set>
+
 CGameArea::CGameArea(CResourceEntry *pEntry)
     : CResource(pEntry)
 {
@@ -233,6 +236,31 @@ void CGameArea::DeleteInstance(CScriptObject *pInstance)
     delete pInstance;
 }
 
+void CGameArea::DeleteLinks(const std::vector<CLink*>& rkLinks)
+{
+    if (rkLinks.empty())
+        return;
+
+    // Remove the links from each affected object in one pass per object, rather than
+    // searching and erasing from the object's link lists once per link.
+    const std::unordered_set<CLink*> LinkSet(rkLinks.begin(), rkLinks.end());
+    std::unordered_set<CScriptObject*> Objects;
+
+    for (CLink *pLink : LinkSet)
+    {
+        if (CScriptObject *pSender = pLink->Sender())
+            Objects.insert(pSender);
+        if (CScriptObject *pReceiver = pLink->Receiver())
+            Objects.insert(pReceiver);
+    }
+
+    for (CScriptObject *pObject : Objects)
+        pObject->RemoveLinks(LinkSet);
+
+    for (CLink *pLink : LinkSet)
+        delete pLink;
+}
+
 void CGameArea::ClearExtraDependencies()
 {
     if (mExtraAreaDeps.empty() || !mExtraLayerDeps.empty())
@@ -242,3 +270,22 @@ void CGameArea::ClearExtraDependencies()
         Entry()->UpdateDependencies();
     }
 }
+
+void CGameArea::BuildLightGrids()
+{
+    mLightGrids.resize(mLightLayers.size());
+
+    for (size_t iLyr = 0; iLyr < mLightLayers.size(); iLyr++)
+        mLightGrids[iLyr].Build(mLightLayers[iLyr]);
+
+    mLightGridsDirty = false;
+}
+
+const CLightGrid& CGameArea::LightGrid(size_t LayerIndex)
+{
+    // Lights can be edited after load, in which case the grids are rebuilt on next use
+    if (mLightGridsDirty)
+        BuildLightGrids();
+
+    return mLightGrids[LayerIndex];
+}
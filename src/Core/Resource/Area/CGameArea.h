@@ -1,6 +1,7 @@
 #ifndef CGAMEAREA_H
 #define CGAMEAREA_H
 
+#include "CLightGrid.h"
 #include "Core/Resource/CResource.h"
 #include "Core/Resource/CLight.h"
 #include "Core/Resource/CMaterialSet.h"
@@ -16,6 +17,7 @@
 #include <unordered_map>
 #include <vector>
 
+class CLink;
 class CScriptLayer;
 class CScriptObject;
 class CScriptTemplate;
@@ -56,6 +58,8 @@ class CGameArea : public CResource
     std::unique_ptr<CCollisionMeshGroup> mpCollision;
     // Lights
     std::vector<std::vector<CLight>> mLightLayers;
+    std::vector<CLightGrid> mLightGrids;
+    bool mLightGridsDirty = true;
     // Path Mesh
     CAssetID mPathID;
     // Portal Area
@@ -86,7 +90,10 @@ public:
                                  uint32 SuggestedLayerIndex = UINT32_MAX);
     void AddInstanceToArea(CScriptObject *pInstance);
     void DeleteInstance(CScriptObject *pInstance);
+    void DeleteLinks(const std::vector<CLink*>& rkLinks);
     void ClearExtraDependencies();
+    void BuildLightGrids();
+    const CLightGrid& LightGrid(size_t LayerIndex);
 
     // Accessors
     uint32 WorldIndex() const                                    { return mWorldIndex; }
@@ -102,6 +109,7 @@ public:
     size_t NumLightLayers() const                                { return mLightLayers.size(); }
     size_t NumLights(size_t LayerIndex) const                    { return (LayerIndex < mLightLayers.size() ? mLightLayers[LayerIndex].size() : 0); }
     CLight* Light(size_t LayerIndex, size_t LightIndex)          { return &mLightLayers[LayerIndex][LightIndex]; }
+    void InvalidateLightGrids()                                  { mLightGridsDirty = true; }
     CAssetID PathID() const                                      { return mPathID; }
     CPoiToWorld* PoiToWorldMap() const                           { return mpPoiToWorldMap; }
     CAssetID PortalAreaID() const                                { return mPortalAreaID; }
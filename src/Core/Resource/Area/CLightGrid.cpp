@@ -0,0 +1,214 @@
+#include "CLightGrid.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace
+{
+// Upper bound on grid resolution per axis; keeps memory usage sane for huge areas
+constexpr uint32 kMaxCellsPerAxis = 32;
+// Approximate number of cells to allocate per bounded light
+constexpr uint32 kCellsPerLight = 4;
+
+float Axis(const CVector3f& rkVec, size_t Index)
+{
+    return (Index == 0 ? rkVec.X : (Index == 1 ? rkVec.Y : rkVec.Z));
+}
+}
+
+void CLightGrid::Build(const std::vector<CLight>& rkLights)
+{
+    Clear();
+    mNumLights = static_cast<uint32>(rkLights.size());
+
+    // Sort lights into ambient, unbounded and bounded, and calculate the bounds of the grid
+    std::vector<uint32> BoundedLights;
+    CVector3f Min(FLT_MAX, FLT_MAX, FLT_MAX);
+    CVector3f Max(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+    for (uint32 iLight = 0; iLight < mNumLights; iLight++)
+    {
+        const CLight& rkLight = rkLights[iLight];
+
+        // Match BuildLightList, which uses the last ambient light on the layer
+        if (rkLight.Type() == ELightType::LocalAmbient)
+        {
+            mAmbientLightIndex = iLight;
+            continue;
+        }
+
+        const float Radius = rkLight.GetRadius();
+
+        if (!std::isfinite(Radius) || Radius >= FLT_MAX)
+        {
+            mUnboundedLights.push_back(iLight);
+            continue;
+        }
+
+        const CVector3f Pos = rkLight.Position();
+        Min = CVector3f(std::min(Min.X, Pos.X - Radius), std::min(Min.Y, Pos.Y - Radius), std::min(Min.Z, Pos.Z - Radius));
+        Max = CVector3f(std::max(Max.X, Pos.X + Radius), std::max(Max.Y, Pos.Y + Radius), std::max(Max.Z, Pos.Z + Radius));
+        BoundedLights.push_back(iLight);
+    }
+
+    if (BoundedLights.empty())
+        return;
+
+    // Pick a roughly cubic cell size that gives us a few cells per light
+    const CVector3f Extent(std::max(Max.X - Min.X, 1.f), std::max(Max.Y - Min.Y, 1.f), std::max(Max.Z - Min.Z, 1.f));
+    const float TargetCells = static_cast<float>(std::min<size_t>(BoundedLights.size() * kCellsPerLight, kMaxCellsPerAxis * kMaxCellsPerAxis * kMaxCellsPerAxis));
+    const float CellSide = std::cbrt((Extent.X * Extent.Y * Extent.Z) / TargetCells);
+
+    for (size_t iAxis = 0; iAxis < 3; iAxis++)
+    {
+        const auto Dim = static_cast<uint32>(std::ceil(Axis(Extent, iAxis) / CellSide));
+        mDims[iAxis] = std::clamp<uint32>(Dim, 1, kMaxCellsPerAxis);
+    }
+
+    mOrigin = Min;
+    mCellSize = CVector3f(Extent.X / mDims[0], Extent.Y / mDims[1], Extent.Z / mDims[2]);
+
+    // Lights that cover a large chunk of the grid are cheaper to keep in the unbounded list
+    const uint32 CellCount = NumCells();
+    const uint32 MaxCellsPerLight = std::max<uint32>(CellCount / 2, 8);
+
+    std::vector<std::array<uint32, 3>> LightLow(BoundedLights.size());
+    std::vector<std::array<uint32, 3>> LightHigh(BoundedLights.size());
+    std::vector<uint32> CellCounts(CellCount, 0);
+
+    for (size_t iBnd = 0; iBnd < BoundedLights.size(); iBnd++)
+    {
+        const CLight& rkLight = rkLights[BoundedLights[iBnd]];
+        const CVector3f Pos = rkLight.Position();
+        const float Radius = rkLight.GetRadius();
+        const CVector3f RadiusVec(Radius, Radius, Radius);
+        CellRange(Pos - RadiusVec, Pos + RadiusVec, LightLow[iBnd], LightHigh[iBnd]);
+
+        const std::array<uint32, 3>& Low = LightLow[iBnd];
+        const std::array<uint32, 3>& High = LightHigh[iBnd];
+        const uint32 NumCovered = (High[0] - Low[0] + 1) * (High[1] - Low[1] + 1) * (High[2] - Low[2] + 1);
+
+        if (NumCovered > MaxCellsPerLight)
+        {
+            mUnboundedLights.push_back(BoundedLights[iBnd]);
+            BoundedLights[iBnd] = UINT32_MAX;
+            continue;
+        }
+
+        for (uint32 Z = Low[2]; Z <= High[2]; Z++)
+            for (uint32 Y = Low[1]; Y <= High[1]; Y++)
+                for (uint32 X = Low[0]; X <= High[0]; X++)
+                    CellCounts[(Z * mDims[1] + Y) * mDims[0] + X]++;
+    }
+
+    std::sort(mUnboundedLights.begin(), mUnboundedLights.end());
+
+    // Convert counts to offsets, then fill. Lights are visited in index order so each cell stays sorted.
+    mCellStart.resize(CellCount + 1);
+    mCellStart[0] = 0;
+
+    for (uint32 iCell = 0; iCell < CellCount; iCell++)
+        mCellStart[iCell + 1] = mCellStart[iCell] + CellCounts[iCell];
+
+    mCellLights.resize(mCellStart[CellCount]);
+    std::vector<uint32> CellFill(mCellStart.begin(), mCellStart.end() - 1);
+
+    for (size_t iBnd = 0; iBnd < BoundedLights.size(); iBnd++)
+    {
+        if (BoundedLights[iBnd] == UINT32_MAX)
+            continue;
+
+        const std::array<uint32, 3>& Low = LightLow[iBnd];
+        const std::array<uint32, 3>& High = LightHigh[iBnd];
+
+        for (uint32 Z = Low[2]; Z <= High[2]; Z++)
+            for (uint32 Y = Low[1]; Y <= High[1]; Y++)
+                for (uint32 X = Low[0]; X <= High[0]; X++)
+                    mCellLights[CellFill[(Z * mDims[1] + Y) * mDims[0] + X]++] = BoundedLights[iBnd];
+    }
+}
+
+void CLightGrid::Clear()
+{
+    mOrigin = CVector3f::Zero();
+    mCellSize = CVector3f::One();
+    mDims = {};
+    mCellStart.clear();
+    mCellLights.clear();
+    mUnboundedLights.clear();
+    mAmbientLightIndex = UINT32_MAX;
+    mNumLights = 0;
+}
+
+void CLightGrid::GatherCandidates(const CAABox& rkBox, std::vector<uint32>& rOutIndices) const
+{
+    rOutIndices.clear();
+    const CVector3f BoxMin = rkBox.Min();
+    const CVector3f BoxMax = rkBox.Max();
+
+    // Degenerate boxes can't be located in the grid; fall back to testing every light
+    const bool BoxValid = std::isfinite(BoxMin.X) && std::isfinite(BoxMin.Y) && std::isfinite(BoxMin.Z) &&
+                          std::isfinite(BoxMax.X) && std::isfinite(BoxMax.Y) && std::isfinite(BoxMax.Z) &&
+                          BoxMin.X <= BoxMax.X && BoxMin.Y <= BoxMax.Y && BoxMin.Z <= BoxMax.Z;
+
+    if (!BoxValid)
+    {
+        rOutIndices.reserve(mNumLights);
+
+        for (uint32 iLight = 0; iLight < mNumLights; iLight++)
+        {
+            if (iLight != mAmbientLightIndex)
+                rOutIndices.push_back(iLight);
+        }
+        return;
+    }
+
+    rOutIndices.insert(rOutIndices.end(), mUnboundedLights.begin(), mUnboundedLights.end());
+
+    std::array<uint32, 3> Low, High;
+    if (mCellStart.empty() || !CellRange(BoxMin, BoxMax, Low, High))
+        return;
+
+    const bool SingleCell = (Low == High);
+
+    for (uint32 Z = Low[2]; Z <= High[2]; Z++)
+    {
+        for (uint32 Y = Low[1]; Y <= High[1]; Y++)
+        {
+            for (uint32 X = Low[0]; X <= High[0]; X++)
+            {
+                const uint32 Cell = (Z * mDims[1] + Y) * mDims[0] + X;
+                rOutIndices.insert(rOutIndices.end(), mCellLights.begin() + mCellStart[Cell], mCellLights.begin() + mCellStart[Cell + 1]);
+            }
+        }
+    }
+
+    // Lights spanning multiple cells show up more than once; also restore index order so results are stable
+    if (!SingleCell || !mUnboundedLights.empty())
+    {
+        std::sort(rOutIndices.begin(), rOutIndices.end());
+        rOutIndices.erase(std::unique(rOutIndices.begin(), rOutIndices.end()), rOutIndices.end());
+    }
+}
+
+bool CLightGrid::CellRange(const CVector3f& rkMin, const CVector3f& rkMax, std::array<uint32, 3>& rOutLow, std::array<uint32, 3>& rOutHigh) const
+{
+    bool Overlaps = true;
+
+    for (size_t iAxis = 0; iAxis < 3; iAxis++)
+    {
+        const float Origin = Axis(mOrigin, iAxis);
+        const float CellSize = Axis(mCellSize, iAxis);
+        const float Low = (Axis(rkMin, iAxis) - Origin) / CellSize;
+        const float High = (Axis(rkMax, iAxis) - Origin) / CellSize;
+        const auto MaxCell = static_cast<float>(mDims[iAxis] - 1);
+
+        if (High < 0.f || Low > static_cast<float>(mDims[iAxis]))
+            Overlaps = false;
+
+        rOutLow[iAxis] = static_cast<uint32>(std::clamp(std::floor(Low), 0.f, MaxCell));
+        rOutHigh[iAxis] = static_cast<uint32>(std::clamp(std::floor(High), 0.f, MaxCell));
+    }
+
+    return Overlaps;
+}
@@ -0,0 +1,46 @@
+#ifndef CLIGHTGRID_H
+#define CLIGHTGRID_H
+
+#include "Core/Resource/CLight.h"
+#include <Common/BasicTypes.h>
+#include <Common/Math/CAABox.h>
+#include <Common/Math/CVector3f.h>
+#include <array>
+#include <vector>
+
+/**
+ * Uniform grid of light influence volumes for a single light layer.
+ * Each bounded light is inserted into every cell its influence sphere overlaps,
+ * so nodes only need to test the lights registered to the cells they touch.
+ * Lights with an unbounded radius (e.g. directional lights) are kept in a
+ * separate list that is returned for every query.
+ */
+class CLightGrid
+{
+    CVector3f mOrigin{CVector3f::Zero()};
+    CVector3f mCellSize{CVector3f::One()};
+    std::array<uint32, 3> mDims{};
+
+    // Cell contents are stored flattened; cell N owns [mCellStart[N], mCellStart[N+1])
+    std::vector<uint32> mCellStart;
+    std::vector<uint32> mCellLights;
+    std::vector<uint32> mUnboundedLights;
+    uint32 mAmbientLightIndex = UINT32_MAX;
+    uint32 mNumLights = 0;
+
+public:
+    void Build(const std::vector<CLight>& rkLights);
+    void Clear();
+    void GatherCandidates(const CAABox& rkBox, std::vector<uint32>& rOutIndices) const;
+
+    uint32 NumLights() const            { return mNumLights; }
+    uint32 NumCells() const             { return mDims[0] * mDims[1] * mDims[2]; }
+    uint32 NumUnboundedLights() const   { return static_cast<uint32>(mUnboundedLights.size()); }
+    uint32 AmbientLightIndex() const    { return mAmbientLightIndex; }
+    bool HasAmbientLight() const        { return mAmbientLightIndex != UINT32_MAX; }
+
+private:
+    bool CellRange(const CVector3f& rkMin, const CVector3f& rkMax, std::array<uint32, 3>& rOutLow, std::array<uint32, 3>& rOutHigh) const;
+};
+
+#endif // CLIGHTGRID_H
@@ -1,6 +1,7 @@
 #include "CResTypeInfo.h"
 #include <Common/Macros.h>
 #include <algorithm>
+#include <mutex>
 
 std::unordered_map<EResourceType, std::unique_ptr<CResTypeInfo>> CResTypeInfo::smTypeMap;
 
@@ -52,10 +53,14 @@ CResTypeInfo* CResTypeInfo::TypeForCookedExtension(EGame Game, CFourCC Ext)
 {
     // Extensions can vary between games, but we're not likely to be calling this function for different games very often.
     // So, to speed things up a little, cache the lookup results in a map.
+    // The cache is shared with resource directory scans running on the job pool, so it's locked.
     static EGame sCachedGame = EGame::Invalid;
     static std::map<CFourCC, CResTypeInfo*> sCachedTypeMap;
+    static std::mutex sCacheMutex;
     Ext = Ext.ToUpper();
 
+    std::lock_guard Lock(sCacheMutex);
+
     // When the game changes, our cache is invalidated, so clear it
     if (sCachedGame != Game)
     {
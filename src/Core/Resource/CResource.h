@@ -10,6 +10,7 @@
 #include <Common/CFourCC.h>
 #include <Common/TString.h>
 #include <Common/Serialization/IArchive.h>
+#include <atomic>
 #include <memory>
 
 // This macro creates functions that allow us to easily identify this resource type.
@@ -33,7 +34,7 @@ class CResource
     DECLARE_RESOURCE_TYPE(Resource)
 
     CResourceEntry *mpEntry;
-    int mRefCount = 0;
+    std::atomic<int> mRefCount{0};   // Resources can be referenced from job threads
 
 public:
     explicit CResource(CResourceEntry *pEntry = nullptr)
@@ -45,6 +46,8 @@ public:
     virtual std::unique_ptr<CDependencyTree> BuildDependencyTree() const { return std::make_unique<CDependencyTree>(); }
     virtual void Serialize(IArchive& /*rArc*/) {}
     virtual void InitializeNewResource()       {}
+    /** Approximate number of bytes of heap memory owned by this resource; 0 if the type doesn't track it */
+    virtual size_t MemoryUsage() const         { return 0; }
 
     CResourceEntry* Entry() const    { return mpEntry; }
     CResTypeInfo* TypeInfo() const   { return mpEntry->TypeInfo(); }
@@ -53,9 +56,9 @@ public:
     TString FullSource() const       { return mpEntry ? mpEntry->CookedAssetPath(true) : ""; }
     CAssetID ID() const              { return mpEntry ? mpEntry->ID() : CAssetID::skInvalidID64; }
     EGame Game() const               { return mpEntry ? mpEntry->Game() : EGame::Invalid; }
-    bool IsReferenced() const        { return mRefCount > 0; }
-    void Lock()                      { mRefCount++; }
-    void Release()                   { mRefCount--; }
+    bool IsReferenced() const        { return mRefCount.load(std::memory_order_acquire) > 0; }
+    void Lock()                      { mRefCount.fetch_add(1, std::memory_order_relaxed); }
+    void Release()                   { mRefCount.fetch_sub(1, std::memory_order_acq_rel); }
 };
 
 #endif // CRESOURCE_H
@@ -259,6 +259,19 @@ bool CTexture::WriteDDS(IOutputStream& rOut)
     return true;
 }
 
+size_t CTexture::MemoryUsage() const
+{
+    // The GL copy of the image is freed along with the texture, so count it as well
+    size_t Size = sizeof(CTexture);
+
+    if (mBufferExists)
+        Size += mImgDataSize;
+    if (mGLBufferExists)
+        Size += CalcTotalSize();
+
+    return Size;
+}
+
 // ************ STATIC ************
 uint32 CTexture::FormatBPP(ETexelFormat Format)
 {
@@ -40,6 +40,7 @@ public:
     void Resize(uint32 Width, uint32 Height);
     float ReadTexelAlpha(const CVector2f& rkTexCoord);
     bool WriteDDS(IOutputStream& rOut);
+    size_t MemoryUsage() const override;
 
     // Accessors
     ETexelFormat TexelFormat() const        { return mTexelFormat; }
@@ -266,7 +266,7 @@ void CAreaCooker::WriteDependencies(IOutputStream& rOut)
 
     for (const auto& dependency : Dependencies)
     {
-        CResourceEntry *pEntry = gpResourceStore->FindEntry(dependency);
+        CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(dependency);
         dependency.Write(rOut);
         pEntry->CookedExtension().Write(rOut);
     }
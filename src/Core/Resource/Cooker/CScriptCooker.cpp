@@ -228,6 +228,136 @@ void CScriptCooker::WriteProperty(IOutputStream& rOut, IProperty* pProperty, voi
     }
 }
 
+bool CScriptCooker::WritePropertiesPlanned(IOutputStream& rOut, CScriptObject* pInstance)
+{
+    if (!CScriptPropertyPlan::IsEnabled())
+        return false;
+
+    const CScriptPropertyPlan& rkPlan = pInstance->Template()->PropertyPlan();
+
+    if (rkPlan.IsFlat() != (mGame <= EGame::Prime))
+        return false;
+
+    // Fixed-size values are encoded into a buffer and written out in batches
+    mPlanBuffer.clear();
+    mPlanBufferStart = rOut.Tell();
+
+    if (rkPlan.IsFlat())
+    {
+        WritePlannedStruct(rOut, rkPlan, rkPlan.RootStruct(), pInstance->ReadOnlyPropertyData());
+    }
+    else
+    {
+        // The root struct has an ID and size like any other property
+        CStructProperty* pProperties = pInstance->Template()->Properties();
+        const CScriptPropertyPlan::SOp RootOp{pProperties, pProperties->ID(), 0, 0, 0, EPlanCodec::Struct, false};
+        WritePlannedProperty(rOut, rkPlan, RootOp, pInstance->ReadOnlyPropertyData(), true);
+    }
+
+    FlushPlanBuffer(rOut);
+    return true;
+}
+
+void CScriptCooker::WritePlannedStruct(IOutputStream& rOut, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SStruct& rkStruct, void* pData)
+{
+    // MP1 objects and atomic structs are written in template order with no property headers
+    if (rkStruct.IsAtomic || rkPlan.IsFlat())
+    {
+        for (uint32 OpIdx = 0; OpIdx < rkStruct.NumOps; OpIdx++)
+            WritePlannedProperty(rOut, rkPlan, rkPlan.Op(rkStruct.FirstOp + OpIdx), pData, false);
+
+        return;
+    }
+
+    std::vector<const CScriptPropertyPlan::SOp*> OpsToWrite;
+    OpsToWrite.reserve(rkStruct.NumOps);
+
+    for (uint32 OpIdx = 0; OpIdx < rkStruct.NumOps; OpIdx++)
+    {
+        const CScriptPropertyPlan::SOp& rkOp = rkPlan.Op(rkStruct.FirstOp + OpIdx);
+
+        if (rkOp.pProperty->ShouldCook(pData))
+            OpsToWrite.push_back(&rkOp);
+    }
+
+    CScriptPropertyPlan::WriteBE16(mPlanBuffer, static_cast<uint16>(OpsToWrite.size()));
+
+    for (const auto* pkOp : OpsToWrite)
+        WritePlannedProperty(rOut, rkPlan, *pkOp, pData, true);
+}
+
+void CScriptCooker::WritePlannedProperty(IOutputStream& rOut, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SOp& rkOp, void* pData, bool WriteHeader)
+{
+    if (rkOp.Codec == EPlanCodec::Struct)
+    {
+        const CScriptPropertyPlan::SStruct& rkStruct = rkPlan.Struct(rkOp.StructIndex);
+
+        if (!WriteHeader)
+        {
+            WritePlannedStruct(rOut, rkPlan, rkStruct, pData);
+            return;
+        }
+
+        const uint32 FlushCount = mNumPlanFlushes;
+        const uint32 SizeOffset = static_cast<uint32>(mPlanBuffer.size()) + 4;
+        const uint32 SizeStreamOffset = mPlanBufferStart + SizeOffset;
+        CScriptPropertyPlan::WriteBE32(mPlanBuffer, rkOp.FileID);
+        CScriptPropertyPlan::WriteBE16(mPlanBuffer, 0);
+
+        WritePlannedStruct(rOut, rkPlan, rkStruct, pData);
+
+        // Fill in the size in the buffer if the struct is still in there, or in the stream if it's been flushed
+        if (FlushCount == mNumPlanFlushes)
+        {
+            const uint32 Size = static_cast<uint32>(mPlanBuffer.size()) - (SizeOffset + 2);
+            mPlanBuffer[SizeOffset] = static_cast<uint8>(Size >> 8);
+            mPlanBuffer[SizeOffset + 1] = static_cast<uint8>(Size);
+        }
+        else
+        {
+            FlushPlanBuffer(rOut);
+            const uint32 StructEnd = rOut.Tell();
+            rOut.Seek(SizeStreamOffset, SEEK_SET);
+            rOut.WriteUShort(static_cast<uint16>(StructEnd - (SizeStreamOffset + 2)));
+            rOut.Seek(StructEnd, SEEK_SET);
+        }
+        return;
+    }
+
+    if (rkOp.Codec != EPlanCodec::Generic)
+    {
+        const size_t Mark = mPlanBuffer.size();
+
+        if (WriteHeader)
+        {
+            CScriptPropertyPlan::WriteBE32(mPlanBuffer, rkOp.FileID);
+            CScriptPropertyPlan::WriteBE16(mPlanBuffer, static_cast<uint16>(rkOp.FileSize));
+        }
+
+        if (rkPlan.EncodeValue(rkOp, pData, mPlanBuffer))
+            return;
+
+        mPlanBuffer.resize(Mark);
+    }
+
+    // Fall back to the regular path for anything without a fixed encoding
+    FlushPlanBuffer(rOut);
+    WriteProperty(rOut, rkOp.pProperty, pData, !WriteHeader);
+    mPlanBufferStart = rOut.Tell();
+}
+
+void CScriptCooker::FlushPlanBuffer(IOutputStream& rOut)
+{
+    if (!mPlanBuffer.empty())
+    {
+        rOut.WriteBytes(mPlanBuffer.data(), static_cast<uint32>(mPlanBuffer.size()));
+        mPlanBuffer.clear();
+        mNumPlanFlushes++;
+    }
+
+    mPlanBufferStart = rOut.Tell();
+}
+
 void CScriptCooker::WriteInstance(IOutputStream& rOut, CScriptObject *pInstance)
 {
     ASSERT(pInstance->Area()->Game() == mGame);
@@ -257,7 +387,9 @@ void CScriptCooker::WriteInstance(IOutputStream& rOut, CScriptObject *pInstance)
         rOut.WriteULong(pLink->ReceiverID());
     }
 
-    WriteProperty(rOut, pInstance->Template()->Properties(), pInstance->PropertyData(), false);
+    if (!WritePropertiesPlanned(rOut, pInstance))
+        WriteProperty(rOut, pInstance->Template()->Properties(), pInstance->ReadOnlyPropertyData(), false);
+
     const uint32 InstanceEnd = rOut.Tell();
 
     rOut.Seek(SizeOffset, SEEK_SET);
@@ -4,8 +4,10 @@
 #include "CSectionMgrOut.h"
 #include "Core/Resource/Script/CScriptLayer.h"
 #include "Core/Resource/Script/CScriptObject.h"
+#include "Core/Resource/Script/CScriptPropertyPlan.h"
 #include <Common/EGame.h>
 #include <Common/FileIO.h>
+#include <vector>
 
 class CScriptCooker
 {
@@ -13,6 +15,16 @@ class CScriptCooker
     std::vector<CScriptObject*> mGeneratedObjects;
     bool mWriteGeneratedSeparately;
 
+    // Data encoded with a compiled property plan that hasn't been written to the stream yet
+    std::vector<uint8> mPlanBuffer;
+    uint32 mPlanBufferStart = 0;
+    uint32 mNumPlanFlushes = 0;
+
+    bool WritePropertiesPlanned(IOutputStream& rOut, CScriptObject* pInstance);
+    void WritePlannedStruct(IOutputStream& rOut, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SStruct& rkStruct, void* pData);
+    void WritePlannedProperty(IOutputStream& rOut, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SOp& rkOp, void* pData, bool WriteHeader);
+    void FlushPlanBuffer(IOutputStream& rOut);
+
 public:
     explicit CScriptCooker(EGame Game, bool WriteGeneratedObjectsSeparately = true)
         : mGame(Game)
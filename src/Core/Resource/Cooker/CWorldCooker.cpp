@@ -69,7 +69,7 @@ bool CWorldCooker::CookMLVL(CWorld *pWorld, IOutputStream& rMLVL)
     for (auto& rArea : pWorld->mAreas)
     {
         // Area Header
-        CResourceEntry *pAreaEntry = gpResourceStore->FindEntry(rArea.AreaResID);
+        CResourceEntry *pAreaEntry = ActiveResourceStore()->FindEntry(rArea.AreaResID);
         ASSERT(pAreaEntry && pAreaEntry->ResourceType() == EResourceType::Area);
 
         const CAssetID AreaNameID = rArea.pAreaName != nullptr ? rArea.pAreaName->ID() : CAssetID::InvalidID(Game);
@@ -101,7 +101,7 @@ bool CWorldCooker::CookMLVL(CWorld *pWorld, IOutputStream& rMLVL)
 
             for (const auto& ID : Dependencies)
             {
-                CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
+                CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
                 ID.Write(rMLVL);
                 pEntry->CookedExtension().Write(rMLVL);
             }
@@ -181,7 +181,7 @@ bool CWorldCooker::CookMLVL(CWorld *pWorld, IOutputStream& rMLVL)
 
         for (const auto AudioGroup : AudioGroups)
         {
-            CAudioGroup *pGroup = gpResourceStore->LoadResource<CAudioGroup>(AudioGroup);
+            CAudioGroup *pGroup = ActiveResourceStore()->LoadResource<CAudioGroup>(AudioGroup);
             ASSERT(pGroup);
             SortedAudioGroups.push_back(pGroup);
         }
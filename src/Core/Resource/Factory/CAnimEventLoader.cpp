@@ -94,7 +94,7 @@ void CAnimEventLoader::LoadSoundEvent(IInputStream& rEVNT)
 
         if (SoundID != 0xFFFF)
         {
-            SSoundInfo SoundInfo = gpResourceStore->Project()->AudioManager()->GetSoundInfo(SoundID);
+            SSoundInfo SoundInfo = ActiveResourceStore()->Project()->AudioManager()->GetSoundInfo(SoundID);
 
             if (SoundInfo.pAudioGroup)
                 mpEventData->AddEvent(CharIndex, SoundInfo.pAudioGroup->ID());
@@ -12,8 +12,8 @@ void CAnimSetLoader::LoadCorruptionCHAR(IInputStream& rCHAR)
     // Character Header
     rChar.ID = rCHAR.ReadUByte();
     rChar.Name = rCHAR.ReadString();
-    rChar.pModel = gpResourceStore->LoadResource<CModel>(rCHAR.ReadULongLong());
-    rChar.pSkin = gpResourceStore->LoadResource<CSkin>(rCHAR.ReadULongLong());
+    rChar.pModel = ActiveResourceStore()->LoadResource<CModel>(rCHAR.ReadULongLong());
+    rChar.pSkin = ActiveResourceStore()->LoadResource<CSkin>(rCHAR.ReadULongLong());
 
     const uint32 NumOverlays = rCHAR.ReadULong();
 
@@ -26,7 +26,7 @@ void CAnimSetLoader::LoadCorruptionCHAR(IInputStream& rCHAR)
         rChar.OverlayModels.push_back(Overlay);
     }
 
-    rChar.pSkeleton = gpResourceStore->LoadResource<CSkeleton>(rCHAR.ReadLongLong());
+    rChar.pSkeleton = ActiveResourceStore()->LoadResource<CSkeleton>(rCHAR.ReadLongLong());
     rChar.AnimDataID = CAssetID(rCHAR, EIDLength::k64Bit);
 
     // PAS Database
@@ -102,7 +102,7 @@ void CAnimSetLoader::LoadReturnsCHAR(IInputStream& rCHAR)
     // Character Header
     rChar.ID = 0;
     rChar.Name = rCHAR.ReadString();
-    rChar.pSkeleton = gpResourceStore->LoadResource<CSkeleton>( rCHAR.ReadLongLong() );
+    rChar.pSkeleton = ActiveResourceStore()->LoadResource<CSkeleton>( rCHAR.ReadLongLong() );
     rChar.CollisionPrimitivesID = rCHAR.ReadLongLong();
 
     const uint32 NumModels = rCHAR.ReadULong();
@@ -116,8 +116,8 @@ void CAnimSetLoader::LoadReturnsCHAR(IInputStream& rCHAR)
 
         if (ModelIdx == 0)
         {
-            rChar.pModel = gpResourceStore->LoadResource<CModel>(ModelID);
-            rChar.pSkin = gpResourceStore->LoadResource<CSkin>(SkinID);
+            rChar.pModel = ActiveResourceStore()->LoadResource<CModel>(ModelID);
+            rChar.pSkin = ActiveResourceStore()->LoadResource<CSkin>(SkinID);
         }
         else
         {
@@ -408,7 +408,7 @@ void CAnimSetLoader::ProcessPrimitives()
 
     if (mGame == EGame::CorruptionProto || mGame == EGame::Corruption)
     {
-        CSourceAnimData *pAnimData = gpResourceStore->LoadResource<CSourceAnimData>( pSet->mCharacters[0].AnimDataID );
+        CSourceAnimData *pAnimData = ActiveResourceStore()->LoadResource<CSourceAnimData>( pSet->mCharacters[0].AnimDataID );
 
         if (pAnimData != nullptr)
             pAnimData->GetUniquePrimitives(UniquePrimitives);
@@ -530,9 +530,9 @@ std::unique_ptr<CAnimSet> CAnimSetLoader::LoadANCS(IInputStream& rANCS, CResourc
             Loader.mGame = (CharVersion == 0xA) ? EGame::Echoes : EGame::Prime;
         }
         pChar->Name = rANCS.ReadString();
-        pChar->pModel = gpResourceStore->LoadResource<CModel>(rANCS.ReadULong());
-        pChar->pSkin = gpResourceStore->LoadResource<CSkin>(rANCS.ReadULong());
-        pChar->pSkeleton = gpResourceStore->LoadResource<CSkeleton>(rANCS.ReadULong());
+        pChar->pModel = ActiveResourceStore()->LoadResource<CModel>(rANCS.ReadULong());
+        pChar->pSkin = ActiveResourceStore()->LoadResource<CSkin>(rANCS.ReadULong());
+        pChar->pSkeleton = ActiveResourceStore()->LoadResource<CSkeleton>(rANCS.ReadULong());
         if (pChar->pModel != nullptr)
             pChar->pModel->SetSkin(pChar->pSkin);
 
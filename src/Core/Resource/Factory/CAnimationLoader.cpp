@@ -199,7 +199,7 @@ void CAnimationLoader::ReadUncompressedANIM()
 
     if (mGame == EGame::Prime)
     {
-        mpAnim->mpEventData = gpResourceStore->LoadResource<CAnimEventData>(mpInput->ReadLong());
+        mpAnim->mpEventData = ActiveResourceStore()->LoadResource<CAnimEventData>(mpInput->ReadLong());
     }
 }
 
@@ -215,7 +215,7 @@ void CAnimationLoader::ReadCompressedANIM()
     // The Echoes demo has some ANIMs that use MP1's format, but don't have the EVNT reference.
     if (mpAnim->Game() <= EGame::Prime)
     {
-        mpAnim->mpEventData = gpResourceStore->LoadResource<CAnimEventData>(mpInput->ReadLong());
+        mpAnim->mpEventData = ActiveResourceStore()->LoadResource<CAnimEventData>(mpInput->ReadLong());
     }
 
     mpInput->Seek(mGame <= EGame::Prime ? 4 : 2, SEEK_CUR); // Skip unknowns
@@ -503,5 +503,8 @@ std::unique_ptr<CAnimation> CAnimationLoader::LoadANIM(IInputStream& rANIM, CRes
     else
         Loader.ReadCompressedANIM();
 
+    if (CAnimation::QuantizeOnLoad())
+        ptr->QuantizeChannels();
+
     return ptr;
 }
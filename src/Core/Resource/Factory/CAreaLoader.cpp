@@ -3,6 +3,7 @@
 #include "CModelLoader.h"
 #include "CMaterialLoader.h"
 #include "CScriptLoader.h"
+#include "Core/CJobPool.h"
 #include "Core/CompressionUtil.h"
 #include <Common/Log.h>
 
@@ -11,6 +12,8 @@
 #include <algorithm>
 #include <cfloat>
 
+bool CAreaLoader::sParallelScriptLoading = true;
+
 CAreaLoader::CAreaLoader() = default;
 
 CAreaLoader::~CAreaLoader()
@@ -113,16 +116,19 @@ void CAreaLoader::ReadSCLYPrime()
     for (auto& layerSize : LayerSizes)
         layerSize = mpMREA->ReadLong();
 
-    // SCLY
+    // Locate every layer up front so they can be loaded independently
+    std::vector<SScriptLayerRange> Ranges(mNumLayers);
+    uint32 LayerOffset = mpMREA->Tell();
+
     for (size_t iLyr = 0; iLyr < mNumLayers; iLyr++)
     {
-        const uint32 Next = mpMREA->Tell() + LayerSizes[iLyr];
-        mpArea->mScriptLayers[iLyr] = CScriptLoader::LoadLayer(*mpMREA, mpArea, mVersion);
-        mpMREA->Seek(Next, SEEK_SET);
+        Ranges[iLyr].Offset = LayerOffset;
+        Ranges[iLyr].Size = LayerSizes[iLyr];
+        LayerOffset += LayerSizes[iLyr];
     }
 
     // SCGN
-    std::unique_ptr<CScriptLayer> pGenLayer;
+    bool HasGenLayer = false;
 
     if (mVersion >= EGame::EchoesDemo)
     {
@@ -136,10 +142,24 @@ void CAreaLoader::ReadSCLYPrime()
         else
         {
             mpMREA->Seek(0x1, SEEK_CUR);
-            pGenLayer = CScriptLoader::LoadLayer(*mpMREA, mpArea, mVersion);
+            const uint32 GenLayerOffset = mpMREA->Tell();
+            Ranges.push_back(SScriptLayerRange{GenLayerOffset, mpSectionMgr->NextOffset() - GenLayerOffset});
+            HasGenLayer = true;
         }
     }
 
+    std::vector<std::unique_ptr<CScriptLayer>> Layers = LoadScriptLayers(Ranges);
+    std::unique_ptr<CScriptLayer> pGenLayer;
+
+    if (HasGenLayer)
+    {
+        pGenLayer = std::move(Layers.back());
+        Layers.pop_back();
+    }
+
+    for (size_t iLyr = 0; iLyr < mNumLayers; iLyr++)
+        mpArea->mScriptLayers[iLyr] = std::move(Layers[iLyr]);
+
     SetUpObjects(pGenLayer.get());
 }
 
@@ -269,6 +289,9 @@ void CAreaLoader::ReadSCLYEchoes()
     mpSectionMgr->ToSection(mScriptLayerBlockNum);
     mpArea->mScriptLayers.resize(mNumLayers);
 
+    // Locate every layer up front so they can be loaded independently. Each layer is its own section.
+    std::vector<SScriptLayerRange> Ranges(mNumLayers);
+
     // SCLY
     for (uint32 iLyr = 0; iLyr < mNumLayers; iLyr++)
     {
@@ -281,21 +304,107 @@ void CAreaLoader::ReadSCLYEchoes()
         }
 
         mpMREA->Seek(0x5, SEEK_CUR); // Skipping unknown + layer index
-        mpArea->mScriptLayers[iLyr] = CScriptLoader::LoadLayer(*mpMREA, mpArea, mVersion);
+        Ranges[iLyr].Offset = mpMREA->Tell();
+        Ranges[iLyr].Size = mpSectionMgr->NextOffset() - Ranges[iLyr].Offset;
         mpSectionMgr->ToNextSection();
     }
 
     // SCGN
     const CFourCC SCGN(*mpMREA);
-    if (SCGN != FOURCC('SCGN'))
+    const bool HasGenLayer = (SCGN == FOURCC('SCGN'));
+
+    if (!HasGenLayer)
     {
         errorf("%s [0x%X]: Invalid SCGN magic: %s", *mpMREA->GetSourceString(), mpMREA->Tell() - 4, *SCGN.ToString());
-        return;
+    }
+    else
+    {
+        mpMREA->Seek(0x1, SEEK_CUR); // Skipping unknown
+        const uint32 GenLayerOffset = mpMREA->Tell();
+        Ranges.push_back(SScriptLayerRange{GenLayerOffset, mpSectionMgr->NextOffset() - GenLayerOffset});
+    }
+
+    std::vector<std::unique_ptr<CScriptLayer>> Layers = LoadScriptLayers(Ranges);
+    std::unique_ptr<CScriptLayer> pGeneratedLayer;
+
+    if (HasGenLayer)
+    {
+        pGeneratedLayer = std::move(Layers.back());
+        Layers.pop_back();
+    }
+
+    for (uint32 iLyr = 0; iLyr < mNumLayers; iLyr++)
+        mpArea->mScriptLayers[iLyr] = std::move(Layers[iLyr]);
+
+    if (HasGenLayer)
+        SetUpObjects(pGeneratedLayer.get());
+}
+
+std::vector<std::unique_ptr<CScriptLayer>> CAreaLoader::LoadScriptLayers(const std::vector<SScriptLayerRange>& rkRanges)
+{
+    std::vector<std::unique_ptr<CScriptLayer>> Layers(rkRanges.size());
+
+    if (!sParallelScriptLoading || rkRanges.size() < 2)
+    {
+        for (size_t LayerIdx = 0; LayerIdx < rkRanges.size(); LayerIdx++)
+        {
+            if (rkRanges[LayerIdx].Size == 0)
+                continue;
+
+            mpMREA->Seek(rkRanges[LayerIdx].Offset, SEEK_SET);
+            Layers[LayerIdx] = CScriptLoader::LoadLayer(*mpMREA, mpArea, mVersion);
+        }
+
+        return Layers;
     }
 
-    mpMREA->Seek(0x1, SEEK_CUR); // Skipping unknown
-    const auto pGeneratedLayer = CScriptLoader::LoadLayer(*mpMREA, mpArea, mVersion);
-    SetUpObjects(pGeneratedLayer.get());
+    // Copy each layer out so it can be read through its own stream
+    std::vector<std::vector<uint8>> LayerData(rkRanges.size());
+
+    for (size_t LayerIdx = 0; LayerIdx < rkRanges.size(); LayerIdx++)
+    {
+        LayerData[LayerIdx].resize(rkRanges[LayerIdx].Size);
+
+        if (!LayerData[LayerIdx].empty())
+        {
+            mpMREA->Seek(rkRanges[LayerIdx].Offset, SEEK_SET);
+            mpMREA->ReadBytes(LayerData[LayerIdx].data(), rkRanges[LayerIdx].Size);
+        }
+    }
+
+    const TString Source = mpMREA->GetSourceString();
+    CGameArea* pArea = mpArea;
+    const EGame Version = mVersion;
+
+    // Property validation looks up resources, so workers need to see the same store as this thread
+    CResourceStore* pStore = ActiveResourceStore();
+
+    CJobPool::Global().ParallelFor(rkRanges.size(), 1, [&](size_t Begin, size_t End)
+    {
+        CScopedResourceStore StoreScope(pStore);
+
+        for (size_t LayerIdx = Begin; LayerIdx < End; LayerIdx++)
+        {
+            if (LayerData[LayerIdx].empty())
+                continue;
+
+            CMemoryInStream LayerStream(LayerData[LayerIdx].data(), static_cast<uint32>(LayerData[LayerIdx].size()), EEndian::BigEndian);
+            LayerStream.SetSourceString(Source);
+            Layers[LayerIdx] = CScriptLoader::LoadLayer(LayerStream, pArea, Version, false);
+        }
+    });
+
+    // Evaluating objects can load other resources, so that's left for this thread
+    for (const auto& pLayer : Layers)
+    {
+        if (!pLayer)
+            continue;
+
+        for (size_t InstIdx = 0; InstIdx < pLayer->NumInstances(); InstIdx++)
+            pLayer->InstanceByIndex(InstIdx)->EvaluateProperties();
+    }
+
+    return Layers;
 }
 
 // ************ CORRUPTION ************
@@ -611,7 +720,7 @@ void CAreaLoader::ReadEGMC()
 {
     mpSectionMgr->ToSection(mEGMCBlockNum);
     const CAssetID EGMC(*mpMREA, mVersion);
-    mpArea->mpPoiToWorldMap = gpResourceStore->LoadResource(EGMC, EResourceType::StaticGeometryMap);
+    mpArea->mpPoiToWorldMap = ActiveResourceStore()->LoadResource(EGMC, EResourceType::StaticGeometryMap);
 }
 
 void CAreaLoader::SetUpObjects(CScriptLayer *pGenLayer)
@@ -696,6 +805,10 @@ void CAreaLoader::SetUpObjects(CScriptLayer *pGenLayer)
             pObj->mInLinks = iConMap->second;
         }
     }
+
+    // Layers are loaded in parallel, so link list positions are only cached once all objects are set up
+    for (auto& object : mpArea->mObjectMap)
+        object.second->RebuildLinkIndex();
 }
 
 // ************ STATIC ************
@@ -784,6 +897,8 @@ std::unique_ptr<CGameArea> CAreaLoader::LoadMREA(IInputStream& MREA, CResourceEn
             return nullptr;
     }
 
+    ptr->BuildLightGrids();
+
     // Cleanup
     delete Loader.mpSectionMgr;
     return ptr;
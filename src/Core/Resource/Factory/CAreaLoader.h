@@ -8,6 +8,7 @@
 #include <Common/EGame.h>
 #include <Common/FileIO.h>
 #include <memory>
+#include <vector>
 
 class CAreaLoader
 {
@@ -55,6 +56,14 @@ class CAreaLoader
         uint32 NumSections;
     };
 
+    // Location of a script layer's data in the MREA; layers that failed to validate have a size of 0
+    struct SScriptLayerRange {
+        uint32 Offset = 0;
+        uint32 Size = 0;
+    };
+
+    static bool sParallelScriptLoading;
+
     CAreaLoader();
     ~CAreaLoader();
 
@@ -83,10 +92,15 @@ class CAreaLoader
     void ReadPTLA();
     void ReadEGMC();
     void SetUpObjects(CScriptLayer *pGenLayer);
+    std::vector<std::unique_ptr<CScriptLayer>> LoadScriptLayers(const std::vector<SScriptLayerRange>& rkRanges);
 
 public:
     static std::unique_ptr<CGameArea> LoadMREA(IInputStream& rMREA, CResourceEntry *pEntry);
     static EGame GetFormatVersion(uint32 Version);
+
+    /** Toggle decoding an area's script layers concurrently. Enabled by default. */
+    static void SetParallelScriptLoading(bool Enabled)  { sParallelScriptLoading = Enabled; }
+    static bool ParallelScriptLoading()                 { return sParallelScriptLoading; }
 };
 
 #endif // CAREALOADER_H
@@ -14,7 +14,7 @@ void CFontLoader::LoadFont(IInputStream& rFONT)
     rFONT.Seek(0x2, SEEK_CUR);
     mpFont->mDefaultSize = rFONT.ReadULong();
     mpFont->mFontName = rFONT.ReadString();
-    mpFont->mpFontTexture = gpResourceStore->LoadResource(CAssetID(rFONT, mVersion), EResourceType::Texture);
+    mpFont->mpFontTexture = ActiveResourceStore()->LoadResource(CAssetID(rFONT, mVersion), EResourceType::Texture);
     mpFont->mTextureFormat = rFONT.ReadULong();
     const uint32 NumGlyphs = rFONT.ReadULong();
     mpFont->mGlyphs.reserve(NumGlyphs);
@@ -44,7 +44,7 @@ void CMaterialLoader::ReadPrimeMatSet()
     for (size_t iTex = 0; iTex < NumTextures; iTex++)
     {
         const uint32 TextureID = mpFile->ReadULong();
-        mTextures[iTex] = gpResourceStore->LoadResource<CTexture>(TextureID);
+        mTextures[iTex] = ActiveResourceStore()->LoadResource<CTexture>(TextureID);
     }
 
     // Materials
@@ -370,7 +370,7 @@ std::unique_ptr<CMaterial> CMaterialLoader::ReadCorruptionMaterial()
 
             const uint64 TextureID = mpFile->ReadULongLong();
             if (TextureID != UINT64_MAX)
-                Pass.mpTexture = gpResourceStore->LoadResource<CTexture>(TextureID);
+                Pass.mpTexture = ActiveResourceStore()->LoadResource<CTexture>(TextureID);
 
             Pass.mUvSrc = mpFile->ReadULong();
 
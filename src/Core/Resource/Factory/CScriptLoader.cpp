@@ -16,7 +16,7 @@ CScriptLoader::CScriptLoader() = default;
 
 void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rSCLY)
 {
-    void* pData = (mpCurrentData ? mpCurrentData : mpObj->mPropertyData.data());
+    void* pData = (mpCurrentData ? mpCurrentData : mpObj->mpPropertyData->Data());
 
     switch (pProp->Type())
     {
@@ -62,16 +62,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
         pChoice->ValueRef(pData) = rSCLY.ReadLong();
 
 #if VALIDATE_PROPERTY_VALUES
-        if (!pChoice->HasValidValue(pData))
-        {
-            uint32 Value = pChoice->ValueRef(pData);
-            errorf("%s [0x%X]: Choice property \"%s\" (%s) has unrecognized value: 0x%08X",
-                   *rSCLY.GetSourceString(),
-                   rSCLY.Tell() - 4,
-                   *pChoice->Name(),
-                   *pChoice->IDString(true),
-                   Value);
-        }
+        ValidatePropertyValue(pChoice, pData, rSCLY, rSCLY.Tell() - 4);
 #endif
         break;
     }
@@ -82,16 +73,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
         pEnum->ValueRef(pData) = rSCLY.ReadLong();
 
 #if VALIDATE_PROPERTY_VALUES
-        if (!pEnum->HasValidValue(pData))
-        {
-            uint32 Value = pEnum->ValueRef(pData);
-            errorf("%s [0x%X]: Enum property \"%s\" (%s) has unrecognized value: 0x%08X",
-                   *rSCLY.GetSourceString(),
-                   rSCLY.Tell() - 4,
-                   *pEnum->Name(),
-                   *pEnum->IDString(true),
-                   Value);
-        }
+        ValidatePropertyValue(pEnum, pData, rSCLY, rSCLY.Tell() - 4);
 #endif
         break;
     }
@@ -102,17 +84,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
         pFlags->ValueRef(pData) = rSCLY.ReadLong();
 
 #if VALIDATE_PROPERTY_VALUES
-        uint32 InvalidBits = pFlags->HasValidValue(pData);
-
-        if (InvalidBits)
-        {
-            warnf("%s [0x%X]: Flags property \"%s\" (%s) has unrecognized flags set: 0x%08X",
-                  *rSCLY.GetSourceString(),
-                  rSCLY.Tell() - 4,
-                  *pFlags->Name(),
-                  *pFlags->IDString(true),
-                  InvalidBits);
-        }
+        ValidatePropertyValue(pFlags, pData, rSCLY, rSCLY.Tell() - 4);
 #endif
         break;
     }
@@ -144,28 +116,7 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
         pAsset->ValueRef(pData) = CAssetID(rSCLY, mpGameTemplate->Game());
 
 #if VALIDATE_PROPERTY_VALUES
-        CAssetID ID = pAsset->ValueRef(pData);
-
-        if (ID.IsValid() && gpResourceStore)
-        {
-            CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
-
-            if (pEntry)
-            {
-                const CResTypeFilter& rkFilter = pAsset->GetTypeFilter();
-                bool Valid = rkFilter.Accepts(pEntry->ResourceType());
-
-                if (!Valid)
-                {
-                    warnf("%s [0x%X]: Asset property \"%s\" (%s) has a reference to an illegal asset type: %s",
-                          *rSCLY.GetSourceString(),
-                          rSCLY.Tell() - static_cast<uint32>(ID.Length()),
-                          *pAsset->Name(),
-                          *pAsset->IDString(true),
-                          *pEntry->CookedExtension().ToString());
-                }
-            }
-        }
+        ValidatePropertyValue(pAsset, pData, rSCLY, rSCLY.Tell() - static_cast<uint32>(pAsset->ValueRef(pData).Length()));
 #endif
         break;
     }
@@ -263,6 +214,206 @@ void CScriptLoader::ReadProperty(IProperty *pProp, uint32 Size, IInputStream& rS
     }
 }
 
+void CScriptLoader::ValidatePropertyValue(IProperty* pProp, void* pData, IInputStream& rSCLY, uint32 ValueOffset)
+{
+    switch (pProp->Type())
+    {
+
+    case EPropertyType::Choice:
+    {
+        CChoiceProperty* pChoice = TPropCast<CChoiceProperty>(pProp);
+
+        if (!pChoice->HasValidValue(pData))
+        {
+            uint32 Value = pChoice->ValueRef(pData);
+            errorf("%s [0x%X]: Choice property \"%s\" (%s) has unrecognized value: 0x%08X",
+                   *rSCLY.GetSourceString(),
+                   ValueOffset,
+                   *pChoice->Name(),
+                   *pChoice->IDString(true),
+                   Value);
+        }
+        break;
+    }
+
+    case EPropertyType::Enum:
+    {
+        CEnumProperty* pEnum = TPropCast<CEnumProperty>(pProp);
+
+        if (!pEnum->HasValidValue(pData))
+        {
+            uint32 Value = pEnum->ValueRef(pData);
+            errorf("%s [0x%X]: Enum property \"%s\" (%s) has unrecognized value: 0x%08X",
+                   *rSCLY.GetSourceString(),
+                   ValueOffset,
+                   *pEnum->Name(),
+                   *pEnum->IDString(true),
+                   Value);
+        }
+        break;
+    }
+
+    case EPropertyType::Flags:
+    {
+        CFlagsProperty* pFlags = TPropCast<CFlagsProperty>(pProp);
+        uint32 InvalidBits = pFlags->HasValidValue(pData);
+
+        if (InvalidBits)
+        {
+            warnf("%s [0x%X]: Flags property \"%s\" (%s) has unrecognized flags set: 0x%08X",
+                  *rSCLY.GetSourceString(),
+                  ValueOffset,
+                  *pFlags->Name(),
+                  *pFlags->IDString(true),
+                  InvalidBits);
+        }
+        break;
+    }
+
+    case EPropertyType::Asset:
+    {
+        CAssetProperty* pAsset = TPropCast<CAssetProperty>(pProp);
+        CAssetID ID = pAsset->ValueRef(pData);
+
+        if (ID.IsValid() && ActiveResourceStore())
+        {
+            CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
+
+            if (pEntry)
+            {
+                const CResTypeFilter& rkFilter = pAsset->GetTypeFilter();
+                bool Valid = rkFilter.Accepts(pEntry->ResourceType());
+
+                if (!Valid)
+                {
+                    warnf("%s [0x%X]: Asset property \"%s\" (%s) has a reference to an illegal asset type: %s",
+                          *rSCLY.GetSourceString(),
+                          ValueOffset,
+                          *pAsset->Name(),
+                          *pAsset->IDString(true),
+                          *pEntry->CookedExtension().ToString());
+                }
+            }
+        }
+        break;
+    }
+
+    default: break;
+    }
+}
+
+bool CScriptLoader::LoadPropertiesPlanned(IInputStream& rSCLY, CScriptTemplate* pTemplate, uint32 End)
+{
+    if (!CScriptPropertyPlan::IsEnabled())
+        return false;
+
+    const CScriptPropertyPlan& rkPlan = pTemplate->PropertyPlan();
+    const uint32 Start = rSCLY.Tell();
+
+    if (rkPlan.IsFlat() != (mVersion <= EGame::Prime) || End < Start)
+        return false;
+
+    // Read the whole object in one go and decode it from memory
+    mPlanBuffer.resize(End - Start);
+    rSCLY.ReadBytes(mPlanBuffer.data(), static_cast<uint32>(mPlanBuffer.size()));
+    mPlanDataStart = Start;
+
+    uint32 Pos = 0;
+    LoadPlannedStruct(rSCLY, rkPlan, rkPlan.RootStruct(), Pos, End - Start);
+    return true;
+}
+
+bool CScriptLoader::LoadPlannedStruct(IInputStream& rSCLY, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SStruct& rkStruct, uint32& rPos, uint32 End)
+{
+    // MP1 objects and atomic structs are stored in template order with no property headers
+    if (rkStruct.IsAtomic || rkPlan.IsFlat())
+    {
+        for (uint32 OpIdx = 0; OpIdx < rkStruct.NumOps; OpIdx++)
+        {
+            if (!LoadPlannedProperty(rSCLY, rkPlan, rkPlan.Op(rkStruct.FirstOp + OpIdx), 0, rPos, End))
+                return false;
+        }
+
+        return true;
+    }
+
+    if (rPos + 2 > End)
+        return false;
+
+    const uint32 ChildCount = CScriptPropertyPlan::ReadBE16(&mPlanBuffer[rPos]);
+    rPos += 2;
+    uint32 Cursor = 0;
+
+    for (uint32 ChildIdx = 0; ChildIdx < ChildCount; ChildIdx++)
+    {
+        const uint32 PropertyStart = rPos;
+
+        if (rPos + 6 > End)
+        {
+            errorf("%s [0x%X]: Property header runs past the end of the object", *rSCLY.GetSourceString(), mPlanDataStart + PropertyStart);
+            return false;
+        }
+
+        const uint32 PropertyID = CScriptPropertyPlan::ReadBE32(&mPlanBuffer[rPos]);
+        const uint16 PropertySize = CScriptPropertyPlan::ReadBE16(&mPlanBuffer[rPos + 4]);
+        rPos += 6;
+        const uint32 NextProperty = rPos + PropertySize;
+
+        if (NextProperty > End)
+        {
+            errorf("%s [0x%X]: Property 0x%08X runs past the end of the object", *rSCLY.GetSourceString(), mPlanDataStart + PropertyStart, PropertyID);
+            return false;
+        }
+
+        const CScriptPropertyPlan::SOp* pkOp = rkPlan.FindOp(rkStruct, PropertyID, Cursor);
+
+        if (pkOp)
+            LoadPlannedProperty(rSCLY, rkPlan, *pkOp, PropertySize, rPos, NextProperty);
+        else
+            errorf("%s [0x%X]: Can't find template for property 0x%08X - skipping", *rSCLY.GetSourceString(), mPlanDataStart + PropertyStart, PropertyID);
+
+        rPos = NextProperty;
+    }
+
+    return true;
+}
+
+bool CScriptLoader::LoadPlannedProperty(IInputStream& rSCLY, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SOp& rkOp, uint32 Size, uint32& rPos, uint32 End)
+{
+    if (rkOp.Codec == EPlanCodec::Struct)
+        return LoadPlannedStruct(rSCLY, rkPlan, rkPlan.Struct(rkOp.StructIndex), rPos, End);
+
+    // Anything without a fixed encoding, or with a different size in the file than expected, goes through the regular path
+    if (rkOp.Codec == EPlanCodec::Generic || (Size != 0 && Size != rkOp.FileSize))
+    {
+        rSCLY.Seek(mPlanDataStart + rPos, SEEK_SET);
+        ReadProperty(rkOp.pProperty, Size, rSCLY);
+        rPos = rSCLY.Tell() - mPlanDataStart;
+        return true;
+    }
+
+    if (rPos + rkOp.FileSize > End)
+    {
+        errorf("%s [0x%X]: Property \"%s\" (%s) runs past the end of the object",
+               *rSCLY.GetSourceString(),
+               mPlanDataStart + rPos,
+               *rkOp.pProperty->Name(),
+               *rkOp.pProperty->IDString(true));
+        return false;
+    }
+
+    void* pData = mpObj->mpPropertyData->Data();
+    rkPlan.DecodeValue(rkOp, &mPlanBuffer[rPos], pData);
+
+#if VALIDATE_PROPERTY_VALUES
+    if (rkOp.Validate)
+        ValidatePropertyValue(rkOp.pProperty, pData, rSCLY, mPlanDataStart + rPos);
+#endif
+
+    rPos += rkOp.FileSize;
+    return true;
+}
+
 void CScriptLoader::LoadStructMP1(IInputStream& rSCLY, CStructProperty* pStruct)
 {
     [[maybe_unused]] const uint32 StructStart = rSCLY.Tell();
@@ -308,6 +459,7 @@ CScriptObject* CScriptLoader::LoadObjectMP1(IInputStream& rSCLY)
     if (InstanceID == 0x03FFFFFF)
         InstanceID = mpArea->FindUnusedInstanceID();
     mpObj = new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+    mpObj->DetachPropertyData(); // Cooked values are written straight into the object's own data
 
     // Load connections
     const uint32 NumLinks = rSCLY.ReadULong();
@@ -324,13 +476,18 @@ CScriptObject* CScriptLoader::LoadObjectMP1(IInputStream& rSCLY)
     }
 
     // Load object...
-    CStructProperty* pProperties = pTemplate->Properties();
-    LoadStructMP1(rSCLY, pProperties);
+    if (!LoadPropertiesPlanned(rSCLY, pTemplate, End))
+    {
+        CStructProperty* pProperties = pTemplate->Properties();
+        LoadStructMP1(rSCLY, pProperties);
+    }
 
     // Cleanup and return
     rSCLY.Seek(End, SEEK_SET);
 
-    mpObj->EvaluateProperties();
+    if (mEvaluateObjects)
+        mpObj->EvaluateProperties();
+
     return mpObj;
 }
 
@@ -419,6 +576,7 @@ CScriptObject* CScriptLoader::LoadObjectMP2(IInputStream& rSCLY)
     if (InstanceID == 0x03FFFFFF)
         InstanceID = mpArea->FindUnusedInstanceID();
     mpObj = new CScriptObject(InstanceID, mpArea, mpLayer, pTemplate);
+    mpObj->DetachPropertyData(); // Cooked values are written straight into the object's own data
 
     // Load connections
     const uint32 NumConnections = rSCLY.ReadUShort();
@@ -436,11 +594,15 @@ CScriptObject* CScriptLoader::LoadObjectMP2(IInputStream& rSCLY)
 
     // Load object
     rSCLY.Seek(0x6, SEEK_CUR); // Skip base struct ID + size
-    LoadStructMP2(rSCLY, pTemplate->Properties());
+
+    if (!LoadPropertiesPlanned(rSCLY, pTemplate, ObjEnd))
+        LoadStructMP2(rSCLY, pTemplate->Properties());
 
     // Cleanup and return
     rSCLY.Seek(ObjEnd, SEEK_SET);
-    mpObj->EvaluateProperties();
+    if (mEvaluateObjects)
+        mpObj->EvaluateProperties();
+
     return mpObj;
 }
 
@@ -465,7 +627,7 @@ std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayerMP2(IInputStream& rSCLY)
 }
 
 // ************ STATIC ************
-std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayer(IInputStream& rSCLY, CGameArea *pArea, EGame Version)
+std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayer(IInputStream& rSCLY, CGameArea *pArea, EGame Version, bool EvaluateObjects)
 {
     if (!rSCLY.IsValid())
         return nullptr;
@@ -474,6 +636,7 @@ std::unique_ptr<CScriptLayer> CScriptLoader::LoadLayer(IInputStream& rSCLY, CGam
     Loader.mVersion = Version;
     Loader.mpGameTemplate = NGameList::GetGameTemplate(Version);
     Loader.mpArea = pArea;
+    Loader.mEvaluateObjects = EvaluateObjects;
 
     if (!Loader.mpGameTemplate)
     {
@@ -504,10 +667,13 @@ CScriptObject* CScriptLoader::LoadInstance(IInputStream& rSCLY, CGameArea *pArea
         return nullptr;
     }
 
-    if (Loader.mVersion <= EGame::Prime)
-        return Loader.LoadObjectMP1(rSCLY);
-    else
-        return Loader.LoadObjectMP2(rSCLY);
+    CScriptObject *pObj = (Loader.mVersion <= EGame::Prime ? Loader.LoadObjectMP1(rSCLY) : Loader.LoadObjectMP2(rSCLY));
+
+    // Cache the link list positions of the new object's links
+    if (pObj)
+        pObj->RebuildLinkIndex();
+
+    return pObj;
 }
 
 void CScriptLoader::LoadStructData(IInputStream& rInput, CStructRef InStruct)
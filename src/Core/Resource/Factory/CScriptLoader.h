@@ -7,6 +7,7 @@
 #include "Core/Resource/Script/CScriptLayer.h"
 #include "Core/Resource/Script/CGameTemplate.h"
 #include <memory>
+#include <vector>
 
 class CScriptLoader
 {
@@ -19,8 +20,20 @@ class CScriptLoader
     // Current data pointer
     void* mpCurrentData = nullptr;
 
+    // Whether to evaluate display assets etc. as objects are loaded; this can load other resources
+    bool mEvaluateObjects = true;
+
+    // Object data being decoded with a compiled property plan, and its offset in the stream
+    std::vector<uint8> mPlanBuffer;
+    uint32 mPlanDataStart = 0;
+
     CScriptLoader();
     void ReadProperty(IProperty* pProp, uint32 Size, IInputStream& rSCLY);
+    void ValidatePropertyValue(IProperty* pProp, void* pData, IInputStream& rSCLY, uint32 ValueOffset);
+
+    bool LoadPropertiesPlanned(IInputStream& rSCLY, CScriptTemplate* pTemplate, uint32 End);
+    bool LoadPlannedStruct(IInputStream& rSCLY, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SStruct& rkStruct, uint32& rPos, uint32 End);
+    bool LoadPlannedProperty(IInputStream& rSCLY, const CScriptPropertyPlan& rkPlan, const CScriptPropertyPlan::SOp& rkOp, uint32 Size, uint32& rPos, uint32 End);
 
     void LoadStructMP1(IInputStream& rSCLY, CStructProperty* pStruct);
     CScriptObject* LoadObjectMP1(IInputStream& rSCLY);
@@ -31,7 +44,7 @@ class CScriptLoader
     std::unique_ptr<CScriptLayer> LoadLayerMP2(IInputStream& rSCLY);
 
 public:
-    static std::unique_ptr<CScriptLayer> LoadLayer(IInputStream& rSCLY, CGameArea *pArea, EGame Version);
+    static std::unique_ptr<CScriptLayer> LoadLayer(IInputStream& rSCLY, CGameArea *pArea, EGame Version, bool EvaluateObjects = true);
     static CScriptObject* LoadInstance(IInputStream& rSCLY, CGameArea *pArea, CScriptLayer *pLayer, EGame Version, bool ForceReturnsFormat);
     static void LoadStructData(IInputStream& rInput, CStructRef InStruct);
 };
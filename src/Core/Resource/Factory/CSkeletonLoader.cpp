@@ -109,6 +109,7 @@ std::unique_ptr<CSkeleton> CSkeletonLoader::LoadCINF(IInputStream& rCINF, CResou
 
     Loader.SetLocalBoneCoords(ptr->mpRootBone);
     Loader.CalculateBoneInverseBindMatrices();
+    ptr->BuildFlatHierarchy();
 
     // Skip bone ID array
     const uint32 NumBoneIDs = rCINF.ReadULong();
@@ -33,7 +33,7 @@ void CUnsupportedFormatLoader::PerformCheating(IInputStream& rFile, EGame Game,
                  (static_cast<uint64>(Data[iByte + 7]) << 0);
         }
 
-        if (gpResourceStore->IsResourceRegistered(ID))
+        if (ActiveResourceStore()->IsResourceRegistered(ID))
             rAssetList.push_back(ID);
     }
 }
@@ -81,7 +81,7 @@ std::unique_ptr<CAudioMacro> CUnsupportedFormatLoader::LoadCAUD(IInputStream& rC
         const uint32 SampleDataEnd = rCAUD.Tell() + SampleDataSize;
 
         const CAssetID SampleID(rCAUD, Game);
-        ASSERT(gpResourceStore->IsResourceRegistered(SampleID) == true);
+        ASSERT(ActiveResourceStore()->IsResourceRegistered(SampleID) == true);
         pMacro->mSamples.push_back(SampleID);
 
         rCAUD.Seek(SampleDataEnd, SEEK_SET);
@@ -481,7 +481,7 @@ std::unique_ptr<CMapArea> CUnsupportedFormatLoader::LoadMAPA(IInputStream& /*rMA
         }
     }
 
-    pMap->Entry()->ResourceStore()->DestroyUnreferencedResources();
+    pMap->Entry()->ResourceStore()->ReleaseUnreferencedResources();
     return ptr;
 }
 
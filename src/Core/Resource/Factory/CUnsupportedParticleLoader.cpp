@@ -1000,7 +1000,7 @@ void CUnsupportedParticleLoader::ParseIntFunction(IInputStream& rFile)
     case FOURCC('CNST'):
     {
         [[maybe_unused]] const uint32 Value = rFile.ReadULong();
-        ASSERT(gpResourceStore->FindEntry(CAssetID(Value)) == nullptr);
+        ASSERT(ActiveResourceStore()->FindEntry(CAssetID(Value)) == nullptr);
         break;
     }
 
@@ -14,26 +14,26 @@ void CWorldLoader::LoadPrimeMLVL(IInputStream& rMLVL)
     // Header
     if (mVersion < EGame::CorruptionProto)
     {
-        mpWorld->mpWorldName = gpResourceStore->LoadResource(rMLVL.ReadULong(), EResourceType::StringTable);
+        mpWorld->mpWorldName = ActiveResourceStore()->LoadResource(rMLVL.ReadULong(), EResourceType::StringTable);
 
         if (mVersion == EGame::Echoes)
-            mpWorld->mpDarkWorldName = gpResourceStore->LoadResource(rMLVL.ReadULong(), EResourceType::StringTable);
+            mpWorld->mpDarkWorldName = ActiveResourceStore()->LoadResource(rMLVL.ReadULong(), EResourceType::StringTable);
 
         if (mVersion >= EGame::Echoes)
             mpWorld->mTempleKeyWorldIndex = rMLVL.ReadULong();
 
         if (mVersion >= EGame::Prime)
-            mpWorld->mpSaveWorld = gpResourceStore->LoadResource(rMLVL.ReadULong(), EResourceType::SaveWorld);
+            mpWorld->mpSaveWorld = ActiveResourceStore()->LoadResource(rMLVL.ReadULong(), EResourceType::SaveWorld);
 
-        mpWorld->mpDefaultSkybox = gpResourceStore->LoadResource(rMLVL.ReadULong(), EResourceType::Model);
+        mpWorld->mpDefaultSkybox = ActiveResourceStore()->LoadResource(rMLVL.ReadULong(), EResourceType::Model);
     }
 
     else
     {
-        mpWorld->mpWorldName = gpResourceStore->LoadResource(rMLVL.ReadULongLong(), EResourceType::StringTable);
+        mpWorld->mpWorldName = ActiveResourceStore()->LoadResource(rMLVL.ReadULongLong(), EResourceType::StringTable);
         rMLVL.Seek(0x4, SEEK_CUR); // Skipping unknown value
-        mpWorld->mpSaveWorld = gpResourceStore->LoadResource(rMLVL.ReadULongLong(), EResourceType::SaveWorld);
-        mpWorld->mpDefaultSkybox = gpResourceStore->LoadResource(rMLVL.ReadULongLong(), EResourceType::Model);
+        mpWorld->mpSaveWorld = ActiveResourceStore()->LoadResource(rMLVL.ReadULongLong(), EResourceType::SaveWorld);
+        mpWorld->mpDefaultSkybox = ActiveResourceStore()->LoadResource(rMLVL.ReadULongLong(), EResourceType::Model);
     }
 
     // Memory relays - only in MP1
@@ -62,7 +62,7 @@ void CWorldLoader::LoadPrimeMLVL(IInputStream& rMLVL)
     {
         // Area header
         CWorld::SArea *pArea = &mpWorld->mAreas[iArea];
-        pArea->pAreaName = gpResourceStore->LoadResource<CStringTable>( CAssetID(rMLVL, mVersion) );
+        pArea->pAreaName = ActiveResourceStore()->LoadResource<CStringTable>( CAssetID(rMLVL, mVersion) );
         pArea->Transform = CTransform4f(rMLVL);
         pArea->AetherBox = CAABox(rMLVL);
         pArea->AreaResID = CAssetID(rMLVL, mVersion);
@@ -137,7 +137,7 @@ void CWorldLoader::LoadPrimeMLVL(IInputStream& rMLVL)
     }
 
     // MapWorld
-    mpWorld->mpMapWorld = gpResourceStore->LoadResource(CAssetID(rMLVL, mVersion), EResourceType::MapWorld);
+    mpWorld->mpMapWorld = ActiveResourceStore()->LoadResource(CAssetID(rMLVL, mVersion), EResourceType::MapWorld);
     rMLVL.Seek(0x5, SEEK_CUR); // Unknown values which are always 0
 
     // Audio Groups - we don't need this info as we regenerate it on cook
@@ -192,7 +192,7 @@ void CWorldLoader::LoadPrimeMLVL(IInputStream& rMLVL)
 
 void CWorldLoader::LoadReturnsMLVL(IInputStream& rMLVL)
 {
-    mpWorld->mpWorldName = gpResourceStore->LoadResource<CStringTable>(rMLVL.ReadULongLong());
+    mpWorld->mpWorldName = ActiveResourceStore()->LoadResource<CStringTable>(rMLVL.ReadULongLong());
 
     CWorld::STimeAttackData& rData = mpWorld->mTimeAttackData;
     rData.HasTimeAttack = rMLVL.ReadBool();
@@ -206,8 +206,8 @@ void CWorldLoader::LoadReturnsMLVL(IInputStream& rMLVL)
         rData.ShinyGoldTime = rMLVL.ReadFloat();
     }
 
-    mpWorld->mpSaveWorld = gpResourceStore->LoadResource(rMLVL.ReadULongLong(), EResourceType::SaveWorld);
-    mpWorld->mpDefaultSkybox = gpResourceStore->LoadResource<CModel>(rMLVL.ReadULongLong());
+    mpWorld->mpSaveWorld = ActiveResourceStore()->LoadResource(rMLVL.ReadULongLong(), EResourceType::SaveWorld);
+    mpWorld->mpDefaultSkybox = ActiveResourceStore()->LoadResource<CModel>(rMLVL.ReadULongLong());
 
     // Areas
     const uint32 NumAreas = rMLVL.ReadULong();
@@ -216,7 +216,7 @@ void CWorldLoader::LoadReturnsMLVL(IInputStream& rMLVL)
     for (auto& area : mpWorld->mAreas)
     {
         // Area header
-        area.pAreaName = gpResourceStore->LoadResource<CStringTable>(rMLVL.ReadULongLong());
+        area.pAreaName = ActiveResourceStore()->LoadResource<CStringTable>(rMLVL.ReadULongLong());
         area.Transform = CTransform4f(rMLVL);
         area.AetherBox = CAABox(rMLVL);
         area.AreaResID = rMLVL.ReadULongLong();
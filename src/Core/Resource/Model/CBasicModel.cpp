@@ -48,3 +48,22 @@ SSurface* CBasicModel::GetSurface(size_t Surface)
 {
     return mSurfaces[Surface];
 }
+
+size_t CBasicModel::MemoryUsage() const
+{
+    // Approximate; the vertex buffer is counted at the size of a full vertex regardless of which attributes it uses
+    size_t Size = sizeof(*this) + mVBO.Size() * sizeof(CVertex);
+
+    if (mHasOwnSurfaces)
+    {
+        for (const SSurface* pkSurface : mSurfaces)
+        {
+            Size += sizeof(SSurface);
+
+            for (const SSurface::SPrimitive& rkPrim : pkSurface->Primitives)
+                Size += rkPrim.Vertices.capacity() * sizeof(CVertex);
+        }
+    }
+
+    return Size;
+}
@@ -309,6 +309,19 @@ bool CModel::IsLightmapped() const
     return false;
 }
 
+size_t CModel::MemoryUsage() const
+{
+    size_t Size = CBasicModel::MemoryUsage();
+
+    for (const std::vector<CIndexBuffer>& rkIBOs : mSurfaceIndexBuffers)
+    {
+        for (const CIndexBuffer& rkIBO : rkIBOs)
+            Size += sizeof(CIndexBuffer) + rkIBO.GetSize() * sizeof(uint16);
+    }
+
+    return Size;
+}
+
 CIndexBuffer* CModel::InternalGetIBO(size_t Surface, EPrimitiveType Primitive)
 {
     std::vector<CIndexBuffer>& pIBOs = mSurfaceIndexBuffers[Surface];
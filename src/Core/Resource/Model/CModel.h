@@ -42,6 +42,7 @@ public:
     bool HasTransparency(size_t MatSet);
     bool IsSurfaceTransparent(size_t Surface, size_t MatSet);
     bool IsLightmapped() const;
+    size_t MemoryUsage() const override;
 
     bool IsSkinned() const { return mpSkin != nullptr; }
 
@@ -2,6 +2,7 @@
 #include "Core/Render/CDrawUtil.h"
 #include "Core/Render/CRenderer.h"
 #include "Core/OpenGL/GLCommon.h"
+#include "Core/CTrace.h"
 
 CStaticModel::CStaticModel()
     : CBasicModel(nullptr)
@@ -119,6 +120,7 @@ void CStaticModel::Draw(FRenderOptions Options)
             glDrawElements(ibo.GetPrimitiveType(), ibo.GetSize(), GL_UNSIGNED_SHORT, nullptr);
             ibo.Unbind();
             gDrawCount++;
+            gDrawCallsCounter.Add(1);
         }
     };
 
@@ -1,9 +1,19 @@
 #include "CGameTemplate.h"
 #include "NPropertyMap.h"
+#include "Core/CJobPool.h"
 #include "Core/Resource/Factory/CWorldLoader.h"
 #include <Common/Log.h>
 
+namespace
+{
+/** Name of the binary template cache file, stored next to the game's template XMLs */
+constexpr char gkpTemplateCacheName[] = "Templates.cache";
+}
+
+std::recursive_mutex CGameTemplate::sLoadMutex;
+
 CGameTemplate::CGameTemplate() = default;
+CGameTemplate::~CGameTemplate() = default;
 
 void CGameTemplate::Serialize(IArchive& Arc)
 {
@@ -16,44 +26,122 @@ void CGameTemplate::Serialize(IArchive& Arc)
 
 void CGameTemplate::Load(const TString& kFilePath)
 {
-    CXMLReader Reader(kFilePath);
-    ASSERT(Reader.IsValid());
+    mSourceFile = kFilePath;
 
-    mGame = Reader.Game();
-    Serialize(Reader);
+    const TString kGameDir = GetGameDirectory();
+    const TString kFileName = kFilePath.GetFileName();
+    const auto SerializeGame = [this](IArchive& Arc) { Serialize(Arc); };
+
+    mpCache = std::make_unique<CTemplateCache>(kGameDir + gkpTemplateCacheName, kGameDir);
+    mpCache->Load();
+
+    if (mpCache->ReadEntry(kFileName, SerializeGame))
+    {
+        mGame = mpCache->Game();
+    }
+    else
+    {
+        CXMLReader Reader(kFilePath);
+        ASSERT(Reader.IsValid());
+
+        mGame = Reader.Game();
+        Serialize(Reader);
+
+        mpCache->SetGame(mGame);
+        mpCache->WriteEntry(kFileName, SerializeGame);
+    }
 
-    mSourceFile = kFilePath;
     mFullyLoaded = true;
 
-    // Load all sub-templates
-    const TString gkGameRoot = GetGameDirectory();
+    // Sub-templates are only recorded here; they're loaded the first time they're requested.
+}
+
+/**
+ * Read and parse every template XML that hasn't been loaded yet on the job pool. This only
+ * parses the files; deserializing them (which resolves property archetypes and registers
+ * properties with NPropertyMap) still happens one template at a time when they are loaded.
+ */
+void CGameTemplate::PreparseTemplates()
+{
+    std::vector<TString> Paths;
 
-    for (auto& [id, path] : mScriptTemplates)
     {
-        TString AbsPath = gkGameRoot + path.Path;
-        path.pTemplate = std::make_shared<CScriptTemplate>(this, id, AbsPath);
+        std::lock_guard Lock(sLoadMutex);
+
+        const auto AddPath = [this, &Paths](const TString& kPath, bool IsLoaded)
+        {
+            if (!IsLoaded && mPreparsedFiles.find(kPath) == mPreparsedFiles.end() && !(mpCache && mpCache->HasValidEntry(kPath)))
+                Paths.push_back(kPath);
+        };
+
+        for (const auto& entry : mScriptTemplates)
+            AddPath(entry.second.Path, entry.second.pTemplate != nullptr);
+
+        for (const auto& entry : mPropertyTemplates)
+            AddPath(entry.second.Path, entry.second.pTemplate != nullptr);
+
+        for (const auto& entry : mMiscTemplates)
+            AddPath(entry.second.Path, entry.second.pTemplate != nullptr);
     }
 
-    for (auto& entry : mPropertyTemplates)
-    {
-        // For properties, remember that property archetypes can reference other archetypes which
-        // may not be loaded yet.. so if this happens, the referenced property will be loaded,
-        // meaning property templates can be loaded out of order, so we need to make sure
-        // that we don't load any template more than once.
-        SPropertyTemplatePath& PropertyPath = entry.second;
+    const TString kGameDir = GetGameDirectory();
+    std::vector<std::unique_ptr<CXMLReader>> Readers(Paths.size());
 
-        if (!PropertyPath.pTemplate)
+    CJobPool::Global().ParallelFor(Paths.size(), 8, [&](size_t Begin, size_t End)
+    {
+        for (size_t PathIdx = Begin; PathIdx < End; PathIdx++)
         {
-            Internal_LoadPropertyTemplate(PropertyPath);
+            auto pReader = std::make_unique<CXMLReader>(kGameDir + Paths[PathIdx]);
+
+            // Leave invalid files to the regular load path so they fail the same way they always have
+            if (pReader->IsValid())
+                Readers[PathIdx] = std::move(pReader);
         }
+    });
+
+    std::lock_guard Lock(sLoadMutex);
+
+    for (size_t PathIdx = 0; PathIdx < Paths.size(); PathIdx++)
+    {
+        if (Readers[PathIdx])
+            mPreparsedFiles.emplace(Paths[PathIdx], std::move(Readers[PathIdx]));
+    }
+}
+
+void CGameTemplate::LoadAllTemplates()
+{
+    PreparseTemplates();
+
+    // Templates are always loaded in the same order, regardless of which thread parsed them
+    std::lock_guard Lock(sLoadMutex);
+
+    for (auto& [id, path] : mScriptTemplates)
+    {
+        Internal_LoadScriptTemplate(path, id);
+    }
+
+    for (auto& entry : mPropertyTemplates)
+    {
+        // Property archetypes can reference other archetypes, so some of these will already
+        // have been loaded out of order by the time we reach them.
+        Internal_LoadPropertyTemplate(entry.second);
     }
 
     for (auto& entry : mMiscTemplates)
     {
-        SScriptTemplatePath& MiscPath = entry.second;
-        TString AbsPath = gkGameRoot + MiscPath.Path;
-        MiscPath.pTemplate = std::make_shared<CScriptTemplate>(this, UINT32_MAX, AbsPath);
+        Internal_LoadScriptTemplate(entry.second, UINT32_MAX);
     }
+
+    mPreparsedFiles.clear();
+}
+
+/** Write any newly compiled templates out to the binary template cache */
+void CGameTemplate::SaveTemplateCache()
+{
+    std::lock_guard Lock(sLoadMutex);
+
+    if (mpCache)
+        mpCache->SaveIfDirty();
 }
 
 void CGameTemplate::Save()
@@ -71,19 +159,73 @@ void CGameTemplate::Internal_LoadPropertyTemplate(SPropertyTemplatePath& Path)
     if (Path.pTemplate != nullptr) // don't load twice
         return;
 
-    const TString kGameDir = GetGameDirectory();
-    const TString kTemplateFilePath = kGameDir + Path.Path;
-    CXMLReader Reader(kTemplateFilePath);
-    ASSERT(Reader.IsValid());
+    const auto SerializeArchetype = [&Path](IArchive& Arc) { Arc << SerialParameter("PropertyArchetype", Path.pTemplate); };
+    const bool LoadedFromCache = mpCache && mpCache->ReadEntry(Path.Path, SerializeArchetype);
 
-    Reader << SerialParameter("PropertyArchetype", Path.pTemplate);
+    if (!LoadedFromCache)
+    {
+        std::unique_ptr<CXMLReader> pReader = Internal_TakePreparsedFile(Path.Path);
+
+        if (!pReader)
+        {
+            const TString kGameDir = GetGameDirectory();
+            const TString kTemplateFilePath = kGameDir + Path.Path;
+            pReader = std::make_unique<CXMLReader>(kTemplateFilePath);
+            ASSERT(pReader->IsValid());
+        }
+
+        SerializeArchetype(*pReader);
+    }
     ASSERT(Path.pTemplate != nullptr);
 
     Path.pTemplate->Initialize(nullptr, nullptr, 0);
+
+    // Compile after initialization so the cache entry matches what saving the template would write
+    if (!LoadedFromCache && mpCache)
+        mpCache->WriteEntry(Path.Path, SerializeArchetype);
+}
+
+/** Internal function for loading a script or misc template from a file on first use. */
+void CGameTemplate::Internal_LoadScriptTemplate(SScriptTemplatePath& Path, uint32 ObjectID)
+{
+    if (Path.pTemplate != nullptr) // don't load twice
+        return;
+
+    const TString kTemplateFilePath = GetGameDirectory() + Path.Path;
+
+    const bool LoadedFromCache = mpCache && mpCache->ReadEntry(Path.Path, [&](IArchive& Arc) {
+        Path.pTemplate = std::make_shared<CScriptTemplate>(this, ObjectID, kTemplateFilePath, Arc);
+    });
+
+    if (!LoadedFromCache)
+    {
+        if (std::unique_ptr<CXMLReader> pReader = Internal_TakePreparsedFile(Path.Path))
+            Path.pTemplate = std::make_shared<CScriptTemplate>(this, ObjectID, kTemplateFilePath, *pReader);
+        else
+            Path.pTemplate = std::make_shared<CScriptTemplate>(this, ObjectID, kTemplateFilePath);
+
+        if (mpCache)
+            mpCache->WriteEntry(Path.Path, [&Path](IArchive& Arc) { Path.pTemplate->Serialize(Arc); });
+    }
+}
+
+/** Internal function to claim the parsed XML for a template, if it was parsed ahead of time. */
+std::unique_ptr<CXMLReader> CGameTemplate::Internal_TakePreparsedFile(const TString& kPath)
+{
+    const auto Iter = mPreparsedFiles.find(kPath);
+
+    if (Iter == mPreparsedFiles.end())
+        return nullptr;
+
+    std::unique_ptr<CXMLReader> pReader = std::move(Iter->second);
+    mPreparsedFiles.erase(Iter);
+    return pReader;
 }
 
 void CGameTemplate::SaveGameTemplates(bool ForceAll)
 {
+    // Templates that were never loaded can't have been modified, so only loaded ones are saved
+    std::lock_guard Lock(sLoadMutex);
     const TString kGameDir = GetGameDirectory();
 
     if (mDirty || ForceAll)
@@ -145,6 +287,8 @@ CScriptTemplate* CGameTemplate::TemplateByID(uint32 ObjectID)
     if (it == mScriptTemplates.end())
         return nullptr;
 
+    std::lock_guard Lock(sLoadMutex);
+    Internal_LoadScriptTemplate(it->second, ObjectID);
     return it->second.pTemplate.get();
 }
 
@@ -155,8 +299,20 @@ CScriptTemplate* CGameTemplate::TemplateByID(const CFourCC& ObjectID)
 
 CScriptTemplate* CGameTemplate::TemplateByIndex(uint32 Index)
 {
-    const auto it = mScriptTemplates.begin();
-    return (std::next(it, Index))->second.pTemplate.get();
+    const auto it = std::next(mScriptTemplates.begin(), Index);
+
+    std::lock_guard Lock(sLoadMutex);
+    Internal_LoadScriptTemplate(it->second, it->first);
+    return it->second.pTemplate.get();
+}
+
+/** Returns the template at the given index, or nullptr if it hasn't been loaded yet */
+CScriptTemplate* CGameTemplate::LoadedTemplateByIndex(uint32 Index) const
+{
+    const auto it = std::next(mScriptTemplates.begin(), Index);
+
+    std::lock_guard Lock(sLoadMutex);
+    return it->second.pTemplate.get();
 }
 
 SState CGameTemplate::StateByID(uint32 StateID) const
@@ -215,6 +371,7 @@ IProperty* CGameTemplate::FindPropertyArchetype(const TString& kTypeName)
     // If the template isn't loaded yet, then load it.
     // This has to be done here to allow recursion while loading other property archetypes, because some properties may
     // request archetypes of other properties that haven't been loaded yet during their load.
+    std::lock_guard Lock(sLoadMutex);
     SPropertyTemplatePath& Path = Iter->second;
     if (!Path.pTemplate)
     {
@@ -242,7 +399,13 @@ bool CGameTemplate::RenamePropertyArchetype(const TString& kTypeName, const TStr
 
         if (Iter != mPropertyTemplates.cend())
         {
+            // Templates are loaded on first use, and any that aren't loaded yet would still refer to the
+            // archetype by its old name. Load them all before renaming so every sub-instance gets updated.
+            LoadAllTemplates();
+
+            std::lock_guard Lock(sLoadMutex);
             SPropertyTemplatePath& Path = Iter->second;
+            Internal_LoadPropertyTemplate(Path);
             IProperty* pArchetype = Path.pTemplate.get();
 
             if (pArchetype)
@@ -306,8 +469,9 @@ CScriptTemplate* CGameTemplate::FindMiscTemplate(const TString& kTemplateName)
         return nullptr;
     }
 
-
+    std::lock_guard Lock(sLoadMutex);
     SScriptTemplatePath& Path = Iter->second;
+    Internal_LoadScriptTemplate(Path, UINT32_MAX);
     return Path.pTemplate.get();
 }
 
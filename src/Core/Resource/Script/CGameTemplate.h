@@ -3,10 +3,13 @@
 
 #include "CLink.h"
 #include "CScriptTemplate.h"
+#include "CTemplateCache.h"
 #include "Core/Resource/Script/Property/Properties.h"
 #include <Common/BasicTypes.h>
 #include <Common/EGame.h>
+#include <Common/Serialization/XML.h>
 #include <map>
+#include <mutex>
 
 /** Serialization aid
  *  Retro switched from using integers to fourCCs to represent IDs in several cases (states/messages, object IDs).
@@ -80,20 +83,42 @@ class CGameTemplate
     std::map<SObjId, TString> mStates;
     std::map<SObjId, TString> mMessages;
 
+    /** Compiled binary copies of the template XMLs */
+    std::unique_ptr<CTemplateCache> mpCache;
+
+    /** Template XMLs that were read and parsed ahead of time by PreparseTemplates, keyed by relative path */
+    std::map<TString, std::unique_ptr<CXMLReader>> mPreparsedFiles;
+
+    /** Guards on-demand template loading. This is recursive because loading a template can load
+     *  the property archetypes it references, and it's shared between games because loaded
+     *  properties register themselves with NPropertyMap. */
+    static std::recursive_mutex sLoadMutex;
+
     /** Internal function for loading a property template from a file. */
     void Internal_LoadPropertyTemplate(SPropertyTemplatePath& Path);
 
+    /** Internal function for loading a script or misc template from a file on first use. */
+    void Internal_LoadScriptTemplate(SScriptTemplatePath& Path, uint32 ObjectID);
+
+    /** Internal function to claim the parsed XML for a template, if it was parsed ahead of time. */
+    std::unique_ptr<CXMLReader> Internal_TakePreparsedFile(const TString& kPath);
+
 public:
     CGameTemplate();
+    ~CGameTemplate();
     void Serialize(IArchive& Arc);
     void Load(const TString& kFilePath);
     void Save();
     void SaveGameTemplates(bool ForceAll = false);
+    void PreparseTemplates();
+    void LoadAllTemplates();
+    void SaveTemplateCache();
 
     uint32 GameVersion(TString VersionName);
     CScriptTemplate* TemplateByID(uint32 ObjectID);
     CScriptTemplate* TemplateByID(const CFourCC& ObjectID);
     CScriptTemplate* TemplateByIndex(uint32 Index);
+    CScriptTemplate* LoadedTemplateByIndex(uint32 Index) const;
     SState StateByID(uint32 StateID) const;
     SState StateByID(const CFourCC& StateID) const;
     SState StateByIndex(uint32 Index) const;
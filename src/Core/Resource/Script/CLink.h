@@ -62,12 +62,18 @@ struct SMessage
 
 class CLink
 {
+    friend class CScriptObject;
+
     CGameArea *mpArea;
     uint32 mStateID = UINT32_MAX;
     uint32 mMessageID = UINT32_MAX;
     uint32 mSenderID = UINT32_MAX;
     uint32 mReceiverID = UINT32_MAX;
 
+    // Position of the link in its sender's and receiver's link lists; kept up to date by CScriptObject
+    uint32 mSenderIndex = UINT32_MAX;
+    uint32 mReceiverIndex = UINT32_MAX;
+
 public:
     explicit CLink(CGameArea *pArea)
         : mpArea(pArea)
@@ -81,64 +87,51 @@ public:
         , mReceiverID(ReceiverID)
     {}
 
-    void SetSender(uint32 NewSenderID, uint32 Index = UINT32_MAX)
-    {
-        const uint32 OldSenderID = mSenderID;
-        CScriptObject *pOldSender = mpArea->InstanceByID(OldSenderID);
-        CScriptObject *pNewSender = mpArea->InstanceByID(NewSenderID);
+    CLink(const CLink& rkOther)
+        : mpArea(rkOther.mpArea)
+        , mStateID(rkOther.mStateID)
+        , mMessageID(rkOther.mMessageID)
+        , mSenderID(rkOther.mSenderID)
+        , mReceiverID(rkOther.mReceiverID)
+    {}
 
-        mSenderID = NewSenderID;
+    CLink& operator=(const CLink& rkOther)
+    {
+        // Copies aren't in any link lists, so the list positions aren't copied
+        mpArea = rkOther.mpArea;
+        mStateID = rkOther.mStateID;
+        mMessageID = rkOther.mMessageID;
+        mSenderID = rkOther.mSenderID;
+        mReceiverID = rkOther.mReceiverID;
+        return *this;
+    }
 
-        if (pOldSender)
+    void SetSender(uint32 NewSenderID, uint32 Index = UINT32_MAX)
+    {
+        if (CScriptObject *pOldSender = mpArea->InstanceByID(mSenderID))
             pOldSender->RemoveLink(ELinkType::Outgoing, this);
 
-        pNewSender->AddLink(ELinkType::Outgoing, this, Index);
+        mSenderID = NewSenderID;
+        mpArea->InstanceByID(NewSenderID)->AddLink(ELinkType::Outgoing, this, Index);
     }
 
     void SetReceiver(uint32 NewReceiverID, uint32 Index = UINT32_MAX)
     {
-        const uint32 OldReceiverID = mSenderID;
-        CScriptObject *pOldReceiver = mpArea->InstanceByID(OldReceiverID);
-        CScriptObject *pNewReceiver = mpArea->InstanceByID(NewReceiverID);
-
-        mReceiverID = NewReceiverID;
-
-        if (pOldReceiver)
+        if (CScriptObject *pOldReceiver = mpArea->InstanceByID(mReceiverID))
             pOldReceiver->RemoveLink(ELinkType::Incoming, this);
 
-        pNewReceiver->AddLink(ELinkType::Incoming, this, Index);
+        mReceiverID = NewReceiverID;
+        mpArea->InstanceByID(NewReceiverID)->AddLink(ELinkType::Incoming, this, Index);
     }
 
     uint32 SenderIndex() const
     {
-        CScriptObject *pSender = mpArea->InstanceByID(mSenderID);
-
-        if (pSender)
-        {
-            for (uint32 iLink = 0; iLink < pSender->NumLinks(ELinkType::Outgoing); iLink++)
-            {
-                if (pSender->Link(ELinkType::Outgoing, iLink) == this)
-                    return iLink;
-            }
-        }
-
-        return UINT32_MAX;
+        return FindIndex(Sender(), ELinkType::Outgoing, mSenderIndex);
     }
 
     uint32 ReceiverIndex() const
     {
-        CScriptObject *pReceiver = mpArea->InstanceByID(mReceiverID);
-
-        if (pReceiver)
-        {
-            for (uint32 iLink = 0; iLink < pReceiver->NumLinks(ELinkType::Incoming); iLink++)
-            {
-                if (pReceiver->Link(ELinkType::Incoming, iLink) == this)
-                    return iLink;
-            }
-        }
-
-        return UINT32_MAX;
+        return FindIndex(Receiver(), ELinkType::Incoming, mReceiverIndex);
     }
 
     // Operators
@@ -167,6 +160,25 @@ public:
 
     void SetState(uint32 StateID)       { mStateID = StateID; }
     void SetMessage(uint32 MessageID)   { mMessageID = MessageID; }
+
+private:
+    uint32 FindIndex(CScriptObject *pObject, ELinkType Type, uint32 CachedIndex) const
+    {
+        if (!pObject)
+            return UINT32_MAX;
+
+        if (CachedIndex < pObject->NumLinks(Type) && pObject->Link(Type, CachedIndex) == this)
+            return CachedIndex;
+
+        // Fall back on a search in case the list was filled in without going through CScriptObject
+        for (uint32 iLink = 0; iLink < pObject->NumLinks(Type); iLink++)
+        {
+            if (pObject->Link(Type, iLink) == this)
+                return iLink;
+        }
+
+        return UINT32_MAX;
+    }
 };
 
 
@@ -0,0 +1,20 @@
+#include "CPropertyBlock.h"
+#include "Core/Resource/Script/Property/CStructProperty.h"
+
+CPropertyBlock::CPropertyBlock(CStructProperty *pProperties)
+    : mpProperties(pProperties)
+    , mData(pProperties->DataSize())
+{
+    mpProperties->Construct(mData.data());
+}
+
+CPropertyBlock::CPropertyBlock(const CPropertyBlock& rkOther)
+    : CPropertyBlock(rkOther.mpProperties)
+{
+    mpProperties->CopyValue(mData.data(), const_cast<char*>(rkOther.mData.data()));
+}
+
+CPropertyBlock::~CPropertyBlock()
+{
+    mpProperties->Destruct(mData.data());
+}
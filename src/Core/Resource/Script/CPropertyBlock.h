@@ -0,0 +1,38 @@
+#ifndef CPROPERTYBLOCK_H
+#define CPROPERTYBLOCK_H
+
+#include <Common/BasicTypes.h>
+#include <vector>
+
+class CStructProperty;
+
+/**
+ * Property values for one script object. Objects that haven't changed anything yet
+ * share a block (usually their template's defaults) and copy it on their first write.
+ * A block that something outside the object keeps a raw pointer into is marked
+ * unshareable, so it is never swapped out from under that pointer.
+ */
+class CPropertyBlock
+{
+    CStructProperty *mpProperties;
+    std::vector<char> mData;
+    bool mIsShareable = true;
+
+public:
+    /** Creates a block holding the default value of every property */
+    explicit CPropertyBlock(CStructProperty *pProperties);
+    CPropertyBlock(const CPropertyBlock& rkOther);
+    ~CPropertyBlock();
+
+    CPropertyBlock& operator=(const CPropertyBlock&) = delete;
+
+    void MarkUnshareable()              { mIsShareable = false; }
+
+    void* Data()                        { return mData.data(); }
+    const void* Data() const            { return mData.data(); }
+    uint32 Size() const                 { return static_cast<uint32>(mData.size()); }
+    bool IsShareable() const            { return mIsShareable; }
+    CStructProperty* Properties() const { return mpProperties; }
+};
+
+#endif // CPROPERTYBLOCK_H
@@ -1,4 +1,5 @@
 #include "CScriptObject.h"
+#include "CLink.h"
 #include "CScriptLayer.h"
 #include "CGameTemplate.h"
 #include "Core/Resource/Animation/CAnimSet.h"
@@ -11,30 +12,14 @@ CScriptObject::CScriptObject(uint32 InstanceID, CGameArea *pArea, CScriptLayer *
 {
     mpTemplate->AddObject(this);
 
-    // Init properties
-    CStructProperty* pProperties = pTemplate->Properties();
-    uint32 PropertiesSize = pProperties->DataSize();
-
-    mPropertyData.resize( PropertiesSize );
-    void* pData = mPropertyData.data();
-    pProperties->Construct( pData );
-
-    mInstanceName = CStringRef(pData, pTemplate->NameProperty());
-    mPosition = CVectorRef(pData, pTemplate->PositionProperty());
-    mRotation = CVectorRef(pData, pTemplate->RotationProperty());
-    mScale = CVectorRef(pData, pTemplate->ScaleProperty());
-    mActive = CBoolRef(pData, pTemplate->ActiveProperty());
-    mLightParameters = CStructRef(pData, pTemplate->LightParametersProperty());
+    // Init properties. New objects share the template's default values until they modify something.
+    mpPropertyData = pTemplate->DefaultPropertyData();
+    BindPropertyRefs();
 }
 
 CScriptObject::~CScriptObject()
 {
-    if (!mPropertyData.empty())
-    {
-        mpTemplate->Properties()->Destruct( mPropertyData.data() );
-        mPropertyData.clear();
-    }
-
+    mpPropertyData.reset();
     mpTemplate->RemoveObject(this);
 
     // Note: Incoming links will be deleted by the sender.
@@ -43,17 +28,103 @@ CScriptObject::~CScriptObject()
 }
 
 // ************ DATA MANIPULATION ************
+void CScriptObject::BindPropertyRefs()
+{
+    void* pData = mpPropertyData->Data();
+    mInstanceName = CStringRef(pData, mpTemplate->NameProperty());
+    mPosition = CVectorRef(pData, mpTemplate->PositionProperty());
+    mRotation = CVectorRef(pData, mpTemplate->RotationProperty());
+    mScale = CVectorRef(pData, mpTemplate->ScaleProperty());
+    mActive = CBoolRef(pData, mpTemplate->ActiveProperty());
+    mLightParameters = CStructRef(pData, mpTemplate->LightParametersProperty());
+}
+
+void CScriptObject::DetachPropertyData()
+{
+    // Take a private copy of shared data before the first write. The template's defaults can be
+    // constructed directly, which is cheaper than copying the values over one by one.
+    if (mpPropertyData.use_count() > 1)
+    {
+        const bool IsDefault = (mpPropertyData == mpTemplate->DefaultPropertyData());
+        mpPropertyData = IsDefault ? std::make_shared<CPropertyBlock>(mpTemplate->Properties())
+                                   : std::make_shared<CPropertyBlock>(*mpPropertyData);
+        BindPropertyRefs();
+    }
+}
+
+void* CScriptObject::PropertyData()
+{
+    // The caller can write through the pointer or hold onto it, so the data can't be shared
+    DetachPropertyData();
+    mpPropertyData->MarkUnshareable();
+    return mpPropertyData->Data();
+}
+
 void CScriptObject::CopyProperties(CScriptObject* pObject)
 {
     ASSERT(pObject->Template() == Template());
-    CSerialVersion Version(0, IArchive::skCurrentArchiveVersion, Template()->Game());
 
-    CVectorOutStream DataStream;
-    CBasicBinaryWriter DataWriter(&DataStream, Version);
-    Template()->Properties()->SerializeValue( pObject->PropertyData(), DataWriter );
+    // Share the source's data if neither object has handed out pointers into its own. Otherwise
+    // assign the values, so anything holding a pointer into this object's data stays valid.
+    if (mpPropertyData->IsShareable() && pObject->mpPropertyData->IsShareable())
+    {
+        mpPropertyData = pObject->mpPropertyData;
+        BindPropertyRefs();
+    }
+    else if (!mpPropertyData->IsShareable())
+    {
+        Template()->Properties()->CopyValue( mpPropertyData->Data(), pObject->ReadOnlyPropertyData() );
+    }
+    else
+    {
+        mpPropertyData = std::make_shared<CPropertyBlock>(*pObject->mpPropertyData);
+        BindPropertyRefs();
+    }
+}
+
+void CScriptObject::SetPosition(const CVector3f& rkNewPos)
+{
+    if (mPosition.IsValid() && mPosition.Get() != rkNewPos)
+    {
+        DetachPropertyData();
+        mPosition.Set(rkNewPos);
+    }
+}
+
+void CScriptObject::SetRotation(const CVector3f& rkNewRot)
+{
+    if (mRotation.IsValid() && mRotation.Get() != rkNewRot)
+    {
+        DetachPropertyData();
+        mRotation.Set(rkNewRot);
+    }
+}
+
+void CScriptObject::SetScale(const CVector3f& rkNewScale)
+{
+    if (mScale.IsValid() && mScale.Get() != rkNewScale)
+    {
+        DetachPropertyData();
+        mScale.Set(rkNewScale);
+    }
+}
+
+void CScriptObject::SetName(const TString& rkNewName)
+{
+    if (mInstanceName.IsValid() && mInstanceName.Get() != rkNewName)
+    {
+        DetachPropertyData();
+        mInstanceName.Set(rkNewName);
+    }
+}
 
-    CBasicBinaryReader DataReader(DataStream.Data(), DataStream.Size(), Version);
-    Template()->Properties()->SerializeValue( PropertyData(), DataReader );
+void CScriptObject::SetActive(bool Active)
+{
+    if (mActive.IsValid() && mActive.Get() != Active)
+    {
+        DetachPropertyData();
+        mActive.Set(Active);
+    }
 }
 
  void CScriptObject::EvaluateProperties()
@@ -65,12 +136,12 @@ void CScriptObject::CopyProperties(CScriptObject* pObject)
 
 void CScriptObject::EvaluateDisplayAsset()
 {
-    mpDisplayAsset = mpTemplate->FindDisplayAsset(PropertyData(), mActiveCharIndex, mActiveAnimIndex, mHasInGameModel);
+    mpDisplayAsset = mpTemplate->FindDisplayAsset(ReadOnlyPropertyData(), mActiveCharIndex, mActiveAnimIndex, mHasInGameModel);
 }
 
 void CScriptObject::EvaluateCollisionModel()
 {
-    mpCollision = mpTemplate->FindCollision(PropertyData());
+    mpCollision = mpTemplate->FindCollision(ReadOnlyPropertyData());
 }
 
 void CScriptObject::EvaluateVolume()
@@ -183,8 +254,9 @@ void CScriptObject::AddLink(ELinkType Type, CLink *pLink, uint32 Index)
 {
     std::vector<CLink*> *pLinkVec = (Type == ELinkType::Incoming ? &mInLinks : &mOutLinks);
 
-    if (Index == UINT32_MAX || Index == pLinkVec->size())
+    if (Index == UINT32_MAX || Index >= pLinkVec->size())
     {
+        Index = pLinkVec->size();
         pLinkVec->push_back(pLink);
     }
     else
@@ -193,40 +265,85 @@ void CScriptObject::AddLink(ELinkType Type, CLink *pLink, uint32 Index)
         std::advance(it, Index);
         pLinkVec->insert(it, pLink);
     }
+
+    ReindexLinks(Type, Index);
 }
 
 void CScriptObject::RemoveLink(ELinkType Type, CLink *pLink)
 {
     std::vector<CLink*> *pLinkVec = (Type == ELinkType::Incoming ? &mInLinks : &mOutLinks);
+    const uint32 CachedIndex = (Type == ELinkType::Incoming ? pLink->mReceiverIndex : pLink->mSenderIndex);
+    size_t Index = pLinkVec->size();
 
-    for (auto it = pLinkVec->begin(); it != pLinkVec->end(); ++it)
+    if (CachedIndex < pLinkVec->size() && (*pLinkVec)[CachedIndex] == pLink)
     {
-        if (*it == pLink)
-        {
-            pLinkVec->erase(it);
-            break;
-        }
+        Index = CachedIndex;
+    }
+    else
+    {
+        auto it = std::find(pLinkVec->begin(), pLinkVec->end(), pLink);
+        Index = std::distance(pLinkVec->begin(), it);
+    }
+
+    if (Index < pLinkVec->size())
+    {
+        pLinkVec->erase(pLinkVec->begin() + Index);
+        ReindexLinks(Type, Index);
     }
 }
 
-void CScriptObject::BreakAllLinks()
+void CScriptObject::RemoveLinks(const std::unordered_set<CLink*>& kLinks)
 {
-    for (auto* link : mInLinks)
+    // Compact both lists in a single pass each, instead of searching and erasing once per link
+    for (ELinkType Type : { ELinkType::Outgoing, ELinkType::Incoming })
     {
-        if (CScriptObject* sender = link->Sender())
-            sender->RemoveLink(ELinkType::Outgoing, link);
+        std::vector<CLink*>& rLinkVec = (Type == ELinkType::Incoming ? mInLinks : mOutLinks);
+        auto IsRemoved = [&kLinks](CLink* pLink) { return kLinks.find(pLink) != kLinks.end(); };
+        auto FirstRemoved = std::find_if(rLinkVec.begin(), rLinkVec.end(), IsRemoved);
 
-        delete link;
+        if (FirstRemoved == rLinkVec.end())
+            continue;
+
+        const size_t FirstIndex = std::distance(rLinkVec.begin(), FirstRemoved);
+        rLinkVec.erase(std::remove_if(FirstRemoved, rLinkVec.end(), IsRemoved), rLinkVec.end());
+        ReindexLinks(Type, FirstIndex);
     }
+}
+
+void CScriptObject::BreakAllLinks()
+{
+    // Self-links are in both lists; only gather them once
+    std::vector<CLink*> Links;
+    Links.reserve(mInLinks.size() + mOutLinks.size());
+    Links.insert(Links.end(), mInLinks.begin(), mInLinks.end());
 
     for (auto* link : mOutLinks)
     {
-        if (CScriptObject* receiver = link->Receiver())
-            receiver->RemoveLink(ELinkType::Incoming, link);
-
-        delete link;
+        if (link->ReceiverID() != link->SenderID())
+            Links.push_back(link);
     }
 
+    mpArea->DeleteLinks(Links);
     mInLinks.clear();
     mOutLinks.clear();
 }
+
+void CScriptObject::RebuildLinkIndex()
+{
+    ReindexLinks(ELinkType::Outgoing, 0);
+    ReindexLinks(ELinkType::Incoming, 0);
+}
+
+void CScriptObject::ReindexLinks(ELinkType Type, size_t FirstIndex)
+{
+    if (Type == ELinkType::Incoming)
+    {
+        for (size_t LinkIdx = FirstIndex; LinkIdx < mInLinks.size(); LinkIdx++)
+            mInLinks[LinkIdx]->mReceiverIndex = LinkIdx;
+    }
+    else
+    {
+        for (size_t LinkIdx = FirstIndex; LinkIdx < mOutLinks.size(); LinkIdx++)
+            mOutLinks[LinkIdx]->mSenderIndex = LinkIdx;
+    }
+}
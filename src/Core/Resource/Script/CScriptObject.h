@@ -6,6 +6,7 @@
 #include "Core/Resource/Collision/CCollisionMeshGroup.h"
 #include "Core/Resource/Model/CModel.h"
 #include "Core/Resource/Script/Property/Properties.h"
+#include <unordered_set>
 
 class CScriptLayer;
 class CLink;
@@ -42,7 +43,7 @@ class CScriptObject
     CInstanceID mInstanceID;
     std::vector<CLink*> mOutLinks;
     std::vector<CLink*> mInLinks;
-    std::vector<char> mPropertyData;
+    std::shared_ptr<CPropertyBlock> mpPropertyData;
 
     CStringRef mInstanceName;
     CVectorRef mPosition;
@@ -63,6 +64,10 @@ class CScriptObject
     // Recursion guard
     mutable bool mIsCheckingNearVisibleActivation = false;
 
+    void ReindexLinks(ELinkType Type, size_t FirstIndex);
+    void BindPropertyRefs();
+    void DetachPropertyData();
+
 public:
     CScriptObject(uint32 InstanceID, CGameArea *pArea, CScriptLayer *pLayer, CScriptTemplate *pTemplate);
     ~CScriptObject();
@@ -79,7 +84,9 @@ public:
 
     void AddLink(ELinkType Type, CLink *pLink, uint32 Index = UINT32_MAX);
     void RemoveLink(ELinkType Type, CLink *pLink);
+    void RemoveLinks(const std::unordered_set<CLink*>& kLinks);
     void BreakAllLinks();
+    void RebuildLinkIndex();
 
     // Accessors
     CScriptTemplate* Template() const                               { return mpTemplate; }
@@ -91,7 +98,13 @@ public:
     CInstanceID InstanceID() const                                  { return mInstanceID; }
     size_t NumLinks(ELinkType Type) const                           { return (Type == ELinkType::Incoming ? mInLinks.size() : mOutLinks.size()); }
     CLink* Link(ELinkType Type, size_t Index) const                 { return (Type == ELinkType::Incoming ? mInLinks[Index] : mOutLinks[Index]); }
-    void* PropertyData() const                                      { return (void*) mPropertyData.data(); }
+    bool SharesPropertyData() const                                 { return mpPropertyData.use_count() > 1; }
+    uint32 PropertyDataSize() const                                 { return mpPropertyData->Size(); }
+
+    /** Property data for reading. Don't hold onto the pointer; the next write can move the data. */
+    void* ReadOnlyPropertyData() const                              { return const_cast<void*>(mpPropertyData->Data()); }
+    /** Property data that stays put for the lifetime of the object, for writing or long-lived refs */
+    void* PropertyData();
 
     CVector3f Position() const                  { return mPosition.IsValid() ? mPosition.Get() : CVector3f::Zero(); }
     CVector3f Rotation() const                  { return mRotation.IsValid() ? mRotation.Get() : CVector3f::Zero(); }
@@ -106,11 +119,11 @@ public:
     CCollisionMeshGroup* Collision() const      { return mpCollision; }
     EVolumeShape VolumeShape() const            { return mVolumeShape; }
     float VolumeScale() const                   { return mVolumeScale; }
-    void SetPosition(const CVector3f& rkNewPos) { mPosition.Set(rkNewPos); }
-    void SetRotation(const CVector3f& rkNewRot) { mRotation.Set(rkNewRot); }
-    void SetScale(const CVector3f& rkNewScale)  { mScale.Set(rkNewScale); }
-    void SetName(const TString& rkNewName)      { mInstanceName.Set(rkNewName); }
-    void SetActive(bool Active)                 { mActive.Set(Active); }
+    void SetPosition(const CVector3f& rkNewPos);
+    void SetRotation(const CVector3f& rkNewRot);
+    void SetScale(const CVector3f& rkNewScale);
+    void SetName(const TString& rkNewName);
+    void SetActive(bool Active);
 
     bool HasPosition() const        { return mPosition.IsValid(); }
     bool HasRotation() const        { return mRotation.IsValid(); }
@@ -0,0 +1,298 @@
+#include "CScriptPropertyPlan.h"
+#include <cstring>
+
+bool CScriptPropertyPlan::sEnabled = true;
+
+CScriptPropertyPlan::CScriptPropertyPlan(CStructProperty* pProperties)
+    : mGame(pProperties->Game())
+    , mAssetIDLength(CAssetID::GameIDLength(pProperties->Game()))
+{
+    if (IsFlat())
+    {
+        mStructs.push_back(SStruct{pProperties, 0, 0, pProperties->IsAtomic()});
+        CompileFlat(pProperties);
+        mStructs[0].NumOps = mOps.size();
+    }
+    else
+    {
+        CompileStruct(pProperties);
+    }
+}
+
+const CScriptPropertyPlan::SOp* CScriptPropertyPlan::FindOp(const SStruct& rkStruct, uint32 FileID, uint32& rInOutCursor) const
+{
+    // Properties are nearly always cooked in template order, so the predicted op is usually right
+    if (rInOutCursor < rkStruct.NumOps && mOps[rkStruct.FirstOp + rInOutCursor].FileID == FileID)
+    {
+        return &mOps[rkStruct.FirstOp + rInOutCursor++];
+    }
+
+    for (uint32 OpIdx = 0; OpIdx < rkStruct.NumOps; OpIdx++)
+    {
+        if (mOps[rkStruct.FirstOp + OpIdx].FileID == FileID)
+        {
+            rInOutCursor = OpIdx + 1;
+            return &mOps[rkStruct.FirstOp + OpIdx];
+        }
+    }
+
+    return nullptr;
+}
+
+void CScriptPropertyPlan::DecodeValue(const SOp& rkOp, const uint8* pkSrc, void* pPropertyData) const
+{
+    void* pValue = static_cast<char*>(pPropertyData) + rkOp.Offset;
+    float Floats[4];
+
+    switch (rkOp.Codec)
+    {
+    case EPlanCodec::Bool:
+        *static_cast<bool*>(pValue) = (pkSrc[0] != 0);
+        break;
+
+    case EPlanCodec::Byte:
+        *static_cast<int8*>(pValue) = static_cast<int8>(pkSrc[0]);
+        break;
+
+    case EPlanCodec::Short:
+        *static_cast<int16*>(pValue) = static_cast<int16>(ReadBE16(pkSrc));
+        break;
+
+    case EPlanCodec::Long:
+    case EPlanCodec::Float:
+    {
+        // Floats are copied as their bit patterns
+        const uint32 Value = ReadBE32(pkSrc);
+        memcpy(pValue, &Value, sizeof(Value));
+        break;
+    }
+
+    case EPlanCodec::Vector:
+    case EPlanCodec::Color:
+    {
+        const uint32 NumFloats = rkOp.FileSize / 4;
+
+        for (uint32 FloatIdx = 0; FloatIdx < NumFloats; FloatIdx++)
+        {
+            const uint32 Bits = ReadBE32(pkSrc + FloatIdx * 4);
+            memcpy(&Floats[FloatIdx], &Bits, sizeof(Bits));
+        }
+
+        if (rkOp.Codec == EPlanCodec::Vector)
+            *static_cast<CVector3f*>(pValue) = CVector3f(Floats[0], Floats[1], Floats[2]);
+        else
+            *static_cast<CColor*>(pValue) = CColor(Floats[0], Floats[1], Floats[2], Floats[3]);
+        break;
+    }
+
+    case EPlanCodec::Asset:
+    {
+        uint64 ID = ReadBE32(pkSrc);
+
+        if (mAssetIDLength == EIDLength::k64Bit)
+            ID = (ID << 32) | ReadBE32(pkSrc + 4);
+
+        *static_cast<CAssetID*>(pValue) = CAssetID(ID, mAssetIDLength);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+bool CScriptPropertyPlan::EncodeValue(const SOp& rkOp, void* pPropertyData, std::vector<uint8>& rOut) const
+{
+    void* pValue = static_cast<char*>(pPropertyData) + rkOp.Offset;
+    float Floats[4];
+
+    switch (rkOp.Codec)
+    {
+    case EPlanCodec::Bool:
+        rOut.push_back(*static_cast<bool*>(pValue) ? 1 : 0);
+        return true;
+
+    case EPlanCodec::Byte:
+        rOut.push_back(static_cast<uint8>(*static_cast<int8*>(pValue)));
+        return true;
+
+    case EPlanCodec::Short:
+        WriteBE16(rOut, static_cast<uint16>(*static_cast<int16*>(pValue)));
+        return true;
+
+    case EPlanCodec::Long:
+    case EPlanCodec::Float:
+    {
+        uint32 Value;
+        memcpy(&Value, pValue, sizeof(Value));
+        WriteBE32(rOut, Value);
+        return true;
+    }
+
+    case EPlanCodec::Vector:
+    case EPlanCodec::Color:
+    {
+        if (rkOp.Codec == EPlanCodec::Vector)
+        {
+            const CVector3f& rkVector = *static_cast<CVector3f*>(pValue);
+            Floats[0] = rkVector.X; Floats[1] = rkVector.Y; Floats[2] = rkVector.Z;
+        }
+        else
+        {
+            const CColor& rkColor = *static_cast<CColor*>(pValue);
+            Floats[0] = rkColor.R; Floats[1] = rkColor.G; Floats[2] = rkColor.B; Floats[3] = rkColor.A;
+        }
+
+        const uint32 NumFloats = rkOp.FileSize / 4;
+
+        for (uint32 FloatIdx = 0; FloatIdx < NumFloats; FloatIdx++)
+        {
+            uint32 Bits;
+            memcpy(&Bits, &Floats[FloatIdx], sizeof(Bits));
+            WriteBE32(rOut, Bits);
+        }
+        return true;
+    }
+
+    case EPlanCodec::Asset:
+    {
+        // Asset IDs are written at their own length, which may not match the game's
+        const CAssetID& rkID = *static_cast<CAssetID*>(pValue);
+
+        if (rkID.Length() != mAssetIDLength)
+            return false;
+
+        if (mAssetIDLength == EIDLength::k64Bit)
+        {
+            const uint64 ID = rkID.ToLongLong();
+            WriteBE32(rOut, static_cast<uint32>(ID >> 32));
+            WriteBE32(rOut, static_cast<uint32>(ID));
+        }
+        else
+        {
+            WriteBE32(rOut, rkID.ToLong());
+        }
+        return true;
+    }
+
+    case EPlanCodec::Count:
+        WriteBE32(rOut, rkOp.FileID);
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+void CScriptPropertyPlan::CompileFlat(CStructProperty* pStruct)
+{
+    if (!pStruct->IsAtomic())
+    {
+        uint32 NumCooked = 0;
+
+        for (size_t ChildIdx = 0; ChildIdx < pStruct->NumChildren(); ChildIdx++)
+        {
+            if (pStruct->ChildByIndex(ChildIdx)->CookPreference() != ECookPreference::Never)
+                NumCooked++;
+        }
+
+        SOp CountOp{pStruct, NumCooked, 0, 4, UINT32_MAX, EPlanCodec::Count, false};
+        mOps.push_back(CountOp);
+    }
+
+    for (size_t ChildIdx = 0; ChildIdx < pStruct->NumChildren(); ChildIdx++)
+    {
+        IProperty* pChild = pStruct->ChildByIndex(ChildIdx);
+
+        // The loader skips these; the cooker only skips them in non-atomic structs
+        if (pChild->CookPreference() == ECookPreference::Never)
+            continue;
+
+        if (pChild->Type() == EPropertyType::Struct)
+        {
+            CStructProperty* pChildStruct = TPropCast<CStructProperty>(pChild);
+            bool CanFlatten = true;
+
+            // Atomic structs with skipped children are read and written differently; leave those to the regular path
+            if (pChildStruct->IsAtomic())
+            {
+                for (size_t SubIdx = 0; SubIdx < pChildStruct->NumChildren(); SubIdx++)
+                {
+                    if (pChildStruct->ChildByIndex(SubIdx)->CookPreference() == ECookPreference::Never)
+                        CanFlatten = false;
+                }
+            }
+
+            if (CanFlatten)
+            {
+                CompileFlat(pChildStruct);
+                continue;
+            }
+        }
+
+        SOp Op = MakeOp(pChild);
+
+        if (Op.Codec == EPlanCodec::Struct)
+            Op.Codec = EPlanCodec::Generic;
+
+        if (Op.Codec == EPlanCodec::Generic)
+            mNumGenericOps++;
+
+        mOps.push_back(Op);
+    }
+}
+
+uint32 CScriptPropertyPlan::CompileStruct(CStructProperty* pStruct)
+{
+    const uint32 StructIdx = mStructs.size();
+    const uint32 FirstOp = mOps.size();
+    mStructs.push_back(SStruct{pStruct, FirstOp, static_cast<uint32>(pStruct->NumChildren()), pStruct->IsAtomic()});
+
+    // Reserve this struct's ops first so they stay contiguous, then fill in any sub-structs
+    for (size_t ChildIdx = 0; ChildIdx < pStruct->NumChildren(); ChildIdx++)
+    {
+        mOps.push_back(MakeOp(pStruct->ChildByIndex(ChildIdx)));
+
+        if (mOps.back().Codec == EPlanCodec::Generic)
+            mNumGenericOps++;
+    }
+
+    for (uint32 OpIdx = FirstOp; OpIdx < FirstOp + pStruct->NumChildren(); OpIdx++)
+    {
+        if (mOps[OpIdx].Codec == EPlanCodec::Struct)
+        {
+            const uint32 SubStructIdx = CompileStruct(TPropCast<CStructProperty>(mOps[OpIdx].pProperty));
+            mOps[OpIdx].StructIndex = SubStructIdx;
+        }
+    }
+
+    return StructIdx;
+}
+
+CScriptPropertyPlan::SOp CScriptPropertyPlan::MakeOp(IProperty* pProperty) const
+{
+    SOp Op{pProperty, pProperty->ID(), pProperty->Offset(), 0, UINT32_MAX, EPlanCodec::Generic, false};
+
+    switch (pProperty->Type())
+    {
+    case EPropertyType::Bool:       Op.Codec = EPlanCodec::Bool;   Op.FileSize = 1; break;
+    case EPropertyType::Byte:       Op.Codec = EPlanCodec::Byte;   Op.FileSize = 1; break;
+    case EPropertyType::Short:      Op.Codec = EPlanCodec::Short;  Op.FileSize = 2; break;
+    case EPropertyType::Int:
+    case EPropertyType::Sound:
+    case EPropertyType::Animation:  Op.Codec = EPlanCodec::Long;   Op.FileSize = 4; break;
+    case EPropertyType::Choice:
+    case EPropertyType::Enum:
+    case EPropertyType::Flags:      Op.Codec = EPlanCodec::Long;   Op.FileSize = 4; Op.Validate = true; break;
+    case EPropertyType::Float:      Op.Codec = EPlanCodec::Float;  Op.FileSize = 4; break;
+    case EPropertyType::Vector:     Op.Codec = EPlanCodec::Vector; Op.FileSize = 12; break;
+    case EPropertyType::Color:      Op.Codec = EPlanCodec::Color;  Op.FileSize = 16; break;
+    case EPropertyType::Asset:      Op.Codec = EPlanCodec::Asset;  Op.FileSize = (mAssetIDLength == EIDLength::k64Bit ? 8 : 4); Op.Validate = true; break;
+    case EPropertyType::Struct:     Op.Codec = EPlanCodec::Struct; break;
+
+    // Strings, arrays, splines, etc. are variable size
+    default: break;
+    }
+
+    return Op;
+}
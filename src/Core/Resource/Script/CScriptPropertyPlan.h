@@ -0,0 +1,127 @@
+#ifndef CSCRIPTPROPERTYPLAN_H
+#define CSCRIPTPROPERTYPLAN_H
+
+#include "Core/Resource/Script/Property/Properties.h"
+#include <Common/BasicTypes.h>
+#include <Common/EGame.h>
+#include <vector>
+
+/** How a single property value is encoded in cooked script data */
+enum class EPlanCodec : uint8
+{
+    Bool,       // 1 byte
+    Byte,       // 1 byte
+    Short,      // 2 bytes
+    Long,       // 4 bytes; ints, choices, enums, flags, sounds and animations
+    Float,      // 4 bytes
+    Vector,     // 3 floats
+    Color,      // 4 floats
+    Asset,      // 4 or 8 byte asset ID, depending on the game
+    Count,      // Property count of an MP1 non-atomic struct
+    Struct,     // MP2+ struct; has its own list of ops
+    Generic     // Variable size or otherwise unsupported; handled by the regular loader/cooker
+};
+
+/**
+ * Compiled layout of a script template's properties, used to read and write cooked
+ * script objects without walking the property tree or going through the stream per value.
+ *
+ * MP1 objects are always laid out in template order, so the whole object is one flat list
+ * of ops. From MP2 onwards, each non-atomic struct has its own list of ops in template order;
+ * cooked data can leave properties out or store them in a different order, so ops are matched
+ * by property ID, using the template order as a guess for which one comes next.
+ */
+class CScriptPropertyPlan
+{
+public:
+    struct SOp
+    {
+        IProperty* pProperty;
+        /** Property ID; for Count ops, the number of properties that get cooked */
+        uint32 FileID;
+        /** Offset of the value within the object's property data */
+        uint32 Offset;
+        /** Size of the encoded value; 0 for Struct and Generic ops */
+        uint32 FileSize;
+        /** Index of the struct's op list, for Struct ops */
+        uint32 StructIndex;
+        EPlanCodec Codec;
+        /** Whether the value can be invalid and should be checked against the template after reading */
+        bool Validate;
+    };
+
+    struct SStruct
+    {
+        CStructProperty* pProperty;
+        uint32 FirstOp;
+        uint32 NumOps;
+        bool IsAtomic;
+    };
+
+private:
+    EGame mGame;
+    EIDLength mAssetIDLength;
+    std::vector<SOp> mOps;
+    std::vector<SStruct> mStructs;
+    uint32 mNumGenericOps = 0;
+
+    static bool sEnabled;
+
+public:
+    explicit CScriptPropertyPlan(CStructProperty* pProperties);
+
+    /** Find the op for a child of a non-atomic struct, starting from the predicted op in rInOutCursor */
+    const SOp* FindOp(const SStruct& rkStruct, uint32 FileID, uint32& rInOutCursor) const;
+
+    /** Decode a fixed-size value from big endian data. pkSrc must have at least FileSize bytes. */
+    void DecodeValue(const SOp& rkOp, const uint8* pkSrc, void* pPropertyData) const;
+
+    /** Append a fixed-size value as big endian data. Returns false if the value can't be encoded with this op. */
+    bool EncodeValue(const SOp& rkOp, void* pPropertyData, std::vector<uint8>& rOut) const;
+
+    /** Whether the plan covers the MP1 format (one flat op list) rather than the MP2+ format */
+    bool IsFlat() const                                 { return mGame <= EGame::Prime; }
+    EGame Game() const                                  { return mGame; }
+    const SStruct& RootStruct() const                   { return mStructs[0]; }
+    const SStruct& Struct(uint32 Index) const           { return mStructs[Index]; }
+    const SOp& Op(uint32 Index) const                   { return mOps[Index]; }
+    uint32 NumOps() const                               { return mOps.size(); }
+    uint32 NumGenericOps() const                        { return mNumGenericOps; }
+
+    /** Toggle use of compiled plans by the script loader and cooker. Enabled by default. */
+    static void SetEnabled(bool Enabled)                { sEnabled = Enabled; }
+    static bool IsEnabled()                             { return sEnabled; }
+
+    /** Big endian helpers */
+    static uint16 ReadBE16(const uint8* pkSrc)
+    {
+        return static_cast<uint16>((pkSrc[0] << 8) | pkSrc[1]);
+    }
+
+    static uint32 ReadBE32(const uint8* pkSrc)
+    {
+        return (static_cast<uint32>(pkSrc[0]) << 24) | (static_cast<uint32>(pkSrc[1]) << 16) |
+               (static_cast<uint32>(pkSrc[2]) << 8)  |  static_cast<uint32>(pkSrc[3]);
+    }
+
+    static void WriteBE16(std::vector<uint8>& rOut, uint16 Value)
+    {
+        rOut.push_back(static_cast<uint8>(Value >> 8));
+        rOut.push_back(static_cast<uint8>(Value));
+    }
+
+    static void WriteBE32(std::vector<uint8>& rOut, uint32 Value)
+    {
+        rOut.push_back(static_cast<uint8>(Value >> 24));
+        rOut.push_back(static_cast<uint8>(Value >> 16));
+        rOut.push_back(static_cast<uint8>(Value >> 8));
+        rOut.push_back(static_cast<uint8>(Value));
+    }
+
+private:
+    void CompileFlat(CStructProperty* pStruct);
+    uint32 CompileStruct(CStructProperty* pStruct);
+    SOp MakeOp(IProperty* pProperty) const;
+};
+
+#endif // CSCRIPTPROPERTYPLAN_H
@@ -27,6 +27,23 @@ CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, cons
 
     // Post load initialization
     mSourceFile = kInFilePath;
+    PostLoad();
+}
+
+// Load from an archive other than the source XML, such as a template cache entry
+CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, const TString& kInFilePath, IArchive& rSource)
+    : mSourceFile(kInFilePath)
+    , mObjectID(InObjectID)
+    , mpGame(pInGame)
+{
+    Serialize(rSource);
+    PostLoad();
+}
+
+CScriptTemplate::~CScriptTemplate() = default;
+
+void CScriptTemplate::PostLoad()
+{
     mpProperties->Initialize(nullptr, this, 0);
 
     if (!mNameIDString.IsEmpty())               mpNameProperty = TPropCast<CStringProperty>( mpProperties->ChildByIDString(mNameIDString) );
@@ -37,8 +54,6 @@ CScriptTemplate::CScriptTemplate(CGameTemplate* pInGame, uint32 InObjectID, cons
     if (!mLightParametersIDString.IsEmpty())    mpLightParametersProperty = TPropCast<CStructProperty>( mpProperties->ChildByIDString(mLightParametersIDString) );
 }
 
-CScriptTemplate::~CScriptTemplate() = default;
-
 void CScriptTemplate::Serialize(IArchive& Arc)
 {
     Arc << SerialParameter("Modules", mModules, SH_Optional)
@@ -133,7 +148,7 @@ int32 CScriptTemplate::CheckVolumeConditions(CScriptObject *pObj, bool LogErrors
         IProperty* pProp = pObj->Template()->Properties()->ChildByIDString(PropID);
 
         // Get value of the condition test property (only boolean, integral, and enum types supported)
-        void* pData = pObj->PropertyData();
+        void* pData = pObj->ReadOnlyPropertyData();
         int Val = 0;
 
         switch (pProp->Type())
@@ -220,7 +235,7 @@ CResource* CScriptTemplate::FindDisplayAsset(void* pPropertyData, uint32& rOutCh
                 ASSERT(pProp->Type() == EPropertyType::Asset);
                 auto* pAsset = TPropCast<CAssetProperty>(pProp);
                 const CAssetID ID = pAsset->Value(pPropertyData);
-                if (CResourceEntry* pEntry = gpResourceStore->FindEntry(ID))
+                if (CResourceEntry* pEntry = ActiveResourceStore()->FindEntry(ID))
                     pRes = pEntry->Load();
             }
         }
@@ -249,7 +264,7 @@ CCollisionMeshGroup* CScriptTemplate::FindCollision(void* pPropertyData)
         // File
         if (asset.AssetSource == SEditorAsset::EAssetSource::File)
         {
-            pRes = gpResourceStore->LoadResource(asset.AssetLocation);
+            pRes = ActiveResourceStore()->LoadResource(asset.AssetLocation);
         }
         else // Property
         {
@@ -258,7 +273,7 @@ CCollisionMeshGroup* CScriptTemplate::FindCollision(void* pPropertyData)
             if (pProp->Type() == EPropertyType::Asset)
             {
                 auto* pAsset = TPropCast<CAssetProperty>(pProp);
-                pRes = gpResourceStore->LoadResource( pAsset->Value(pPropertyData), EResourceType::DynamicCollision );
+                pRes = ActiveResourceStore()->LoadResource( pAsset->Value(pPropertyData), EResourceType::DynamicCollision );
             }
         }
 
@@ -270,6 +285,41 @@ CCollisionMeshGroup* CScriptTemplate::FindCollision(void* pPropertyData)
     return nullptr;
 }
 
+// ************ COOKED DATA LAYOUT ************
+const CScriptPropertyPlan& CScriptTemplate::PropertyPlan()
+{
+    // Script layers can be loaded on several threads at once
+    std::lock_guard Lock(mPropertyPlanMutex);
+
+    if (!mpPropertyPlan)
+        mpPropertyPlan = std::make_unique<CScriptPropertyPlan>(mpProperties.get());
+
+    return *mpPropertyPlan;
+}
+
+void CScriptTemplate::InvalidatePropertyPlan()
+{
+    {
+        std::lock_guard Lock(mPropertyPlanMutex);
+        mpPropertyPlan.reset();
+    }
+
+    // The shared defaults were laid out for the old properties too. Objects that still share them
+    // keep the old block alive until they detach; new objects get a freshly built one.
+    std::lock_guard Lock(mDefaultPropertyDataMutex);
+    mpDefaultPropertyData.reset();
+}
+
+std::shared_ptr<CPropertyBlock> CScriptTemplate::DefaultPropertyData()
+{
+    // Objects can be created on several threads at once while loading layers
+    std::lock_guard Lock(mDefaultPropertyDataMutex);
+
+    if (!mpDefaultPropertyData)
+        mpDefaultPropertyData = std::make_shared<CPropertyBlock>(mpProperties.get());
+
+    return mpDefaultPropertyData;
+}
 
 // ************ OBJECT TRACKING ************
 uint32 CScriptTemplate::NumObjects() const
@@ -284,11 +334,13 @@ const std::list<CScriptObject*>& CScriptTemplate::ObjectList() const
 
 void CScriptTemplate::AddObject(CScriptObject *pObject)
 {
+    std::lock_guard Lock(mObjectListMutex);
     mObjectList.push_back(pObject);
 }
 
 void CScriptTemplate::RemoveObject(const CScriptObject *pObject)
 {
+    std::lock_guard Lock(mObjectListMutex);
     const auto iter = std::find_if(mObjectList.cbegin(), mObjectList.cend(),
                                    [pObject](const auto* ptr) { return ptr == pObject; });
 
@@ -2,12 +2,16 @@
 #define CSCRIPTTEMPLATE_H
 
 #include "Core/Resource/Script/Property/Properties.h"
+#include "Core/Resource/Script/CPropertyBlock.h"
+#include "Core/Resource/Script/CScriptPropertyPlan.h"
 #include "EVolumeShape.h"
 #include "Core/Resource/Model/CModel.h"
 #include "Core/Resource/Collision/CCollisionMeshGroup.h"
 #include <Common/BasicTypes.h>
 #include <Common/CFourCC.h>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 class CGameTemplate;
@@ -76,6 +80,14 @@ public:
 private:
     std::vector<TString> mModules;
     std::unique_ptr<CStructProperty> mpProperties;
+
+    // Compiled layout used to read/write cooked instances; built on first use
+    std::unique_ptr<CScriptPropertyPlan> mpPropertyPlan;
+    std::mutex mPropertyPlanMutex;
+
+    // Default property values, shared by objects that haven't modified any properties yet
+    std::shared_ptr<CPropertyBlock> mpDefaultPropertyData;
+    std::mutex mDefaultPropertyDataMutex;
     std::vector<SEditorAsset> mAssets;
     std::vector<SAttachment> mAttachments;
 
@@ -102,6 +114,9 @@ private:
     CGameTemplate* mpGame;
     std::list<CScriptObject*> mObjectList;
 
+    // Objects can be created on several threads at once while loading script layers
+    std::mutex mObjectListMutex;
+
     CStringProperty* mpNameProperty = nullptr;
     CVectorProperty* mpPositionProperty = nullptr;
     CVectorProperty* mpRotationProperty = nullptr;
@@ -132,6 +147,8 @@ public:
     explicit CScriptTemplate(CGameTemplate *pGame);
     // New constructor
     CScriptTemplate(CGameTemplate* pGame, uint32 ObjectID, const TString& kFilePath);
+    // Load from an already opened archive, such as a template cache entry
+    CScriptTemplate(CGameTemplate* pGame, uint32 ObjectID, const TString& kFilePath, IArchive& rSource);
     ~CScriptTemplate();
     void Serialize(IArchive& rArc);
     void Save(bool Force = false);
@@ -168,6 +185,11 @@ public:
     void MarkDirty()                 { mDirty = true; }
     bool IsDirty() const             { return mDirty || mpProperties->IsDirty(); }
 
+    // Cooked Data Layout
+    const CScriptPropertyPlan& PropertyPlan();
+    void InvalidatePropertyPlan();
+    std::shared_ptr<CPropertyBlock> DefaultPropertyData();
+
     // Object Tracking
     uint32 NumObjects() const;
     const std::list<CScriptObject*>& ObjectList() const;
@@ -176,6 +198,7 @@ public:
     void SortObjects();
 
 private:
+    void PostLoad();
     int32 CheckVolumeConditions(CScriptObject *pObj, bool LogErrors);
 };
 
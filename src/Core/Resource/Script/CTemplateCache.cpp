@@ -0,0 +1,181 @@
+#include "CTemplateCache.h"
+#include "Core/GameProject/CResourceStore.h"
+#include <Common/CFourCC.h>
+#include <Common/FileIO.h>
+#include <Common/FileUtil.h>
+#include <Common/Log.h>
+#include <Common/Hash/CFNV1A.h>
+#include <Common/Serialization/Binary.h>
+
+namespace
+{
+/** Bump this whenever the layout of serialized template data changes */
+constexpr uint32 kCacheVersion = 2;
+}
+
+CTemplateCache::CTemplateCache(TString CachePath, TString SourceDir)
+    : mCachePath(std::move(CachePath))
+    , mSourceDir(std::move(SourceDir))
+{
+}
+
+bool CTemplateCache::Load()
+{
+    mEntries.clear();
+    mDirty = false;
+
+    std::vector<uint8> FileData;
+    if (!FileUtil::Exists(mCachePath) || !FileUtil::LoadFileToBuffer(mCachePath, FileData))
+        return false;
+
+    CMemoryInStream Input(FileData.data(), FileData.size(), EEndian::LittleEndian);
+
+    if (FileData.size() < 16 ||
+        Input.ReadLong() != FOURCC('TCAC') ||
+        Input.ReadLong() != kCacheVersion ||
+        Input.ReadLong() != IArchive::skCurrentArchiveVersion)
+    {
+        debugf("Discarding outdated template cache: %s", *mCachePath);
+        return false;
+    }
+
+    mGame = static_cast<EGame>(Input.ReadLong());
+    const uint32 NumEntries = Input.ReadLong();
+
+    for (uint32 EntryIdx = 0; EntryIdx < NumEntries && !Input.EoF(); EntryIdx++)
+    {
+        const TString Path = Input.ReadString();
+        SEntry& rEntry = mEntries[Path];
+        rEntry.SourceModifiedTime = Input.ReadLongLong();
+        rEntry.SourceSize = Input.ReadLongLong();
+        rEntry.SourceHash = Input.ReadLongLong();
+        rEntry.Data.resize(Input.ReadLong());
+        Input.ReadBytes(rEntry.Data.data(), rEntry.Data.size());
+    }
+
+    return true;
+}
+
+bool CTemplateCache::Save()
+{
+    std::vector<char> FileData;
+
+    {
+        CVectorOutStream Output(&FileData, EEndian::LittleEndian);
+        Output.WriteLong(FOURCC('TCAC'));
+        Output.WriteLong(kCacheVersion);
+        Output.WriteLong(IArchive::skCurrentArchiveVersion);
+        Output.WriteLong(static_cast<uint32>(mGame));
+        Output.WriteLong(mEntries.size());
+
+        for (const auto& [Path, Entry] : mEntries)
+        {
+            Output.WriteString(Path);
+            Output.WriteLongLong(Entry.SourceModifiedTime);
+            Output.WriteLongLong(Entry.SourceSize);
+            Output.WriteLongLong(Entry.SourceHash);
+            Output.WriteLong(Entry.Data.size());
+            Output.WriteBytes(Entry.Data.data(), Entry.Data.size());
+        }
+    }
+
+    CFileOutStream File(mCachePath, EEndian::LittleEndian);
+
+    if (!File.IsValid())
+    {
+        debugf("Unable to write template cache: %s", *mCachePath);
+        return false;
+    }
+
+    File.WriteBytes(FileData.data(), FileData.size());
+    mDirty = false;
+    return true;
+}
+
+void CTemplateCache::SaveIfDirty()
+{
+    // Installed copies may have a read-only templates directory; we just go without a cache then
+    if (mDirty && gTemplatesWritable)
+        Save();
+}
+
+bool CTemplateCache::HasValidEntry(const TString& kSourcePath)
+{
+    const auto Iter = mEntries.find(kSourcePath);
+    return Iter != mEntries.end() && ValidateEntry(Iter);
+}
+
+bool CTemplateCache::ReadEntry(const TString& kSourcePath, const std::function<void(IArchive&)>& kSerialize)
+{
+    const auto Iter = mEntries.find(kSourcePath);
+
+    if (Iter == mEntries.end() || !ValidateEntry(Iter))
+        return false;
+
+    const SEntry& rkEntry = Iter->second;
+    CMemoryInStream Input(rkEntry.Data.data(), rkEntry.Data.size(), EEndian::LittleEndian);
+    CBinaryReader Reader(&Input, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, mGame));
+    kSerialize(Reader);
+    return true;
+}
+
+void CTemplateCache::WriteEntry(const TString& kSourcePath, const std::function<void(IArchive&)>& kSerialize)
+{
+    const TString SourcePath = mSourceDir + kSourcePath;
+    SEntry& rEntry = mEntries[kSourcePath];
+    rEntry.SourceModifiedTime = FileUtil::LastModifiedTime(SourcePath);
+    rEntry.SourceHash = HashFile(SourcePath, rEntry.SourceSize);
+    rEntry.Data.clear();
+    rEntry.Validated = true;
+
+    {
+        CVectorOutStream Output(&rEntry.Data, EEndian::LittleEndian);
+        CBinaryWriter Writer(&Output, CSerialVersion(IArchive::skCurrentArchiveVersion, 0, mGame));
+        kSerialize(Writer);
+    }
+
+    mDirty = true;
+}
+
+bool CTemplateCache::ValidateEntry(std::map<TString, SEntry>::iterator Iter)
+{
+    SEntry& rEntry = Iter->second;
+
+    if (rEntry.Validated)
+        return true;
+
+    // Checking the timestamp is cheap. If it changed, the file may have just been touched
+    // (e.g. by a checkout), so compare hashes before throwing the entry away.
+    const TString SourcePath = mSourceDir + Iter->first;
+    const uint64 ModifiedTime = FileUtil::LastModifiedTime(SourcePath);
+
+    if (ModifiedTime != rEntry.SourceModifiedTime || FileUtil::FileSize(SourcePath) != rEntry.SourceSize)
+    {
+        uint64 Size = 0;
+        const uint64 Hash = HashFile(SourcePath, Size);
+
+        if (Hash != rEntry.SourceHash || Size != rEntry.SourceSize)
+        {
+            mEntries.erase(Iter);
+            mDirty = true;
+            return false;
+        }
+
+        rEntry.SourceModifiedTime = ModifiedTime;
+        mDirty = true;
+    }
+
+    rEntry.Validated = true;
+    return true;
+}
+
+uint64 CTemplateCache::HashFile(const TString& kPath, uint64& rOutSize)
+{
+    std::vector<uint8> Data;
+    FileUtil::LoadFileToBuffer(kPath, Data);
+    rOutSize = Data.size();
+
+    CFNV1A Hash(CFNV1A::EHashLength::k64Bit);
+    Hash.HashData(Data.data(), Data.size());
+    return Hash.GetHash64();
+}
@@ -0,0 +1,78 @@
+#ifndef CTEMPLATECACHE_H
+#define CTEMPLATECACHE_H
+
+#include <Common/BasicTypes.h>
+#include <Common/EGame.h>
+#include <Common/TString.h>
+#include <Common/Serialization/IArchive.h>
+#include <functional>
+#include <map>
+#include <vector>
+
+/**
+ * Binary cache of compiled template data.
+ * Each entry holds the binary serialized form of one template XML, stamped with the
+ * modification time, size and hash of the source file it was compiled from. Entries are
+ * validated against their source file when they're read, and stale entries are discarded
+ * so the caller falls back to parsing the XML and writes a fresh entry.
+ * The whole cache is stored in a single file and loaded with a single read.
+ */
+class CTemplateCache
+{
+    struct SEntry
+    {
+        uint64 SourceModifiedTime = 0;
+        uint64 SourceSize = 0;
+        uint64 SourceHash = 0;
+        std::vector<char> Data;
+
+        /** Whether the entry has already been checked against its source file this session */
+        bool Validated = false;
+    };
+
+    /** Path of the cache file */
+    TString mCachePath;
+
+    /** Directory that entry paths are relative to */
+    TString mSourceDir;
+
+    /** Game that the cached templates belong to; Invalid for game-independent data */
+    EGame mGame = EGame::Invalid;
+
+    /** Entries, keyed by source path relative to mSourceDir */
+    std::map<TString, SEntry> mEntries;
+
+    bool mDirty = false;
+
+public:
+    CTemplateCache(TString CachePath, TString SourceDir);
+
+    /** Load the cache file from disk. Returns false if it's missing or was written by a different version. */
+    bool Load();
+
+    /** Write the cache file to disk */
+    bool Save();
+
+    /** Write the cache file to disk if any entries have changed since it was loaded */
+    void SaveIfDirty();
+
+    /** Returns whether there is an up-to-date entry for the given source file */
+    bool HasValidEntry(const TString& kSourcePath);
+
+    /** Deserialize the entry for the given source file. Returns false if there is no valid entry. */
+    bool ReadEntry(const TString& kSourcePath, const std::function<void(IArchive&)>& kSerialize);
+
+    /** Serialize a new entry for the given source file, replacing any existing entry */
+    void WriteEntry(const TString& kSourcePath, const std::function<void(IArchive&)>& kSerialize);
+
+    void SetGame(EGame Game)             { if (mGame != Game) { mGame = Game; mEntries.clear(); mDirty = true; } }
+    EGame Game() const                   { return mGame; }
+    uint32 NumEntries() const            { return mEntries.size(); }
+    bool IsDirty() const                 { return mDirty; }
+
+private:
+    bool ValidateEntry(std::map<TString, SEntry>::iterator Iter);
+    static uint64 HashFile(const TString& kPath, uint64& rOutSize);
+};
+
+#endif // CTEMPLATECACHE_H
@@ -1,7 +1,10 @@
 #include "NGameList.h"
+#include "Core/CJobPool.h"
 #include <Common/Log.h>
 
 #include <array>
+#include <mutex>
+#include <vector>
 
 namespace NGameList
 {
@@ -39,6 +42,9 @@ std::array<SGameInfo, static_cast<size_t>(EGame::Max)> gGameList;
 /** Whether the game list has been loaded */
 bool gLoadedGameList = false;
 
+/** Guards lazy loading of the game list and game templates */
+std::mutex gGameListMutex;
+
 /** Returns whether a game template has been loaded or not */
 bool IsGameTemplateLoaded(EGame Game)
 {
@@ -112,8 +118,37 @@ void SaveGameList()
 /** Load all game templates into memory */
 void LoadAllGameTemplates()
 {
+    std::vector<CGameTemplate*> GameTemplates;
+
+    for (int GameIdx = 0; GameIdx < static_cast<int>(EGame::Max); GameIdx++)
+    {
+        if (CGameTemplate* pGameTemplate = GetGameTemplate(static_cast<EGame>(GameIdx)))
+            GameTemplates.push_back(pGameTemplate);
+    }
+
+    // Parse every game's XMLs at once so the job pool stays busy, then load each game in order
+    CJobPool::Global().ParallelFor(GameTemplates.size(), 1, [&GameTemplates](size_t Begin, size_t End)
+    {
+        for (size_t GameIdx = Begin; GameIdx < End; GameIdx++)
+            GameTemplates[GameIdx]->PreparseTemplates();
+    });
+
+    for (CGameTemplate* pGameTemplate : GameTemplates)
+        pGameTemplate->LoadAllTemplates();
+}
+
+/** Compile all templates for every game into their binary template caches */
+void CompileTemplateCaches()
+{
+    LoadAllGameTemplates();
+
     for (int GameIdx = 0; GameIdx < static_cast<int>(EGame::Max); GameIdx++)
-        GetGameTemplate(static_cast<EGame>(GameIdx));
+    {
+        const auto Game = static_cast<EGame>(GameIdx);
+
+        if (IsGameTemplateLoaded(Game))
+            GetGameTemplate(Game)->SaveTemplateCache();
+    }
 }
 
 /** Resave templates. If ForceAll is false, only saves templates that have been modified. */
@@ -140,6 +175,7 @@ CGameTemplate* GetGameTemplate(EGame Game)
     }
 
     ASSERT(Game >= static_cast<EGame>(0) && Game < EGame::Max);
+    std::lock_guard Lock(gGameListMutex);
 
     // Initialize the game list, if it hasn't been loaded yet.
     if (!gLoadedGameList)
@@ -166,6 +202,10 @@ void Shutdown()
 {
     for (int GameIdx = 0; GameIdx < static_cast<int>(EGame::Max); GameIdx++)
     {
+        // Keep any templates that were compiled this session for the next launch
+        if (gGameList[GameIdx].pTemplate)
+            gGameList[GameIdx].pTemplate->SaveTemplateCache();
+
         gGameList[GameIdx].Name = "";
         gGameList[GameIdx].TemplatePath = "";
         gGameList[GameIdx].pTemplate = nullptr;
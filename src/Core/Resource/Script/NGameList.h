@@ -6,9 +6,10 @@
 namespace NGameList
 {
 
-/** Load all game templates into memory
- *  This normally isn't necessary to call, as game templates will be lazy-loaded the
- *  first time they are requested.
+/** Load all game templates into memory, including every script and property template
+ *  This normally isn't necessary to call, as game templates and their sub-templates will be
+ *  lazy-loaded the first time they are requested. Call it before operations that need to
+ *  see every property in every game.
  */
 void LoadAllGameTemplates();
 
@@ -18,6 +19,11 @@ void LoadGameList();
 /** Save the game list back out to a file */
 void SaveGameList();
 
+/** Compile all templates for every game into their binary template caches.
+ *  The caches are also filled in as templates are used, so this is only needed to build them ahead of time.
+ */
+void CompileTemplateCaches();
+
 /** Resave templates. If ForceAll is false, only saves templates that have been modified. */
 void SaveTemplates(bool ForceAll = false);
 
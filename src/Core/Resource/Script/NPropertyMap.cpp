@@ -1,5 +1,6 @@
 #include "NPropertyMap.h"
 #include "NGameList.h"
+#include "CTemplateCache.h"
 #include <Common/NBasics.h>
 #include <Common/Serialization/XML.h>
 
@@ -12,6 +13,10 @@ namespace
 constexpr char gpkLegacyMapPath[] = "templates/PropertyMapLegacy.xml";
 constexpr char gpkMapPath[] = "templates/PropertyMap.xml";
 
+/** Path to the binary cache of the property map, and the map's path relative to it */
+constexpr char gpkMapCachePath[] = "templates/PropertyMap.cache";
+constexpr char gpkMapCacheEntry[] = "PropertyMap.xml";
+
 /** Whether to do name lookups from the legacy map */
 constexpr bool gkUseLegacyMapForNameLookups = false;
 
@@ -158,9 +163,21 @@ void LoadMap()
     }
     else
     {
-        CXMLReader Reader(gDataDir + gpkMapPath);
-        ASSERT(Reader.IsValid());
-        Reader << SerialParameter("PropertyMap", gNameMap, SH_HexDisplay);
+        const auto SerializeMap = [](IArchive& Arc) { Arc << SerialParameter("PropertyMap", gNameMap, SH_HexDisplay); };
+
+        CTemplateCache Cache(gDataDir + gpkMapCachePath, TString(gDataDir + gpkMapPath).GetFileDirectory());
+        Cache.Load();
+
+        if (!Cache.ReadEntry(gpkMapCacheEntry, SerializeMap))
+        {
+            CXMLReader Reader(gDataDir + gpkMapPath);
+            ASSERT(Reader.IsValid());
+            SerializeMap(Reader);
+
+            Cache.WriteEntry(gpkMapCacheEntry, SerializeMap);
+        }
+
+        Cache.SaveIfDirty();
 
         // Iterate over the map and set up the valid flags
         for (auto& [key, value] : gNameMap)
@@ -86,6 +86,18 @@ public:
         ValueRef(pData) = 0;
     }
 
+    void CopyValue(void* pDstData, void* pSrcData) const override
+    {
+        // Items are copied one by one so that strings, nested arrays, etc. are deep copied
+        const uint32 Count = ArrayCount(pSrcData);
+        Resize(pDstData, Count);
+
+        for (uint32 ItemIdx = 0; ItemIdx < Count; ItemIdx++)
+        {
+            mpItemArchetype->CopyValue(ItemPointer(pDstData, ItemIdx), ItemPointer(pSrcData, ItemIdx));
+        }
+    }
+
     bool CanHaveDefault() const override
     {
         return true;
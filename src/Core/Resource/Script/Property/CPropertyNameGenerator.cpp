@@ -4,9 +4,150 @@
 #include "Core/Resource/Script/NPropertyMap.h"
 #include <Common/Hash/CCRC32.h>
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <thread>
 
+// Size of the valid ID filter, as a power of two; with a few thousand valid IDs, well under 1% of random IDs get through
+constexpr uint32 kIDFilterBits = 24;
+
+/** Standard reflected CRC32 table, used to shift hashes past runs of zero bytes */
+static const std::array<uint32, 256> gkCRCTable = []()
+{
+    std::array<uint32, 256> Table{};
+
+    for (uint32 Byte = 0; Byte < 256; Byte++)
+    {
+        uint32 Value = Byte;
+
+        for (int Bit = 0; Bit < 8; Bit++)
+            Value = (Value & 1) ? (Value >> 1) ^ 0xEDB88320 : (Value >> 1);
+
+        Table[Byte] = Value;
+    }
+
+    return Table;
+}();
+
+// ************ CPropertyNameHashKernel ************
+uint32 CPropertyNameHashKernel::ShiftZeroBytes(uint32 Hash, uint32 NumBytes)
+{
+    for (uint32 ByteIdx = 0; ByteIdx < NumBytes; ByteIdx++)
+        Hash = (Hash >> 8) ^ gkCRCTable[Hash & 0xFF];
+
+    return Hash;
+}
+
+uint32 CPropertyNameHashKernel::HashString(const TString& rkString)
+{
+    CCRC32 Hash;
+    Hash.Hash(*rkString);
+    return Hash.Digest();
+}
+
+void CPropertyNameHashKernel::Init(const std::vector<TString>& rkWords, const std::vector<TString>& rkTypeNames,
+                                   const TString& rkPrefix, const TString& rkSuffix, ENameCasing Casing)
+{
+    // Hashes are affine in the starting state, so the constant for a string S is
+    // Hash(S) ^ Shift(Hash(""), Length(S)); that way, Hash(A + S) = Shift(Hash(A), Length(S)) ^ Constant(S).
+    const uint32 EmptyHash = HashString("");
+
+    auto Constant = [EmptyHash](const TString& rkString)
+    {
+        return HashString(rkString) ^ ShiftZeroBytes(EmptyHash, rkString.Size());
+    };
+
+    mPrefixHash = HashString(rkPrefix);
+    mLengths.clear();
+    mTailLengths.clear();
+
+    std::vector<uint32> TailConstants;
+
+    for (const TString& rkType : rkTypeNames)
+    {
+        const TString Tail = rkSuffix + rkType;
+        mTailLengths.push_back(Tail.Size());
+        TailConstants.push_back(Constant(Tail));
+    }
+
+    const uint32 NumTypes = rkTypeNames.size();
+
+    for (int PosIdx = 0; PosIdx < 2; PosIdx++)
+    {
+        const bool IsFirstWord = (PosIdx == 0);
+        SWordPosition& rPos = mPositions[PosIdx];
+        rPos.WordConstants.resize(rkWords.size());
+        rPos.WordLengths.resize(rkWords.size());
+        rPos.LengthIndices.resize(rkWords.size());
+        rPos.TailConstants.resize(rkWords.size() * NumTypes);
+
+        for (size_t WordIdx = 0; WordIdx < rkWords.size(); WordIdx++)
+        {
+            TString Word = rkWords[WordIdx];
+
+            // For camelcase, hash the first letter of the first word as lowercase
+            if (IsFirstWord && Casing == ENameCasing::camelCase && !Word.IsEmpty())
+                Word[0] = TString::CharToLower(Word[0]);
+
+            // Add an underscore for snake case
+            else if (!IsFirstWord && Casing == ENameCasing::Snake_Case)
+                Word = TString("_") + Word;
+
+            const uint32 WordConstant = Constant(Word);
+            rPos.WordConstants[WordIdx] = WordConstant;
+            rPos.WordLengths[WordIdx] = static_cast<uint8>(Word.Size());
+
+            auto LengthIt = std::find(mLengths.begin(), mLengths.end(), Word.Size());
+
+            if (LengthIt == mLengths.end())
+                LengthIt = mLengths.insert(mLengths.end(), Word.Size());
+
+            rPos.LengthIndices[WordIdx] = static_cast<uint8>(std::distance(mLengths.begin(), LengthIt));
+
+            for (uint32 TypeIdx = 0; TypeIdx < NumTypes; TypeIdx++)
+            {
+                rPos.TailConstants[WordIdx * NumTypes + TypeIdx] =
+                        ShiftZeroBytes(WordConstant, mTailLengths[TypeIdx]) ^ TailConstants[TypeIdx];
+            }
+        }
+    }
+}
+
+void CPropertyNameHashKernel::PrepareLastWords(uint32 StemHash, std::vector<uint32>& rOutRows) const
+{
+    // Shift the stem past every possible word length, then past every tail length
+    const uint32 NumTypes = mTailLengths.size();
+    rOutRows.resize(mLengths.size() * NumTypes);
+
+    for (size_t LengthIdx = 0; LengthIdx < mLengths.size(); LengthIdx++)
+    {
+        const uint32 WordShifted = ShiftZeroBytes(StemHash, mLengths[LengthIdx]);
+
+        for (uint32 TypeIdx = 0; TypeIdx < NumTypes; TypeIdx++)
+            rOutRows[LengthIdx * NumTypes + TypeIdx] = ShiftZeroBytes(WordShifted, mTailLengths[TypeIdx]);
+    }
+}
+
+void CPropertyNameHashKernel::HashLastWords(const std::vector<uint32>& rkRows, bool IsFirstWord, uint32 FirstWord, uint32 NumWords, uint32* pOutIDs) const
+{
+    const SWordPosition& rkPos = Position(IsFirstWord);
+    const uint32 NumTypes = mTailLengths.size();
+
+    for (uint32 WordIdx = FirstWord; WordIdx < FirstWord + NumWords; WordIdx++)
+    {
+        const uint32* pkRow = &rkRows[rkPos.LengthIndices[WordIdx] * NumTypes];
+        const uint32* pkTail = &rkPos.TailConstants[WordIdx * NumTypes];
+
+        for (uint32 TypeIdx = 0; TypeIdx < NumTypes; TypeIdx++)
+            pOutIDs[TypeIdx] = pkRow[TypeIdx] ^ pkTail[TypeIdx];
+
+        pOutIDs += NumTypes;
+    }
+}
+
+// ************ CPropertyNameGenerator ************
+
 /** Default constructor */
 CPropertyNameGenerator::CPropertyNameGenerator() = default;
 
@@ -73,13 +214,31 @@ void CPropertyNameGenerator::Generate(const SPropertyNameGenerationParameters& r
     // If we haven't loaded the word list yet, load it.
     Warmup();
 
+    // Set up the hashing kernel and make sure it agrees with CCRC32 before relying on it
+    mKernel.Init(mWords, mTypeNames, rkParams.Prefix, rkParams.Suffix, rkParams.Casing);
+    BuildValidIDFilter();
+
+    if (!ValidateKernel(rkParams))
+    {
+        errorf("Property name generation failed; batched name hashes don't match CCRC32");
+        mIsRunning = false;
+        return;
+    }
+
     // Calculate the number of steps involved in this task.
     const size_t kNumWords = mWords.size();
     const int kMaxWords = rkParams.MaxWords;
-    TotalTests = 1;
+    TotalTests = 0;
+    TotalTestsDone = 0;
 
-    for (int i = 0; i < kMaxWords; i++)
-        TotalTests *= kNumWords;
+    // One test per name; names can have up to kMaxWords words
+    uint64 NumNames = 1;
+
+    for (int NumNameWords = 1; NumNameWords <= kMaxWords; NumNameWords++)
+    {
+        NumNames *= kNumWords;
+        TotalTests += NumNames;
+    }
 
     pProgress->SetOneShotTask("Generating property names");
     pProgress->Report(0, TotalTests);
@@ -114,171 +273,235 @@ void CPropertyNameGenerator::GenerateTask(const SPropertyNameGenerationParameter
                                           SPropertyNameGenerationTaskParameters taskParams,
                                           IProgressNotifier* pProgress)
 {
-    const size_t kNumWords = mWords.size();
-    const int kMaxWords = rkParams.MaxWords;
+    const uint32 kNumWords = mWords.size();
+    const uint32 kNumTypes = mTypeNames.size();
+    const uint32 kMaxWords = rkParams.MaxWords;
+
+    // Last words are hashed and tested in batches of this many
+    constexpr uint32 kBatchSize = 1024;
 
     // Configure params needed to run the name generation!
     bool WriteToLog = rkParams.PrintToLog;
     bool SaveResults = true;
     uint64 TestsDone = 0;
+    uint64 TestsReported = 0;
 
-    // The prefix only needs to be hashed this one time
-    CCRC32 PrefixHash;
-    PrefixHash.Hash( *rkParams.Prefix );
+    std::vector<uint32> IDs(kBatchSize * kNumTypes);
+    std::vector<uint32> Rows;
 
-    // Use a stack to keep track of the current word we are on. We can use this
-    // to cache the hash of a word and then re-use it later instead of recaculating
-    // the same hashes over and over. Init the stack with the first word.
-    struct SWordCache
+    // Every name is a "stem" of leading words plus a last word. The stem is advanced like an odometer,
+    // caching the hash after each of its words so that only the words that changed are rehashed.
+    // For each stem, every possible last word is then hashed by the kernel in batches.
+    for (uint32 NumNameWords = 1; NumNameWords <= kMaxWords; NumNameWords++)
     {
-        uint WordIndex;
-        CCRC32 Hash;
-    };
-    std::vector<SWordCache> WordCache;
+        const uint32 StemSize = NumNameWords - 1;
 
-    SWordCache FirstWord { taskParams.StartWord - 1, CCRC32() };
-    WordCache.push_back(FirstWord);
+        // The first word is split up between the tasks; words after it can be anything
+        const uint32 LastStart = (StemSize == 0 ? taskParams.StartWord : 0);
+        const uint32 LastEnd = (StemSize == 0 ? taskParams.EndWord : kNumWords);
 
-    while ( true )
-    {
-        // Increment the current word, handle wrapping back to 0, and update cached hashes as needed.
-        int RecalcIndex = WordCache.size() - 1;
-        WordCache.back().WordIndex++;
+        if (taskParams.StartWord >= taskParams.EndWord || LastStart >= LastEnd)
+            continue;
+
+        std::vector<uint32> WordIndices(NumNameWords, 0);
+        std::vector<uint32> StemHashes(NumNameWords);
+        WordIndices[0] = taskParams.StartWord;
+        StemHashes[0] = mKernel.PrefixHash();
+        uint32 RecalcIndex = 0;
 
-        while (WordCache[RecalcIndex].WordIndex >= kNumWords ||
-               (RecalcIndex == 0 && WordCache[0].WordIndex >= taskParams.EndWord))
+        while (true)
         {
-            if (RecalcIndex == 0)
+            for (; RecalcIndex < StemSize; RecalcIndex++)
+                StemHashes[RecalcIndex + 1] = mKernel.AppendWord(StemHashes[RecalcIndex], WordIndices[RecalcIndex], RecalcIndex == 0);
+
+            mKernel.PrepareLastWords(StemHashes[StemSize], Rows);
+
+            for (uint32 BatchStart = LastStart; BatchStart < LastEnd; BatchStart += kBatchSize)
             {
-                WordCache[0].WordIndex = taskParams.StartWord;
+                const uint32 BatchSize = std::min(kBatchSize, LastEnd - BatchStart);
+                mKernel.HashLastWords(Rows, StemSize == 0, BatchStart, BatchSize, IDs.data());
 
-                SWordCache NewWord { 0, CCRC32() };
-                WordCache.push_back(NewWord);
+                for (uint32 IdIdx = 0; IdIdx < BatchSize * kNumTypes; IdIdx++)
+                {
+                    const uint32 PropertyID = IDs[IdIdx];
+
+                    if (!PassesValidIDFilter(PropertyID))
+                        continue;
+
+                    // Check if this hash is a property ID
+                    const char* pkTypeName = *mTypeNames[IdIdx % kNumTypes];
+
+                    if (IsValidPropertyID(PropertyID, pkTypeName, rkParams))
+                    {
+                        WordIndices[StemSize] = BatchStart + (IdIdx / kNumTypes);
+                        AddGeneratedName(rkParams, WordIndices, PropertyID, pkTypeName, WriteToLog, SaveResults);
+                    }
+                }
+
+                // Check with the progress notifier after every batch. Update the progress
+                // bar and check whether the user has requested to cancel the operation.
+                TestsDone += BatchSize;
+
+                if (TestsDone - TestsReported >= 5000)
+                {
+                    if (pProgress->ShouldCancel())
+                        return;
+
+                    std::unique_lock lock{mWarmupMutex};
+                    auto Value = TotalTestsDone += (TestsDone - TestsReported);
+                    TestsReported = TestsDone;
+                    pProgress->Report(Value, TotalTests);
+                }
             }
-            else
+
+            // Advance to the next stem
+            int WordIdx = static_cast<int>(StemSize) - 1;
+
+            for (; WordIdx >= 0; WordIdx--)
             {
-                WordCache[RecalcIndex].WordIndex = 0;
+                WordIndices[WordIdx]++;
+
+                if (WordIndices[WordIdx] < (WordIdx == 0 ? taskParams.EndWord : kNumWords))
+                    break;
 
-                RecalcIndex--;
-                WordCache[RecalcIndex].WordIndex++;
+                WordIndices[WordIdx] = (WordIdx == 0 ? taskParams.StartWord : 0);
             }
+
+            if (WordIdx < 0)
+                break;
+
+            RecalcIndex = WordIdx;
         }
+    }
 
-        // If we've hit the word limit, break out and end the name generation system.
-        if (WordCache.size() > kMaxWords)
-            break;
+    TotalTestsDone += (TestsDone - TestsReported);
+}
 
-        // Now that all words are updated, calculate the new hashes.
-        CCRC32 LastValidHash = (RecalcIndex > 0 ? WordCache[RecalcIndex - 1].Hash : PrefixHash);
+bool CPropertyNameGenerator::ValidateKernel(const SPropertyNameGenerationParameters& rkParams) const
+{
+    // Hash a few names both ways; one, two and three words, so both word positions are covered
+    const uint32 NumTestWords = std::min<uint32>(mWords.size(), 3);
+    std::vector<uint32> Rows;
+    std::vector<uint32> IDs(mTypeNames.size());
 
-        for (; RecalcIndex < WordCache.size(); RecalcIndex++)
+    for (uint32 NumNameWords = 1; NumNameWords <= NumTestWords; NumNameWords++)
+    {
+        TString Name = rkParams.Prefix;
+        uint32 StemHash = mKernel.PrefixHash();
+
+        for (uint32 WordIdx = 0; WordIdx < NumNameWords; WordIdx++)
         {
-            int Index = WordCache[RecalcIndex].WordIndex;
+            TString Word = mWords[WordIdx];
 
-            // For camelcase, hash the first letter of the first word as lowercase
-            if (RecalcIndex == 0 && rkParams.Casing == ENameCasing::camelCase)
-            {
-                const char* pkWord = *mWords[Index];
-                LastValidHash.Hash( TString::CharToLower( pkWord[0] ) );
-                LastValidHash.Hash( &pkWord[1] );
-            }
-            else
-            {
-                // Add an underscore for snake case
-                if (RecalcIndex > 0 && rkParams.Casing == ENameCasing::Snake_Case)
-                    LastValidHash.Hash("_");
+            if (WordIdx == 0 && rkParams.Casing == ENameCasing::camelCase && !Word.IsEmpty())
+                Word[0] = TString::CharToLower(Word[0]);
+            else if (WordIdx > 0 && rkParams.Casing == ENameCasing::Snake_Case)
+                Word = TString("_") + Word;
 
-                LastValidHash.Hash( *mWords[Index] );
-            }
+            Name += Word;
 
-            WordCache[RecalcIndex].Hash = LastValidHash;
+            if (WordIdx < NumNameWords - 1)
+                StemHash = mKernel.AppendWord(StemHash, WordIdx, WordIdx == 0);
         }
 
-        // We got our hash yay! Now hash the suffix and then we can test with each type name
-        CCRC32 BaseHash = LastValidHash;
-        BaseHash.Hash( *rkParams.Suffix );
+        mKernel.PrepareLastWords(StemHash, Rows);
+        mKernel.HashLastWords(Rows, NumNameWords == 1, NumNameWords - 1, 1, IDs.data());
 
-        for (const auto& typeName : mTypeNames)
+        for (size_t TypeIdx = 0; TypeIdx < mTypeNames.size(); TypeIdx++)
         {
-            CCRC32 FullHash = BaseHash;
-            const char* pkTypeName = *typeName;
-            FullHash.Hash( pkTypeName );
-            const uint32 PropertyID = FullHash.Digest();
+            if (IDs[TypeIdx] != CPropertyNameHashKernel::HashString(Name + rkParams.Suffix + mTypeNames[TypeIdx]))
+                return false;
+        }
+    }
 
-            // Check if this hash is a property ID
-            if (IsValidPropertyID(PropertyID, pkTypeName, rkParams))
-            {
-                std::unique_lock lock{mPropertyCheckMutex};
+    return true;
+}
 
-                SGeneratedPropertyName PropertyName;
-                NPropertyMap::RetrieveXMLsWithProperty(PropertyID, pkTypeName, PropertyName.XmlList);
+void CPropertyNameGenerator::BuildValidIDFilter()
+{
+    mValidIDFilter.assign((1 << kIDFilterBits) / 64, 0);
 
-                // Generate a string with the complete name. (We wait to do this until now to avoid needless string allocation)
-                PropertyName.Name = rkParams.Prefix;
+    auto AddID = [this](uint32 ID)
+    {
+        const uint32 Bit = ID >> (32 - kIDFilterBits);
+        mValidIDFilter[Bit / 64] |= (1ULL << (Bit % 64));
+    };
 
-                for (size_t WordIdx = 0; WordIdx < WordCache.size(); WordIdx++)
-                {
-                    const int Index = WordCache[WordIdx].WordIndex;
+    if (!mValidTypePairMap.empty())
+    {
+        for (const auto& [ID, pkType] : mValidTypePairMap)
+            AddID(ID);
+    }
+    else
+    {
+        for (NPropertyMap::CIterator It; It; ++It)
+            AddID(It.ID());
+    }
+}
 
-                    if (WordIdx > 0 && rkParams.Casing == ENameCasing::Snake_Case)
-                    {
-                        PropertyName.Name += "_";
-                    }
+bool CPropertyNameGenerator::PassesValidIDFilter(uint32 ID) const
+{
+    const uint32 Bit = ID >> (32 - kIDFilterBits);
+    return (mValidIDFilter[Bit / 64] & (1ULL << (Bit % 64))) != 0;
+}
 
-                    PropertyName.Name += mWords[Index];
-                }
+void CPropertyNameGenerator::AddGeneratedName(const SPropertyNameGenerationParameters& rkParams, const std::vector<uint32>& rkWordIndices,
+                                              uint32 PropertyID, const char* pkTypeName, bool& rWriteToLog, bool& rSaveResults)
+{
+    std::unique_lock lock{mPropertyCheckMutex};
 
-                if (rkParams.Casing == ENameCasing::camelCase)
-                {
-                    PropertyName.Name[0] = TString::CharToLower( PropertyName.Name[0] );
-                }
+    SGeneratedPropertyName PropertyName;
+    NPropertyMap::RetrieveXMLsWithProperty(PropertyID, pkTypeName, PropertyName.XmlList);
 
-                PropertyName.Name += rkParams.Suffix;
-                PropertyName.Type = pkTypeName;
-                PropertyName.ID = PropertyID;
+    // Generate a string with the complete name. (We wait to do this until now to avoid needless string allocation)
+    PropertyName.Name = rkParams.Prefix;
 
-                if (SaveResults)
-                {
-                    mGeneratedNames.push_back(PropertyName);
+    for (size_t WordIdx = 0; WordIdx < rkWordIndices.size(); WordIdx++)
+    {
+        const uint32 Index = rkWordIndices[WordIdx];
 
-                    // Check if we have too many saved results. This can cause memory issues and crashing.
-                    // If we have too many saved results, then to avoid crashing we will force enable log output.
-                    if (mGeneratedNames.size() > 9999)
-                    {
-                        gpUIRelay->ShowMessageBoxAsync("Warning", "There are over 10,000 results. Results will no longer print to the screen. Check the log for the remaining output.");
-                        WriteToLog = true;
-                        SaveResults = false;
-                    }
-                }
+        if (WordIdx > 0 && rkParams.Casing == ENameCasing::Snake_Case)
+        {
+            PropertyName.Name += "_";
+        }
 
-                // Log this out
-                if ( WriteToLog )
-                {
-                    TString DelimitedXmlList;
+        PropertyName.Name += mWords[Index];
+    }
 
-                    for (const auto& xml : PropertyName.XmlList)
-                    {
-                        DelimitedXmlList += xml + '\n';
-                    }
+    if (rkParams.Casing == ENameCasing::camelCase)
+    {
+        PropertyName.Name[0] = TString::CharToLower( PropertyName.Name[0] );
+    }
 
-                    debugf("%s [%s] : 0x%08X\n%s", *PropertyName.Name, *PropertyName.Type, PropertyName.ID, *DelimitedXmlList);
-                }
-            }
-        }
+    PropertyName.Name += rkParams.Suffix;
+    PropertyName.Type = pkTypeName;
+    PropertyName.ID = PropertyID;
 
-        // Every 5000 tests, check with the progress notifier. Update the progress
-        // bar and check whether the user has requested to cancel the operation.
-        TestsDone++;
+    if (rSaveResults)
+    {
+        mGeneratedNames.push_back(PropertyName);
 
-        if ( (TestsDone % 5000) == 0 )
+        // Check if we have too many saved results. This can cause memory issues and crashing.
+        // If we have too many saved results, then to avoid crashing we will force enable log output.
+        if (mGeneratedNames.size() > 9999)
         {
-            if (pProgress->ShouldCancel())
-                break;
+            gpUIRelay->ShowMessageBoxAsync("Warning", "There are over 10,000 results. Results will no longer print to the screen. Check the log for the remaining output.");
+            rWriteToLog = true;
+            rSaveResults = false;
+        }
+    }
 
-            std::unique_lock lock{mWarmupMutex};
-            auto Value = TotalTestsDone += 5000;
-            pProgress->Report(Value, TotalTests);
+    // Log this out
+    if ( rWriteToLog )
+    {
+        TString DelimitedXmlList;
+
+        for (const auto& xml : PropertyName.XmlList)
+        {
+            DelimitedXmlList += xml + '\n';
         }
+
+        debugf("%s [%s] : 0x%08X\n%s", *PropertyName.Name, *PropertyName.Type, PropertyName.ID, *DelimitedXmlList);
     }
 }
 
@@ -77,6 +77,75 @@ struct SGeneratedPropertyName
     std::set<TString> XmlList;
 };
 
+/**
+ * Batched property ID hashing for the name generator.
+ *
+ * CRC32 is affine in its running state: appending an N byte string to a hash gives the same result
+ * as appending N zero bytes and then XORing in a constant that only depends on the string. So the
+ * kernel precomputes one constant per word, and one per word and type name for the word/suffix/type
+ * tail that ends every name. For a given set of leading words, the IDs of every candidate last word
+ * are then one XOR per type against a small table that only depends on the leading words and the
+ * length of the last word, instead of a byte-by-byte CRC of the word, suffix and type name.
+ */
+class CPropertyNameHashKernel
+{
+    /** Precomputed data for words in one position; camelCase changes the first word, Snake_Case the rest */
+    struct SWordPosition
+    {
+        /** Per word: constant for appending the word to a hash */
+        std::vector<uint32> WordConstants;
+
+        /** Per word and type: word constant shifted past the tail, combined with the tail constant */
+        std::vector<uint32> TailConstants;
+
+        /** Per word: index of the word's length in mLengths */
+        std::vector<uint8> LengthIndices;
+
+        /** Per word: length of the word in bytes */
+        std::vector<uint8> WordLengths;
+    };
+    SWordPosition mPositions[2];
+
+    /** Distinct word lengths, over both positions */
+    std::vector<uint32> mLengths;
+
+    /** Per type: length of the suffix plus type name */
+    std::vector<uint32> mTailLengths;
+
+    /** Hash of the name prefix */
+    uint32 mPrefixHash = 0;
+
+    const SWordPosition& Position(bool IsFirstWord) const   { return mPositions[IsFirstWord ? 0 : 1]; }
+
+public:
+    /** Precompute word and type constants */
+    void Init(const std::vector<TString>& rkWords, const std::vector<TString>& rkTypeNames,
+              const TString& rkPrefix, const TString& rkSuffix, ENameCasing Casing);
+
+    /** Hash of the prefix with the given word appended */
+    uint32 AppendWord(uint32 Hash, uint32 WordIndex, bool IsFirstWord) const
+    {
+        const SWordPosition& rkPos = Position(IsFirstWord);
+        return ShiftZeroBytes(Hash, rkPos.WordLengths[WordIndex]) ^ rkPos.WordConstants[WordIndex];
+    }
+
+    /** Build the per-length table for a set of leading words. Only needs to be done once per set of leading words. */
+    void PrepareLastWords(uint32 StemHash, std::vector<uint32>& rOutRows) const;
+
+    /** Calculate the property IDs of NumWords consecutive last words for every type, word-major */
+    void HashLastWords(const std::vector<uint32>& rkRows, bool IsFirstWord, uint32 FirstWord, uint32 NumWords, uint32* pOutIDs) const;
+
+    /** Accessors */
+    uint32 PrefixHash() const   { return mPrefixHash; }
+    uint32 NumTypes() const     { return mTailLengths.size(); }
+
+    /** Advance a CRC32 state by NumBytes zero bytes, without the constant part of the update */
+    static uint32 ShiftZeroBytes(uint32 Hash, uint32 NumBytes);
+
+    /** Hash a whole string with CCRC32 */
+    static uint32 HashString(const TString& rkString);
+};
+
 /** Generates property names and validates them against know property IDs. */
 class CPropertyNameGenerator
 {
@@ -92,6 +161,15 @@ class CPropertyNameGenerator
     /** Mapping of valid ID/type pairs; if empty, all property names in NPropertyMap are allowed */
     std::unordered_map<uint32, const char*> mValidTypePairMap;
 
+    /**
+     * Bitset of every ID that can pass IsValidPropertyID, indexed by the top bits of the ID.
+     * Nearly all candidate IDs are rejected by one bit test; the few that pass go through the full check.
+     */
+    std::vector<uint64> mValidIDFilter;
+
+    /** Batched hashing kernel for the current generation parameters */
+    CPropertyNameHashKernel mKernel;
+
     /** List of words */
     std::vector<TString> mWords;
 
@@ -114,6 +192,13 @@ class CPropertyNameGenerator
                       SPropertyNameGenerationTaskParameters taskParams,
                       IProgressNotifier* pProgressNotifier);
 
+    bool ValidateKernel(const SPropertyNameGenerationParameters& rkParams) const;
+    void BuildValidIDFilter();
+    bool PassesValidIDFilter(uint32 ID) const;
+
+    void AddGeneratedName(const SPropertyNameGenerationParameters& rkParams, const std::vector<uint32>& rkWordIndices,
+                          uint32 PropertyID, const char* pkTypeName, bool& rWriteToLog, bool& rSaveResults);
+
 public:
     /** Default constructor */
     CPropertyNameGenerator();
@@ -137,6 +222,12 @@ public:
     {
         return mGeneratedNames;
     }
+
+    /** Number of property IDs tested so far in the current run; one per name and type */
+    uint64 NumIDsTested() const
+    {
+        return TotalTestsDone * mTypeNames.size();
+    }
 };
 
 #endif // CPROPERTYNAMEGENERATOR_H
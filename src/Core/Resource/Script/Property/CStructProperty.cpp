@@ -64,6 +64,14 @@ void CStructProperty::RevertToDefault(void* pData) const
     }
 }
 
+void CStructProperty::CopyValue(void* pDstData, void* pSrcData) const
+{
+    for (auto* child : mChildren)
+    {
+        child->CopyValue(pDstData, pSrcData);
+    }
+}
+
 void CStructProperty::SetDefaultFromData(void* pData)
 {
     for (auto* child : mChildren)
@@ -25,6 +25,7 @@ public:
     void Destruct(void* pData) const override;
     bool MatchesDefault(void* pData) const override;
     void RevertToDefault(void* pData) const override;
+    void CopyValue(void* pDstData, void* pSrcData) const override;
     void SetDefaultFromData(void* pData) override;
     const char* HashableTypeName() const override;
     void Serialize(IArchive& rArc) override;
@@ -32,6 +32,7 @@ void IProperty::_ClearChildren()
     }
 
     mChildren.clear();
+    mChildIndexByID.clear();
 }
 
 IProperty::~IProperty()
@@ -214,6 +215,27 @@ void IProperty::Initialize(IProperty* pInParent, CScriptTemplate* pInTemplate, u
         }
     }
 
+    // Script loading looks up every property by ID, so index larger structs by ID.
+    // Small structs are faster to scan than to hash.
+    constexpr size_t kMinChildrenForIDTable = 8;
+    mChildIndexByID.clear();
+
+    if (mChildren.size() >= kMinChildrenForIDTable)
+    {
+        mChildIndexByID.reserve(mChildren.size());
+
+        for (size_t ChildIdx = 0; ChildIdx < mChildren.size(); ChildIdx++)
+        {
+            mChildIndexByID.emplace(mChildren[ChildIdx]->mID, static_cast<uint32>(ChildIdx));
+        }
+
+        // Duplicate IDs can't be represented in the table; leave lookups to the linear search
+        if (mChildIndexByID.size() != mChildren.size())
+        {
+            mChildIndexByID.clear();
+        }
+    }
+
     mFlags |= EPropertyFlag::IsInitialized;
 }
 
@@ -228,6 +250,23 @@ void* IProperty::RawValuePtr(void* pData) const
 
 IProperty* IProperty::ChildByID(uint32 ID) const
 {
+    // Hits are verified against the child itself. Misses are not trusted, since a child's ID or the
+    // child list may have changed since the table was built, so they fall back to the linear search.
+    if (!mChildIndexByID.empty())
+    {
+        const auto Find = mChildIndexByID.find(ID);
+
+        if (Find != mChildIndexByID.cend() && Find->second < mChildren.size())
+        {
+            IProperty* pChild = mChildren[Find->second];
+
+            if (pChild->mID == ID)
+            {
+                return pChild;
+            }
+        }
+    }
+
     const auto iter = std::find_if(mChildren.begin(), mChildren.end(),
                                    [ID](const auto* element) { return element->mID == ID; });
 
@@ -491,7 +530,15 @@ bool IProperty::ConvertType(EPropertyType NewType, IProperty* pNewArchetype)
         pNewProperty->mChildren.push_back(child);
     }
     ASSERT(pNewProperty->mChildren.size() == mChildren.size());
+    pNewProperty->mChildIndexByID = std::move(mChildIndexByID);
     mChildren.clear();
+    mChildIndexByID.clear();
+
+    // The template's compiled cooked data layout refers to the old property
+    if (mpScriptTemplate != nullptr)
+    {
+        mpScriptTemplate->InvalidatePropertyPlan();
+    }
 
     // Create new versions of all sub-instances that inherit from the new property.
     // Note that when the sub-instances complete their conversion, they delete themselves.
@@ -7,6 +7,7 @@
 #include <Common/Math/MathUtil.h>
 
 #include <memory>
+#include <unordered_map>
 
 /** Forward declares */
 class CGameTemplate;
@@ -133,6 +134,11 @@ protected:
     /** Child properties; these appear underneath this property on the UI */
     std::vector<IProperty*> mChildren;
 
+    /** Lookup table from child ID to index in mChildren, used by ChildByID.
+     *  Built on Initialize for properties with enough children to make it worthwhile.
+     *  Only verified hits are used; anything else falls back to a linear search. */
+    std::unordered_map<uint32, uint32> mChildIndexByID;
+
     /** Game this property belongs to */
     EGame mGame;
 
@@ -173,6 +179,7 @@ public:
     virtual void Destruct(void* pData) const = 0;
     virtual bool MatchesDefault(void* pData) const = 0;
     virtual void RevertToDefault(void* pData) const = 0;
+    virtual void CopyValue(void* pDstData, void* pSrcData) const = 0;
     virtual void SerializeValue(void* pData, IArchive& Arc) const = 0;
 
     virtual void PostInitialize() {}
@@ -312,6 +319,7 @@ public:
     void Destruct(void* pData) const override        { ValueRef(pData).~PropType(); }
     bool MatchesDefault(void* pData) const override  { return ValueRef(pData) == mDefaultValue; }
     void RevertToDefault(void* pData) const override { ValueRef(pData) = mDefaultValue; }
+    void CopyValue(void* pDstData, void* pSrcData) const override { ValueRef(pDstData) = ValueRef(pSrcData); }
     void SetDefaultFromData(void* pData) override
     {
         mDefaultValue = ValueRef(pData);
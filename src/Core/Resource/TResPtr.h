@@ -34,7 +34,7 @@ public:
 
         if (rArc.IsReader())
         {
-            CResourceEntry *pEntry = gpResourceStore->FindEntry(ID);
+            CResourceEntry *pEntry = ActiveResourceStore()->FindEntry(ID);
             *this = (pEntry ? pEntry->Load() : nullptr);
         }
     }
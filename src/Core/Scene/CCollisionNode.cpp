@@ -19,7 +19,7 @@ ENodeType CCollisionNode::NodeType()
 void CCollisionNode::AddToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInfo)
 {
     if (!mpCollision) return;
-    if (!rkViewInfo.ViewFrustum.BoxInFrustum(AABox())) return;
+    if (!IsInFrustum(rkViewInfo)) return;
     if (rkViewInfo.GameMode) return;
 
     pRenderer->AddMesh(this, -1, AABox(), false, ERenderCommand::DrawMesh);
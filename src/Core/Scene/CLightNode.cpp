@@ -1,4 +1,5 @@
 #include "CLightNode.h"
+#include "CScene.h"
 #include "Core/Render/CDrawUtil.h"
 #include "Core/Render/CGraphics.h"
 #include "Core/Render/CRenderer.h"
@@ -29,7 +30,7 @@ void CLightNode::AddToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInfo
 {
     if (rkViewInfo.GameMode) return;
 
-    if (rkViewInfo.ViewFrustum.BoxInFrustum(AABox()))
+    if (IsInFrustum(rkViewInfo))
         pRenderer->AddMesh(this, -1, AABox(), false, ERenderCommand::DrawMesh);
 
     if (IsSelected() && mpLight->Type() == ELightType::Custom)
@@ -138,6 +139,9 @@ void CLightNode::PropertyModified(IProperty* pProperty)
 {
     CSceneNode::PropertyModified(pProperty);
 
+    if (CGameArea *pArea = mpScene->ActiveArea())
+        pArea->InvalidateLightGrids();
+
     if (pProperty->Name() == "Position")
         SetPosition( mpLight->Position() );
 }
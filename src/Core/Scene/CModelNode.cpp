@@ -30,7 +30,7 @@ void CModelNode::AddToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInfo
     if (!mpModel)
         return;
  
-    if (!rkViewInfo.ViewFrustum.BoxInFrustum(AABox()))
+    if (!IsInFrustum(rkViewInfo))
         return;
 
     if (rkViewInfo.GameMode)
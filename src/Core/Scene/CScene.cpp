@@ -218,11 +218,23 @@ void CScene::SetActiveArea(CWorld *pWorld, CGameArea *pArea)
     }
 
     // Ensure script nodes have valid positions + build light lists
+    uint32 NumLitNodes = 0;
+    uint32 NumLightsTested = 0;
+
     for (CSceneIterator It(this, ENodeType::Script, true); It; ++It)
     {
         CScriptNode *pScript = static_cast<CScriptNode*>(*It);
         pScript->GeneratePosition();
         pScript->BuildLightList(mpArea);
+
+        NumLitNodes++;
+        NumLightsTested += pScript->NumLightsTested();
+    }
+
+    if (NumLitNodes > 0)
+    {
+        debugf("Light lists: %d nodes, %.2f lights tested per node", NumLitNodes,
+               static_cast<float>(NumLightsTested) / static_cast<float>(NumLitNodes));
     }
 
     const size_t NumLightLayers = mpArea->NumLightLayers();
@@ -282,10 +294,28 @@ void CScene::AddSceneToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInf
     const FShowFlags ShowFlags = rkViewInfo.GameMode ? gkGameModeShowFlags : rkViewInfo.ShowFlags;
     const FNodeFlags NodeFlags = NodeFlagsForShowFlags(ShowFlags);
 
+    // Gather the bounds of every candidate node and cull them against the view frustum in one batch
+    mRenderCandidates.clear();
+    mFrustumCuller.Clear();
+    mFrustumCuller.Reserve(mNumNodes);
+
     for (CSceneIterator It(this, NodeFlags, false); It; ++It)
     {
         if (rkViewInfo.GameMode || It->IsVisible())
-            It->AddToRenderer(pRenderer, rkViewInfo);
+        {
+            mRenderCandidates.push_back(*It);
+            mFrustumCuller.AddBox(It->AABox());
+        }
+    }
+
+    mFrustumCuller.Cull(rkViewInfo.ViewFrustum);
+
+    for (uint32 iNode = 0; iNode < mRenderCandidates.size(); iNode++)
+    {
+        CSceneNode *pNode = mRenderCandidates[iNode];
+        pNode->SetCullResult(mFrustumCuller.IsVisible(iNode));
+        pNode->AddToRenderer(pRenderer, rkViewInfo);
+        pNode->ResetCullResult();
     }
 }
 
@@ -9,6 +9,7 @@
 #include "CStaticNode.h"
 #include "CCollisionNode.h"
 #include "FShowFlags.h"
+#include "Core/Render/CFrustumCuller.h"
 #include "Core/Render/CRenderer.h"
 #include "Core/Render/SViewInfo.h"
 #include "Core/Resource/Area/CGameArea.h"
@@ -43,6 +44,10 @@ class CScene
     std::unordered_map<uint32, CSceneNode*> mNodeMap;
     std::unordered_map<uint32, CScriptNode*> mScriptMap;
 
+    // Rendering
+    CFrustumCuller mFrustumCuller;
+    std::vector<CSceneNode*> mRenderCandidates;
+
 public:
     CScene();
     ~CScene();
@@ -116,9 +116,19 @@ void CSceneNode::LoadModelMatrix()
     CGraphics::UpdateMVPBlock();
 }
 
+bool CSceneNode::IsInFrustum(const SViewInfo& rkViewInfo) const
+{
+    // Use the result of the scene's culling pass if we have one, otherwise test our own bounds
+    if (mCullResult != -1)
+        return mCullResult == 1;
+
+    return rkViewInfo.ViewFrustum.BoxInFrustum(AABox());
+}
+
 void CSceneNode::BuildLightList(CGameArea *pArea)
 {
     mLightCount = 0;
+    mNumLightsTested = 0;
     mAmbientColor = CColor::TransparentBlack();
 
     size_t Index = mLightLayerIndex;
@@ -141,26 +151,37 @@ void CSceneNode::BuildLightList(CGameArea *pArea)
     // Default ambient color to white if there are no lights on the selected layer
     const size_t NumLights = pArea->NumLights(Index);
     if (NumLights == 0)
+    {
         mAmbientColor = CColor::TransparentWhite();
+        return;
+    }
+
+    // Ambient lights should only be present one per layer; need to check how the game deals with multiple ambients
+    const CLightGrid& rkGrid = pArea->LightGrid(Index);
 
-    for (size_t iLight = 0; iLight < NumLights; iLight++)
+    if (rkGrid.HasAmbientLight())
+        mAmbientColor = pArea->Light(Index, rkGrid.AmbientLightIndex())->Color();
+
+    // Other lights will be used depending which are closest to the node.
+    // The light grid gives us the lights whose influence volumes overlap our bounds.
+    const CAABox Bounds = AABox();
+    std::vector<uint32> Candidates;
+    rkGrid.GatherCandidates(Bounds, Candidates);
+    mNumLightsTested = static_cast<uint32>(Candidates.size());
+
+    for (const uint32 LightIndex : Candidates)
     {
-        CLight* pLight = pArea->Light(Index, iLight);
+        CLight* pLight = pArea->Light(Index, LightIndex);
 
-        // Ambient lights should only be present one per layer; need to check how the game deals with multiple ambients
         if (pLight->Type() == ELightType::LocalAmbient)
-        {
-            mAmbientColor = pLight->Color();
-        }
-        else // Other lights will be used depending which are closest to the node
-        {
-            const bool IsInRange = AABox().IntersectsSphere(pLight->Position(), pLight->GetRadius());
+            continue;
+
+        const bool IsInRange = Bounds.IntersectsSphere(pLight->Position(), pLight->GetRadius());
 
-            if (IsInRange)
-            {
-                const float Dist = mPosition.Distance(pLight->Position());
-                LightEntries.push_back(SLightEntry(pLight, Dist));
-            }
+        if (IsInRange)
+        {
+            const float Dist = mPosition.Distance(pLight->Position());
+            LightEntries.push_back(SLightEntry(pLight, Dist));
         }
     }
 
@@ -92,12 +92,14 @@ protected:
     CAABox mLocalAABox;
 
     bool mMouseHovering = false;
+    int8 mCullResult = -1; // Result of the scene's batched frustum cull; -1 if untested
     bool mSelected = false;
     bool mVisible = true;
     std::list<CSceneNode*> mChildren;
 
     uint32 mLightLayerIndex = 0;
     uint32 mLightCount = 0;
+    uint32 mNumLightsTested = 0;
     std::array<CLight*, 8> mLights{};
     CColor mAmbientColor;
 
@@ -126,6 +128,9 @@ public:
     void DeleteChildren();
     void SetInheritance(bool InheritPos, bool InheritRot, bool InheritScale);
     void LoadModelMatrix();
+    bool IsInFrustum(const SViewInfo& rkViewInfo) const;
+    void SetCullResult(bool InFrustum)      { mCullResult = (InFrustum ? 1 : 0); }
+    void ResetCullResult()                  { mCullResult = -1; }
     void BuildLightList(CGameArea *pArea);
     void LoadLights(const SViewInfo& rkViewInfo);
     void AddModelToRenderer(CRenderer *pRenderer, CModel *pModel, size_t MatSet);
@@ -161,6 +166,7 @@ public:
     CVector3f LocalScale() const            { return mScale; }
     CVector3f CenterPoint() const           { return AABox().Center(); }
     uint32 LightLayerIndex() const          { return mLightLayerIndex; }
+    uint32 NumLightsTested() const          { return mNumLightsTested; }
     bool MarkedVisible() const              { return mVisible; }
     bool IsMouseHovering() const            { return mMouseHovering; }
     bool IsSelected() const                 { return mSelected; }
@@ -25,7 +25,7 @@ void CScriptAttachNode::AttachPropertyModified()
     if (mpAttachAssetProp)
     {
         if (mAttachAssetRef.IsValid())
-            mpAttachAsset = gpResourceStore->LoadResource<CModel>(mAttachAssetRef.Get());
+            mpAttachAsset = ActiveResourceStore()->LoadResource<CModel>(mAttachAssetRef.Get());
         else if (mAttachAnimSetRef.IsValid())
             mpAttachAsset = mAttachAnimSetRef.Get().AnimSet();
 
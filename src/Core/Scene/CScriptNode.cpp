@@ -61,8 +61,7 @@ CScriptNode::CScriptNode(CScene *pScene, uint32 NodeID, CSceneNode *pParent, CSc
         }
 
         // Fetch LightParameters
-        mpLightParameters = std::make_unique<CLightParameters>(mpInstance->LightParameters(), mpInstance->GameTemplate()->Game());
-        SetLightLayerIndex(mpLightParameters->LightLayerIndex());
+        SetLightLayerIndex(LightParameters().LightLayerIndex());
     }
     else
     {
@@ -140,7 +139,7 @@ void CScriptNode::AddToRenderer(CRenderer* pRenderer, const SViewInfo& rkViewInf
             for (auto& attachment : mAttachments)
                 attachment->AddToRenderer(pRenderer, rkViewInfo);
 
-            if (rkViewInfo.ViewFrustum.BoxInFrustum(AABox()))
+            if (IsInFrustum(rkViewInfo))
             {
                 if (CModel* pModel = ActiveModel())
                     AddModelToRenderer(pRenderer, pModel, 0);
@@ -170,7 +169,7 @@ void CScriptNode::Draw(FRenderOptions Options, int /*ComponentIndex*/, ERenderCo
     // Draw model
     if (UsesModel())
     {
-        const auto LightingOptions = (mpLightParameters ? mpLightParameters->WorldLightingOptions() : EWorldLightingOptions::NormalLighting);
+        const auto LightingOptions = LightParameters().WorldLightingOptions();
 
         if (CGraphics::sLightMode == CGraphics::ELightingMode::World && LightingOptions == EWorldLightingOptions::DisableWorldLighting)
         {
@@ -518,7 +517,7 @@ void CScriptNode::PropertyModified(IProperty* pProp)
         mScale = mpInstance->Scale();
 
     MarkTransformChanged();
-    SetLightLayerIndex(mpLightParameters->LightLayerIndex());
+    SetLightLayerIndex(LightParameters().LightLayerIndex());
 
     // Notify attachments
     for (auto* pAttachNode : mAttachments)
@@ -753,6 +752,20 @@ CTransform4f CScriptNode::BoneTransform(uint32 BoneID, EAttachType AttachType, b
 }
 
 // ************ PROTECTED ************
+const CLightParameters& CScriptNode::LightParameters()
+{
+    // The instance copies its property data on its first write, so rebuild the refs if it moved
+    const void* pData = mpInstance->ReadOnlyPropertyData();
+
+    if (!mpLightParameters || mpLightParametersData != pData)
+    {
+        mpLightParameters = std::make_unique<CLightParameters>(mpInstance->LightParameters(), mpInstance->GameTemplate()->Game());
+        mpLightParametersData = pData;
+    }
+
+    return *mpLightParameters;
+}
+
 void CScriptNode::SetDisplayAsset(CResource *pRes)
 {
     mpDisplayAsset = pRes;
@@ -25,7 +25,9 @@ class CScriptNode : public CSceneNode
     bool mHasVolumePreview = false;
     CModelNode *mpVolumePreviewNode = nullptr;
 
+    // Refs into the instance's property data, which moves if the instance stops sharing it
     std::unique_ptr<CLightParameters> mpLightParameters;
+    const void* mpLightParametersData = nullptr;
 
 public:
     enum class EGameModeVisibility
@@ -77,6 +79,7 @@ public:
     CResource* DisplayAsset() const                      { return mpDisplayAsset; }
 
 protected:
+    const CLightParameters& LightParameters();
     void SetDisplayAsset(CResource *pRes);
     void CalculateTransform(CTransform4f& rOut) const override;
 };
@@ -35,7 +35,7 @@ void CStaticNode::AddToRenderer(CRenderer *pRenderer, const SViewInfo& rkViewInf
     if (mpModel->IsOccluder())
         return;
 
-    if (!rkViewInfo.ViewFrustum.BoxInFrustum(AABox()))
+    if (!IsInFrustum(rkViewInfo))
         return;
 
     if (!mpModel->IsTransparent())
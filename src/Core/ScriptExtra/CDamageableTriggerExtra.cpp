@@ -186,7 +186,7 @@ void CDamageableTriggerExtra::PropertyModified(IProperty* pProperty)
         {
             if (pProperty == mTextureAssets[TextureIdx].Property())
             {
-                mpTextures[TextureIdx] = gpResourceStore->LoadResource<CTexture>( mTextureAssets[TextureIdx].Get() );
+                mpTextures[TextureIdx] = ActiveResourceStore()->LoadResource<CTexture>( mTextureAssets[TextureIdx].Get() );
 
                 if (mpTextures[TextureIdx] && mpTextures[TextureIdx]->Type() != EResourceType::Texture)
                     mpTextures[TextureIdx] = nullptr;
@@ -29,7 +29,7 @@ void CDoorExtra::PropertyModified(IProperty* pProperty)
 {
     if (pProperty == mShieldModelProp)
     {
-        mpShieldModel = gpResourceStore->LoadResource<CModel>( mShieldModelProp.Get() );
+        mpShieldModel = ActiveResourceStore()->LoadResource<CModel>( mShieldModelProp.Get() );
 
         if (mpShieldModel)
             mLocalAABox = mpShieldModel->AABox();
@@ -22,7 +22,7 @@ void CPointOfInterestExtra::PropertyModified(IProperty* pProperty)
 {
     if (mScanProperty.Property() == pProperty)
     {
-        mpScanData = gpResourceStore->LoadResource<CScan>( mScanProperty.Get() );
+        mpScanData = ActiveResourceStore()->LoadResource<CScan>( mScanProperty.Get() );
         mScanIsCritical = (mpScanData ? mpScanData->IsCriticalPropertyRef() : CBoolRef());
     }
 }
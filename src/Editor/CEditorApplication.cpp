@@ -3,6 +3,7 @@
 #include "CBasicViewport.h"
 #include "CProgressDialog.h"
 #include "CProjectSettingsDialog.h"
+#include "CResourceCacheDialog.h"
 #include "NDolphinIntegration.h"
 
 #include "Editor/CharacterEditor/CCharacterEditor.h"
@@ -15,6 +16,8 @@
 
 #include <Common/Macros.h>
 #include <Common/CTimer.h>
+#include <Core/CTrace.h>
+#include <Core/GameProject/CAsyncResourceLoader.h>
 #include <Core/GameProject/CGameProject.h>
 
 #include <QFuture>
@@ -36,6 +39,8 @@ CEditorApplication::~CEditorApplication()
 
 void CEditorApplication::InitEditor()
 {
+    CResourceCacheDialog::LoadBudgetSetting();
+
     mpResourceBrowser = new CResourceBrowser();
     mpWorldEditor = new CWorldEditor();
     mpProjectDialog = new CProjectSettingsDialog(mpWorldEditor);
@@ -276,11 +281,10 @@ bool CEditorApplication::RebuildResourceDatabase()
         emit ActiveProjectChanged(nullptr);
 
         // Rebuild
-        CProgressDialog Dialog(tr("Rebuilding resource database"), true, false, mpWorldEditor);
-        Dialog.SetOneShotTask("Rebuilding resource database");
+        CProgressDialog Dialog(tr("Rebuilding resource database"), false, false, mpWorldEditor);
         Dialog.DisallowCanceling();
 
-        QFuture<void> Future = QtConcurrent::run(pProj->ResourceStore(), &CResourceStore::RebuildFromDirectory);
+        QFuture<void> Future = QtConcurrent::run([&]() { pProj->ResourceStore()->RebuildFromDirectory(&Dialog); });
         Dialog.WaitForResults(Future);
         Dialog.close();
 
@@ -316,6 +320,16 @@ void CEditorApplication::TickEditors()
     if (gpResourceStore)
         gpResourceStore->ConditionalSaveStore();
 
+    // Finish background resource loads whose data has been read. The budget is per store
+    // and leaves most of the 8ms tick for the editors.
+    constexpr double AsyncLoadBudget = 0.004;
+
+    if (gpEditorStore)
+        gpEditorStore->AsyncLoader()->Update(AsyncLoadBudget);
+
+    if (gpResourceStore && gpResourceStore != gpEditorStore)
+        gpResourceStore->AsyncLoader()->Update(AsyncLoadBudget);
+
     // Tick each editor window and redraw their viewports
     for (IEditor *pEditor : mEditorWindows)
     {
@@ -333,6 +347,9 @@ void CEditorApplication::TickEditors()
                 pViewport->Render();
         }
     }
+
+    if (NTrace::IsEnabled())
+        NTrace::SampleCounters();
 }
 
 void CEditorApplication::OnEditorClose()
@@ -366,7 +383,7 @@ void CEditorApplication::OnEditorClose()
 
         if (mpActiveProject)
         {
-            mpActiveProject->ResourceStore()->DestroyUnreferencedResources();
+            mpActiveProject->ResourceStore()->ReleaseUnreferencedResources();
         }
     }
 }
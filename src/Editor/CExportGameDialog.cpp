@@ -444,6 +444,8 @@ void CExportGameDialog::Export()
     TString StrExportDir = TO_TSTRING(ExportDir);
     StrExportDir.EnsureEndsWith('/');
 
+    mpExporter->SetUsePackedMetadata(mpUI->PackedMetadataCheckBox->isChecked());
+
     CProgressDialog Dialog(tr("Creating new game project"), false, true, parentWidget());
     QFuture<bool> Future = QtConcurrent::run(mpExporter.get(), &CGameExporter::Export, mpDisc.get(), StrExportDir, &NameMap, &GameInfo, &Dialog);
     mExportSuccess = Dialog.WaitForResults(Future);
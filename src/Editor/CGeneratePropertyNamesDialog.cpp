@@ -172,6 +172,11 @@ void CGeneratePropertyNamesDialog::StartGeneration()
     mUpdateTimer.start(500);
     connect(&mUpdateTimer, &QTimer::timeout, this, &CGeneratePropertyNamesDialog::CheckForNewResults);
 
+    mGenerationTimer.start();
+    mRateTimer.start();
+    mLastIDsTested = 0;
+    mpUI->ProgressBar->setFormat(QStringLiteral("%p%"));
+
     UpdateUI();
 }
 
@@ -193,6 +198,15 @@ void CGeneratePropertyNamesDialog::GenerationComplete()
 
     mpUI->ProgressBar->setValue(mpUI->ProgressBar->maximum());
 
+    // Show the average rate for the whole run
+    const double Seconds = mGenerationTimer.elapsed() / 1000.0;
+
+    if (Seconds > 0.0)
+    {
+        const double IDsPerSecond = mGenerator.NumIDsTested() / Seconds;
+        mpUI->ProgressBar->setFormat(tr("%p% (average %1M IDs/s)").arg(IDsPerSecond / 1000000.0, 0, 'f', 1));
+    }
+
     disconnect(&mFutureWatcher, nullptr, this, nullptr);
     disconnect(&mUpdateTimer, nullptr, this, nullptr);
     CheckForNewResults();
@@ -338,9 +352,26 @@ void CGeneratePropertyNamesDialog::CheckForNewResults()
         }
     }
 
+    if (mRunningNameGeneration)
+        UpdateTestRate();
+
     UpdateUI();
 }
 
+/** Show the number of property IDs tested per second on the progress bar */
+void CGeneratePropertyNamesDialog::UpdateTestRate()
+{
+    const uint64 IDsTested = mGenerator.NumIDsTested();
+    const double Seconds = mRateTimer.restart() / 1000.0;
+
+    if (Seconds <= 0.0)
+        return;
+
+    const double IDsPerSecond = (IDsTested - mLastIDsTested) / Seconds;
+    mLastIDsTested = IDsTested;
+    mpUI->ProgressBar->setFormat(tr("%p% (%1M IDs/s)").arg(IDsPerSecond / 1000000.0, 0, 'f', 1));
+}
+
 /** Updates the enabled status of various widgets */
 void CGeneratePropertyNamesDialog::UpdateUI()
 {
@@ -8,6 +8,7 @@
 #include <Core/Resource/Script/Property/CEnumProperty.h>
 
 #include <QDialog>
+#include <QElapsedTimer>
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QScopedPointer>
@@ -45,6 +46,11 @@ class CGeneratePropertyNamesDialog : public QDialog
     /** Timer for fetching updates from name generation task */
     QTimer mUpdateTimer;
 
+    /** Timers and test counts for showing the hashing rate on the progress bar */
+    QElapsedTimer mGenerationTimer;
+    QElapsedTimer mRateTimer;
+    uint64 mLastIDsTested = 0;
+
     /** Checked items in the output tree widget */
     QVector<QTreeWidgetItem*> mCheckedItems;
 
@@ -110,6 +116,9 @@ public slots:
     /** Check progress on name generation task and display results on the UI */
     void CheckForNewResults();
 
+    /** Show the number of property IDs tested per second on the progress bar */
+    void UpdateTestRate();
+
     /** Updates the enabled status of various widgets */
     void UpdateUI();
 };
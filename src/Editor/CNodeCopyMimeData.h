@@ -9,6 +9,7 @@
 #include "Editor/CSelectionIterator.h"
 #include "Editor/WorldEditor/CWorldEditor.h"
 
+#include <QHash>
 #include <QMimeData>
 
 class CNodeCopyMimeData : public QMimeData
@@ -32,6 +33,7 @@ private:
     CWorldEditor *mpEditor;
     CAssetID mAreaID;
     QVector<SCopiedNode> mCopiedNodes;
+    QHash<uint32, int> mInstanceIDToIndex;
     EGame mGame;
 
 public:
@@ -39,6 +41,7 @@ public:
         : mpEditor(rkSrc.mpEditor)
         , mAreaID(rkSrc.mAreaID)
         , mCopiedNodes(rkSrc.mCopiedNodes)
+        , mInstanceIDToIndex(rkSrc.mInstanceIDToIndex)
         , mGame(rkSrc.mGame)
     {
     }
@@ -68,6 +71,7 @@ public:
             {
                 CScriptObject *pInst = static_cast<CScriptNode*>(*It)->Instance();
                 rNode.OriginalInstanceID = pInst->InstanceID();
+                mInstanceIDToIndex.insert(rNode.OriginalInstanceID, NodeIndex);
 
                 CVectorOutStream Out(&rNode.InstanceData, EEndian::BigEndian);
 
@@ -93,13 +97,7 @@ public:
 
     int IndexOfInstanceID(uint32 InstanceID) const
     {
-        for (int iNode = 0; iNode < mCopiedNodes.size(); iNode++)
-        {
-            if (mCopiedNodes[iNode].OriginalInstanceID == InstanceID)
-                return iNode;
-        }
-
-        return -1;
+        return mInstanceIDToIndex.value(InstanceID, -1);
     }
 
     CAssetID AreaID() const                         { return mAreaID; }
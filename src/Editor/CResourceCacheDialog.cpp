@@ -0,0 +1,147 @@
+#include "CResourceCacheDialog.h"
+#include "ui_CResourceCacheDialog.h"
+#include "UICommon.h"
+#include <Core/GameProject/CResourceStore.h>
+#include <Core/Resource/CResTypeInfo.h>
+#include <QLocale>
+#include <QSettings>
+#include <algorithm>
+
+constexpr char gkpResourceCacheBudgetSetting[] = "Editor/ResourceCacheBudgetMB";
+
+static QString FormatSize(uint64 Bytes)
+{
+    return QLocale().formattedDataSize(static_cast<qint64>(Bytes));
+}
+
+CResourceCacheDialog::CResourceCacheDialog(QWidget *pParent)
+    : QDialog(pParent)
+    , ui(std::make_unique<Ui::CResourceCacheDialog>())
+{
+    ui->setupUi(this);
+    ui->BudgetSpinBox->setValue(static_cast<int>(CResourceCache::DefaultBudget() / (1024 * 1024)));
+
+    mRefreshTimer.setInterval(500);
+
+    connect(&mRefreshTimer, &QTimer::timeout, this, &CResourceCacheDialog::Refresh);
+    connect(ui->BudgetSpinBox, &QSpinBox::editingFinished, this, &CResourceCacheDialog::OnBudgetEditingFinished);
+    connect(ui->ResetCountersButton, &QPushButton::clicked, this, &CResourceCacheDialog::OnResetCounters);
+    connect(ui->FlushButton, &QPushButton::clicked, this, &CResourceCacheDialog::OnFlush);
+    connect(ui->CloseButton, &QPushButton::clicked, this, &CResourceCacheDialog::close);
+}
+
+CResourceCacheDialog::~CResourceCacheDialog() = default;
+
+void CResourceCacheDialog::LoadBudgetSetting()
+{
+    const int BudgetMB = QSettings().value(gkpResourceCacheBudgetSetting, static_cast<int>(CResourceCache::DefaultBudget() / (1024 * 1024))).toInt();
+    const uint64 Budget = static_cast<uint64>(std::max(BudgetMB, 0)) * 1024 * 1024;
+    CResourceCache::SetDefaultBudget(Budget);
+
+    if (gpEditorStore)
+        gpEditorStore->SetResourceCacheBudget(Budget);
+}
+
+void CResourceCacheDialog::showEvent(QShowEvent *pEvent)
+{
+    Refresh();
+    mRefreshTimer.start();
+    QDialog::showEvent(pEvent);
+}
+
+void CResourceCacheDialog::hideEvent(QHideEvent *pEvent)
+{
+    mRefreshTimer.stop();
+    QDialog::hideEvent(pEvent);
+}
+
+void CResourceCacheDialog::Refresh()
+{
+    CResourceStore *pStore = gpResourceStore;
+    const bool HasStore = (pStore != nullptr);
+    ui->ResetCountersButton->setEnabled(HasStore);
+    ui->FlushButton->setEnabled(HasStore);
+
+    if (!HasStore)
+    {
+        ui->LoadedLabel->setText(tr("No project open"));
+        ui->CachedLabel->clear();
+        ui->HitsLabel->clear();
+        ui->MissesLabel->clear();
+        ui->EvictionsLabel->clear();
+        ui->TypeTable->setRowCount(0);
+        return;
+    }
+
+    const CResourceCache& rkCache = pStore->ResourceCache();
+    const CResourceCache::SStats& rkStats = rkCache.Stats();
+    const uint64 NumLoads = rkStats.Hits + rkStats.Misses;
+    const double HitRate = (NumLoads > 0 ? static_cast<double>(rkStats.Hits) / static_cast<double>(NumLoads) : 0.0);
+
+    ui->LoadedLabel->setText(QString::number(pStore->NumLoadedResources()));
+    ui->CachedLabel->setText(tr("%1 (%2 of %3)").arg(rkStats.NumCached).arg(FormatSize(rkStats.CachedBytes)).arg(FormatSize(rkCache.Budget())));
+
+    if (rkStats.ReservedBytes > 0)
+        ui->CachedLabel->setText(ui->CachedLabel->text() + tr(", %1 reserved").arg(FormatSize(rkStats.ReservedBytes)));
+    ui->HitsLabel->setText(tr("%1 (%2%)").arg(rkStats.Hits).arg(HitRate * 100.0, 0, 'f', 1));
+    ui->MissesLabel->setText(QString::number(rkStats.Misses));
+    ui->EvictionsLabel->setText(QString::number(rkStats.Evictions));
+
+    // Per-type usage, skipping types that have nothing cached
+    int Row = 0;
+
+    for (const auto& [Type, rkTypeStats] : rkStats.Types)
+    {
+        if (rkTypeStats.NumCached == 0)
+            continue;
+
+        if (Row >= ui->TypeTable->rowCount())
+            ui->TypeTable->insertRow(Row);
+
+        const CResTypeInfo *pkTypeInfo = CResTypeInfo::FindTypeInfo(Type);
+        ui->TypeTable->setItem(Row, 0, new QTableWidgetItem(pkTypeInfo ? TO_QSTRING(pkTypeInfo->TypeName()) : tr("Unknown")));
+        ui->TypeTable->setItem(Row, 1, new QTableWidgetItem(QString::number(rkTypeStats.NumCached)));
+        ui->TypeTable->setItem(Row, 2, new QTableWidgetItem(FormatSize(rkTypeStats.CachedBytes)));
+        Row++;
+    }
+
+    ui->TypeTable->setRowCount(Row);
+}
+
+void CResourceCacheDialog::OnBudgetEditingFinished()
+{
+    // Shrinking the budget unloads resources, which waits for the async loader to pause parsing,
+    // so only apply it once editing is done rather than on every spin box step
+    const int BudgetMB = ui->BudgetSpinBox->value();
+    const uint64 Budget = static_cast<uint64>(BudgetMB) * 1024 * 1024;
+
+    if (Budget == CResourceCache::DefaultBudget())
+        return;
+
+    QSettings().setValue(gkpResourceCacheBudgetSetting, BudgetMB);
+    CResourceCache::SetDefaultBudget(Budget);
+
+    if (gpEditorStore)
+        gpEditorStore->SetResourceCacheBudget(Budget);
+
+    if (gpResourceStore && gpResourceStore != gpEditorStore)
+        gpResourceStore->SetResourceCacheBudget(Budget);
+
+    Refresh();
+}
+
+void CResourceCacheDialog::OnResetCounters()
+{
+    if (gpResourceStore)
+        gpResourceStore->ResourceCache().ResetCounters();
+
+    Refresh();
+}
+
+void CResourceCacheDialog::OnFlush()
+{
+    if (gpResourceStore)
+        gpResourceStore->DestroyUnreferencedResources();
+
+    Refresh();
+}
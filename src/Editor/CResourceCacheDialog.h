@@ -0,0 +1,39 @@
+#ifndef CRESOURCECACHEDIALOG_H
+#define CRESOURCECACHEDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+
+#include <memory>
+
+namespace Ui {
+class CResourceCacheDialog;
+}
+
+/** Shows the active resource store's cache usage and hit/miss counters, and edits the cache budget */
+class CResourceCacheDialog : public QDialog
+{
+    Q_OBJECT
+
+    std::unique_ptr<Ui::CResourceCacheDialog> ui;
+    QTimer mRefreshTimer;
+
+public:
+    explicit CResourceCacheDialog(QWidget *pParent = nullptr);
+    ~CResourceCacheDialog() override;
+
+    /** Apply the budget saved in the editor settings; call once on startup */
+    static void LoadBudgetSetting();
+
+protected:
+    void showEvent(QShowEvent *pEvent) override;
+    void hideEvent(QHideEvent *pEvent) override;
+
+public slots:
+    void Refresh();
+    void OnBudgetEditingFinished();
+    void OnResetCounters();
+    void OnFlush();
+};
+
+#endif // CRESOURCECACHEDIALOG_H
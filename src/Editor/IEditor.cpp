@@ -1,6 +1,7 @@
 #include "IEditor.h"
 
 #include "Editor/Undo/IUndoCommand.h"
+#include <Core/GameProject/CResourceStore.h>
 
 #include <QMenu>
 #include <QMessageBox>
@@ -14,7 +15,7 @@ IEditor::IEditor(QWidget* pParent)
     gpEdApp->AddEditor(this);
 
     // Create undo actions
-    QAction *pUndoAction = mUndoStack.createUndoAction(this);
+    QAction *pUndoAction = mUndoStack.CreateUndoAction(this);
     QAction *pRedoAction = mUndoStack.createRedoAction(this);
     pUndoAction->setShortcut(QKeySequence::Undo);
     pRedoAction->setShortcut(QKeySequence::Redo);
@@ -26,7 +27,7 @@ IEditor::IEditor(QWidget* pParent)
     connect(&mUndoStack, &QUndoStack::indexChanged, this, &IEditor::OnUndoStackIndexChanged);
 }
 
-QUndoStack& IEditor::UndoStack()
+CUndoStack& IEditor::UndoStack()
 {
     return mUndoStack;
 }
@@ -56,8 +57,12 @@ bool IEditor::CheckUnsavedChanges()
         }
         else if (Result == QMessageBox::No)
         {
-            mUndoStack.setIndex(0); // Revert all changes
+            mUndoStack.setIndex(mUndoStack.FloorIndex()); // Revert all changes that are still in the undo stack
             OkToClear = true;
+
+            // Changes below the floor index can't be reverted, so make sure the resource cache doesn't hand out modified resources
+            if (gpResourceStore)
+                gpResourceStore->ExcludeLoadedResourcesFromCache();
         }
         else if (Result == QMessageBox::Cancel)
         {
@@ -4,9 +4,9 @@
 #include <QMainWindow>
 #include <QAction>
 #include <QList>
-#include <QUndoStack>
 
 #include "CEditorApplication.h"
+#include "Editor/Undo/CUndoStack.h"
 
 /** Base class of all editor windows */
 class IEditor : public QMainWindow
@@ -15,13 +15,13 @@ class IEditor : public QMainWindow
 
 protected:
     // Undo stack
-    QUndoStack mUndoStack;
+    CUndoStack mUndoStack;
     QList<QAction*> mUndoActions;
 
 public:
     explicit IEditor(QWidget* pParent);
 
-    QUndoStack& UndoStack();
+    CUndoStack& UndoStack();
     void AddUndoActions(QToolBar* pToolBar, QAction* pBefore = nullptr);
     void AddUndoActions(QMenu* pMenu, QAction* pBefore = nullptr);
     bool CheckUnsavedChanges();
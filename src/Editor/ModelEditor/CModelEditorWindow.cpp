@@ -755,7 +755,7 @@ void CModelEditorWindow::Import()
     SetActiveModel(pModel);
     SET_WINDOWTITLE_APPVARS(tr("%APP_FULL_NAME% - Model Editor: Untitled"));
     mOutputFilename = "";
-    gpResourceStore->DestroyUnreferencedResources();
+    gpResourceStore->ReleaseUnreferencedResources();
 }
 
 void CModelEditorWindow::ConvertToDDS()
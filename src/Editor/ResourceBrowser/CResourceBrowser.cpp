@@ -12,6 +12,7 @@
 #include "Editor/Undo/ICreateDeleteDirectoryCommand.h"
 #include "Editor/Undo/ICreateDeleteResourceCommand.h"
 #include <Core/GameProject/AssetNameGeneration.h>
+#include <Core/Resource/Animation/CAnimation.h>
 #include <Core/GameProject/CAssetNameMap.h>
 
 #include <QButtonGroup>
@@ -20,8 +21,11 @@
 #include <QInputDialog>
 #include <QMenu>
 #include <QMessageBox>
+#include <QSettings>
 #include <QtConcurrent/QtConcurrentRun>
 
+constexpr char gkpQuantizeAnimationsSetting[] = "ResourceBrowser/QuantizeAnimations";
+
 CResourceBrowser::CResourceBrowser(QWidget *pParent)
     : QWidget(pParent)
     , mpUI(std::make_unique<Ui::CResourceBrowser>())
@@ -116,8 +120,27 @@ CResourceBrowser::CResourceBrowser(QWidget *pParent)
     connect(pDisplayAssetIDsAction, &QAction::toggled, this, &CResourceBrowser::SetAssetIDDisplayEnabled);
     pOptionsMenu->addAction(pDisplayAssetIDsAction);
 
+    QAction *pQuantizeAnimsAction = new QAction(tr("Compress Loaded Animations"), this);
+    pQuantizeAnimsAction->setCheckable(true);
+    pQuantizeAnimsAction->setToolTip(tr("Store animation keys at reduced precision to save memory. Applies to animations loaded after this is enabled."));
+    pQuantizeAnimsAction->setChecked(QSettings().value(gkpQuantizeAnimationsSetting, false).toBool());
+    CAnimation::SetQuantizeOnLoad(pQuantizeAnimsAction->isChecked());
+    connect(pQuantizeAnimsAction, &QAction::toggled, this, &CResourceBrowser::SetAnimationQuantizationEnabled);
+    pOptionsMenu->addAction(pQuantizeAnimsAction);
+
     pOptionsMenu->addAction(tr("Find Asset by ID"), this, &CResourceBrowser::FindAssetByID);
     pOptionsMenu->addAction(tr("Rebuild Database"), this, &CResourceBrowser::RebuildResourceDB);
+
+    mpPackedMetadataAction = new QAction(tr("Pack Resource Metadata"), this);
+    mpPackedMetadataAction->setCheckable(true);
+    mpPackedMetadataAction->setToolTip(tr("Store resource metadata in a single file instead of one .rsmeta file per resource."));
+    connect(mpPackedMetadataAction, &QAction::triggered, this, &CResourceBrowser::SetPackedMetadataEnabled);
+    connect(pOptionsMenu, &QMenu::aboutToShow, this, [this]()
+    {
+        mpPackedMetadataAction->setEnabled(mpStore != nullptr);
+        mpPackedMetadataAction->setChecked(mpStore && mpStore->UsesPackedMetadata());
+    });
+    pOptionsMenu->addAction(mpPackedMetadataAction);
     mpUI->OptionsToolButton->setMenu(pOptionsMenu);
 
 #if !PUBLIC_RELEASE
@@ -816,6 +839,13 @@ void CResourceBrowser::OnResourceSelectionChanged(const QModelIndex& rkNewIndex)
 {
     QModelIndex SourceIndex = mpProxyModel->mapToSource(rkNewIndex);
     mpSelectedEntry = mpModel->IndexEntry(SourceIndex);
+
+    // Most selected resources get opened next, so get a head start on reading them in
+    if (mpSelectedEntry && mpStore)
+        mpSelectionPrefetch = mpStore->LoadResourceAsync(mpSelectedEntry->ID(), EResourceLoadPriority::Prefetch);
+    else
+        mpSelectionPrefetch.reset();
+
     emit SelectedResourceChanged(mpSelectedEntry);
 }
 
@@ -874,6 +904,12 @@ void CResourceBrowser::SetAssetIDDisplayEnabled(bool Enable)
     mpModel->RefreshAllIndices();
 }
 
+void CResourceBrowser::SetAnimationQuantizationEnabled(bool Enable)
+{
+    CAnimation::SetQuantizeOnLoad(Enable);
+    QSettings().setValue(gkpQuantizeAnimationsSetting, Enable);
+}
+
 void CResourceBrowser::UpdateStore()
 {
     CGameProject *pProj = gpEdApp->ActiveProject();
@@ -883,6 +919,7 @@ void CResourceBrowser::UpdateStore()
     if (mpStore != pNewStore)
     {
         mpStore = pNewStore;
+        mpSelectionPrefetch.reset();
 
         // Clear search
         mpUI->SearchBar->clear();
@@ -1021,6 +1058,17 @@ void CResourceBrowser::RebuildResourceDB()
     }
 }
 
+void CResourceBrowser::SetPackedMetadataEnabled(bool Enable)
+{
+    if (!mpStore || mpStore->UsesPackedMetadata() == Enable)
+        return;
+
+    const bool Success = (Enable ? mpStore->MigrateToPackedMetadata() : mpStore->MigrateToPerFileMetadata());
+
+    if (!Success)
+        UICommon::ErrorMsg(this, tr("Failed to migrate resource metadata! Check the log for details."));
+}
+
 void CResourceBrowser::ClearFilters()
 {
     ResetSearch();
@@ -5,6 +5,7 @@
 #include "CResourceProxyModel.h"
 #include "CResourceTableModel.h"
 #include "CVirtualDirectoryModel.h"
+#include <Core/GameProject/CAsyncResourceLoader.h>
 
 #include <QCheckBox>
 #include <QMenu>
@@ -21,6 +22,7 @@ class CResourceBrowser : public QWidget
     Q_OBJECT
     std::unique_ptr<Ui::CResourceBrowser> mpUI;
     CResourceEntry *mpSelectedEntry = nullptr;
+    TResourceLoadHandle mpSelectionPrefetch;  // Starts loading the selected resource before it's opened
     CResourceStore *mpStore = nullptr;
     CResourceTableModel *mpModel = nullptr;
     CResourceProxyModel *mpProxyModel = nullptr;
@@ -51,6 +53,7 @@ class CResourceBrowser : public QWidget
     QUndoStack mUndoStack;
     QAction *mpUndoAction = nullptr;
     QAction *mpRedoAction = nullptr;
+    QAction *mpPackedMetadataAction = nullptr;
     QWidget *mpActionContainerWidget = nullptr;
 
     // Misc
@@ -104,6 +107,7 @@ public slots:
     void OnResourceSelectionChanged(const QModelIndex& rkNewIndex);
     void FindAssetByID();
     void SetAssetIDDisplayEnabled(bool Enable);
+    void SetAnimationQuantizationEnabled(bool Enable);
 
     void UpdateStore();
     void SetProjectStore();
@@ -113,6 +117,7 @@ public slots:
     void ImportAssetNameMap();
     void ExportAssetNames();
     void RebuildResourceDB();
+    void SetPackedMetadataEnabled(bool Enable);
 
     void ClearFilters();
     void ResetSearch();
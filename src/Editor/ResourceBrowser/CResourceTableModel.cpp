@@ -2,6 +2,8 @@
 #include "CResourceBrowser.h"
 #include "CResourceMimeData.h"
 
+#include <QLocale>
+
 CResourceTableModel::CResourceTableModel(CResourceBrowser *pBrowser, QObject *pParent)
     : QAbstractTableModel(pParent)
 {
@@ -54,7 +56,19 @@ QVariant CResourceTableModel::data(const QModelIndex& rkIndex, int Role) const
         return TO_QSTRING(pEntry->Name());
 
     if (Role == Qt::ToolTipRole)
-        return TO_QSTRING(pEntry->CookedAssetPath(true));
+    {
+        QString ToolTip = TO_QSTRING(pEntry->CookedAssetPath(true));
+
+        if (pEntry->IsLoaded())
+        {
+            const size_t MemoryUsage = pEntry->Resource()->MemoryUsage();
+
+            if (MemoryUsage > 0)
+                ToolTip += tr("\nMemory usage: %1").arg(QLocale().formattedDataSize(static_cast<qint64>(MemoryUsage)));
+        }
+
+        return ToolTip;
+    }
 
     if (Role == Qt::DecorationRole)
         return QIcon(QStringLiteral(":/icons/Sphere Preview.svg"));
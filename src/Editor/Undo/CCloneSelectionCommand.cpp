@@ -52,8 +52,7 @@ void CCloneSelectionCommand::redo()
 {
     QList<CSceneNode*> ToClone = mNodesToClone.DereferenceList();
     QList<CSceneNode*> ClonedNodes;
-    QList<uint32> ToCloneInstanceIDs;
-    QList<uint32> ClonedInstanceIDs;
+    QHash<uint32, uint32> ClonedInstanceIDs; // Original instance ID -> clone instance ID
 
     // Clone nodes
     for (CSceneNode *pNode : ToClone)
@@ -72,8 +71,7 @@ void CCloneSelectionCommand::redo()
         pCloneNode->SetRotation(pScript->LocalRotation());
         pCloneNode->SetScale(pScript->LocalScale());
 
-        ToCloneInstanceIDs.push_back(pInstance->InstanceID());
-        ClonedInstanceIDs.push_back(pCloneInst->InstanceID());
+        ClonedInstanceIDs.insert(pInstance->InstanceID(), pCloneInst->InstanceID());
         ClonedNodes.push_back(pCloneNode);
         mClonedNodes.push_back(pCloneNode);
         mpEditor->NotifyNodeSpawned(pCloneNode);
@@ -90,9 +88,7 @@ void CCloneSelectionCommand::redo()
             CLink *pSrcLink = pSrc->Link(ELinkType::Outgoing, iLink);
 
             // If we're cloning the receiver then target the cloned receiver instead of the original one.
-            uint32 ReceiverID = pSrcLink->ReceiverID();
-            if (ToCloneInstanceIDs.contains(ReceiverID))
-                ReceiverID = ClonedInstanceIDs[ToCloneInstanceIDs.indexOf(ReceiverID)];
+            const uint32 ReceiverID = ClonedInstanceIDs.value(pSrcLink->ReceiverID(), pSrcLink->ReceiverID());
 
             CLink *pCloneLink = new CLink(pSrcLink->Area(), pSrcLink->State(), pSrcLink->Message(), pClone->InstanceID(), ReceiverID);
             pCloneLink->Sender()->AddLink(ELinkType::Outgoing, pCloneLink);
@@ -76,19 +76,15 @@ void CDeleteLinksCommand::undo()
 
 void CDeleteLinksCommand::redo()
 {
-    QVector<CLink*> Links;
+    std::vector<CLink*> Links;
+    Links.reserve(mLinks.size());
 
     for (const auto& rLink : mLinks)
     {
         Links.push_back(rLink.pSender->Link(ELinkType::Outgoing, rLink.SenderIndex));
     }
 
-    for (auto* pLink : Links)
-    {
-        pLink->Sender()->RemoveLink(ELinkType::Outgoing, pLink);
-        pLink->Receiver()->RemoveLink(ELinkType::Incoming, pLink);
-        delete pLink;
-    }
+    mpEditor->ActiveArea()->DeleteLinks(Links);
 
     // Notify world editor
     mpEditor->OnLinksModified(mAffectedInstances.DereferenceList());
@@ -10,6 +10,7 @@ CDeleteSelectionCommand::CDeleteSelectionCommand(CWorldEditor *pEditor, const QS
 {
     QSet<CLink*> Links;
     QList<CScriptObject*> LinkedInstances;
+    QSet<CScriptObject*> SeenInstances;
 
     for (CSelectionIterator It(pEditor->Selection()); It; ++It)
     {
@@ -55,10 +56,14 @@ CDeleteSelectionCommand::CDeleteSelectionCommand(CWorldEditor *pEditor, const QS
                         mDeletedLinks.push_back(Link);
                         Links.insert(pLink);
 
-                        if (!LinkedInstances.contains(pLink->Sender()))
-                            LinkedInstances.push_back(pLink->Sender());
-                        if (!LinkedInstances.contains(pLink->Receiver()))
-                            LinkedInstances.push_back(pLink->Receiver());
+                        for (CScriptObject *pLinked : { pLink->Sender(), pLink->Receiver() })
+                        {
+                            if (!SeenInstances.contains(pLinked))
+                            {
+                                SeenInstances.insert(pLinked);
+                                LinkedInstances.push_back(pLinked);
+                            }
+                        }
                     }
                 }
             }
@@ -76,10 +81,10 @@ CDeleteSelectionCommand::CDeleteSelectionCommand(CWorldEditor *pEditor, const QS
     // Remove selected objects from the linked instances list.
     LinkedInstances.removeAll(nullptr);
 
-    for (CScriptObject *pInst : LinkedInstances)
+    for (int InstIdx = LinkedInstances.size() - 1; InstIdx >= 0; InstIdx--)
     {
-        if (mpEditor->Scene()->NodeForInstance(pInst)->IsSelected())
-            LinkedInstances.removeOne(pInst);
+        if (mpEditor->Scene()->NodeForInstance(LinkedInstances[InstIdx])->IsSelected())
+            LinkedInstances.removeAt(InstIdx);
     }
 
     mLinkedInstances = LinkedInstances;
@@ -88,7 +93,7 @@ CDeleteSelectionCommand::CDeleteSelectionCommand(CWorldEditor *pEditor, const QS
 void CDeleteSelectionCommand::undo()
 {
     QList<CSceneNode*> NewNodes;
-    QList<uint32> NewInstanceIDs;
+    QSet<uint32> NewInstanceIDs;
 
     // Spawn nodes
     for (SDeletedNode& rNode : mDeletedNodes)
@@ -106,7 +111,7 @@ void CDeleteSelectionCommand::undo()
         pNode->SetScale(rNode.Scale);
 
         NewNodes.push_back(pNode);
-        NewInstanceIDs.push_back(pInstance->InstanceID());
+        NewInstanceIDs.insert(pInstance->InstanceID());
         mpEditor->NotifyNodeSpawned(*rNode.NodePtr);
     }
 
@@ -0,0 +1,112 @@
+#include "CUndoStack.h"
+#include "IUndoCommand.h"
+#include <QSettings>
+#include <algorithm>
+
+constexpr char gkpUndoMemoryBudgetSetting[] = "Editor/UndoMemoryBudgetMB";
+constexpr int gkDefaultUndoMemoryBudgetMB = 64;
+
+CUndoStack::CUndoStack(QObject* pParent)
+    : QUndoStack(pParent)
+    , mMemoryBudget(DefaultMemoryBudget())
+{
+    connect(this, &QUndoStack::indexChanged, this, &CUndoStack::OnIndexChanged);
+}
+
+QAction* CUndoStack::CreateUndoAction(QObject* pParent)
+{
+    QAction* pAction = new QAction(tr("Undo"), pParent);
+
+    auto UpdateAction = [this, pAction]()
+    {
+        const QString Text = undoText();
+        pAction->setText(Text.isEmpty() ? tr("Undo") : tr("Undo %1").arg(Text));
+        pAction->setEnabled(CanUndo());
+    };
+
+    UpdateAction();
+    connect(this, &QUndoStack::indexChanged, pAction, UpdateAction);
+    connect(this, &QUndoStack::canUndoChanged, pAction, UpdateAction);
+    connect(this, &QUndoStack::undoTextChanged, pAction, UpdateAction);
+    connect(pAction, &QAction::triggered, this, &CUndoStack::Undo);
+    return pAction;
+}
+
+void CUndoStack::Undo()
+{
+    if (CanUndo())
+        undo();
+}
+
+size_t CUndoStack::MemoryUsage() const
+{
+    size_t Usage = 0;
+
+    for (int CmdIdx = mFloorIndex; CmdIdx < count(); CmdIdx++)
+        Usage += CommandMemoryUsage(command(CmdIdx));
+
+    return Usage;
+}
+
+void CUndoStack::SetMemoryBudget(size_t Budget)
+{
+    mMemoryBudget = Budget;
+    OnIndexChanged();
+}
+
+size_t CUndoStack::DefaultMemoryBudget()
+{
+    const int BudgetMB = QSettings().value(gkpUndoMemoryBudgetSetting, gkDefaultUndoMemoryBudgetMB).toInt();
+    return static_cast<size_t>(std::max(BudgetMB, 0)) * 1024 * 1024;
+}
+
+void CUndoStack::SetDefaultMemoryBudget(size_t Budget)
+{
+    QSettings().setValue(gkpUndoMemoryBudgetSetting, static_cast<int>(Budget / (1024 * 1024)));
+}
+
+void CUndoStack::OnIndexChanged()
+{
+    // The stack was cleared
+    if (count() < mFloorIndex)
+        mFloorIndex = 0;
+
+    if (mMemoryBudget == 0)
+        return;
+
+    // Evict the oldest commands until we're back under budget. Commands that have been undone are
+    // left alone, since they'll be discarded anyway as soon as a new command is pushed, and the
+    // most recent command is always kept so the last edit can be undone no matter how big it is.
+    size_t Usage = MemoryUsage();
+
+    while (Usage > mMemoryBudget && mFloorIndex < index() - 1)
+    {
+        QUndoCommand* pCommand = const_cast<QUndoCommand*>(command(mFloorIndex));
+        Usage -= CommandMemoryUsage(pCommand);
+        ReleaseCommandData(pCommand);
+        mFloorIndex++;
+    }
+}
+
+size_t CUndoStack::CommandMemoryUsage(const QUndoCommand* pkCommand)
+{
+    size_t Usage = 0;
+
+    if (const IUndoCommand* pkCmd = dynamic_cast<const IUndoCommand*>(pkCommand))
+        Usage += pkCmd->MemoryUsage();
+
+    // Macros keep their commands as children
+    for (int ChildIdx = 0; ChildIdx < pkCommand->childCount(); ChildIdx++)
+        Usage += CommandMemoryUsage(pkCommand->child(ChildIdx));
+
+    return Usage;
+}
+
+void CUndoStack::ReleaseCommandData(QUndoCommand* pCommand)
+{
+    if (IUndoCommand* pCmd = dynamic_cast<IUndoCommand*>(pCommand))
+        pCmd->ReleaseUndoData();
+
+    for (int ChildIdx = 0; ChildIdx < pCommand->childCount(); ChildIdx++)
+        ReleaseCommandData(const_cast<QUndoCommand*>(pCommand->child(ChildIdx)));
+}
@@ -0,0 +1,50 @@
+#ifndef CUNDOSTACK_H
+#define CUNDOSTACK_H
+
+#include <QAction>
+#include <QUndoStack>
+
+/**
+ * Undo stack with a memory budget. Once the undo data held by the commands on the stack
+ * goes over the budget, the oldest commands have their data released and can no longer
+ * be undone. QUndoStack can't remove commands from the bottom of a non-empty stack, so
+ * the released commands stay on the stack below a floor index that undo won't go past.
+ */
+class CUndoStack : public QUndoStack
+{
+    Q_OBJECT
+
+    /** Memory budget for undo data, in bytes; 0 means unlimited */
+    size_t mMemoryBudget;
+
+    /** Index of the oldest command that can still be undone */
+    int mFloorIndex = 0;
+
+public:
+    explicit CUndoStack(QObject* pParent = nullptr);
+
+    /** Create an undo action that respects the floor index. Use this instead of createUndoAction(). */
+    QAction* CreateUndoAction(QObject* pParent);
+
+    /** Undo the most recent command, unless it has been evicted */
+    void Undo();
+
+    /** Approximate memory held by the undo data of all commands that can still be undone */
+    size_t MemoryUsage() const;
+
+    void SetMemoryBudget(size_t Budget);
+    size_t MemoryBudget() const     { return mMemoryBudget; }
+    int FloorIndex() const          { return mFloorIndex; }
+    bool CanUndo() const            { return canUndo() && index() > mFloorIndex; }
+
+    /** Default budget for new undo stacks, in bytes. Stored in the editor settings. */
+    static size_t DefaultMemoryBudget();
+    static void SetDefaultMemoryBudget(size_t Budget);
+
+private:
+    void OnIndexChanged();
+    static size_t CommandMemoryUsage(const QUndoCommand* pkCommand);
+    static void ReleaseCommandData(QUndoCommand* pCommand);
+};
+
+#endif // CUNDOSTACK_H
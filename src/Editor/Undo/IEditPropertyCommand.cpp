@@ -31,6 +31,22 @@ void IEditPropertyCommand::RestoreObjectStateFromArray(std::vector<char>& rArray
     }
 }
 
+/** Move the object properties to the old or new state by applying the delta to their current state */
+void IEditPropertyCommand::ApplyDelta(bool Forward)
+{
+    std::vector<char> Data;
+    SaveObjectStateToArray(Data);
+
+    // Undo/redo may be called when the change has already been applied outside of the undo command
+    if (Forward ? mDelta.MatchesNew(Data) : mDelta.MatchesOld(Data))
+        return;
+
+    if (Forward ? mDelta.ApplyForward(Data) : mDelta.ApplyBackward(Data))
+        RestoreObjectStateFromArray(Data);
+    else
+        errorf("%s of %s failed; property values don't match the undo data", Forward ? "Redo" : "Undo", *mpProperty->Name());
+}
+
 IEditPropertyCommand::IEditPropertyCommand(
         IProperty* pProperty,
         CPropertyModel* pModel,
@@ -71,14 +87,18 @@ void IEditPropertyCommand::SaveOldData()
 
 void IEditPropertyCommand::SaveNewData()
 {
-    SaveObjectStateToArray(mNewData);
+    std::vector<char> NewData;
+    SaveObjectStateToArray(NewData);
+    mDelta = CBinaryDelta::Create(mOldData, NewData);
     mSavedNewData = true;
+
+    mOldData.clear();
+    mOldData.shrink_to_fit();
 }
 
 bool IEditPropertyCommand::IsNewDataDifferent()
 {
-    if (mOldData.size() != mNewData.size()) return true;
-    return memcmp(mOldData.data(), mNewData.data(), mNewData.size()) != 0;
+    return !mDelta.IsEmpty();
 }
 
 void IEditPropertyCommand::SetEditComplete(bool IsComplete)
@@ -114,8 +134,16 @@ bool IEditPropertyCommand::mergeWith(const QUndoCommand *pkOther)
                         return false;
                 }
 
-                // Match
-                mNewData = pkCmd->mNewData;
+                // Match. The other command has already been applied, so walk back through
+                // both deltas from the current state to get our old state.
+                std::vector<char> NewData;
+                SaveObjectStateToArray(NewData);
+                std::vector<char> OldData = NewData;
+
+                if (!pkCmd->mDelta.ApplyBackward(OldData) || !mDelta.ApplyBackward(OldData))
+                    return false;
+
+                mDelta = CBinaryDelta::Create(OldData, NewData);
                 mCommandEnded = pkCmd->mCommandEnded;
                 return true;
             }
@@ -128,7 +156,7 @@ bool IEditPropertyCommand::mergeWith(const QUndoCommand *pkOther)
 void IEditPropertyCommand::undo()
 {
     ASSERT(mSavedOldData && mSavedNewData);
-    RestoreObjectStateFromArray(mOldData);
+    ApplyDelta(false);
     mCommandEnded = true;
 
     if (mpModel && mIndex.isValid())
@@ -144,7 +172,7 @@ void IEditPropertyCommand::undo()
 void IEditPropertyCommand::redo()
 {
     ASSERT(mSavedOldData && mSavedNewData);
-    RestoreObjectStateFromArray(mNewData);
+    ApplyDelta(true);
 
     if (mpModel && mIndex.isValid())
     {
@@ -160,3 +188,15 @@ bool IEditPropertyCommand::AffectsCleanState() const
 {
     return true;
 }
+
+size_t IEditPropertyCommand::MemoryUsage() const
+{
+    return sizeof(*this) + mOldData.capacity() + mDelta.MemoryUsage();
+}
+
+void IEditPropertyCommand::ReleaseUndoData()
+{
+    mOldData.clear();
+    mOldData.shrink_to_fit();
+    mDelta.Clear();
+}
@@ -4,13 +4,15 @@
 #include "IUndoCommand.h"
 #include "EUndoCommand.h"
 #include "Editor/PropertyEdit/CPropertyModel.h"
+#include <Core/CBinaryDelta.h>
 
 class IEditPropertyCommand : public IUndoCommand
 {
 protected:
-    // Has to be std::vector for compatibility with CVectorOutStream
+    // Has to be std::vector for compatibility with CVectorOutStream.
+    // The full old state is only kept until the new state is saved; after that, just the changes are kept.
     std::vector<char> mOldData;
-    std::vector<char> mNewData;
+    CBinaryDelta mDelta;
 
     IProperty* mpProperty;
     CPropertyModel* mpModel;
@@ -25,6 +27,9 @@ protected:
     /** Restore the state of the object properties from the given data buffer */
     void RestoreObjectStateFromArray(std::vector<char>& rArray);
 
+    /** Move the object properties to the old or new state by applying the delta to their current state */
+    void ApplyDelta(bool Forward);
+
 public:
     IEditPropertyCommand(
             IProperty* pProperty,
@@ -50,6 +55,8 @@ public:
     void undo() override;
     void redo() override;
     bool AffectsCleanState() const override;
+    size_t MemoryUsage() const override;
+    void ReleaseUndoData() override;
 };
 
 #endif // IEDITPROPERTYCOMMAND_H
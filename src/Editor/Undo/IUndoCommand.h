@@ -13,6 +13,12 @@ public:
         : QUndoCommand(rkText, pParent) {}
 
     virtual bool AffectsCleanState() const = 0;
+
+    /** Approximate memory held by the command's undo/redo data, counted against the undo stack's memory budget */
+    virtual size_t MemoryUsage() const  { return 0; }
+
+    /** Free the command's undo/redo data. Only called by CUndoStack once the command can no longer be undone. */
+    virtual void ReleaseUndoData()      {}
 };
 
 #endif // IUNDOCOMMAND
@@ -3,29 +3,59 @@
 
 #include "IUndoCommand.h"
 #include <Common/Common.h>
+#include <Core/CBinaryDelta.h>
 
 /**
- * Undo command that works by restoring the full state of an object
+ * Undo command that works by restoring the serialized state of an object
  * on undo/redo. To use, create the command object, apply the change
  * you want to make to the object, and then push the command.
  *
  * Commands with IsActionComplete=false will be merged.
  * To prevent merging, push a final command with IsActionComplete=true.
  *
- * The current implementatation is "dumb" and just saves and restores
- * the entire object, including parameters that have not changed. Due
- * to this, it could be memory-intensive and not super performant.
- * As a result, it's probably not a good idea to use this on very
- * large objects right now.
+ * Only the byte ranges of the serialized data that changed are kept. The full
+ * old state is only held until the new state has been saved. On undo/redo the
+ * object is serialized again and the delta is applied to that, so each undo or
+ * redo still costs a full serialize and deserialize of the object.
  */
 template<typename ObjectT>
 class TSerializeUndoCommand : public IUndoCommand
 {
     ObjectT* mpObject;
     std::vector<char> mOldData;
-    std::vector<char> mNewData;
+    CBinaryDelta mDelta;
+    bool mSavedNewData = false;
     bool mIsActionComplete;
 
+    void SaveState(std::vector<char>& rOut) const
+    {
+        CVectorOutStream Out(&rOut, EEndian::SystemEndian);
+        CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
+        mpObject->Serialize(Writer);
+    }
+
+    void RestoreState(std::vector<char>& rData)
+    {
+        CMemoryInStream In(rData.data(), rData.size(), EEndian::SystemEndian);
+        CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
+        mpObject->Serialize(Reader);
+    }
+
+    void ApplyDelta(bool Forward)
+    {
+        std::vector<char> Data;
+        SaveState(Data);
+
+        // The change may already have been applied to the object outside of the command
+        if (Forward ? mDelta.MatchesNew(Data) : mDelta.MatchesOld(Data))
+            return;
+
+        if (Forward ? mDelta.ApplyForward(Data) : mDelta.ApplyBackward(Data))
+            RestoreState(Data);
+        else
+            errorf("%s failed; object state doesn't match the undo data", Forward ? "Redo" : "Undo");
+    }
+
 public:
     TSerializeUndoCommand(const QString& kText, ObjectT* pObject, bool IsActionComplete)
         : IUndoCommand(kText)
@@ -33,9 +63,7 @@ public:
         , mIsActionComplete(IsActionComplete)
     {
         // Save old state of object
-        CVectorOutStream Out(&mOldData, EEndian::SystemEndian);
-        CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
-        mpObject->Serialize(Writer);
+        SaveState(mOldData);
     }
 
     /** IUndoCommand interface */
@@ -46,39 +74,32 @@ public:
 
     void undo() override
     {
-        // Restore old state of object
-        CMemoryInStream In(&mOldData[0], mOldData.size(), EEndian::SystemEndian);
-        CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
-        mpObject->Serialize(Reader);
+        ApplyDelta(false);
     }
 
     void redo() override
     {
         // First call when command is pushed - save new state of object
-        if (mNewData.empty())
+        if (!mSavedNewData)
         {
-            CVectorOutStream Out(&mNewData, EEndian::SystemEndian);
-            CBasicBinaryWriter Writer(&Out, 0, EGame::Invalid);
-            mpObject->Serialize(Writer);
+            std::vector<char> NewData;
+            SaveState(NewData);
+            mDelta = CBinaryDelta::Create(mOldData, NewData);
+            mSavedNewData = true;
+
+            mOldData.clear();
+            mOldData.shrink_to_fit();
 
-            // Obsolete command if memory buffers match
-            if (mIsActionComplete)
+            // Obsolete command if nothing changed
+            if (mIsActionComplete && mDelta.IsEmpty())
             {
-                if (mOldData.size() == mNewData.size())
-                {
-                    if (memcmp(mOldData.data(), mNewData.data(), mNewData.size()) == 0)
-                    {
-                        setObsolete(true);
-                    }
-                }
+                setObsolete(true);
             }
         }
         // Subsequent calls - restore new state of object
         else
         {
-            CMemoryInStream In(&mNewData[0], mNewData.size(), EEndian::SystemEndian);
-            CBasicBinaryReader Reader(&In, CSerialVersion(0,0,EGame::Invalid));
-            mpObject->Serialize(Reader);
+            ApplyDelta(true);
         }
     }
 
@@ -89,19 +110,22 @@ public:
             const TSerializeUndoCommand* pkSerializeCommand =
                     static_cast<const TSerializeUndoCommand*>(pkOther);
 
-            mNewData = pkSerializeCommand->mNewData;
+            // The other command has just been pushed, so the object is in its new state.
+            // Walk back through both deltas to get our old state and diff the two.
+            std::vector<char> NewData;
+            SaveState(NewData);
+            std::vector<char> OldData = NewData;
+
+            if (!pkSerializeCommand->mDelta.ApplyBackward(OldData) || !mDelta.ApplyBackward(OldData))
+                return false;
+
+            mDelta = CBinaryDelta::Create(OldData, NewData);
             mIsActionComplete = pkSerializeCommand->mIsActionComplete;
 
-            // Obsolete command if memory buffers match
-            if (mIsActionComplete)
+            // Obsolete command if nothing changed
+            if (mIsActionComplete && mDelta.IsEmpty())
             {
-                if (mOldData.size() == mNewData.size())
-                {
-                    if (memcmp(mOldData.data(), mNewData.data(), mNewData.size()) == 0)
-                    {
-                        setObsolete(true);
-                    }
-                }
+                setObsolete(true);
             }
 
             return true;
@@ -113,6 +137,18 @@ public:
     {
         return true;
     }
+
+    size_t MemoryUsage() const override
+    {
+        return sizeof(TSerializeUndoCommand) + mOldData.capacity() + mDelta.MemoryUsage();
+    }
+
+    void ReleaseUndoData() override
+    {
+        mOldData.clear();
+        mOldData.shrink_to_fit();
+        mDelta.Clear();
+    }
 };
 
 #endif // TSERIALIZEUNDOCOMMAND_H
@@ -583,9 +583,10 @@ void CInstancesModel::GenerateList()
 
         for (uint32 iTemp = 0; iTemp < NumTemplates; iTemp++)
         {
-            CScriptTemplate *pTemp = mpCurrentGame->TemplateByIndex(iTemp);
+            // Unloaded templates can't have any instances
+            CScriptTemplate *pTemp = mpCurrentGame->LoadedTemplateByIndex(iTemp);
 
-            if (pTemp->NumObjects() > 0)
+            if (pTemp && pTemp->NumObjects() > 0)
                 mTemplateList.push_back(pTemp);
         }
 
@@ -35,11 +35,41 @@
 #include <QSettings>
 #include <QToolButton>
 
+#include <algorithm>
+#include <set>
+#include <utility>
+
+/** How long an area has to be open before its attached areas start loading in the background, in seconds */
+constexpr double gkAdjacentAreaPrefetchDelay = 1.0;
+
+/** Rough memory cost of loading an area: the area file plus every resource it references that isn't loaded yet */
+static uint64 EstimateAreaLoadSize(CResourceEntry *pAreaEntry)
+{
+    uint64 Size = pAreaEntry->Size();
+
+    if (CDependencyTree *pTree = pAreaEntry->Dependencies())
+    {
+        std::set<CAssetID> References;
+        pTree->GetAllResourceReferences(References);
+
+        for (const CAssetID& rkID : References)
+        {
+            CResourceEntry *pDependency = pAreaEntry->ResourceStore()->FindEntry(rkID);
+
+            if (pDependency && !pDependency->IsLoaded())
+                Size += pDependency->Size();
+        }
+    }
+
+    return Size;
+}
+
 CWorldEditor::CWorldEditor(QWidget *parent)
     : INodeEditor(parent)
     , ui(std::make_unique<Ui::CWorldEditor>())
     , mpLinkDialog(new CLinkDialog(this, this))
     , mpGeneratePropertyNamesDialog(new CGeneratePropertyNamesDialog(this))
+    , mpResourceCacheDialog(new CResourceCacheDialog(this))
     , mpTweakEditor(new CTweakEditor(this))
 {
     debugf("Creating World Editor");
@@ -192,6 +222,7 @@ CWorldEditor::CWorldEditor(QWidget *parent)
         connect(ui->ActionGeneratePropertyNames, SIGNAL(triggered()), mpGeneratePropertyNamesDialog, SLOT(show()));
     else
         ui->ActionGeneratePropertyNames->setEnabled(false);
+    connect(ui->ActionResourceCache, SIGNAL(triggered()), mpResourceCacheDialog, SLOT(show()));
 
     connect(ui->ActionDrawWorld, SIGNAL(triggered()), this, SLOT(ToggleDrawWorld()));
     connect(ui->ActionDrawObjects, SIGNAL(triggered()), this, SLOT(ToggleDrawObjects()));
@@ -218,6 +249,7 @@ CWorldEditor::CWorldEditor(QWidget *parent)
 CWorldEditor::~CWorldEditor()
 {
     mScene.ClearScene();
+    ClearAdjacentAreaPrefetches();
     mpArea = nullptr;
     mpWorld = nullptr;
     if (gpResourceStore)
@@ -240,10 +272,12 @@ bool CWorldEditor::CloseWorld()
         mpLinkDialog->close();
         mpQuickplayAction->setEnabled(false);
 
+        ClearAdjacentAreaPrefetches();
+        mShouldPrefetchAdjacentAreas = false;
         mpArea = nullptr;
         mpWorld = nullptr;
-        if (gpResourceStore)
-            gpResourceStore->DestroyUnreferencedResources(); // this should destroy the area!
+        mAreaIndex = -1;
+        mShouldReleaseResources = true; // the area stays cached until the cache needs the memory
         UpdateWindowTitle();
 
         ui->ActionSave->setEnabled(false);
@@ -257,8 +291,17 @@ bool CWorldEditor::CloseWorld()
 
 bool CWorldEditor::SetArea(CWorld *pWorld, int AreaIndex)
 {
+    // Hold on to the adjacent areas until the new area is loaded; it's most likely one of them
+    std::vector<TResourceLoadHandle> OldPrefetches = std::move(mAdjacentAreaPrefetches);
+    const uint64 OldPrefetchBytes = std::exchange(mAdjacentAreaPrefetchBytes, 0);
+    mAdjacentAreaPrefetches.clear();
+
     if (!CloseWorld())
+    {
+        mAdjacentAreaPrefetches = std::move(OldPrefetches);
+        mAdjacentAreaPrefetchBytes = OldPrefetchBytes;
         return false;
+    }
 
     ExitPickMode();
     ui->MainViewport->ResetHover();
@@ -267,11 +310,25 @@ bool CWorldEditor::SetArea(CWorld *pWorld, int AreaIndex)
 
     // Load new area
     mpWorld = pWorld;
+    mAreaIndex = AreaIndex;
     CAssetID AreaID = mpWorld->AreaResourceID(AreaIndex);
     CResourceEntry *pAreaEntry = gpResourceStore->FindEntry(AreaID);
     ASSERT(pAreaEntry);
 
-    mpArea = pAreaEntry->Load();
+    const auto Prefetch = std::find_if(OldPrefetches.begin(), OldPrefetches.end(), [pAreaEntry](const TResourceLoadHandle& pkRequest) {
+        return pkRequest->Entry() == pAreaEntry;
+    });
+
+    if (Prefetch != OldPrefetches.end())
+    {
+        (*Prefetch)->RaisePriority(EResourceLoadPriority::Immediate);
+        mpArea = (*Prefetch)->Wait();
+    }
+    else
+    {
+        mpArea = pAreaEntry->Load();
+    }
+
     ASSERT(mpArea);
     mpWorld->SetAreaLayerInfo(mpArea);
     mScene.SetActiveArea(mpWorld, mpArea);
@@ -314,6 +371,13 @@ bool CWorldEditor::SetArea(CWorld *pWorld, int AreaIndex)
     emit MapChanged(mpWorld, mpArea);
     emit LayersModified();
 
+    // Adjacent areas of the old area that aren't needed anymore go to the resource cache
+    OldPrefetches.clear();
+    gpResourceStore->ResourceCache().Unreserve(OldPrefetchBytes);
+    mShouldReleaseResources = true;
+
+    mAreaLoadTime = CTimer::GlobalTime();
+    mShouldPrefetchAdjacentAreas = true;
     return true;
 }
 
@@ -348,6 +412,31 @@ void CWorldEditor::EditorTick(float)
 {
     // Update new link line
     UpdateNewLinkLine();
+
+    if (!gpResourceStore)
+        return;
+
+    // Drop the prefetched areas if the cache budget was lowered below what they need
+    if (mAdjacentAreaPrefetchBytes > gpResourceStore->ResourceCache().Budget() / 2)
+    {
+        ClearAdjacentAreaPrefetches();
+        mShouldReleaseResources = true;
+    }
+
+    // Releasing would block until a running parse finishes, so leave it for a later tick instead
+    if (mShouldReleaseResources && !gpResourceStore->AsyncLoader()->IsParsing())
+    {
+        mShouldReleaseResources = false;
+        gpResourceStore->ReleaseUnreferencedResources();
+    }
+
+    // Start loading the attached areas once the active area has settled and nothing else is loading
+    if (mShouldPrefetchAdjacentAreas &&
+        CTimer::GlobalTime() - mAreaLoadTime >= gkAdjacentAreaPrefetchDelay &&
+        gpResourceStore->AsyncLoader()->NumPendingRequests() == 0)
+    {
+        PrefetchAdjacentAreas();
+    }
 }
 
 void CWorldEditor::NotifyNodeAboutToBeDeleted(CSceneNode *pNode)
@@ -358,6 +447,58 @@ void CWorldEditor::NotifyNodeAboutToBeDeleted(CSceneNode *pNode)
         ui->MainViewport->ResetHover();
 }
 
+void CWorldEditor::PrefetchAdjacentAreas()
+{
+    mShouldPrefetchAdjacentAreas = false;
+
+    if (!mpWorld || !mpArea || mAreaIndex < 0)
+        return;
+
+    // Prefetched areas stay loaded until the next area change, so keep them within half the
+    // resource cache budget. Areas that don't fit are loaded on demand as usual. The size is
+    // reserved in the cache, which evicts cached resources to make room on the next release.
+    const uint64 Budget = gpResourceStore->ResourceCache().Budget() / 2;
+    uint64 TotalSize = 0;
+
+    for (uint32 AttachIdx = 0; AttachIdx < mpWorld->AreaAttachedCount(mAreaIndex); AttachIdx++)
+    {
+        const uint32 AdjacentIndex = mpWorld->AreaAttachedID(mAreaIndex, AttachIdx);
+
+        if (AdjacentIndex >= mpWorld->NumAreas() || static_cast<int>(AdjacentIndex) == mAreaIndex)
+            continue;
+
+        CResourceEntry *pEntry = gpResourceStore->FindEntry(mpWorld->AreaResourceID(AdjacentIndex));
+
+        if (!pEntry)
+            continue;
+
+        const uint64 Size = EstimateAreaLoadSize(pEntry);
+
+        if (TotalSize + Size > Budget)
+            break;
+
+        TotalSize += Size;
+        mAdjacentAreaPrefetches.push_back(gpResourceStore->LoadResourceAsync(pEntry->ID(), EResourceLoadPriority::Prefetch));
+    }
+
+    if (TotalSize > 0)
+    {
+        gpResourceStore->ResourceCache().Reserve(TotalSize);
+        mAdjacentAreaPrefetchBytes += TotalSize;
+        mShouldReleaseResources = true;
+    }
+}
+
+void CWorldEditor::ClearAdjacentAreaPrefetches()
+{
+    mAdjacentAreaPrefetches.clear();
+
+    if (mAdjacentAreaPrefetchBytes > 0 && gpResourceStore)
+        gpResourceStore->ResourceCache().Unreserve(mAdjacentAreaPrefetchBytes);
+
+    mAdjacentAreaPrefetchBytes = 0;
+}
+
 bool CWorldEditor::Save()
 {
     if (!mpArea)
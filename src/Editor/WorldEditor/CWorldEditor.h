@@ -11,6 +11,7 @@
 #include "NDolphinIntegration.h"
 #include "Editor/INodeEditor.h"
 #include "Editor/CGeneratePropertyNamesDialog.h"
+#include "Editor/CResourceCacheDialog.h"
 #include "Editor/CGizmo.h"
 #include "Editor/CSceneViewport.h"
 
@@ -18,6 +19,7 @@
 #include <Common/EKeyInputs.h>
 #include <Common/Math/CRay.h>
 #include <Common/Math/ETransformSpace.h>
+#include <Core/GameProject/CAsyncResourceLoader.h>
 #include <Core/Render/CRenderer.h>
 #include <Core/Resource/Area/CGameArea.h>
 #include <Core/Resource/CWorld.h>
@@ -35,6 +37,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 namespace Ui {
 class CWorldEditor;
@@ -58,10 +61,22 @@ class CWorldEditor : public INodeEditor
 
     TResPtr<CWorld> mpWorld;
     TResPtr<CGameArea> mpArea;
+    int mAreaIndex = -1;
+
+    // Areas attached to the active area, loaded in the background once it has been open for a moment.
+    // Their estimated size is reserved in the resource cache, so cached resources make room for them.
+    std::vector<TResourceLoadHandle> mAdjacentAreaPrefetches;
+    uint64 mAdjacentAreaPrefetchBytes = 0;
+    double mAreaLoadTime = 0.0;
+    bool mShouldPrefetchAdjacentAreas = false;
+
+    // Unloading waits for background parsing, so unreferenced resources are released once it's idle
+    bool mShouldReleaseResources = false;
 
     CCollisionRenderSettingsDialog* mpCollisionDialog;
     CLinkDialog* mpLinkDialog;
     CGeneratePropertyNamesDialog* mpGeneratePropertyNamesDialog;
+    CResourceCacheDialog* mpResourceCacheDialog;
     CTweakEditor* mpTweakEditor;
 
     bool mIsMakingLink = false;
@@ -143,6 +158,8 @@ public slots:
     void LaunchQuickplayFromLocation(CVector3f Location, bool ForceAsSpawnPosition);
 
 protected:
+    void PrefetchAdjacentAreas();
+    void ClearAdjacentAreaPrefetches();
     QAction* AddEditModeButton(QIcon Icon, QString ToolTip, EWorldEditorMode Mode);
     void SetSidebar(CWorldEditorSidebar *pSidebar);
     void GizmoModeChanged(CGizmo::EGizmoMode Mode) override;
@@ -57,12 +57,30 @@ bool WCreateTab::eventFilter(QObject *pObj, QEvent *pEvent)
     return false;
 }
 
+void WCreateTab::showEvent(QShowEvent *pEvent)
+{
+    if (mHasPendingGame)
+    {
+        ui->TemplateView->SetGame(mpPendingGame);
+        mHasPendingGame = false;
+    }
+
+    QWidget::showEvent(pEvent);
+}
+
 // ************ PUBLIC SLOTS ************
 void WCreateTab::OnActiveProjectChanged(CGameProject *pProj)
 {
     EGame Game = (pProj ? pProj->Game() : EGame::Invalid);
-    CGameTemplate *pGame = NGameList::GetGameTemplate(Game);
-    ui->TemplateView->SetGame(pGame);
+    mpPendingGame = NGameList::GetGameTemplate(Game);
+    mHasPendingGame = true;
+
+    // Listing the templates loads all of them, so wait until the tab is actually shown
+    if (isVisible())
+    {
+        ui->TemplateView->SetGame(mpPendingGame);
+        mHasPendingGame = false;
+    }
 }
 
 void WCreateTab::OnLayersChanged()
@@ -16,12 +16,15 @@ class WCreateTab : public QWidget
     Q_OBJECT
     CWorldEditor *mpEditor;
     CScriptLayer *mpSpawnLayer = nullptr;
+    CGameTemplate *mpPendingGame = nullptr;
+    bool mHasPendingGame = false;
 
 public:
     explicit WCreateTab(CWorldEditor *pEditor, QWidget *parent = nullptr);
     ~WCreateTab() override;
 
     bool eventFilter(QObject *, QEvent *) override;
+    void showEvent(QShowEvent *pEvent) override;
 
     // Accessors
     CScriptLayer* SpawnLayer() const { return mpSpawnLayer; }
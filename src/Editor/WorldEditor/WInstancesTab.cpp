@@ -304,10 +304,13 @@ void WInstancesTab::OnHideAllExceptTypeAction()
         EGame Game = mpEditor->CurrentGame();
         CGameTemplate *pGame = NGameList::GetGameTemplate(Game);
 
+        // Templates that haven't been loaded have no instances, so there's nothing to hide
         for (uint32 iTemp = 0; iTemp < pGame->NumScriptTemplates(); iTemp++)
         {
-            CScriptTemplate *pTemplate = pGame->TemplateByIndex(iTemp);
-            pTemplate->SetVisible( pTemplate == mpMenuTemplate ? true : false );
+            CScriptTemplate *pTemplate = pGame->LoadedTemplateByIndex(iTemp);
+
+            if (pTemplate)
+                pTemplate->SetVisible( pTemplate == mpMenuTemplate ? true : false );
         }
 
         mpTypesModel->dataChanged( mpTypesModel->index(0, 2, TypeParent), mpTypesModel->index(mpTypesModel->rowCount(TypeParent) - 1, 2, TypeParent) );
@@ -335,7 +338,10 @@ void WInstancesTab::OnUnhideAllTypes()
         CGameTemplate *pGame = NGameList::GetGameTemplate(Game);
 
         for (uint32 iTemp = 0; iTemp < pGame->NumScriptTemplates(); iTemp++)
-            pGame->TemplateByIndex(iTemp)->SetVisible(true);
+        {
+            if (CScriptTemplate *pTemplate = pGame->LoadedTemplateByIndex(iTemp))
+                pTemplate->SetVisible(true);
+        }
 
         mpTypesModel->dataChanged( mpTypesModel->index(0, 2, TypeParent), mpTypesModel->index(mpTypesModel->rowCount(TypeParent) - 1, 2, TypeParent) );
     }
@@ -369,7 +375,10 @@ void WInstancesTab::OnUnhideAll()
         CGameTemplate *pGame = NGameList::GetGameTemplate(Game);
 
         for (uint32 iTemp = 0; iTemp < pGame->NumScriptTemplates(); iTemp++)
-            pGame->TemplateByIndex(iTemp)->SetVisible(true);
+        {
+            if (CScriptTemplate *pTemplate = pGame->LoadedTemplateByIndex(iTemp))
+                pTemplate->SetVisible(true);
+        }
 
         mpTypesModel->dataChanged( mpTypesModel->index(0, 2, TypesRoot), mpTypesModel->index(mpTypesModel->rowCount(TypesRoot) - 1, 2, TypesRoot) );
     }
@@ -4,6 +4,7 @@
 #include "UICommon.h"
 #include <Common/Log.h>
 
+#include <Core/CTrace.h>
 #include <Core/NCoreTests.h>
 #include <Core/Resource/Script/NGameList.h>
 
@@ -77,6 +78,9 @@ static TString LocateLogPath()
 
 class CMain
 {
+    /** Where to write the trace of this session, if one was requested with -trace */
+    TString mTracePath;
+
 public:
     /** Main function */
     int Main(int argc, char *argv[])
@@ -119,6 +123,17 @@ public:
             UICommon::ErrorMsg(nullptr, "Couldn't open log file. Logging will not work for this session.");
         qInstallMessageHandler(QtLogRedirect);
 
+        // Record a trace of the whole session if requested; it's written out on exit
+        const QStringList Args = App.arguments();
+        const int TraceArg = Args.indexOf(QStringLiteral("-trace"));
+
+        if (TraceArg >= 0 && TraceArg + 1 < Args.size())
+        {
+            mTracePath = TO_TSTRING(Args[TraceArg + 1]);
+            NTrace::SetThreadName("Main thread");
+            NTrace::SetEnabled(true);
+        }
+
         // Locate data directory and check write permissions
         gDataDir = LocateDataDirectory();
         gResourcesWritable = FileUtil::IsDirectoryWritable(gDataDir + "resources");
@@ -141,6 +156,13 @@ public:
             gpEditorStore->ConditionalSaveStore();
         }
 
+        // Precompile the binary template caches and exit; meant to be run as a packaging step
+        if ( App.arguments().contains(QStringLiteral("CompileTemplateCache")) )
+        {
+            NGameList::CompileTemplateCaches();
+            return 0;
+        }
+
         // Check for unit tests being run
         if ( NCoreTests::RunTests(argc, argv) )
         {
@@ -155,6 +177,9 @@ public:
     /** Clean up any resources at the end of application execution */
     ~CMain()
     {
+        if (!mTracePath.IsEmpty())
+            NTrace::WriteChromeTrace(mTracePath);
+
         NGameList::Shutdown();
     }
 